@@ -0,0 +1,348 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+#include <openssl/crypto.h>
+
+#include "pqc_async.h"
+#include "pqc_backend.h"
+#include "pqc_metrics.h"
+#include "pqc_timer.h"
+
+/*
+ * Reactor latency under heavy signing. An epoll loop serves a 1 ms timer,
+ * standing in for socket events, and is asked for one signature every
+ * SIGN_EVERY_MS. Each path runs the same schedule:
+ *
+ *   idle      timer only, no signatures
+ *   blocking  the loop calls pqc_sign() itself, like do_sign() in a handler
+ *   async     the loop submits a pqc_async request and picks the signature
+ *             up when the completion fd fires
+ *
+ * The latency of a tick is how late the loop got to the oldest expiry it
+ * had not served yet, so a loop stuck in a 100 ms signature records 100 ms.
+ */
+
+#define TICK_NS       1000000ull
+#define SIGN_EVERY_MS 50
+#define MAX_INFLIGHT  64
+
+static const uint8_t msg[] = "reactor bench: a handshake transcript to sign";
+
+typedef enum { PATH_IDLE, PATH_BLOCKING, PATH_ASYNC } path;
+
+typedef struct {
+    pqc_async_req req;
+    uint8_t *sig;
+    int busy;
+    struct bench *b;
+} sign_slot;
+
+typedef struct bench {
+    const char *alg;
+    pqc_alg *a;                 /* the loop's own handle, for PATH_BLOCKING */
+    const pqc_alg_info *info;
+    uint8_t *pk, *sk;
+    pqc_async *async;
+    sign_slot slots[MAX_INFLIGHT];
+
+    uint64_t *lat;              /* one per timer wakeup */
+    size_t n_lat, max_lat;
+    size_t signed_ok, failed, skipped;
+} bench;
+
+/* Runs on the loop thread, from pqc_async_poll() */
+static void on_signed(pqc_async_req *req) {
+    sign_slot *slot = req->user;
+
+    if (req->ok) slot->b->signed_ok++;
+    else slot->b->failed++;
+    slot->busy = 0;
+}
+
+static int request_signature(bench *b, path p) {
+    size_t sig_len;
+
+    if (p == PATH_BLOCKING) {
+        if (pqc_sign(b->a, b->slots[0].sig, &sig_len, msg, sizeof(msg), b->sk)) b->signed_ok++;
+        else b->failed++;
+        return 1;
+    }
+    for (size_t i = 0; i < MAX_INFLIGHT; i++) {
+        sign_slot *slot = &b->slots[i];
+
+        if (slot->busy) continue;
+        memset(&slot->req, 0, sizeof(slot->req));
+        slot->req.op = PQC_ASYNC_SIGN;
+        slot->req.alg = b->alg;
+        slot->req.backend = pqc_alg_backend(b->a)->name;
+        slot->req.key = b->sk;
+        slot->req.msg = msg;
+        slot->req.msg_len = sizeof(msg);
+        slot->req.sig = slot->sig;
+        slot->req.done = on_signed;
+        slot->req.user = slot;
+        if (!pqc_async_submit(b->async, &slot->req)) return 0;
+        slot->busy = 1;
+        return 1;
+    }
+    b->skipped++;               /* the pool is MAX_INFLIGHT signatures behind */
+    return 1;
+}
+
+/* *elapsed includes collecting the last signatures */
+static int run(bench *b, path p, double seconds, uint64_t *elapsed) {
+    struct itimerspec its = { { 0, (long)TICK_NS }, { 0, (long)TICK_NS } };
+    struct epoll_event ev, events[4];
+    uint64_t start, ticks = 0, every = SIGN_EVERY_MS * 1000000ull / TICK_NS;
+    int tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK), epfd = epoll_create1(0), ok = 0;
+
+    b->n_lat = b->signed_ok = b->failed = b->skipped = 0;
+    if (tfd < 0 || epfd < 0) goto done;
+    ev.events = EPOLLIN;
+    ev.data.fd = tfd;
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, tfd, &ev) != 0) goto done;
+    if (p == PATH_ASYNC) {
+        ev.data.fd = pqc_async_fd(b->async);
+        if (epoll_ctl(epfd, EPOLL_CTL_ADD, ev.data.fd, &ev) != 0) goto done;
+    }
+    if (timerfd_settime(tfd, 0, &its, NULL) != 0) goto done;
+    start = pqc_now_ns();
+
+    while (ticks * TICK_NS < (uint64_t)(seconds * 1e9)) {
+        int n = epoll_wait(epfd, events, 4, -1);
+
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            goto done;
+        }
+        for (int i = 0; i < n; i++) {
+            uint64_t expired, now;
+
+            if (events[i].data.fd != tfd) {
+                pqc_async_poll(b->async);
+                continue;
+            }
+            if (read(tfd, &expired, sizeof(expired)) != sizeof(expired)) continue;
+            now = pqc_now_ns();
+            if (b->n_lat < b->max_lat) {
+                uint64_t due = start + (ticks + 1) * TICK_NS;
+                b->lat[b->n_lat++] = now > due ? now - due : 0;
+            }
+            for (uint64_t t = ticks + 1; t <= ticks + expired; t++)
+                if (p != PATH_IDLE && t % every == 0 && !request_signature(b, p)) goto done;
+            ticks += expired;
+        }
+    }
+
+    /* Collect the signatures still in flight */
+    while (p == PATH_ASYNC && pqc_async_pending(b->async)) {
+        struct pollfd pfd = { pqc_async_fd(b->async), POLLIN, 0 };
+
+        if (poll(&pfd, 1, -1) > 0) pqc_async_poll(b->async);
+    }
+    *elapsed = pqc_now_ns() - start;
+    ok = 1;
+
+done:
+    if (tfd >= 0) close(tfd);
+    if (epfd >= 0) close(epfd);
+    return ok;
+}
+
+static void report(const char *name, bench *b, uint64_t elapsed) {
+    pqc_stats st;
+    pqc_metrics_sizes sizes = { b->info->pk_len, b->info->sk_len, 0, 0, b->info->sig_len };
+
+    /* ops/sec here is timer wakeups over the whole path, drain included */
+    pqc_metrics_emit_samples(b->alg, "tick-latency", name, b->lat, b->n_lat, elapsed, &sizes);
+    pqc_stats_compute(&st, b->lat, NULL, b->n_lat, 0);
+    printf("  %-10s %9.1f %9.1f %10.1f %9.1f", name, st.median_ns / 1e3, st.p99_ns / 1e3,
+           st.max_ns / 1e3, b->signed_ok * 1e9 / elapsed);
+    if (b->skipped) printf("  %zu skipped (pool behind)", b->skipped);
+    printf("\n");
+}
+
+/* Blocks until req has completed; the bench loop is not running yet */
+static int wait_for(pqc_async *a, pqc_async_req *req, int *flag) {
+    *flag = 0;
+    if (!pqc_async_submit(a, req)) return 0;
+    while (!*flag) {
+        struct pollfd pfd = { pqc_async_fd(a), POLLIN, 0 };
+
+        if (poll(&pfd, 1, -1) > 0) pqc_async_poll(a);
+    }
+    return req->ok;
+}
+
+static void on_flag(pqc_async_req *req) {
+    *(int *)req->user = 1;
+}
+
+/* Every async operation must match its blocking counterpart */
+static int check(bench *b, const char *kem_alg) {
+    const char *backend = pqc_alg_backend(b->a)->name;
+    pqc_alg *kem = pqc_alg_open(kem_alg, backend);
+    const pqc_alg_info *ki = kem ? pqc_alg_info_get(kem) : NULL;
+    uint8_t *kpk = NULL, *ksk = NULL, *ct = NULL, *ss1 = NULL, *ss2 = NULL;
+    pqc_async_req r;
+    int flag, ok = 0;
+
+    /* Sign, verify, then verify a modified signature */
+    r = (pqc_async_req){ .op = PQC_ASYNC_SIGN, .alg = b->alg, .backend = backend, .key = b->sk,
+                         .msg = msg, .msg_len = sizeof(msg), .sig = b->slots[0].sig,
+                         .done = on_flag, .user = &flag };
+    if (!wait_for(b->async, &r, &flag)) goto done;
+    r.op = PQC_ASYNC_VERIFY;
+    r.key = b->pk;
+    if (!wait_for(b->async, &r, &flag)) goto done;
+    r.sig[r.sig_len / 2] ^= 1;
+    if (wait_for(b->async, &r, &flag)) goto done;
+
+    /* Keygen, encaps and decaps on the pool */
+    if (!ki) {
+        ok = 1;
+        goto done;
+    }
+    kpk = malloc(ki->pk_len);
+    ksk = malloc(ki->sk_len);
+    ct = malloc(ki->ct_len);
+    ss1 = malloc(ki->ss_len);
+    ss2 = malloc(ki->ss_len);
+    if (!kpk || !ksk || !ct || !ss1 || !ss2) goto done;
+    r = (pqc_async_req){ .op = PQC_ASYNC_KEYPAIR, .alg = kem_alg, .backend = backend, .pk = kpk, .sk = ksk,
+                         .done = on_flag, .user = &flag };
+    if (!wait_for(b->async, &r, &flag)) goto done;
+    r.op = PQC_ASYNC_ENCAPS;
+    r.key = kpk;
+    r.ct = ct;
+    r.ss = ss1;
+    if (!wait_for(b->async, &r, &flag)) goto done;
+    r.op = PQC_ASYNC_DECAPS;
+    r.key = ksk;
+    r.ss = ss2;
+    ok = wait_for(b->async, &r, &flag) && CRYPTO_memcmp(ss1, ss2, ki->ss_len) == 0;
+
+done:
+    if (ksk) OPENSSL_cleanse(ksk, ki->sk_len);
+    if (ss1) OPENSSL_cleanse(ss1, ki->ss_len);
+    if (ss2) OPENSSL_cleanse(ss2, ki->ss_len);
+    free(kpk);
+    free(ksk);
+    free(ct);
+    free(ss1);
+    free(ss2);
+    pqc_alg_close(kem);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    const char *backend = NULL;
+    double seconds = 3.0;
+    unsigned workers = 0;
+    pqc_pin_mode pin = PQC_PIN_CORE;
+    bench b;
+    uint64_t elapsed = 0;
+    int c, ret = 1;
+
+    memset(&b, 0, sizeof(b));
+    b.alg = "SLH-DSA-SHA2-128s";
+    while ((c = getopt(argc, argv, "a:b:s:w:P:h")) != -1) {
+        switch (c) {
+        case 'a': b.alg = optarg; break;
+        case 'b': backend = optarg; break;
+        case 's': seconds = atof(optarg); break;
+        case 'w': workers = (unsigned)strtoul(optarg, NULL, 10); break;
+        case 'P':
+            if (pqc_sched_parse_pin(optarg, &pin)) break;
+            /* fall through */
+        default:
+            printf("Usage: %s [-a algorithm] [-b backend] [-s seconds] [-w workers] [-P none|core|node]\n", argv[0]);
+            return c == 'h' ? 0 : 1;
+        }
+    }
+    if (seconds <= 0) seconds = 1;
+
+    pqc_metrics_init("reactor_bench");
+    printf("🎯 Reactor Latency Under Signing\n");
+    printf("================================\n");
+
+    if (!(b.a = pqc_alg_open(b.alg, backend)) || (b.info = pqc_alg_info_get(b.a))->kind != PQC_SIG) {
+        printf("❌ %s is not available as a signature algorithm\n", b.alg);
+        goto cleanup;
+    }
+    b.pk = malloc(b.info->pk_len);
+    b.sk = malloc(b.info->sk_len);
+    b.max_lat = (size_t)(seconds * 1e9 / TICK_NS) + 16;
+    b.lat = malloc(b.max_lat * sizeof(*b.lat));
+    if (!b.pk || !b.sk || !b.lat) {
+        printf("❌ Memory allocation failed\n");
+        goto cleanup;
+    }
+    for (size_t i = 0; i < MAX_INFLIGHT; i++) {
+        b.slots[i].b = &b;
+        if (!(b.slots[i].sig = malloc(b.info->sig_len))) {
+            printf("❌ Memory allocation failed\n");
+            goto cleanup;
+        }
+    }
+    if (!pqc_keypair(b.a, b.pk, b.sk)) {
+        printf("❌ Key generation failed\n");
+        goto cleanup;
+    }
+    if (!(b.async = pqc_async_new(workers, pin))) {
+        printf("❌ Failed to start the crypto pool\n");
+        goto cleanup;
+    }
+
+    if (!check(&b, "ML-KEM-768")) {
+        printf("❌ An async operation disagreed with the blocking API\n");
+        goto cleanup;
+    }
+    printf("✅ Async sign, verify, keygen, encaps and decaps agree with the blocking calls\n\n");
+
+    printf("Algorithm: %s (%s), 1 ms timer, one signature every %d ms, %.1fs per path, %u workers\n\n",
+           b.alg, pqc_alg_backend(b.a)->name, SIGN_EVERY_MS, seconds, pqc_sched_workers(pqc_async_sched(b.async)));
+    printf("  %-10s %9s %9s %10s %9s\n", "path", "p50 us", "p99 us", "max us", "signs/s");
+
+    {
+        static const struct { const char *name; path p; } paths[] = {
+            { "idle", PATH_IDLE }, { "blocking", PATH_BLOCKING }, { "async", PATH_ASYNC },
+        };
+
+        for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+            if (paths[i].p == PATH_ASYNC) pqc_sched_reset_stats(pqc_async_sched(b.async));
+            if (!run(&b, paths[i].p, seconds, &elapsed)) {
+                printf("❌ Event loop setup failed: %s\n", strerror(errno));
+                goto cleanup;
+            }
+            if (b.failed) {
+                printf("❌ Signing failed\n");
+                goto cleanup;
+            }
+            report(paths[i].name, &b, elapsed);
+        }
+    }
+
+    printf("\nCrypto pool during the async path:\n");
+    pqc_sched_report(pqc_async_sched(b.async), elapsed);
+    printf("\n✨ Benchmark completed!\n");
+    ret = 0;
+
+cleanup:
+    pqc_async_free(b.async);
+    for (size_t i = 0; i < MAX_INFLIGHT; i++) free(b.slots[i].sig);
+    if (b.sk) OPENSSL_cleanse(b.sk, b.info->sk_len);
+    free(b.sk);
+    free(b.pk);
+    free(b.lat);
+    pqc_alg_close(b.a);
+    return ret;
+}
@@ -0,0 +1,121 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <openssl/crypto.h>
+
+#include "pqc_arena.h"
+
+#define MAX_SECRETS 16
+
+typedef struct {
+    size_t offset;
+    size_t len;
+} secret_region;
+
+struct pqc_arena {
+    unsigned char *base;
+    size_t capacity;
+    size_t used;
+    secret_region secrets[MAX_SECRETS];
+    size_t nsecrets;
+    int wipe_all;               /* more secrets than we track: wipe all used bytes */
+};
+
+static pthread_once_t thread_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t thread_key;
+
+static void thread_arena_free(void *arena) {
+    pqc_arena_free(arena);
+}
+
+static void thread_key_init(void) {
+    pthread_key_create(&thread_key, thread_arena_free);
+}
+
+pqc_arena *pqc_arena_new(size_t capacity) {
+    pqc_arena *arena = calloc(1, sizeof(*arena));
+    void *base = NULL;
+
+    if (!arena) return NULL;
+
+    capacity = pqc_arena_size(capacity ? capacity : 1);
+    if (posix_memalign(&base, PQC_ARENA_ALIGN, capacity) != 0) {
+        free(arena);
+        return NULL;
+    }
+    arena->base = base;
+    arena->capacity = capacity;
+    return arena;
+}
+
+void pqc_arena_free(pqc_arena *arena) {
+    if (!arena) return;
+    pqc_arena_reset(arena);
+    free(arena->base);
+    free(arena);
+}
+
+pqc_arena *pqc_arena_thread(size_t capacity) {
+    pqc_arena *arena;
+
+    pthread_once(&thread_key_once, thread_key_init);
+    arena = pthread_getspecific(thread_key);
+
+    if (arena && arena->capacity >= capacity) return arena;
+    if (arena && arena->used) return NULL;
+
+    pqc_arena_free(arena);
+    arena = pqc_arena_new(capacity);
+    pthread_setspecific(thread_key, arena);
+    return arena;
+}
+
+void *pqc_arena_alloc(pqc_arena *arena, size_t len) {
+    size_t size = pqc_arena_size(len);
+    void *p;
+
+    if (!arena || size > arena->capacity - arena->used) return NULL;
+    p = arena->base + arena->used;
+    arena->used += size;
+    return p;
+}
+
+void *pqc_arena_alloc_secret(pqc_arena *arena, size_t len) {
+    size_t offset = arena ? arena->used : 0;
+    void *p = pqc_arena_alloc(arena, len);
+
+    if (!p) return NULL;
+    if (arena->nsecrets < MAX_SECRETS) {
+        arena->secrets[arena->nsecrets].offset = offset;
+        arena->secrets[arena->nsecrets].len = len;
+        arena->nsecrets++;
+    } else {
+        arena->wipe_all = 1;
+    }
+    return p;
+}
+
+void pqc_arena_reset(pqc_arena *arena) {
+    if (!arena) return;
+
+    if (arena->wipe_all) {
+        OPENSSL_cleanse(arena->base, arena->used);
+    } else {
+        for (size_t i = 0; i < arena->nsecrets; i++)
+            OPENSSL_cleanse(arena->base + arena->secrets[i].offset, arena->secrets[i].len);
+    }
+    arena->nsecrets = 0;
+    arena->wipe_all = 0;
+    arena->used = 0;
+}
+
+size_t pqc_arena_used(const pqc_arena *arena) {
+    return arena->used;
+}
+
+size_t pqc_arena_capacity(const pqc_arena *arena) {
+    return arena->capacity;
+}
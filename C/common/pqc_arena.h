@@ -0,0 +1,52 @@
+#ifndef PQC_ARENA_H
+#define PQC_ARENA_H
+
+#include <stddef.h>
+
+/*
+ * Bump allocator for the key, ciphertext and signature buffers of one
+ * operation.
+ *
+ * The arena is sized once from the algorithm's lengths (sig->length_*,
+ * kem->length_*) and handed out with pqc_arena_alloc() /
+ * pqc_arena_alloc_secret(). pqc_arena_reset() releases everything at once
+ * and zeroizes the regions that were allocated as secret, so a loop that
+ * resets the arena each iteration does no heap allocation at all.
+ *
+ * An arena is not thread-safe; pqc_arena_thread() gives each thread its own.
+ */
+
+#define PQC_ARENA_ALIGN 64
+
+typedef struct pqc_arena pqc_arena;
+
+/* Space one buffer of len bytes takes up in the arena. */
+static inline size_t pqc_arena_size(size_t len) {
+    return (len + PQC_ARENA_ALIGN - 1) & ~(size_t)(PQC_ARENA_ALIGN - 1);
+}
+
+pqc_arena *pqc_arena_new(size_t capacity);
+
+/* Zeroizes secret regions and frees the arena. */
+void pqc_arena_free(pqc_arena *arena);
+
+/*
+ * The calling thread's arena, created on first use and freed when the thread
+ * exits. If it is smaller than capacity and currently empty it is replaced by
+ * a larger one; if it is in use, NULL is returned.
+ */
+pqc_arena *pqc_arena_thread(size_t capacity);
+
+/* PQC_ARENA_ALIGN-aligned, uninitialised. NULL when the arena is full. */
+void *pqc_arena_alloc(pqc_arena *arena, size_t len);
+
+/* As pqc_arena_alloc(), but the region is zeroized on reset and free. */
+void *pqc_arena_alloc_secret(pqc_arena *arena, size_t len);
+
+/* Zeroizes secret regions and makes the whole arena available again. */
+void pqc_arena_reset(pqc_arena *arena);
+
+size_t pqc_arena_used(const pqc_arena *arena);
+size_t pqc_arena_capacity(const pqc_arena *arena);
+
+#endif /* PQC_ARENA_H */
@@ -0,0 +1,228 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+#include "pqc_async.h"
+#include "pqc_backend.h"
+#include "pqc_timer.h"
+
+#define HANDLES_PER_WORKER 8
+
+struct pqc_async {
+    pqc_sched *sched;
+    int rfd, wfd;               /* the same eventfd, or the two ends of a pipe */
+
+    pthread_mutex_t lock;       /* completion list */
+    pqc_async_req *head, *tail;
+    size_t pending;
+};
+
+/* A worker's open handles, looked up by algorithm and backend name */
+typedef struct {
+    struct {
+        char *alg;
+        char *backend;          /* NULL: default */
+        pqc_alg *a;
+    } h[HANDLES_PER_WORKER];
+    unsigned n, evict;
+} worker_handles;
+
+static void *worker_init(pqc_worker *w, void *arg) {
+    (void)w;
+    (void)arg;
+    return calloc(1, sizeof(worker_handles));
+}
+
+static void worker_fini(pqc_worker *w, void *arg) {
+    worker_handles *wh = w->local;
+
+    (void)arg;
+    for (unsigned i = 0; i < wh->n; i++) {
+        pqc_alg_close(wh->h[i].a);
+        free(wh->h[i].alg);
+        free(wh->h[i].backend);
+    }
+    free(wh);
+}
+
+static int same_backend(const char *x, const char *y) {
+    return x == y || (x && y && strcmp(x, y) == 0);
+}
+
+static char *dup_str(const char *s) {
+    char *d;
+
+    if (!s) return NULL;
+    if ((d = malloc(strlen(s) + 1))) strcpy(d, s);
+    return d;
+}
+
+static pqc_alg *handle(worker_handles *wh, const char *alg, const char *backend) {
+    unsigned i;
+    pqc_alg *a;
+
+    for (i = 0; i < wh->n; i++)
+        if (strcmp(wh->h[i].alg, alg) == 0 && same_backend(wh->h[i].backend, backend)) return wh->h[i].a;
+
+    if (!(a = pqc_alg_open(alg, backend))) return NULL;
+    if (wh->n < HANDLES_PER_WORKER) {
+        i = wh->n++;
+    } else {
+        /* Full: replace slots in turn */
+        i = wh->evict++ % HANDLES_PER_WORKER;
+        pqc_alg_close(wh->h[i].a);
+        free(wh->h[i].alg);
+        free(wh->h[i].backend);
+    }
+    wh->h[i].a = a;
+    wh->h[i].alg = dup_str(alg);
+    wh->h[i].backend = dup_str(backend);
+    if (!wh->h[i].alg || (backend && !wh->h[i].backend)) {
+        pqc_alg_close(a);
+        free(wh->h[i].alg);
+        free(wh->h[i].backend);
+        wh->h[i] = wh->h[--wh->n];
+        return NULL;
+    }
+    return a;
+}
+
+static int run_op(pqc_alg *a, pqc_async_req *r) {
+    switch (r->op) {
+    case PQC_ASYNC_KEYPAIR: return pqc_keypair(a, r->pk, r->sk);
+    case PQC_ASYNC_SIGN:    return pqc_sign(a, r->sig, &r->sig_len, r->msg, r->msg_len, r->key);
+    case PQC_ASYNC_VERIFY:  return pqc_verify(a, r->msg, r->msg_len, r->sig, r->sig_len, r->key);
+    case PQC_ASYNC_ENCAPS:  return pqc_encaps(a, r->ct, r->ss, r->key);
+    case PQC_ASYNC_DECAPS:  return pqc_decaps(a, r->ss, r->ct, r->key);
+    }
+    return 0;
+}
+
+static void notify(pqc_async *a) {
+    uint64_t one = 1;
+
+    while (write(a->wfd, &one, sizeof(one)) < 0 && errno == EINTR)
+        ;
+}
+
+static void job(pqc_worker *w, void *arg) {
+    pqc_async_req *r = arg;
+    pqc_async *a = r->owner;
+    pqc_alg *alg = handle(w->local, r->alg, r->backend);
+    uint64_t t0 = pqc_now_ns();
+    int was_empty;
+
+    r->wait_ns = t0 - r->submitted_ns;
+    r->ok = alg && run_op(alg, r);
+    r->run_ns = pqc_now_ns() - t0;
+
+    r->next = NULL;
+    pthread_mutex_lock(&a->lock);
+    was_empty = a->head == NULL;
+    if (a->tail) a->tail->next = r;
+    else a->head = r;
+    a->tail = r;
+    pthread_mutex_unlock(&a->lock);
+
+    /*
+     * Only the first completion of a batch needs to wake the loop:
+     * pqc_async_poll() clears the fd before it takes the list.
+     */
+    if (was_empty) notify(a);
+}
+
+static int open_fds(pqc_async *a) {
+#ifdef __linux__
+    a->rfd = a->wfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    return a->rfd >= 0;
+#else
+    int fds[2];
+
+    if (pipe(fds) != 0) return 0;
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    fcntl(fds[1], F_SETFL, O_NONBLOCK);
+    a->rfd = fds[0];
+    a->wfd = fds[1];
+    return 1;
+#endif
+}
+
+pqc_async *pqc_async_new(unsigned workers, pqc_pin_mode pin) {
+    pqc_async *a = calloc(1, sizeof(*a));
+    pqc_sched_config cfg = { workers, pin, worker_init, worker_fini, NULL };
+
+    if (!a) return NULL;
+    a->rfd = a->wfd = -1;
+    pthread_mutex_init(&a->lock, NULL);
+    if (!open_fds(a) || !(a->sched = pqc_sched_new(&cfg))) {
+        pqc_async_free(a);
+        return NULL;
+    }
+    return a;
+}
+
+void pqc_async_free(pqc_async *a) {
+    if (!a) return;
+    pqc_sched_free(a->sched);
+    pqc_async_poll(a);
+    if (a->wfd >= 0 && a->wfd != a->rfd) close(a->wfd);
+    if (a->rfd >= 0) close(a->rfd);
+    pthread_mutex_destroy(&a->lock);
+    free(a);
+}
+
+int pqc_async_submit(pqc_async *a, pqc_async_req *req) {
+    req->owner = a;
+    req->ok = 0;
+    req->wait_ns = req->run_ns = 0;
+    req->submitted_ns = pqc_now_ns();
+    __atomic_add_fetch(&a->pending, 1, __ATOMIC_RELAXED);
+    if (!pqc_sched_submit(a->sched, job, req)) {
+        __atomic_sub_fetch(&a->pending, 1, __ATOMIC_RELAXED);
+        return 0;
+    }
+    return 1;
+}
+
+int pqc_async_fd(const pqc_async *a) {
+    return a->rfd;
+}
+
+size_t pqc_async_poll(pqc_async *a) {
+    uint64_t buf[64];
+    pqc_async_req *r, *next;
+    size_t n = 0;
+
+    /* eventfd: one read resets the counter; pipe: empty it */
+    while (read(a->rfd, buf, sizeof(buf)) > 0 && a->rfd != a->wfd)
+        ;
+
+    pthread_mutex_lock(&a->lock);
+    r = a->head;
+    a->head = a->tail = NULL;
+    pthread_mutex_unlock(&a->lock);
+
+    for (; r; r = next, n++) {
+        next = r->next;         /* done may free or resubmit r */
+        __atomic_sub_fetch(&a->pending, 1, __ATOMIC_RELAXED);
+        if (r->done) r->done(r);
+    }
+    return n;
+}
+
+size_t pqc_async_pending(const pqc_async *a) {
+    return __atomic_load_n(&a->pending, __ATOMIC_RELAXED);
+}
+
+pqc_sched *pqc_async_sched(pqc_async *a) {
+    return a->sched;
+}
@@ -0,0 +1,88 @@
+#ifndef PQC_ASYNC_H
+#define PQC_ASYNC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pqc_sched.h"
+
+/*
+ * Completion-based keygen, sign, verify, encaps and decaps for event loops.
+ *
+ * Every call in pqc_backend.h (and OQS_SIG_sign, EVP_PKEY_sign underneath)
+ * blocks, and one SLH-DSA-SHA2-128s signature holds a reactor thread for
+ * 100 ms or more. pqc_async runs requests on a pqc_sched worker pool
+ * instead. A finished request is queued for the loop and the completion fd
+ * (an eventfd on Linux, a pipe elsewhere) becomes readable. The loop
+ * watches that fd with epoll/poll and calls pqc_async_poll(), which runs
+ * the callbacks on the loop's own thread, in completion order.
+ *
+ * The caller owns each request and the buffers it points to until its
+ * callback has run. Each worker opens its own pqc_alg handle per algorithm
+ * and backend on first use and keeps it, since handles are not thread-safe.
+ *
+ * pqc_async_submit() may be called from any thread; pqc_async_poll() and
+ * pqc_async_free() from one thread at a time.
+ */
+
+typedef enum {
+    PQC_ASYNC_KEYPAIR,          /* pk, sk out */
+    PQC_ASYNC_SIGN,             /* msg, key = sk in; sig, sig_len out */
+    PQC_ASYNC_VERIFY,           /* msg, sig, sig_len, key = pk in */
+    PQC_ASYNC_ENCAPS,           /* key = pk in; ct, ss out */
+    PQC_ASYNC_DECAPS            /* ct, key = sk in; ss out */
+} pqc_async_op;
+
+typedef struct pqc_async_req pqc_async_req;
+
+struct pqc_async_req {
+    pqc_async_op op;
+    const char *alg;
+    const char *backend;        /* as for pqc_alg_open(); NULL for the default */
+
+    const uint8_t *key;
+    const uint8_t *msg;
+    size_t msg_len;
+    uint8_t *pk, *sk;
+    uint8_t *sig;               /* pqc_alg_info sig_len bytes for SIGN */
+    size_t sig_len;
+    uint8_t *ct, *ss;
+
+    void (*done)(pqc_async_req *req);   /* on the polling thread */
+    void *user;
+
+    /* Set before done runs */
+    int ok;                     /* 1: the operation succeeded (VERIFY: signature valid) */
+    uint64_t wait_ns;           /* submitted until a worker started it */
+    uint64_t run_ns;            /* time on the worker */
+
+    /* Internal */
+    uint64_t submitted_ns;
+    struct pqc_async *owner;
+    pqc_async_req *next;
+};
+
+typedef struct pqc_async pqc_async;
+
+/* Starts the pool; workers and pin as in pqc_sched_config. NULL on failure. */
+pqc_async *pqc_async_new(unsigned workers, pqc_pin_mode pin);
+
+/* Finishes the queued requests, runs their callbacks, then stops the pool. */
+void pqc_async_free(pqc_async *a);
+
+/* Queues req. Returns 1, or 0 (callback never runs) on allocation failure. */
+int pqc_async_submit(pqc_async *a, pqc_async_req *req);
+
+/* Readable while completions wait for pqc_async_poll(). */
+int pqc_async_fd(const pqc_async *a);
+
+/* Runs the callbacks of every finished request; returns how many. Never blocks. */
+size_t pqc_async_poll(pqc_async *a);
+
+/* Submitted requests whose callback has not run yet. */
+size_t pqc_async_pending(const pqc_async *a);
+
+/* The underlying pool, for pqc_sched_report() and the like. */
+pqc_sched *pqc_async_sched(pqc_async *a);
+
+#endif /* PQC_ASYNC_H */
@@ -0,0 +1,385 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+#include <openssl/crypto.h>
+
+#include "pqc_backend.h"
+#include "pqc_timer.h"
+
+#define CACHE_ENTRIES 64
+#define NAME_MAX_LEN 48
+#define VERSION_MAX_LEN 64
+#define FINGERPRINT_MAX 256
+#define CALIBRATE_MS 300
+#define CALIBRATE_MIN_ITERS 3
+#define CALIBRATE_MAX_ITERS 1000
+
+struct pqc_alg {
+    char name[NAME_MAX_LEN];
+    const pqc_backend *backend;
+    void *state;
+    pqc_alg_info info;
+};
+
+size_t pqc_backend_count(void) {
+    size_t n = 0;
+
+    while (pqc_backends[n]) n++;
+    return n;
+}
+
+const pqc_backend *pqc_backend_at(size_t i) {
+    return i < pqc_backend_count() ? pqc_backends[i] : NULL;
+}
+
+const pqc_backend *pqc_backend_find(const char *name) {
+    for (size_t i = 0; pqc_backends[i]; i++)
+        if (strcmp(pqc_backends[i]->name, name) == 0) return pqc_backends[i];
+    return NULL;
+}
+
+/* ---- Cache of the fastest backend per algorithm ---- */
+
+/*
+ * Every tool shares the file but links its own set of backends, so entries
+ * are kept by name: a tool skips, and writes back unchanged, entries for
+ * backends it does not have. An algorithm can have one entry per backend;
+ * the lowest score among the backends a tool has wins.
+ */
+typedef struct {
+    char alg[NAME_MAX_LEN];
+    char backend[NAME_MAX_LEN];
+    char version[VERSION_MAX_LEN];      /* backend version when recorded, "-" if none */
+    uint64_t score_ns;
+} cache_entry;
+
+static cache_entry cache[CACHE_ENTRIES];
+static size_t cache_n;
+static char fingerprint[FINGERPRINT_MAX];
+static CRYPTO_ONCE cache_once = CRYPTO_ONCE_STATIC_INIT;
+static CRYPTO_RWLOCK *cache_lock;
+
+static void cache_path(char *buf, size_t len) {
+    const char *env = getenv("PQC_BACKEND_CACHE"), *home = getenv("HOME");
+    const char *xdg = getenv("XDG_CACHE_HOME");
+
+    if (env && *env) snprintf(buf, len, "%s", env);
+    else if (xdg && *xdg) snprintf(buf, len, "%s/pqc_backend.cache", xdg);
+    else if (home && *home) snprintf(buf, len, "%s/.cache/pqc_backend.cache", home);
+    else snprintf(buf, len, "pqc_backend.cache");
+}
+
+static const char *backend_version(const pqc_backend *b) {
+    const char *version = b->version ? b->version() : NULL;
+    return version && *version ? version : "-";
+}
+
+/* CPU and OpenSSL, which every backend and tool runs on; backend versions
+ * are kept per entry */
+static void make_fingerprint(void) {
+    char line[256], cpu[128] = "unknown CPU";
+    FILE *f = fopen("/proc/cpuinfo", "r");
+
+    while (f && fgets(line, sizeof(line), f)) {
+        char *colon = strchr(line, ':');
+        if (colon && strncmp(line, "model name", 10) == 0) {
+            snprintf(cpu, sizeof(cpu), "%s", colon + 2);
+            cpu[strcspn(cpu, "\n")] = '\0';
+            break;
+        }
+    }
+    if (f) fclose(f);
+
+    snprintf(fingerprint, sizeof(fingerprint), "%s | OpenSSL %s", cpu,
+             OpenSSL_version(OPENSSL_VERSION_STRING));
+}
+
+static void cache_load(void) {
+    char path[512], line[512];
+    int matches = 0;
+    FILE *f;
+
+    cache_lock = CRYPTO_THREAD_lock_new();
+    make_fingerprint();
+    cache_path(path, sizeof(path));
+    if (!(f = fopen(path, "r"))) return;
+
+    /* "fingerprint = ..." first, then "ALG = backend score_ns version" lines */
+    while (fgets(line, sizeof(line), f) && cache_n < CACHE_ENTRIES) {
+        cache_entry *e = &cache[cache_n];
+        unsigned long long score;
+
+        line[strcspn(line, "\n")] = '\0';
+        if (line[0] == '#' || line[0] == '\0') continue;
+        if (strncmp(line, "fingerprint = ", 14) == 0) {
+            matches = strcmp(line + 14, fingerprint) == 0;
+            continue;
+        }
+        if (!matches) break;
+        if (sscanf(line, "%47s = %47s %llu %63s", e->alg, e->backend, &score, e->version) == 4) {
+            e->score_ns = score;
+            cache_n++;
+        }
+    }
+    fclose(f);
+}
+
+static int cache_ready(void) {
+    return CRYPTO_THREAD_run_once(&cache_once, cache_load) && cache_lock;
+}
+
+const char *pqc_backend_fingerprint(void) {
+    return cache_ready() ? fingerprint : "";
+}
+
+/* The program's backend for an entry, NULL if it has none or it changed */
+static const pqc_backend *entry_backend(const cache_entry *e) {
+    const pqc_backend *b = pqc_backend_find(e->backend);
+    return b && strcmp(backend_version(b), e->version) == 0 ? b : NULL;
+}
+
+const char *pqc_backend_cached(const char *alg, uint64_t *score_ns) {
+    const pqc_backend *best = NULL;
+    uint64_t best_ns = 0;
+
+    if (!cache_ready() || !CRYPTO_THREAD_read_lock(cache_lock)) return NULL;
+    for (size_t i = 0; i < cache_n; i++) {
+        const pqc_backend *b;
+        if (strcmp(cache[i].alg, alg) != 0 || !(b = entry_backend(&cache[i]))) continue;
+        if (!best || cache[i].score_ns < best_ns) {
+            best = b;
+            best_ns = cache[i].score_ns;
+        }
+    }
+    CRYPTO_THREAD_unlock(cache_lock);
+    if (best && score_ns) *score_ns = best_ns;
+    return best ? best->name : NULL;
+}
+
+/* Rewrites the whole file; called with the write lock held */
+static int cache_save(void) {
+    char path[512], tmp[520];
+    FILE *f;
+
+    cache_path(path, sizeof(path));
+    if (!getenv("PQC_BACKEND_CACHE") && !getenv("XDG_CACHE_HOME") && getenv("HOME")) {
+        char dir[512];
+        snprintf(dir, sizeof(dir), "%s/.cache", getenv("HOME"));
+        mkdir(dir, 0700);
+    }
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    if (!(f = fopen(tmp, "w"))) return 0;
+    fprintf(f, "# Fastest PQC backend per algorithm: median encaps+decaps or sign+verify, ns\n");
+    fprintf(f, "fingerprint = %s\n", fingerprint);
+    for (size_t i = 0; i < cache_n; i++)
+        fprintf(f, "%s = %s %llu %s\n", cache[i].alg, cache[i].backend,
+                (unsigned long long)cache[i].score_ns, cache[i].version);
+    if (fclose(f) != 0 || rename(tmp, path) != 0) {
+        remove(tmp);
+        return 0;
+    }
+    return 1;
+}
+
+int pqc_backend_record(const char *alg, const char *backend, uint64_t score_ns) {
+    const pqc_backend *b = pqc_backend_find(backend);
+    size_t i, kept = 0;
+    int ok;
+
+    if (!b || strlen(alg) >= NAME_MAX_LEN || strlen(backend_version(b)) >= VERSION_MAX_LEN
+        || !cache_ready() || !CRYPTO_THREAD_write_lock(cache_lock))
+        return 0;
+    /* alg's entries for this program's backends are superseded; other
+     * programs' backends keep theirs */
+    for (i = 0; i < cache_n; i++)
+        if (strcmp(cache[i].alg, alg) != 0 || !pqc_backend_find(cache[i].backend))
+            cache[kept++] = cache[i];
+    cache_n = kept;
+    if (cache_n == CACHE_ENTRIES) {
+        CRYPTO_THREAD_unlock(cache_lock);
+        return 0;
+    }
+    i = cache_n++;
+    strcpy(cache[i].alg, alg);
+    strcpy(cache[i].backend, b->name);
+    strcpy(cache[i].version, backend_version(b));
+    cache[i].score_ns = score_ns;
+    ok = cache_save();
+    CRYPTO_THREAD_unlock(cache_lock);
+    return ok;
+}
+
+/* ---- Handles ---- */
+
+/* PQC_BACKEND="oqs" or "ML-KEM-768=oqs,ML-DSA-65=evp"; the per-algorithm form wins */
+static const char *env_choice(const char *alg, char *buf, size_t len) {
+    const char *env = getenv("PQC_BACKEND");
+    size_t alg_len = strlen(alg);
+
+    if (!env) return NULL;
+    for (int pass = 0; pass < 2; pass++) {
+        for (const char *p = env; *p; p += *p == ',') {
+            size_t n = strcspn(p, ",");
+            const char *eq = memchr(p, '=', n), *value = NULL;
+
+            if (pass == 0 && eq && (size_t)(eq - p) == alg_len && memcmp(p, alg, alg_len) == 0)
+                value = eq + 1;
+            else if (pass == 1 && !eq)
+                value = p;
+            p += n;
+            if (value && (size_t)(p - value) < len) {
+                memcpy(buf, value, (size_t)(p - value));
+                buf[p - value] = '\0';
+                return buf;
+            }
+        }
+    }
+    return NULL;
+}
+
+static pqc_alg *open_on(const pqc_backend *b, const char *alg) {
+    pqc_alg *a;
+
+    if (strlen(alg) >= NAME_MAX_LEN || !(a = calloc(1, sizeof(*a)))) return NULL;
+    strcpy(a->name, alg);
+    a->backend = b;
+    a->state = b->open(alg, &a->info);
+    if (!a->state
+        || (a->info.kind == PQC_KEM && (!b->keypair || !b->encaps || !b->decaps))
+        || (a->info.kind == PQC_SIG && (!b->keypair || !b->sign || !b->verify))) {
+        if (a->state) b->close(a->state);
+        free(a);
+        return NULL;
+    }
+    return a;
+}
+
+pqc_alg *pqc_alg_open(const char *alg, const char *backend) {
+    char buf[NAME_MAX_LEN];
+    int calibrate = backend && strcmp(backend, "auto") == 0;
+
+    if (!backend || calibrate) {
+        backend = env_choice(alg, buf, sizeof(buf));
+        if (!backend) backend = pqc_backend_cached(alg, NULL);
+        if (!backend && calibrate) backend = pqc_backend_calibrate(alg, CALIBRATE_MS);
+    }
+    if (backend) {
+        const pqc_backend *b = pqc_backend_find(backend);
+        if (!b) {
+            fprintf(stderr, "ERROR: Unknown PQC backend '%s'\n", backend);
+            return NULL;
+        }
+        return open_on(b, alg);
+    }
+    for (size_t i = 0; pqc_backends[i]; i++) {
+        pqc_alg *a = open_on(pqc_backends[i], alg);
+        if (a) return a;
+    }
+    return NULL;
+}
+
+void pqc_alg_close(pqc_alg *a) {
+    if (!a) return;
+    a->backend->close(a->state);
+    free(a);
+}
+
+const char *pqc_alg_name(const pqc_alg *a) {
+    return a->name;
+}
+
+const pqc_backend *pqc_alg_backend(const pqc_alg *a) {
+    return a->backend;
+}
+
+const pqc_alg_info *pqc_alg_info_get(const pqc_alg *a) {
+    return &a->info;
+}
+
+int pqc_keypair(pqc_alg *a, uint8_t *pk, uint8_t *sk) {
+    return a->backend->keypair(a->state, pk, sk);
+}
+
+int pqc_encaps(pqc_alg *a, uint8_t *ct, uint8_t *ss, const uint8_t *pk) {
+    return a->info.kind == PQC_KEM && a->backend->encaps(a->state, ct, ss, pk);
+}
+
+int pqc_decaps(pqc_alg *a, uint8_t *ss, const uint8_t *ct, const uint8_t *sk) {
+    return a->info.kind == PQC_KEM && a->backend->decaps(a->state, ss, ct, sk);
+}
+
+int pqc_sign(pqc_alg *a, uint8_t *sig, size_t *sig_len,
+             const uint8_t *msg, size_t msg_len, const uint8_t *sk) {
+    return a->info.kind == PQC_SIG && a->backend->sign(a->state, sig, sig_len, msg, msg_len, sk);
+}
+
+int pqc_verify(pqc_alg *a, const uint8_t *msg, size_t msg_len,
+               const uint8_t *sig, size_t sig_len, const uint8_t *pk) {
+    return a->info.kind == PQC_SIG && a->backend->verify(a->state, msg, msg_len, sig, sig_len, pk);
+}
+
+/* ---- Calibration ---- */
+
+/* Median ns of encaps+decaps or sign+verify; 0 if the backend failed */
+static uint64_t time_backend(pqc_alg *a, uint64_t budget_ns) {
+    const pqc_alg_info *in = &a->info;
+    uint8_t msg[32] = { 0 };
+    uint8_t *pk = malloc(in->pk_len), *sk = malloc(in->sk_len);
+    uint8_t *out = malloc(in->kind == PQC_KEM ? in->ct_len : in->sig_len);
+    uint8_t *ss = malloc(in->kind == PQC_KEM ? 2 * in->ss_len : 1);
+    uint64_t ns[CALIBRATE_MAX_ITERS], start, median = 0;
+    size_t n = 0, sig_len;
+
+    if (!pk || !sk || !out || !ss || !pqc_keypair(a, pk, sk)) goto cleanup;
+
+    start = pqc_now_ns();
+    while (n < CALIBRATE_MAX_ITERS && (n < CALIBRATE_MIN_ITERS || pqc_now_ns() - start < budget_ns)) {
+        uint64_t t0 = pqc_now_ns();
+        int ok = in->kind == PQC_KEM
+            ? pqc_encaps(a, out, ss, pk) && pqc_decaps(a, ss + in->ss_len, out, sk)
+              && memcmp(ss, ss + in->ss_len, in->ss_len) == 0
+            : pqc_sign(a, out, &sig_len, msg, sizeof(msg), sk)
+              && pqc_verify(a, msg, sizeof(msg), out, sig_len, pk);
+        if (!ok) goto cleanup;
+        ns[n++] = pqc_now_ns() - t0;
+    }
+    {
+        pqc_stats st;
+        pqc_stats_compute(&st, ns, NULL, n, pqc_now_ns() - start);
+        median = st.median_ns ? st.median_ns : 1;
+    }
+
+cleanup:
+    if (sk) OPENSSL_cleanse(sk, in->sk_len);
+    if (ss && in->kind == PQC_KEM) OPENSSL_cleanse(ss, 2 * in->ss_len);
+    free(pk);
+    free(sk);
+    free(out);
+    free(ss);
+    return median;
+}
+
+const char *pqc_backend_calibrate(const char *alg, unsigned budget_ms) {
+    const pqc_backend *best = NULL;
+    uint64_t best_ns = 0, per_backend = (uint64_t)budget_ms * 1000000ull / pqc_backend_count();
+
+    for (size_t i = 0; pqc_backends[i]; i++) {
+        pqc_alg *a = open_on(pqc_backends[i], alg);
+        uint64_t t;
+
+        if (!a) continue;
+        t = time_backend(a, per_backend);
+        pqc_alg_close(a);
+        if (t && (!best || t < best_ns)) {
+            best = pqc_backends[i];
+            best_ns = t;
+        }
+    }
+    if (!best) return NULL;
+    pqc_backend_record(alg, best->name, best_ns);
+    return best->name;
+}
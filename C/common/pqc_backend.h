@@ -0,0 +1,129 @@
+#ifndef PQC_BACKEND_H
+#define PQC_BACKEND_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * One API over the PQC implementations in the tree.
+ *
+ * The demos run the same algorithms through two stacks: OpenSSL EVP
+ * (ml_kem/, ml_dsa/) and liboqs (*_oqs_example/). Here each implementation
+ * is a backend with a liboqs-style vtable over raw FIPS 203/204/205 key,
+ * ciphertext and signature encodings:
+ *
+ *   evp          OpenSSL default provider
+ *   oqsprovider  OpenSSL with oqs-provider loaded
+ *   oqs          liboqs called directly (pqc_backend_oqs.c, make WITH_OQS=1)
+ *   slh_par      slh_dsa_parallel's SLH-DSA signing (slh_par_backend.c)
+ *
+ * Which backends a program has is up to the program: it defines the
+ * pqc_backends table below in its own backends.c. This layer is built the
+ * same way for every tool.
+ *
+ * The encodings are the standard ones, so keys, ciphertexts and signatures
+ * from one backend work with any other.
+ *
+ * Choosing a backend: pqc_alg_open() takes a backend name, or NULL. NULL
+ * means: the PQC_BACKEND environment variable if it names one for this
+ * algorithm ("oqs", or "ML-KEM-768=oqs,ML-DSA-65=evp"), else the fastest
+ * backend recorded for this machine by pqc_backend_record() (pqc_bench does
+ * this), else the first backend that has the algorithm. "auto" is the same,
+ * except that with nothing recorded it times every backend first and records
+ * the winner. Records are kept in a small file, PQC_BACKEND_CACHE or
+ * ~/.cache/pqc_backend.cache, tagged with the CPU and OpenSSL version and
+ * each with its backend's version; they are ignored after an upgrade or on
+ * another machine. Every tool shares the file: records for backends a tool
+ * does not link are left alone, and the fastest recorded backend the tool
+ * has is used.
+ */
+
+typedef enum { PQC_KEM, PQC_SIG } pqc_kind;
+
+typedef struct {
+    pqc_kind kind;
+    size_t pk_len;
+    size_t sk_len;
+    size_t ct_len;              /* KEM */
+    size_t ss_len;              /* KEM */
+    size_t sig_len;             /* signatures: maximum length */
+} pqc_alg_info;
+
+/*
+ * Backend vtable. open() returns per-handle state, or NULL when the backend
+ * does not have the algorithm; it fills info. Operations return 1 on
+ * success. Only the KEM or the signature half needs to be set.
+ */
+typedef struct {
+    const char *name;
+    const char *description;
+    const char *(*version)(void);   /* tags the selection cache; may be NULL */
+    void *(*open)(const char *alg, pqc_alg_info *info);
+    void (*close)(void *state);
+    int (*keypair)(void *state, uint8_t *pk, uint8_t *sk);
+    int (*encaps)(void *state, uint8_t *ct, uint8_t *ss, const uint8_t *pk);
+    int (*decaps)(void *state, uint8_t *ss, const uint8_t *ct, const uint8_t *sk);
+    int (*sign)(void *state, uint8_t *sig, size_t *sig_len,
+                const uint8_t *msg, size_t msg_len, const uint8_t *sk);
+    int (*verify)(void *state, const uint8_t *msg, size_t msg_len,
+                  const uint8_t *sig, size_t sig_len, const uint8_t *pk);
+} pqc_backend;
+
+/* The backends above; pqc_backend_oqs and pqc_backend_slh_par need their
+ * source files linked in. */
+extern const pqc_backend pqc_backend_evp;
+extern const pqc_backend pqc_backend_oqsprovider;
+extern const pqc_backend pqc_backend_oqs;
+extern const pqc_backend pqc_backend_slh_par;
+
+/* Defined by each program: its backends in default preference order,
+ * ending with NULL. */
+extern const pqc_backend *const pqc_backends[];
+
+/* The program's backends, in default preference order. */
+size_t pqc_backend_count(void);
+const pqc_backend *pqc_backend_at(size_t i);
+const pqc_backend *pqc_backend_find(const char *name);
+
+/*
+ * A handle is one algorithm on one backend. Like mlkem_engine, it caches
+ * per-key state between calls and is not safe for concurrent use: open one
+ * per thread.
+ */
+typedef struct pqc_alg pqc_alg;
+
+/* backend: a backend name, NULL or "auto" (see above). NULL on failure. */
+pqc_alg *pqc_alg_open(const char *alg, const char *backend);
+void pqc_alg_close(pqc_alg *a);
+
+const char *pqc_alg_name(const pqc_alg *a);
+const pqc_backend *pqc_alg_backend(const pqc_alg *a);
+const pqc_alg_info *pqc_alg_info_get(const pqc_alg *a);
+
+int pqc_keypair(pqc_alg *a, uint8_t *pk, uint8_t *sk);
+int pqc_encaps(pqc_alg *a, uint8_t *ct, uint8_t *ss, const uint8_t *pk);
+int pqc_decaps(pqc_alg *a, uint8_t *ss, const uint8_t *ct, const uint8_t *sk);
+/* *sig_len is set to the signature length; sig holds info->sig_len bytes. */
+int pqc_sign(pqc_alg *a, uint8_t *sig, size_t *sig_len,
+             const uint8_t *msg, size_t msg_len, const uint8_t *sk);
+int pqc_verify(pqc_alg *a, const uint8_t *msg, size_t msg_len,
+               const uint8_t *sig, size_t sig_len, const uint8_t *pk);
+
+/*
+ * Selection cache. The score is the median time of one encaps + decaps,
+ * or sign + verify, in ns. pqc_backend_record() replaces alg's entries for
+ * the program's own backends and returns 1 if the file was written.
+ */
+const char *pqc_backend_cached(const char *alg, uint64_t *score_ns);
+int pqc_backend_record(const char *alg, const char *backend, uint64_t score_ns);
+
+/*
+ * Times every backend that has alg for about budget_ms in total, records
+ * the fastest and returns its name (NULL if none has the algorithm).
+ */
+const char *pqc_backend_calibrate(const char *alg, unsigned budget_ms);
+
+/* "cpu model | OpenSSL version" that tags the cache */
+const char *pqc_backend_fingerprint(void);
+
+#endif /* PQC_BACKEND_H */
@@ -0,0 +1,257 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include <openssl/evp.h>
+#include <openssl/err.h>
+#include <openssl/crypto.h>
+#include <openssl/provider.h>
+#include <openssl/core_names.h>
+
+#include "pqc_backend.h"
+
+/*
+ * EVP backends: the default provider and oqs-provider. Both go through the
+ * same code; they differ in the property query, which pins the provider,
+ * and in algorithm names.
+ *
+ * The vtable passes raw keys, while EVP works on EVP_PKEY objects. Each
+ * handle keeps the last public and private key it saw, with its initialised
+ * context, and imports a key only when the bytes change. keypair() fills
+ * both, so the common keygen-then-use pattern never imports at all.
+ */
+
+typedef struct {
+    uint8_t *raw;               /* copy of the key bytes, info length */
+    int valid;
+    EVP_PKEY *pkey;
+    EVP_PKEY_CTX *ctx;          /* created on first use */
+} key_slot;
+
+typedef struct {
+    char name[64];              /* provider's name for the algorithm */
+    const char *propq;
+    pqc_alg_info info;
+    EVP_PKEY_CTX *keygen;
+    EVP_SIGNATURE *sig;
+    key_slot pub, priv;
+} evp_state;
+
+/* oqs-provider names for the standard parameter sets */
+static const struct { const char *std, *oqs; } oqsprovider_names[] = {
+    { "ML-KEM-512", "mlkem512" }, { "ML-KEM-768", "mlkem768" }, { "ML-KEM-1024", "mlkem1024" },
+    { "ML-DSA-44", "mldsa44" }, { "ML-DSA-65", "mldsa65" }, { "ML-DSA-87", "mldsa87" },
+};
+
+static void slot_clear(key_slot *s, size_t len) {
+    EVP_PKEY_CTX_free(s->ctx);
+    EVP_PKEY_free(s->pkey);
+    s->ctx = NULL;
+    s->pkey = NULL;
+    s->valid = 0;
+    if (s->raw) OPENSSL_cleanse(s->raw, len);
+}
+
+static void evp_close(void *state) {
+    evp_state *st = state;
+
+    if (!st) return;
+    slot_clear(&st->pub, st->info.pk_len);
+    slot_clear(&st->priv, st->info.sk_len);
+    OPENSSL_free(st->pub.raw);
+    OPENSSL_free(st->priv.raw);
+    EVP_PKEY_CTX_free(st->keygen);
+    EVP_SIGNATURE_free(st->sig);
+    OPENSSL_free(st);
+}
+
+static int export_raw(EVP_PKEY *pkey, const char *param, uint8_t *out, size_t len) {
+    size_t got = 0;
+    return EVP_PKEY_get_octet_string_param(pkey, param, out, len, &got) && got == len;
+}
+
+/* Makes pkey (raw in out) the current key of both slots */
+static int adopt_keypair(evp_state *st, EVP_PKEY *pkey) {
+    slot_clear(&st->pub, st->info.pk_len);
+    slot_clear(&st->priv, st->info.sk_len);
+    if (!export_raw(pkey, OSSL_PKEY_PARAM_PUB_KEY, st->pub.raw, st->info.pk_len)
+        || !export_raw(pkey, OSSL_PKEY_PARAM_PRIV_KEY, st->priv.raw, st->info.sk_len))
+        return 0;
+    /* one reference per slot */
+    if (EVP_PKEY_up_ref(pkey)) st->pub.pkey = pkey;
+    if (EVP_PKEY_up_ref(pkey)) st->priv.pkey = pkey;
+    st->pub.valid = st->pub.pkey != NULL;
+    st->priv.valid = st->priv.pkey != NULL;
+    return st->pub.valid && st->priv.valid;
+}
+
+/* Context for the key in raw, importing it if it is not the slot's key */
+static EVP_PKEY_CTX *slot_ctx(evp_state *st, key_slot *s, const uint8_t *raw, int is_private) {
+    size_t len = is_private ? st->info.sk_len : st->info.pk_len;
+
+    if (!s->valid || CRYPTO_memcmp(s->raw, raw, len) != 0) {
+        slot_clear(s, len);
+        s->pkey = is_private
+            ? EVP_PKEY_new_raw_private_key_ex(NULL, st->name, st->propq, raw, len)
+            : EVP_PKEY_new_raw_public_key_ex(NULL, st->name, st->propq, raw, len);
+        if (!s->pkey) return NULL;
+        memcpy(s->raw, raw, len);
+        s->valid = 1;
+    }
+    if (!s->ctx) {
+        int ok;
+
+        if (!(s->ctx = EVP_PKEY_CTX_new_from_pkey(NULL, s->pkey, st->propq))) return NULL;
+        if (st->info.kind == PQC_KEM)
+            ok = is_private ? EVP_PKEY_decapsulate_init(s->ctx, NULL) > 0
+                            : EVP_PKEY_encapsulate_init(s->ctx, NULL) > 0;
+        else
+            ok = 1;             /* signing contexts are initialised per message */
+        if (!ok) {
+            EVP_PKEY_CTX_free(s->ctx);
+            s->ctx = NULL;
+        }
+    }
+    return s->ctx;
+}
+
+static void *evp_open_with(const char *name, const char *propq, pqc_alg_info *info) {
+    evp_state *st = OPENSSL_zalloc(sizeof(*st));
+    EVP_KEM *kem = NULL;
+    EVP_PKEY *pkey = NULL;
+    EVP_PKEY_CTX *ctx = NULL;
+    int ok = 0;
+
+    if (!st || strlen(name) >= sizeof(st->name)) goto cleanup;
+    strcpy(st->name, name);
+    st->propq = propq;
+
+    if ((kem = EVP_KEM_fetch(NULL, name, propq))) st->info.kind = PQC_KEM;
+    else if ((st->sig = EVP_SIGNATURE_fetch(NULL, name, propq))) st->info.kind = PQC_SIG;
+    else goto cleanup;
+
+    /* One key up front to learn the sizes; it also primes the slots */
+    if (!(st->keygen = EVP_PKEY_CTX_new_from_name(NULL, name, propq))
+        || EVP_PKEY_keygen_init(st->keygen) <= 0
+        || EVP_PKEY_generate(st->keygen, &pkey) <= 0
+        || !EVP_PKEY_get_octet_string_param(pkey, OSSL_PKEY_PARAM_PUB_KEY, NULL, 0, &st->info.pk_len)
+        || !EVP_PKEY_get_octet_string_param(pkey, OSSL_PKEY_PARAM_PRIV_KEY, NULL, 0, &st->info.sk_len))
+        goto cleanup;
+    if (st->info.kind == PQC_KEM) {
+        if (!(ctx = EVP_PKEY_CTX_new_from_pkey(NULL, pkey, propq))
+            || EVP_PKEY_encapsulate_init(ctx, NULL) <= 0
+            || EVP_PKEY_encapsulate(ctx, NULL, &st->info.ct_len, NULL, &st->info.ss_len) <= 0)
+            goto cleanup;
+    } else if ((st->info.sig_len = (size_t)EVP_PKEY_get_size(pkey)) == 0) {
+        goto cleanup;
+    }
+
+    if (!(st->pub.raw = OPENSSL_malloc(st->info.pk_len))
+        || !(st->priv.raw = OPENSSL_malloc(st->info.sk_len))
+        || !adopt_keypair(st, pkey))
+        goto cleanup;
+    *info = st->info;
+    ok = 1;
+
+cleanup:
+    ERR_clear_error();          /* unavailable algorithms are not errors here */
+    EVP_KEM_free(kem);
+    EVP_PKEY_CTX_free(ctx);
+    EVP_PKEY_free(pkey);
+    if (!ok) {
+        evp_close(st);
+        return NULL;
+    }
+    return st;
+}
+
+static int evp_keypair(void *state, uint8_t *pk, uint8_t *sk) {
+    evp_state *st = state;
+    EVP_PKEY *pkey = NULL;
+    int ok = EVP_PKEY_generate(st->keygen, &pkey) > 0 && adopt_keypair(st, pkey);
+
+    if (ok) {
+        memcpy(pk, st->pub.raw, st->info.pk_len);
+        memcpy(sk, st->priv.raw, st->info.sk_len);
+    }
+    EVP_PKEY_free(pkey);
+    return ok;
+}
+
+static int evp_encaps(void *state, uint8_t *ct, uint8_t *ss, const uint8_t *pk) {
+    evp_state *st = state;
+    EVP_PKEY_CTX *ctx = slot_ctx(st, &st->pub, pk, 0);
+    size_t ct_len = st->info.ct_len, ss_len = st->info.ss_len;
+
+    return ctx && EVP_PKEY_encapsulate(ctx, ct, &ct_len, ss, &ss_len) > 0;
+}
+
+static int evp_decaps(void *state, uint8_t *ss, const uint8_t *ct, const uint8_t *sk) {
+    evp_state *st = state;
+    EVP_PKEY_CTX *ctx = slot_ctx(st, &st->priv, sk, 1);
+    size_t ss_len = st->info.ss_len;
+
+    return ctx && EVP_PKEY_decapsulate(ctx, ss, &ss_len, ct, st->info.ct_len) > 0;
+}
+
+static int evp_sign(void *state, uint8_t *sig, size_t *sig_len,
+                    const uint8_t *msg, size_t msg_len, const uint8_t *sk) {
+    evp_state *st = state;
+    EVP_PKEY_CTX *ctx = slot_ctx(st, &st->priv, sk, 1);
+
+    *sig_len = st->info.sig_len;
+    return ctx
+        && EVP_PKEY_sign_message_init(ctx, st->sig, NULL) > 0
+        && EVP_PKEY_sign(ctx, sig, sig_len, msg, msg_len) > 0;
+}
+
+static int evp_verify(void *state, const uint8_t *msg, size_t msg_len,
+                      const uint8_t *sig, size_t sig_len, const uint8_t *pk) {
+    evp_state *st = state;
+    EVP_PKEY_CTX *ctx = slot_ctx(st, &st->pub, pk, 0);
+    int ok = ctx
+        && EVP_PKEY_verify_message_init(ctx, st->sig, NULL) > 0
+        && EVP_PKEY_verify(ctx, sig, sig_len, msg, msg_len) == 1;
+
+    if (!ok) ERR_clear_error();
+    return ok;
+}
+
+static const char *evp_version(void) {
+    return OpenSSL_version(OPENSSL_VERSION_STRING);
+}
+
+static void *default_open(const char *alg, pqc_alg_info *info) {
+    return evp_open_with(alg, "provider=default", info);
+}
+
+/* oqs-provider alongside the default provider, loaded on first use */
+static CRYPTO_ONCE oqsprovider_once = CRYPTO_ONCE_STATIC_INIT;
+static OSSL_PROVIDER *oqsprovider;
+
+static void oqsprovider_load(void) {
+    oqsprovider = OSSL_PROVIDER_try_load(NULL, "oqsprovider", 1);
+    ERR_clear_error();
+}
+
+static void *oqsprovider_open(const char *alg, pqc_alg_info *info) {
+    const char *name = alg;
+
+    if (!CRYPTO_THREAD_run_once(&oqsprovider_once, oqsprovider_load) || !oqsprovider)
+        return NULL;
+    for (size_t i = 0; i < sizeof(oqsprovider_names) / sizeof(oqsprovider_names[0]); i++)
+        if (strcmp(alg, oqsprovider_names[i].std) == 0) name = oqsprovider_names[i].oqs;
+    return evp_open_with(name, "provider=oqsprovider", info);
+}
+
+const pqc_backend pqc_backend_evp = {
+    "evp", "OpenSSL EVP, default provider", evp_version,
+    default_open, evp_close, evp_keypair, evp_encaps, evp_decaps, evp_sign, evp_verify
+};
+
+const pqc_backend pqc_backend_oqsprovider = {
+    "oqsprovider", "OpenSSL EVP, oqs-provider", NULL,
+    oqsprovider_open, evp_close, evp_keypair, evp_encaps, evp_decaps, evp_sign, evp_verify
+};
@@ -0,0 +1,107 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+#include "pqc_backend.h"
+
+/*
+ * Raw liboqs backend. liboqs already works on raw key bytes, so this is a
+ * thin wrapper. Only built with make WITH_OQS=1.
+ */
+
+#include "oqs/oqs.h"
+
+typedef struct {
+    OQS_KEM *kem;
+    OQS_SIG *sig;
+} oqs_state;
+
+/* liboqs calls pure SLH-DSA-SHA2-128f "SLH_DSA_PURE_SHA2_128F" */
+static void oqs_name(const char *alg, char *buf, size_t len) {
+    size_t used = 0;
+
+    if (strncmp(alg, "SLH-DSA-", 8) == 0) {
+        used = (size_t)snprintf(buf, len, "SLH_DSA_PURE_");
+        alg += 8;
+    }
+    for (; *alg && used + 1 < len; alg++)
+        buf[used++] = *alg == '-' ? '_' : (char)toupper((unsigned char)*alg);
+    buf[used] = '\0';
+}
+
+static void oqs_close(void *state) {
+    oqs_state *st = state;
+
+    if (!st) return;
+    OQS_KEM_free(st->kem);
+    OQS_SIG_free(st->sig);
+    free(st);
+}
+
+static void *oqs_open(const char *alg, pqc_alg_info *info) {
+    oqs_state *st = calloc(1, sizeof(*st));
+    char alt[64];
+
+    if (!st) return NULL;
+    oqs_name(alg, alt, sizeof(alt));
+    if (OQS_KEM_alg_is_enabled(alg)) st->kem = OQS_KEM_new(alg);
+    if (!st->kem && OQS_SIG_alg_is_enabled(alg)) st->sig = OQS_SIG_new(alg);
+    if (!st->kem && !st->sig && OQS_SIG_alg_is_enabled(alt)) st->sig = OQS_SIG_new(alt);
+
+    memset(info, 0, sizeof(*info));
+    if (st->kem) {
+        info->kind = PQC_KEM;
+        info->pk_len = st->kem->length_public_key;
+        info->sk_len = st->kem->length_secret_key;
+        info->ct_len = st->kem->length_ciphertext;
+        info->ss_len = st->kem->length_shared_secret;
+    } else if (st->sig) {
+        info->kind = PQC_SIG;
+        info->pk_len = st->sig->length_public_key;
+        info->sk_len = st->sig->length_secret_key;
+        info->sig_len = st->sig->length_signature;
+    } else {
+        oqs_close(st);
+        return NULL;
+    }
+    return st;
+}
+
+static int oqs_keypair(void *state, uint8_t *pk, uint8_t *sk) {
+    oqs_state *st = state;
+    return (st->kem ? OQS_KEM_keypair(st->kem, pk, sk) : OQS_SIG_keypair(st->sig, pk, sk)) == OQS_SUCCESS;
+}
+
+static int oqs_encaps(void *state, uint8_t *ct, uint8_t *ss, const uint8_t *pk) {
+    oqs_state *st = state;
+    return OQS_KEM_encaps(st->kem, ct, ss, pk) == OQS_SUCCESS;
+}
+
+static int oqs_decaps(void *state, uint8_t *ss, const uint8_t *ct, const uint8_t *sk) {
+    oqs_state *st = state;
+    return OQS_KEM_decaps(st->kem, ss, ct, sk) == OQS_SUCCESS;
+}
+
+static int oqs_sign(void *state, uint8_t *sig, size_t *sig_len,
+                    const uint8_t *msg, size_t msg_len, const uint8_t *sk) {
+    oqs_state *st = state;
+    return OQS_SIG_sign(st->sig, sig, sig_len, msg, msg_len, sk) == OQS_SUCCESS;
+}
+
+static int oqs_verify(void *state, const uint8_t *msg, size_t msg_len,
+                      const uint8_t *sig, size_t sig_len, const uint8_t *pk) {
+    oqs_state *st = state;
+    return OQS_SIG_verify(st->sig, msg, msg_len, sig, sig_len, pk) == OQS_SUCCESS;
+}
+
+static const char *oqs_version(void) {
+    return OQS_version();
+}
+
+const pqc_backend pqc_backend_oqs = {
+    "oqs", "liboqs", oqs_version,
+    oqs_open, oqs_close, oqs_keypair, oqs_encaps, oqs_decaps, oqs_sign, oqs_verify
+};
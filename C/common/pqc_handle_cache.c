@@ -0,0 +1,219 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <openssl/evp.h>
+#include <openssl/err.h>
+#include <openssl/crypto.h>
+
+#include "pqc_handle_cache.h"
+
+#define ALG_SLOTS    64     /* power of two */
+#define PKEY_SLOTS   64
+#define ALG_NAME_MAX 64
+
+/*
+ * Algorithm entries are only ever added, never removed (until cleanup), so
+ * readers can walk the table without the lock: an entry's key fields are
+ * written before `used` is published with release semantics, and each handle
+ * pointer is published the same way once fetched.
+ */
+typedef struct {
+    int used;
+    OSSL_LIB_CTX *libctx;
+    unsigned long hash;
+    char name[ALG_NAME_MAX];
+    EVP_SIGNATURE *sig;
+    EVP_KEM *kem;
+    EVP_PKEY_CTX *keygen_tmpl;
+} alg_entry;
+
+/* Per-key templates can be removed again, so they sit behind the rwlock */
+typedef struct {
+    EVP_PKEY *pkey;
+    EVP_PKEY_CTX *tmpl;
+} pkey_entry;
+
+static alg_entry alg_table[ALG_SLOTS];
+static pkey_entry pkey_table[PKEY_SLOTS];
+
+static CRYPTO_ONCE cache_once = CRYPTO_ONCE_STATIC_INIT;
+static CRYPTO_RWLOCK *alg_lock;
+static CRYPTO_RWLOCK *pkey_lock;
+
+static void cache_init(void) {
+    alg_lock = CRYPTO_THREAD_lock_new();
+    pkey_lock = CRYPTO_THREAD_lock_new();
+}
+
+static int cache_ready(void) {
+    return CRYPTO_THREAD_run_once(&cache_once, cache_init) && alg_lock && pkey_lock;
+}
+
+static unsigned long hash_key(OSSL_LIB_CTX *libctx, const char *name) {
+    unsigned long h = 2166136261ul ^ (unsigned long)(size_t)libctx;
+    for (const unsigned char *p = (const unsigned char *)name; *p; p++)
+        h = (h ^ *p) * 16777619ul;
+    return h;
+}
+
+static alg_entry *find_alg(OSSL_LIB_CTX *libctx, const char *name, unsigned long h) {
+    for (size_t i = 0; i < ALG_SLOTS; i++) {
+        alg_entry *e = &alg_table[(h + i) & (ALG_SLOTS - 1)];
+        if (!__atomic_load_n(&e->used, __ATOMIC_ACQUIRE)) return NULL;
+        if (e->hash == h && e->libctx == libctx && strcmp(e->name, name) == 0) return e;
+    }
+    return NULL;
+}
+
+static alg_entry *get_alg(OSSL_LIB_CTX *libctx, const char *name) {
+    unsigned long h;
+    alg_entry *e;
+
+    if (!name || strlen(name) >= ALG_NAME_MAX || !cache_ready()) return NULL;
+
+    h = hash_key(libctx, name);
+    e = find_alg(libctx, name, h);
+    if (e) return e;
+
+    if (!CRYPTO_THREAD_write_lock(alg_lock)) return NULL;
+    e = find_alg(libctx, name, h);
+    for (size_t i = 0; !e && i < ALG_SLOTS; i++) {
+        alg_entry *slot = &alg_table[(h + i) & (ALG_SLOTS - 1)];
+        if (!slot->used) {
+            slot->libctx = libctx;
+            slot->hash = h;
+            strcpy(slot->name, name);
+            __atomic_store_n(&slot->used, 1, __ATOMIC_RELEASE);
+            e = slot;
+        }
+    }
+    CRYPTO_THREAD_unlock(alg_lock);
+
+    if (!e) fprintf(stderr, "ERROR: Algorithm handle cache is full\n");
+    return e;
+}
+
+enum handle_kind { HANDLE_SIGNATURE, HANDLE_KEM, HANDLE_KEYGEN };
+
+static void *get_handle(OSSL_LIB_CTX *libctx, const char *alg, enum handle_kind kind) {
+    alg_entry *e = get_alg(libctx, alg);
+    void **slot;
+    void *h;
+
+    if (!e) return NULL;
+
+    switch (kind) {
+    case HANDLE_SIGNATURE: slot = (void **)&e->sig; break;
+    case HANDLE_KEM:       slot = (void **)&e->kem; break;
+    default:               slot = (void **)&e->keygen_tmpl; break;
+    }
+
+    h = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+    if (h) return h;
+
+    /* First use: fetch under the lock so that only one thread does it */
+    if (!CRYPTO_THREAD_write_lock(alg_lock)) return NULL;
+    h = *slot;
+    if (!h) {
+        switch (kind) {
+        case HANDLE_SIGNATURE: h = EVP_SIGNATURE_fetch(libctx, alg, NULL); break;
+        case HANDLE_KEM:       h = EVP_KEM_fetch(libctx, alg, NULL); break;
+        default:               h = EVP_PKEY_CTX_new_from_name(libctx, alg, NULL); break;
+        }
+        if (h) __atomic_store_n(slot, h, __ATOMIC_RELEASE);
+    }
+    CRYPTO_THREAD_unlock(alg_lock);
+    return h;
+}
+
+EVP_SIGNATURE *pqc_handle_cache_signature(OSSL_LIB_CTX *libctx, const char *alg) {
+    return get_handle(libctx, alg, HANDLE_SIGNATURE);
+}
+
+EVP_KEM *pqc_handle_cache_kem(OSSL_LIB_CTX *libctx, const char *alg) {
+    return get_handle(libctx, alg, HANDLE_KEM);
+}
+
+EVP_PKEY_CTX *pqc_handle_cache_keygen_ctx(OSSL_LIB_CTX *libctx, const char *alg) {
+    EVP_PKEY_CTX *tmpl = get_handle(libctx, alg, HANDLE_KEYGEN);
+    EVP_PKEY_CTX *ctx;
+
+    if (!tmpl) return NULL;
+
+    ctx = EVP_PKEY_CTX_dup(tmpl);
+    if (ctx && EVP_PKEY_keygen_init(ctx) <= 0) {
+        EVP_PKEY_CTX_free(ctx);
+        ctx = NULL;
+    }
+    return ctx;
+}
+
+EVP_PKEY_CTX *pqc_handle_cache_pkey_ctx(EVP_PKEY *pkey) {
+    EVP_PKEY_CTX *ctx = NULL, *tmpl;
+    pkey_entry *free_slot = NULL;
+
+    if (!pkey || !cache_ready()) return NULL;
+
+    if (CRYPTO_THREAD_read_lock(pkey_lock)) {
+        for (size_t i = 0; i < PKEY_SLOTS && !ctx; i++)
+            if (pkey_table[i].pkey == pkey) ctx = EVP_PKEY_CTX_dup(pkey_table[i].tmpl);
+        CRYPTO_THREAD_unlock(pkey_lock);
+        if (ctx) return ctx;
+    }
+
+    tmpl = EVP_PKEY_CTX_new_from_pkey(NULL, pkey, NULL);
+    if (!tmpl) return NULL;
+
+    if (!CRYPTO_THREAD_write_lock(pkey_lock)) return tmpl;
+    for (size_t i = 0; i < PKEY_SLOTS; i++) {
+        if (pkey_table[i].pkey == pkey) {
+            /* Another thread got here first */
+            free_slot = NULL;
+            break;
+        }
+        if (!pkey_table[i].pkey && !free_slot) free_slot = &pkey_table[i];
+    }
+    if (free_slot && EVP_PKEY_up_ref(pkey)) {
+        ctx = EVP_PKEY_CTX_dup(tmpl);
+        if (ctx) {
+            free_slot->pkey = pkey;
+            free_slot->tmpl = tmpl;
+            tmpl = NULL;
+        } else {
+            EVP_PKEY_free(pkey);
+        }
+    }
+    CRYPTO_THREAD_unlock(pkey_lock);
+
+    /* Cache full (or lost the race): hand out the fresh context itself */
+    if (!ctx) return tmpl;
+    return ctx;
+}
+
+void pqc_handle_cache_forget_pkey(EVP_PKEY *pkey) {
+    if (!pkey || !cache_ready() || !CRYPTO_THREAD_write_lock(pkey_lock)) return;
+    for (size_t i = 0; i < PKEY_SLOTS; i++) {
+        if (pkey_table[i].pkey == pkey) {
+            EVP_PKEY_CTX_free(pkey_table[i].tmpl);
+            EVP_PKEY_free(pkey_table[i].pkey);
+            pkey_table[i].pkey = NULL;
+            pkey_table[i].tmpl = NULL;
+        }
+    }
+    CRYPTO_THREAD_unlock(pkey_lock);
+}
+
+void pqc_handle_cache_cleanup(void) {
+    for (size_t i = 0; i < ALG_SLOTS; i++) {
+        EVP_SIGNATURE_free(alg_table[i].sig);
+        EVP_KEM_free(alg_table[i].kem);
+        EVP_PKEY_CTX_free(alg_table[i].keygen_tmpl);
+    }
+    memset(alg_table, 0, sizeof(alg_table));
+
+    for (size_t i = 0; i < PKEY_SLOTS; i++) {
+        EVP_PKEY_CTX_free(pkey_table[i].tmpl);
+        EVP_PKEY_free(pkey_table[i].pkey);
+    }
+    memset(pkey_table, 0, sizeof(pkey_table));
+}
@@ -0,0 +1,46 @@
+#ifndef PQC_HANDLE_CACHE_H
+#define PQC_HANDLE_CACHE_H
+
+#include <openssl/evp.h>
+
+/*
+ * Process-wide cache of pre-fetched OpenSSL algorithm handles.
+ *
+ * EVP_SIGNATURE_fetch(), EVP_KEM_fetch() and EVP_PKEY_CTX_new_*() go through
+ * the provider store, which takes global locks in OpenSSL 3. This cache does
+ * each fetch once per (library context, algorithm name) and hands out either
+ * the cached handle or a cheap EVP_PKEY_CTX_dup() of a cached template.
+ *
+ * Lookups of already cached entries are lock-free; only the first fetch of a
+ * handle takes the cache lock. All functions are thread-safe except
+ * pqc_handle_cache_cleanup(), which must run after all users are done.
+ */
+
+/*
+ * Borrowed handles, owned by the cache: do not free them. They stay valid
+ * until pqc_handle_cache_cleanup(). NULL if the algorithm is unavailable.
+ */
+EVP_SIGNATURE *pqc_handle_cache_signature(OSSL_LIB_CTX *libctx, const char *alg);
+EVP_KEM *pqc_handle_cache_kem(OSSL_LIB_CTX *libctx, const char *alg);
+
+/*
+ * New context ready for EVP_PKEY_keygen(), duplicated from a cached template.
+ * The caller frees it with EVP_PKEY_CTX_free().
+ */
+EVP_PKEY_CTX *pqc_handle_cache_keygen_ctx(OSSL_LIB_CTX *libctx, const char *alg);
+
+/*
+ * New operation-less context for pkey, duplicated from a per-key template
+ * instead of going through EVP_PKEY_CTX_new_from_pkey(). The cache keeps a
+ * reference on up to a fixed number of long-lived keys; beyond that it falls
+ * back to EVP_PKEY_CTX_new_from_pkey(). The caller frees the result.
+ */
+EVP_PKEY_CTX *pqc_handle_cache_pkey_ctx(EVP_PKEY *pkey);
+
+/* Drops the per-key template (and the reference) held for pkey, if any. */
+void pqc_handle_cache_forget_pkey(EVP_PKEY *pkey);
+
+/* Frees every cached handle. Not thread-safe. */
+void pqc_handle_cache_cleanup(void);
+
+#endif /* PQC_HANDLE_CACHE_H */
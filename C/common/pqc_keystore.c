@@ -0,0 +1,442 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <openssl/core_names.h>
+#include <openssl/crypto.h>
+#include <openssl/params.h>
+
+#include "pqc_keystore.h"
+
+/* OSSL_PKEY_PARAM_ML_DSA_SEED and OSSL_PKEY_PARAM_ML_KEM_SEED (OpenSSL 3.5) */
+#define SEED_PARAM "seed"
+
+static const char magic[8] = { 'P', 'Q', 'C', 'K', 'S', 'T', 'O', 'R' };
+
+#define HEADER_SIZE 64
+#define ENTRY_SIZE  96
+#define DATA_ALIGN  8
+
+/* Header field offsets */
+#define H_VERSION    8
+#define H_ENTRY_SIZE 12
+#define H_COUNT      16
+#define H_INDEX_OFF  24
+#define H_DATA_OFF   32
+#define H_FILE_SIZE  40
+
+/* Index entry field offsets */
+#define E_ID       0
+#define E_ALG      32
+#define E_PUB_LEN  56
+#define E_PRIV_LEN 60
+#define E_PUB_OFF  64
+#define E_PRIV_OFF 72
+#define E_FLAGS    80
+
+static uint32_t load_le32(const unsigned char *p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint64_t load_le64(const unsigned char *p) {
+    return (uint64_t)load_le32(p) | (uint64_t)load_le32(p + 4) << 32;
+}
+
+static void store_le32(unsigned char *p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static void store_le64(unsigned char *p, uint64_t v) {
+    store_le32(p, (uint32_t)v);
+    store_le32(p + 4, (uint32_t)(v >> 32));
+}
+
+/* Key IDs are compared as fixed-width, zero-padded fields */
+static int pad_id(const char *key_id, unsigned char out[PQC_KEYSTORE_ID_LEN]) {
+    size_t len = key_id ? strlen(key_id) : 0;
+
+    if (len == 0 || len > PQC_KEYSTORE_ID_LEN) return 0;
+    memset(out, 0, PQC_KEYSTORE_ID_LEN);
+    memcpy(out, key_id, len);
+    return 1;
+}
+
+/* ---- Reading ---- */
+
+struct pqc_keystore {
+    const unsigned char *base;
+    size_t size;
+    size_t count;
+    const unsigned char *index;
+    size_t data_off;
+};
+
+pqc_keystore *pqc_keystore_open(const char *path) {
+    pqc_keystore *ks = NULL;
+    struct stat st;
+    void *map = MAP_FAILED;
+    const unsigned char *h;
+    uint64_t count, index_off, data_off;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) return NULL;
+    if (fstat(fd, &st) != 0 || st.st_size < HEADER_SIZE) goto fail;
+
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) goto fail;
+    h = map;
+
+    count = load_le64(h + H_COUNT);
+    index_off = load_le64(h + H_INDEX_OFF);
+    data_off = load_le64(h + H_DATA_OFF);
+    if (memcmp(h, magic, sizeof(magic)) != 0
+        || load_le32(h + H_VERSION) != PQC_KEYSTORE_VERSION
+        || load_le32(h + H_ENTRY_SIZE) != ENTRY_SIZE
+        || load_le64(h + H_FILE_SIZE) != (uint64_t)st.st_size
+        || index_off < HEADER_SIZE
+        || count > ((uint64_t)st.st_size - index_off) / ENTRY_SIZE
+        || data_off < index_off + count * ENTRY_SIZE
+        || data_off > (uint64_t)st.st_size)
+        goto fail;
+
+    ks = malloc(sizeof(*ks));
+    if (!ks) goto fail;
+    ks->base = map;
+    ks->size = (size_t)st.st_size;
+    ks->count = (size_t)count;
+    ks->index = h + index_off;
+    ks->data_off = (size_t)data_off;
+
+    /* Lookups touch a few scattered index pages; don't read ahead */
+    posix_madvise(map, ks->size, POSIX_MADV_RANDOM);
+    close(fd);
+    return ks;
+
+fail:
+    if (map != MAP_FAILED) munmap(map, (size_t)st.st_size);
+    close(fd);
+    return NULL;
+}
+
+void pqc_keystore_close(pqc_keystore *ks) {
+    if (!ks) return;
+    munmap((void *)ks->base, ks->size);
+    free(ks);
+}
+
+size_t pqc_keystore_count(const pqc_keystore *ks) {
+    return ks ? ks->count : 0;
+}
+
+const char *pqc_keystore_id_at(const pqc_keystore *ks, size_t i, size_t *len) {
+    const char *id;
+
+    if (!ks || i >= ks->count) return NULL;
+    id = (const char *)ks->index + i * ENTRY_SIZE + E_ID;
+    if (len) {
+        size_t n = 0;
+        while (n < PQC_KEYSTORE_ID_LEN && id[n]) n++;
+        *len = n;
+    }
+    return id;
+}
+
+/* Entry fields are checked on use, so a corrupt file fails lookups, not reads. */
+static int entry_ref(const pqc_keystore *ks, const unsigned char *e, pqc_key_ref *ref) {
+    uint64_t pub_off = load_le64(e + E_PUB_OFF), priv_off = load_le64(e + E_PRIV_OFF);
+    uint32_t pub_len = load_le32(e + E_PUB_LEN), priv_len = load_le32(e + E_PRIV_LEN);
+
+    if (e[E_ALG + PQC_KEYSTORE_ALG_LEN - 1] != 0 || e[E_ALG] == 0) return 0;
+    if (pub_off < ks->data_off || pub_off > ks->size || pub_len > ks->size - pub_off) return 0;
+    if (priv_len && (priv_off < ks->data_off || priv_off > ks->size
+                     || priv_len > ks->size - priv_off)) return 0;
+
+    ref->alg = (const char *)e + E_ALG;
+    ref->pub = ks->base + pub_off;
+    ref->pub_len = pub_len;
+    ref->priv = priv_len ? ks->base + priv_off : NULL;
+    ref->priv_len = priv_len;
+    ref->priv_is_seed = priv_len && (load_le32(e + E_FLAGS) & PQC_KEYSTORE_SEED);
+    return 1;
+}
+
+int pqc_keystore_find(const pqc_keystore *ks, const char *key_id, pqc_key_ref *ref) {
+    unsigned char id[PQC_KEYSTORE_ID_LEN];
+    size_t lo = 0, hi;
+
+    if (!ks || !pad_id(key_id, id)) return 0;
+    hi = ks->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        const unsigned char *e = ks->index + mid * ENTRY_SIZE;
+        int cmp = memcmp(id, e + E_ID, PQC_KEYSTORE_ID_LEN);
+
+        if (cmp == 0) return entry_ref(ks, e, ref);
+        if (cmp < 0) hi = mid;
+        else lo = mid + 1;
+    }
+    return 0;
+}
+
+EVP_PKEY *pqc_keystore_load(const pqc_keystore *ks, OSSL_LIB_CTX *libctx,
+                            const char *key_id) {
+    EVP_PKEY_CTX *ctx = NULL;
+    EVP_PKEY *pkey = NULL;
+    pqc_key_ref ref;
+    OSSL_PARAM params[2];
+
+    if (!pqc_keystore_find(ks, key_id, &ref)) return NULL;
+
+    /* The private key encodings of ML-DSA, ML-KEM and SLH-DSA determine the
+     * public key, so importing the public half too would only add a check. */
+    if (ref.priv)
+        params[0] = OSSL_PARAM_construct_octet_string(ref.priv_is_seed ? SEED_PARAM : OSSL_PKEY_PARAM_PRIV_KEY,
+                                                      (void *)ref.priv, ref.priv_len);
+    else
+        params[0] = OSSL_PARAM_construct_octet_string(OSSL_PKEY_PARAM_PUB_KEY,
+                                                      (void *)ref.pub, ref.pub_len);
+    params[1] = OSSL_PARAM_construct_end();
+
+    ctx = EVP_PKEY_CTX_new_from_name(libctx, ref.alg, NULL);
+    if (!ctx || EVP_PKEY_fromdata_init(ctx) <= 0
+        || EVP_PKEY_fromdata(ctx, &pkey, ref.priv ? EVP_PKEY_KEYPAIR : EVP_PKEY_PUBLIC_KEY,
+                             params) <= 0)
+        pkey = NULL;
+    EVP_PKEY_CTX_free(ctx);
+    return pkey;
+}
+
+/* ---- Writing ---- */
+
+typedef struct {
+    unsigned char id[PQC_KEYSTORE_ID_LEN];
+    char alg[PQC_KEYSTORE_ALG_LEN];
+    unsigned char *pub, *priv;
+    size_t pub_len, priv_len;
+    unsigned flags;
+} pending_key;
+
+struct pqc_keystore_writer {
+    pending_key *keys;
+    size_t count;
+    size_t capacity;
+};
+
+pqc_keystore_writer *pqc_keystore_writer_new(void) {
+    return calloc(1, sizeof(pqc_keystore_writer));
+}
+
+void pqc_keystore_writer_free(pqc_keystore_writer *w) {
+    if (!w) return;
+    for (size_t i = 0; i < w->count; i++) {
+        OPENSSL_free(w->keys[i].pub);
+        OPENSSL_clear_free(w->keys[i].priv, w->keys[i].priv_len);
+    }
+    free(w->keys);
+    free(w);
+}
+
+int pqc_keystore_writer_add(pqc_keystore_writer *w, const char *key_id, const char *alg,
+                            const unsigned char *pub, size_t pub_len,
+                            const unsigned char *priv, size_t priv_len, unsigned flags) {
+    pending_key *k;
+
+    if (!w || !alg || strlen(alg) >= PQC_KEYSTORE_ALG_LEN || !pub || pub_len == 0
+        || pub_len > UINT32_MAX || priv_len > UINT32_MAX)
+        return 0;
+
+    if (w->count == w->capacity) {
+        size_t capacity = w->capacity ? w->capacity * 2 : 64;
+        pending_key *keys = realloc(w->keys, capacity * sizeof(*keys));
+        if (!keys) return 0;
+        w->keys = keys;
+        w->capacity = capacity;
+    }
+
+    k = &w->keys[w->count];
+    memset(k, 0, sizeof(*k));
+    if (!pad_id(key_id, k->id)) return 0;
+    strcpy(k->alg, alg);
+    k->flags = priv && priv_len ? flags & PQC_KEYSTORE_SEED : 0;
+    k->pub = OPENSSL_memdup(pub, pub_len);
+    k->pub_len = pub_len;
+    if (priv && priv_len) {
+        k->priv = OPENSSL_memdup(priv, priv_len);
+        k->priv_len = priv_len;
+    }
+    if (!k->pub || (priv && priv_len && !k->priv)) {
+        OPENSSL_free(k->pub);
+        OPENSSL_free(k->priv);
+        return 0;
+    }
+    w->count++;
+    return 1;
+}
+
+/* Raw octet-string key parameter; *out is OPENSSL_malloc()ed, NULL if absent */
+static int export_octets(EVP_PKEY *pkey, const char *name, unsigned char **out, size_t *len) {
+    *out = NULL;
+    *len = 0;
+    if (EVP_PKEY_get_octet_string_param(pkey, name, NULL, 0, len) <= 0 || *len == 0) return 0;
+    *out = OPENSSL_malloc(*len);
+    if (!*out || EVP_PKEY_get_octet_string_param(pkey, name, *out, *len, len) <= 0) {
+        OPENSSL_clear_free(*out, *len);
+        *out = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+int pqc_keystore_writer_add_pkey(pqc_keystore_writer *w, const char *key_id, EVP_PKEY *pkey,
+                                 unsigned flags) {
+    unsigned char *pub = NULL, *priv = NULL;
+    size_t pub_len = 0, priv_len = 0;
+    const char *alg = pkey ? EVP_PKEY_get0_type_name(pkey) : NULL;
+    int ok;
+
+    if (!alg || !export_octets(pkey, OSSL_PKEY_PARAM_PUB_KEY, &pub, &pub_len)) return 0;
+    if (flags & PQC_KEYSTORE_SEED) {
+        if (!export_octets(pkey, SEED_PARAM, &priv, &priv_len)) {
+            OPENSSL_free(pub);
+            return 0;
+        }
+    } else {
+        export_octets(pkey, OSSL_PKEY_PARAM_PRIV_KEY, &priv, &priv_len);
+    }
+
+    ok = pqc_keystore_writer_add(w, key_id, alg, pub, pub_len, priv, priv_len, flags);
+    OPENSSL_free(pub);
+    OPENSSL_clear_free(priv, priv_len);
+    return ok;
+}
+
+static int compare_keys(const void *a, const void *b) {
+    return memcmp(((const pending_key *)a)->id, ((const pending_key *)b)->id, PQC_KEYSTORE_ID_LEN);
+}
+
+static size_t align_up(size_t v) {
+    return (v + DATA_ALIGN - 1) & ~(size_t)(DATA_ALIGN - 1);
+}
+
+static int write_padded(FILE *f, const void *buf, size_t len) {
+    static const unsigned char zeros[DATA_ALIGN] = { 0 };
+    size_t pad = align_up(len) - len;
+
+    return fwrite(buf, 1, len, f) == len && (pad == 0 || fwrite(zeros, 1, pad, f) == pad);
+}
+
+int pqc_keystore_writer_commit(pqc_keystore_writer *w, const char *path) {
+    unsigned char header[HEADER_SIZE] = { 0 }, entry[ENTRY_SIZE];
+    char *tmp = NULL;
+    size_t data_off, off;
+    FILE *f = NULL;
+    int fd = -1, ok = 0;
+
+    if (!w || !path) return 0;
+
+    qsort(w->keys, w->count, sizeof(*w->keys), compare_keys);
+    for (size_t i = 1; i < w->count; i++) {
+        if (compare_keys(&w->keys[i - 1], &w->keys[i]) == 0) return 0;
+    }
+
+    /* Header and entries are multiples of DATA_ALIGN, so data follows the index */
+    data_off = HEADER_SIZE + w->count * ENTRY_SIZE;
+    off = data_off;
+    for (size_t i = 0; i < w->count; i++) {
+        off += align_up(w->keys[i].pub_len);
+        off += align_up(w->keys[i].priv_len);
+    }
+
+    memcpy(header, magic, sizeof(magic));
+    store_le32(header + H_VERSION, PQC_KEYSTORE_VERSION);
+    store_le32(header + H_ENTRY_SIZE, ENTRY_SIZE);
+    store_le64(header + H_COUNT, w->count);
+    store_le64(header + H_INDEX_OFF, HEADER_SIZE);
+    store_le64(header + H_DATA_OFF, data_off);
+    store_le64(header + H_FILE_SIZE, off);
+
+    tmp = malloc(strlen(path) + 32);
+    if (!tmp) return 0;
+    sprintf(tmp, "%s.tmp.%ld", path, (long)getpid());
+    fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0 || !(f = fdopen(fd, "wb"))) goto cleanup;
+    fd = -1;
+
+    if (fwrite(header, 1, sizeof(header), f) != sizeof(header)) goto cleanup;
+
+    /* Index: data is laid out in index order, public key then private key */
+    off = data_off;
+    for (size_t i = 0; i < w->count; i++) {
+        const pending_key *k = &w->keys[i];
+
+        memset(entry, 0, sizeof(entry));
+        memcpy(entry + E_ID, k->id, PQC_KEYSTORE_ID_LEN);
+        memcpy(entry + E_ALG, k->alg, PQC_KEYSTORE_ALG_LEN);
+        store_le32(entry + E_PUB_LEN, (uint32_t)k->pub_len);
+        store_le32(entry + E_PRIV_LEN, (uint32_t)k->priv_len);
+        store_le64(entry + E_PUB_OFF, off);
+        off += align_up(k->pub_len);
+        store_le64(entry + E_PRIV_OFF, k->priv_len ? off : 0);
+        off += align_up(k->priv_len);
+        store_le32(entry + E_FLAGS, k->flags);
+        if (fwrite(entry, 1, sizeof(entry), f) != sizeof(entry)) goto cleanup;
+    }
+    for (size_t i = 0; i < w->count; i++) {
+        const pending_key *k = &w->keys[i];
+        if (!write_padded(f, k->pub, k->pub_len)
+            || (k->priv_len && !write_padded(f, k->priv, k->priv_len)))
+            goto cleanup;
+    }
+
+    ok = fflush(f) == 0 && fsync(fileno(f)) == 0;
+    ok = (fclose(f) == 0) && ok;
+    f = NULL;
+    ok = ok && rename(tmp, path) == 0;
+
+cleanup:
+    if (f) fclose(f);
+    if (fd >= 0) close(fd);
+    if (!ok && tmp) unlink(tmp);
+    free(tmp);
+    return ok;
+}
+
+int pqc_keystore_demo_path(char *path, size_t len, const char *name, int *scratch) {
+    const char *keep = getenv("PQC_KEYSTORE"), *tmp = getenv("TMPDIR");
+    size_t dir_len;
+
+    *scratch = 0;
+    if (keep && *keep) return (size_t)snprintf(path, len, "%s", keep) < len;
+
+    if ((size_t)snprintf(path, len, "%s/pqc_keystore.XXXXXX", tmp && *tmp ? tmp : "/tmp") >= len
+        || !mkdtemp(path)) {
+        perror("mkdtemp");
+        return 0;
+    }
+    dir_len = strlen(path);
+    if ((size_t)snprintf(path + dir_len, len - dir_len, "/%s", name) >= len - dir_len) {
+        path[dir_len] = '\0';
+        rmdir(path);
+        return 0;
+    }
+    *scratch = 1;
+    return 1;
+}
+
+void pqc_keystore_remove_scratch(const char *path) {
+    char dir[4096];
+    const char *slash = strrchr(path, '/');
+
+    unlink(path);
+    if (!slash || (size_t)(slash - path) >= sizeof(dir)) return;
+    memcpy(dir, path, (size_t)(slash - path));
+    dir[slash - path] = '\0';
+    rmdir(dir);
+}
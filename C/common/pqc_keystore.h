@@ -0,0 +1,118 @@
+#ifndef PQC_KEYSTORE_H
+#define PQC_KEYSTORE_H
+
+#include <stddef.h>
+
+#include <openssl/evp.h>
+
+/*
+ * Memory-mapped binary keystore for many ML-DSA, ML-KEM and SLH-DSA keys.
+ *
+ * A keystore file is written once by pqc_keystore_writer and then opened
+ * read-only with mmap. Opening only validates the fixed-size header, so it
+ * takes the same time for ten keys or a million; pages of the index and of
+ * the key material are faulted in on first use. Keys are looked up by ID with
+ * a binary search over the sorted on-disk index and returned as pointers into
+ * the mapping: no PEM or DER parsing and no copy.
+ *
+ * File layout (all integers little-endian):
+ *
+ *   header  64 bytes   magic "PQCKSTOR", version, entry size, key count,
+ *                      index and data offsets, file size
+ *   index   count * 96 entries sorted by key ID: ID, algorithm name,
+ *                      public/private key lengths and offsets, flags
+ *   data    raw public and private keys as exported by OpenSSL
+ *           (OSSL_PKEY_PARAM_PUB_KEY / OSSL_PKEY_PARAM_PRIV_KEY), 8-byte aligned
+ *
+ * ML-DSA and ML-KEM private keys can instead be stored as their FIPS 203/204
+ * seed (32 or 64 bytes instead of 2400-4896), which makes a multi-tenant
+ * keystore several times smaller; loading then re-derives the key, which
+ * costs about as much as importing the expanded form.
+ *
+ * Private keys are stored in the clear: the file is created with mode 0600,
+ * and protecting it at rest (disk encryption, or wrapping the keys before
+ * adding them) is up to the deployment.
+ */
+
+#define PQC_KEYSTORE_VERSION 1
+#define PQC_KEYSTORE_ID_LEN  32     /* key IDs are up to 32 bytes */
+#define PQC_KEYSTORE_ALG_LEN 24     /* algorithm names up to 23 characters */
+
+typedef struct pqc_keystore pqc_keystore;
+typedef struct pqc_keystore_writer pqc_keystore_writer;
+
+/* A key inside an open keystore; pointers are valid until it is closed. */
+typedef struct {
+    const char *alg;                /* e.g. "ML-DSA-65", NUL-terminated */
+    const unsigned char *pub;
+    size_t pub_len;
+    const unsigned char *priv;      /* NULL for public-only entries */
+    size_t priv_len;
+    int priv_is_seed;               /* priv is the key generation seed */
+} pqc_key_ref;
+
+/* Maps path read-only. NULL if it cannot be opened or is not a keystore. */
+pqc_keystore *pqc_keystore_open(const char *path);
+void pqc_keystore_close(pqc_keystore *ks);
+
+size_t pqc_keystore_count(const pqc_keystore *ks);
+
+/* 1 and fills *ref if key_id is present, 0 otherwise. O(log n). */
+int pqc_keystore_find(const pqc_keystore *ks, const char *key_id, pqc_key_ref *ref);
+
+/* ID of the i-th key in index (sorted) order, for listing; not NUL-terminated
+ * when it is exactly PQC_KEYSTORE_ID_LEN bytes, hence *len. */
+const char *pqc_keystore_id_at(const pqc_keystore *ks, size_t i, size_t *len);
+
+/*
+ * EVP_PKEY built straight from the mapped key bytes with EVP_PKEY_fromdata().
+ * A key pair if the entry has a private key, else a public key. The caller
+ * frees it.
+ */
+EVP_PKEY *pqc_keystore_load(const pqc_keystore *ks, OSSL_LIB_CTX *libctx,
+                            const char *key_id);
+
+/* ---- Writing ---- */
+
+pqc_keystore_writer *pqc_keystore_writer_new(void);
+
+/* Wipes the buffered private keys. */
+void pqc_keystore_writer_free(pqc_keystore_writer *w);
+
+/* Flags for the writer */
+#define PQC_KEYSTORE_SEED 0x1       /* priv is a seed / store the seed only */
+
+/* Buffers a copy of the key. priv may be NULL. Returns 1 on success. */
+int pqc_keystore_writer_add(pqc_keystore_writer *w, const char *key_id, const char *alg,
+                            const unsigned char *pub, size_t pub_len,
+                            const unsigned char *priv, size_t priv_len, unsigned flags);
+
+/*
+ * Exports pkey's raw public key and, if present, its private key and adds
+ * them. With PQC_KEYSTORE_SEED the seed is stored instead of the private
+ * key; fails if the key has no seed (e.g. SLH-DSA, or keys imported without
+ * one).
+ */
+int pqc_keystore_writer_add_pkey(pqc_keystore_writer *w, const char *key_id, EVP_PKEY *pkey,
+                                 unsigned flags);
+
+/*
+ * Sorts the index and writes the keystore to path through a temporary file
+ * that is fsync()ed and renamed over path, so readers never see a partial
+ * file. Fails on duplicate key IDs.
+ */
+int pqc_keystore_writer_commit(pqc_keystore_writer *w, const char *path);
+
+/* ---- Demo files ---- */
+
+/*
+ * Where a demo writes its private keys: $PQC_KEYSTORE if set, and kept;
+ * otherwise name inside a new private (0700) directory under $TMPDIR or
+ * /tmp, never the current directory. *scratch is set in the second case,
+ * and pqc_keystore_remove_scratch() deletes the file and the directory
+ * once the keys are loaded. Returns 1 on success.
+ */
+int pqc_keystore_demo_path(char *path, size_t len, const char *name, int *scratch);
+void pqc_keystore_remove_scratch(const char *path);
+
+#endif /* PQC_KEYSTORE_H */
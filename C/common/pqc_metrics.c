@@ -0,0 +1,267 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <openssl/crypto.h>
+
+#include "pqc_metrics.h"
+
+/* ---- Histogram ---- */
+
+static size_t bucket_of(uint64_t v) {
+    unsigned shift;
+
+    if (v < 2 * PQC_HIST_SUB) return (size_t)v;
+    shift = (unsigned)(63 - __builtin_clzll(v)) - 7;
+    return 2 * PQC_HIST_SUB + (size_t)(shift - 1) * PQC_HIST_SUB + (size_t)((v >> shift) - PQC_HIST_SUB);
+}
+
+/* Largest value that lands in bucket i */
+static uint64_t bucket_upper(size_t i) {
+    unsigned shift;
+    uint64_t sub;
+
+    if (i < 2 * PQC_HIST_SUB) return i;
+    shift = (unsigned)((i - 2 * PQC_HIST_SUB) / PQC_HIST_SUB) + 1;
+    sub = (i - 2 * PQC_HIST_SUB) % PQC_HIST_SUB + PQC_HIST_SUB;
+    return ((sub + 1) << shift) - 1;    /* the top bucket wraps to UINT64_MAX */
+}
+
+pqc_hist *pqc_hist_new(void) {
+    pqc_hist *h = malloc(sizeof(*h));
+
+    if (h) pqc_hist_reset(h);
+    return h;
+}
+
+void pqc_hist_free(pqc_hist *h) {
+    free(h);
+}
+
+void pqc_hist_reset(pqc_hist *h) {
+    memset(h, 0, sizeof(*h));
+    h->min_ns = UINT64_MAX;
+}
+
+void pqc_hist_record(pqc_hist *h, uint64_t ns) {
+    h->counts[bucket_of(ns)]++;
+    h->samples++;
+    h->sum_ns += (double)ns;
+    if (ns < h->min_ns) h->min_ns = ns;
+    if (ns > h->max_ns) h->max_ns = ns;
+}
+
+void pqc_hist_merge(pqc_hist *dst, const pqc_hist *src) {
+    for (size_t i = 0; i < PQC_HIST_BUCKETS; i++) dst->counts[i] += src->counts[i];
+    dst->samples += src->samples;
+    dst->sum_ns += src->sum_ns;
+    if (src->min_ns < dst->min_ns) dst->min_ns = src->min_ns;
+    if (src->max_ns > dst->max_ns) dst->max_ns = src->max_ns;
+}
+
+uint64_t pqc_hist_percentile(const pqc_hist *h, double p) {
+    uint64_t rank, seen = 0;
+
+    if (!h->samples) return 0;
+    rank = (uint64_t)(p / 100.0 * (double)h->samples + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > h->samples) rank = h->samples;
+    for (size_t i = 0; i < PQC_HIST_BUCKETS; i++) {
+        if ((seen += h->counts[i]) >= rank) {
+            uint64_t v = bucket_upper(i);
+            return v < h->max_ns ? v : h->max_ns;
+        }
+    }
+    return h->max_ns;
+}
+
+/* ---- Output ---- */
+
+enum { FMT_OFF, FMT_JSON, FMT_CSV };
+
+static struct {
+    int format;
+    FILE *out;
+    int header_done;
+    char program[64];
+    char host[128];
+    char build[192];
+    const char *tag;
+} m;
+
+static void close_output(void) {
+    if (m.out && m.out != stderr) fclose(m.out);
+    m.out = NULL;
+}
+
+int pqc_metrics_init(const char *program) {
+    const char *fmt = getenv("PQC_METRICS"), *path = getenv("PQC_METRICS_FILE");
+
+    if (m.format != FMT_OFF) return 1;
+    if (!fmt || !*fmt) return 0;
+    if (strcmp(fmt, "json") == 0) m.format = FMT_JSON;
+    else if (strcmp(fmt, "csv") == 0) m.format = FMT_CSV;
+    else {
+        fprintf(stderr, "PQC_METRICS: expected json or csv, got '%s'\n", fmt);
+        return 0;
+    }
+
+    if (path && *path) {
+        if (!(m.out = fopen(path, "a"))) {
+            perror(path);
+            m.format = FMT_OFF;
+            return 0;
+        }
+        fseek(m.out, 0, SEEK_END);
+        m.header_done = ftell(m.out) > 0;
+        atexit(close_output);
+    } else {
+        m.out = stderr;         /* stdout carries the human-readable text */
+    }
+
+    snprintf(m.program, sizeof(m.program), "%s", program);
+    if (gethostname(m.host, sizeof(m.host)) != 0) snprintf(m.host, sizeof(m.host), "unknown");
+    m.host[sizeof(m.host) - 1] = '\0';
+#ifdef __VERSION__
+    snprintf(m.build, sizeof(m.build), "cc %s, %s", __VERSION__, OpenSSL_version(OPENSSL_VERSION));
+#else
+    snprintf(m.build, sizeof(m.build), "%s", OpenSSL_version(OPENSSL_VERSION));
+#endif
+    m.tag = getenv("PQC_METRICS_TAG");
+    return 1;
+}
+
+int pqc_metrics_enabled(void) {
+    return m.format != FMT_OFF;
+}
+
+static void json_str(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; s && *s; s++) {
+        unsigned char c = (unsigned char)*s;
+
+        if (c == '"' || c == '\\') fprintf(f, "\\%c", c);
+        else if (c < 0x20) fprintf(f, "\\u%04x", c);
+        else fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+static void csv_str(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; s && *s; s++) {
+        if (*s == '"') fputc('"', f);
+        fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+static void emit_json(const char *alg, const char *op, const char *impl, const pqc_hist *h,
+                      double ops, const pqc_metrics_sizes *sz) {
+    static const double pct[] = { 50, 90, 99, 99.9 };
+    static const char *const pct_names[] = { "p50_ns", "p90_ns", "p99_ns", "p999_ns" };
+    FILE *f = m.out;
+    int first = 1;
+
+    fprintf(f, "{\"schema\":\"%s\",\"lang\":\"c\",\"program\":", PQC_METRICS_SCHEMA);
+    json_str(f, m.program);
+    fprintf(f, ",\"host\":");
+    json_str(f, m.host);
+    fprintf(f, ",\"build\":");
+    json_str(f, m.build);
+    fprintf(f, ",\"tag\":");
+    json_str(f, m.tag ? m.tag : "");
+    fprintf(f, ",\"alg\":");
+    json_str(f, alg);
+    fprintf(f, ",\"op\":");
+    json_str(f, op);
+    fprintf(f, ",\"impl\":");
+    json_str(f, impl ? impl : "");
+    fprintf(f, ",\"samples\":%llu,\"ops_per_sec\":%.3f,\"mean_ns\":%.1f,\"min_ns\":%llu",
+            (unsigned long long)h->samples, ops, h->samples ? h->sum_ns / h->samples : 0.0,
+            (unsigned long long)(h->samples ? h->min_ns : 0));
+    for (int i = 0; i < 4; i++)
+        fprintf(f, ",\"%s\":%llu", pct_names[i], (unsigned long long)pqc_hist_percentile(h, pct[i]));
+    fprintf(f, ",\"max_ns\":%llu,\"sizes\":{", (unsigned long long)h->max_ns);
+    if (sz) {
+        const struct { const char *name; size_t v; } s[] = {
+            { "pk", sz->pk }, { "sk", sz->sk }, { "ct", sz->ct }, { "ss", sz->ss }, { "sig", sz->sig },
+        };
+
+        for (int i = 0; i < 5; i++) {
+            if (!s[i].v) continue;
+            fprintf(f, "%s\"%s\":%zu", first ? "" : ",", s[i].name, s[i].v);
+            first = 0;
+        }
+    }
+    /* [upper bound ns, count] per non-empty bucket */
+    fprintf(f, "},\"histogram\":[");
+    first = 1;
+    for (size_t i = 0; i < PQC_HIST_BUCKETS; i++) {
+        if (!h->counts[i]) continue;
+        fprintf(f, "%s[%llu,%llu]", first ? "" : ",", (unsigned long long)bucket_upper(i),
+                (unsigned long long)h->counts[i]);
+        first = 0;
+    }
+    fprintf(f, "]}\n");
+}
+
+static void emit_csv(const char *alg, const char *op, const char *impl, const pqc_hist *h,
+                     double ops, const pqc_metrics_sizes *sz) {
+    FILE *f = m.out;
+    pqc_metrics_sizes none = { 0, 0, 0, 0, 0 };
+
+    if (!sz) sz = &none;
+    if (!m.header_done) {
+        fprintf(f, "schema,lang,program,host,build,tag,alg,op,impl,samples,ops_per_sec,mean_ns,min_ns,"
+                   "p50_ns,p90_ns,p99_ns,p999_ns,max_ns,pk_bytes,sk_bytes,ct_bytes,ss_bytes,sig_bytes\n");
+        m.header_done = 1;
+    }
+    fprintf(f, "%s,c,", PQC_METRICS_SCHEMA);
+    csv_str(f, m.program);
+    fputc(',', f);
+    csv_str(f, m.host);
+    fputc(',', f);
+    csv_str(f, m.build);
+    fputc(',', f);
+    csv_str(f, m.tag);
+    fputc(',', f);
+    csv_str(f, alg);
+    fputc(',', f);
+    csv_str(f, op);
+    fputc(',', f);
+    csv_str(f, impl);
+    fprintf(f, ",%llu,%.3f,%.1f,%llu,%llu,%llu,%llu,%llu,%llu,%zu,%zu,%zu,%zu,%zu\n",
+            (unsigned long long)h->samples, ops, h->samples ? h->sum_ns / h->samples : 0.0,
+            (unsigned long long)(h->samples ? h->min_ns : 0),
+            (unsigned long long)pqc_hist_percentile(h, 50), (unsigned long long)pqc_hist_percentile(h, 90),
+            (unsigned long long)pqc_hist_percentile(h, 99), (unsigned long long)pqc_hist_percentile(h, 99.9),
+            (unsigned long long)h->max_ns, sz->pk, sz->sk, sz->ct, sz->ss, sz->sig);
+}
+
+void pqc_metrics_emit(const char *alg, const char *op, const char *impl,
+                      const pqc_hist *h, uint64_t total_ns, const pqc_metrics_sizes *sizes) {
+    double total = total_ns ? (double)total_ns : h->sum_ns;
+    double ops = total > 0 ? h->samples * 1e9 / total : 0.0;
+
+    if (m.format == FMT_OFF) return;
+    flockfile(m.out);
+    if (m.format == FMT_JSON) emit_json(alg, op, impl, h, ops, sizes);
+    else emit_csv(alg, op, impl, h, ops, sizes);
+    fflush(m.out);
+    funlockfile(m.out);
+}
+
+void pqc_metrics_emit_samples(const char *alg, const char *op, const char *impl,
+                              const uint64_t *ns, size_t n, uint64_t total_ns,
+                              const pqc_metrics_sizes *sizes) {
+    pqc_hist *h;
+
+    if (m.format == FMT_OFF || !(h = pqc_hist_new())) return;
+    for (size_t i = 0; i < n; i++) pqc_hist_record(h, ns[i]);
+    pqc_metrics_emit(alg, op, impl, h, total_ns, sizes);
+    pqc_hist_free(h);
+}
@@ -0,0 +1,75 @@
+#ifndef PQC_METRICS_H
+#define PQC_METRICS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Machine-readable results for dashboards, next to the emoji text.
+ *
+ * With PQC_METRICS=json or PQC_METRICS=csv in the environment, every
+ * benchmarked operation also produces one record: program, algorithm,
+ * operation, implementation, sample count, ops/sec, mean / min / p50 / p90 /
+ * p99 / p99.9 / max latency, key, ciphertext and signature sizes, and (JSON
+ * only) the non-empty histogram buckets. JSON is one object per line; CSV has
+ * a header line when the output starts empty. Records are appended to
+ * PQC_METRICS_FILE, or written to stderr, apart from the text on stdout.
+ * Every record carries the host, a build string (compiler and OpenSSL
+ * versions) and PQC_METRICS_TAG, so runs from different machines and builds
+ * can share one file. The Rust crates write the same schema
+ * (Rust/pqc-metrics).
+ *
+ * Histograms are HDR-style: values below 256 ns are exact, larger ones fall
+ * in one of 128 linear buckets per power of two, so every percentile is
+ * within 1% of the recorded value, from 1 ns to centuries.
+ */
+
+#define PQC_METRICS_SCHEMA "pqc-metrics/1"
+
+#define PQC_HIST_SUB     128
+#define PQC_HIST_BUCKETS (2 * PQC_HIST_SUB + 56 * PQC_HIST_SUB)
+
+typedef struct {
+    uint64_t counts[PQC_HIST_BUCKETS];
+    uint64_t samples;
+    uint64_t min_ns, max_ns;
+    double sum_ns;
+} pqc_hist;
+
+/* Zeroed; pqc_hist_free() releases it. */
+pqc_hist *pqc_hist_new(void);
+void pqc_hist_free(pqc_hist *h);
+void pqc_hist_reset(pqc_hist *h);
+
+void pqc_hist_record(pqc_hist *h, uint64_t ns);
+void pqc_hist_merge(pqc_hist *dst, const pqc_hist *src);
+
+/* The p-th percentile (0..100): the upper bound of its bucket. 0 if empty. */
+uint64_t pqc_hist_percentile(const pqc_hist *h, double p);
+
+/* Byte sizes of the algorithm's objects; 0 where they do not apply. */
+typedef struct {
+    size_t pk, sk, ct, ss, sig;
+} pqc_metrics_sizes;
+
+/*
+ * Reads PQC_METRICS once and names the program in its records.
+ * Returns 1 when metrics are on. Call from main() before any emit.
+ */
+int pqc_metrics_init(const char *program);
+int pqc_metrics_enabled(void);
+
+/*
+ * One record. impl names the backend or code path (may be NULL), sizes may
+ * be NULL, and total_ns is the wall time for ops/sec (0: the summed latency).
+ * No-op when metrics are off.
+ */
+void pqc_metrics_emit(const char *alg, const char *op, const char *impl,
+                      const pqc_hist *h, uint64_t total_ns, const pqc_metrics_sizes *sizes);
+
+/* Same, from an array of latencies. */
+void pqc_metrics_emit_samples(const char *alg, const char *op, const char *impl,
+                              const uint64_t *ns, size_t n, uint64_t total_ns,
+                              const pqc_metrics_sizes *sizes);
+
+#endif /* PQC_METRICS_H */
@@ -0,0 +1,128 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sched.h>
+
+#include <openssl/crypto.h>
+#include "oqs/oqs.h"
+
+#include "pqc_oqs_registry.h"
+
+enum { INFO_UNKNOWN, INFO_LOADING, INFO_READY, INFO_DISABLED };
+
+/*
+ * One entry per liboqs identifier. The name and hash are set when the index
+ * is built; info is filled by whichever thread first moves state from
+ * INFO_UNKNOWN to INFO_LOADING, and published by the release store of
+ * INFO_READY.
+ */
+typedef struct {
+    pqc_oqs_sig_info info;
+    unsigned long hash;
+    int state;
+} sig_entry;
+
+static sig_entry *entries;
+static size_t n_entries;
+static size_t *slots;           /* open addressing, entry index + 1, 0 = empty */
+static size_t slot_mask;
+
+static CRYPTO_ONCE registry_once = CRYPTO_ONCE_STATIC_INIT;
+static int registry_ok;
+
+static unsigned long hash_name(const char *name) {
+    unsigned long h = 2166136261ul;
+    for (const unsigned char *p = (const unsigned char *)name; *p; p++)
+        h = (h ^ *p) * 16777619ul;
+    return h;
+}
+
+static void registry_init(void) {
+    int count = OQS_SIG_alg_count();
+    size_t nslots = 1;
+
+    if (count <= 0) return;
+    while (nslots < 2 * (size_t)count) nslots <<= 1;
+    entries = calloc((size_t)count, sizeof(*entries));
+    slots = calloc(nslots, sizeof(*slots));
+    if (!entries || !slots) {
+        free(entries);
+        free(slots);
+        return;
+    }
+
+    for (size_t i = 0; i < (size_t)count; i++) {
+        sig_entry *e = &entries[i];
+        size_t s;
+
+        e->info.name = OQS_SIG_alg_identifier(i);
+        e->hash = hash_name(e->info.name);
+        for (s = e->hash & (nslots - 1); slots[s]; s = (s + 1) & (nslots - 1))
+            ;
+        slots[s] = i + 1;
+    }
+    n_entries = (size_t)count;
+    slot_mask = nslots - 1;
+    registry_ok = 1;
+}
+
+static int registry_ready(void) {
+    return CRYPTO_THREAD_run_once(&registry_once, registry_init) && registry_ok;
+}
+
+static const pqc_oqs_sig_info *load(sig_entry *e) {
+    int state = __atomic_load_n(&e->state, __ATOMIC_ACQUIRE);
+
+    while (state == INFO_UNKNOWN || state == INFO_LOADING) {
+        int expected = INFO_UNKNOWN;
+
+        if (__atomic_compare_exchange_n(&e->state, &expected, INFO_LOADING, 0,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+            OQS_SIG *sig = OQS_SIG_alg_is_enabled(e->info.name) ? OQS_SIG_new(e->info.name) : NULL;
+
+            if (sig) {
+                e->info.alg_version = sig->alg_version;
+                e->info.claimed_nist_level = sig->claimed_nist_level;
+                e->info.euf_cma = sig->euf_cma;
+                e->info.length_public_key = sig->length_public_key;
+                e->info.length_secret_key = sig->length_secret_key;
+                e->info.length_signature = sig->length_signature;
+                OQS_SIG_free(sig);
+            }
+            state = sig ? INFO_READY : INFO_DISABLED;
+            __atomic_store_n(&e->state, state, __ATOMIC_RELEASE);
+            break;
+        }
+        /* Another thread is loading this entry */
+        if (expected == INFO_LOADING) sched_yield();
+        state = expected;
+    }
+    return state == INFO_READY ? &e->info : NULL;
+}
+
+size_t pqc_oqs_sig_count(void) {
+    return registry_ready() ? n_entries : 0;
+}
+
+const char *pqc_oqs_sig_name(size_t i) {
+    return registry_ready() && i < n_entries ? entries[i].info.name : NULL;
+}
+
+const pqc_oqs_sig_info *pqc_oqs_sig_find(const char *name) {
+    unsigned long h;
+
+    if (!name || !registry_ready()) return NULL;
+    h = hash_name(name);
+    for (size_t s = h & slot_mask; slots[s]; s = (s + 1) & slot_mask) {
+        sig_entry *e = &entries[slots[s] - 1];
+
+        if (e->hash == h && strcmp(e->info.name, name) == 0) return load(e);
+    }
+    return NULL;
+}
+
+const pqc_oqs_sig_info *pqc_oqs_sig_at(size_t i) {
+    return registry_ready() && i < n_entries ? load(&entries[i]) : NULL;
+}
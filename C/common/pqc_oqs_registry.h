@@ -0,0 +1,44 @@
+#ifndef PQC_OQS_REGISTRY_H
+#define PQC_OQS_REGISTRY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Lazily filled registry of liboqs signature algorithms.
+ *
+ * Listing liboqs algorithms with their sizes the obvious way calls
+ * OQS_SIG_new() and OQS_SIG_free() for each of OQS_SIG_alg_count() (over
+ * 200) identifiers, and OQS_SIG_alg_is_enabled() is itself a linear string
+ * search. The registry instead builds a hashed name index once, on first
+ * use, without creating any OQS_SIG. An algorithm's sizes and properties
+ * are read on the first lookup of that algorithm and kept.
+ *
+ * So pqc_oqs_sig_find() costs one hash probe after the first call, and a
+ * program pays OQS_SIG_new() only for the algorithms it asks about. All
+ * functions are thread-safe. Returned entries live until the process exits.
+ */
+
+typedef struct {
+    const char *name;           /* liboqs identifier */
+    const char *alg_version;
+    uint8_t claimed_nist_level;
+    int euf_cma;
+    size_t length_public_key;
+    size_t length_secret_key;
+    size_t length_signature;    /* maximum */
+} pqc_oqs_sig_info;
+
+/* Number of identifiers liboqs knows, enabled or not. */
+size_t pqc_oqs_sig_count(void);
+
+/* Identifier i, in liboqs order, without loading its sizes. NULL past the end. */
+const char *pqc_oqs_sig_name(size_t i);
+
+/* Sizes and properties of an enabled algorithm; NULL if unknown, disabled or name is NULL. */
+const pqc_oqs_sig_info *pqc_oqs_sig_find(const char *name);
+
+/* Same as pqc_oqs_sig_find(pqc_oqs_sig_name(i)). */
+const pqc_oqs_sig_info *pqc_oqs_sig_at(size_t i);
+
+#endif /* PQC_OQS_REGISTRY_H */
@@ -0,0 +1,471 @@
+#define _GNU_SOURCE     /* cpu_set_t, pthread_setaffinity_np */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "pqc_sched.h"
+#include "pqc_timer.h"
+
+#define MAX_CPUS 1024
+#define DEQUE_INIT 64
+
+typedef struct {
+    pqc_job_fn fn;
+    void *arg;
+} job;
+
+/*
+ * A worker and its deque. The owner takes its oldest job, so jobs submitted
+ * in order start roughly in order; thieves take the newest. count changes
+ * under the lock but is stored atomically, so thieves can skip empty deques
+ * without taking it. Counters are written only by the owner. The padding
+ * keeps neighbouring workers' locks and counters on separate cache lines.
+ */
+typedef struct {
+    struct pqc_sched *s;
+    pthread_mutex_t lock;
+    job *ring;
+    size_t cap, head, count;
+    pqc_worker w;
+    unsigned *victims;          /* steal order: own node first */
+    pthread_t thread;
+    int started;
+    uint64_t jobs, stolen, remote, busy_ns;
+    unsigned char pad[64];
+} worker;
+
+struct pqc_sched {
+    pqc_sched_config cfg;
+    worker *workers;
+    unsigned n;
+    unsigned nnodes;            /* highest node id + 1 */
+    int cpus[MAX_CPUS];         /* usable CPUs, interleaved across nodes */
+    unsigned cpu_node[MAX_CPUS];
+    unsigned ncpus;
+
+    size_t queued;              /* jobs sitting in deques */
+    size_t pending;             /* submitted, not finished */
+    unsigned next;              /* round-robin submission */
+    unsigned sleepers;
+    int shutdown;
+
+    pthread_mutex_t lock;       /* sleeping, startup and waiting only */
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    unsigned ready;
+    int init_failed;
+};
+
+/* ---- Topology ---- */
+
+#ifdef __linux__
+/* Marks the CPUs of a sysfs cpulist such as "0-3,8-11" with node */
+static void parse_cpulist(const char *list, unsigned node, int *node_of) {
+    while (*list) {
+        char *end;
+        long lo = strtol(list, &end, 10), hi = lo;
+
+        if (end == list) break;
+        if (*end == '-') hi = strtol(end + 1, &end, 10);
+        for (long c = lo; c <= hi && c < MAX_CPUS; c++)
+            if (c >= 0) node_of[c] = (int)node;
+        list = *end == ',' ? end + 1 : end;
+        if (*list == '\n') break;
+    }
+}
+#endif
+
+static void topology(pqc_sched *s) {
+    int node_of[MAX_CPUS];
+    unsigned per_node[PQC_SCHED_MAX_NODES] = { 0 }, taken[PQC_SCHED_MAX_NODES] = { 0 };
+    int usable[MAX_CPUS] = { 0 };
+
+    for (int c = 0; c < MAX_CPUS; c++) node_of[c] = 0;
+#ifdef __linux__
+    cpu_set_t mask;
+
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        for (int c = 0; c < MAX_CPUS && c < CPU_SETSIZE; c++) usable[c] = CPU_ISSET(c, &mask) != 0;
+    }
+    for (unsigned node = 0; node < PQC_SCHED_MAX_NODES; node++) {
+        char path[64], list[4096];
+        FILE *f;
+
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", node);
+        if (!(f = fopen(path, "r"))) continue;
+        if (fgets(list, sizeof(list), f)) parse_cpulist(list, node, node_of);
+        fclose(f);
+    }
+#endif
+
+    s->ncpus = 0;
+    s->nnodes = 1;
+    for (int c = 0; c < MAX_CPUS; c++) {
+        if (!usable[c]) continue;
+        per_node[node_of[c]]++;
+        if ((unsigned)node_of[c] + 1 > s->nnodes) s->nnodes = (unsigned)node_of[c] + 1;
+    }
+
+    /* Interleave: the k-th CPU of every node before the (k+1)-th of any */
+    for (unsigned added = 1; added;) {
+        added = 0;
+        for (unsigned node = 0; node < s->nnodes; node++) {
+            if (taken[node] >= per_node[node]) continue;
+            for (int c = 0, seen = 0; c < MAX_CPUS; c++) {
+                if (!usable[c] || (unsigned)node_of[c] != node) continue;
+                if ((unsigned)seen++ < taken[node]) continue;
+                s->cpus[s->ncpus] = c;
+                s->cpu_node[s->ncpus++] = node;
+                taken[node]++;
+                added = 1;
+                break;
+            }
+        }
+    }
+
+    /* No affinity information: unpinned, one node */
+    if (s->ncpus == 0) {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+        s->ncpus = n > 0 ? (unsigned)(n < MAX_CPUS ? n : MAX_CPUS) : 1;
+        for (unsigned i = 0; i < s->ncpus; i++) {
+            s->cpus[i] = -1;
+            s->cpu_node[i] = 0;
+        }
+        s->nnodes = 1;
+    }
+}
+
+static void pin(pqc_sched *s, worker *wk) {
+#ifdef __linux__
+    cpu_set_t set;
+
+    if (s->cfg.pin == PQC_PIN_NONE || (s->cfg.pin == PQC_PIN_CORE && wk->w.cpu < 0)) return;
+    CPU_ZERO(&set);
+    if (s->cfg.pin == PQC_PIN_CORE) {
+        CPU_SET(wk->w.cpu, &set);
+    } else {
+        for (unsigned i = 0; i < s->ncpus; i++)
+            if (s->cpus[i] >= 0 && s->cpu_node[i] == wk->w.node) CPU_SET(s->cpus[i], &set);
+        if (CPU_COUNT(&set) == 0) return;
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)s;
+    (void)wk;
+#endif
+}
+
+/* ---- Deques ---- */
+
+static int push(worker *wk, job j) {
+    int ok = 1;
+
+    pthread_mutex_lock(&wk->lock);
+    if (wk->count == wk->cap) {
+        size_t cap = wk->cap ? 2 * wk->cap : DEQUE_INIT;
+        job *ring = malloc(cap * sizeof(*ring));
+
+        if (!ring) {
+            ok = 0;
+        } else {
+            for (size_t i = 0; i < wk->count; i++) ring[i] = wk->ring[(wk->head + i) % wk->cap];
+            free(wk->ring);
+            wk->ring = ring;
+            wk->cap = cap;
+            wk->head = 0;
+        }
+    }
+    if (ok) {
+        wk->ring[(wk->head + wk->count) % wk->cap] = j;
+        __atomic_store_n(&wk->count, wk->count + 1, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&wk->lock);
+    return ok;
+}
+
+static int pop_oldest(worker *wk, job *j) {
+    int ok = 0;
+
+    pthread_mutex_lock(&wk->lock);
+    if (wk->count) {
+        *j = wk->ring[wk->head];
+        wk->head = (wk->head + 1) % wk->cap;
+        __atomic_store_n(&wk->count, wk->count - 1, __ATOMIC_RELAXED);
+        ok = 1;
+    }
+    pthread_mutex_unlock(&wk->lock);
+    return ok;
+}
+
+static int pop_newest(worker *wk, job *j) {
+    int ok = 0;
+
+    pthread_mutex_lock(&wk->lock);
+    if (wk->count) {
+        *j = wk->ring[(wk->head + wk->count - 1) % wk->cap];
+        __atomic_store_n(&wk->count, wk->count - 1, __ATOMIC_RELAXED);
+        ok = 1;
+    }
+    pthread_mutex_unlock(&wk->lock);
+    return ok;
+}
+
+static int steal(pqc_sched *s, worker *wk, job *j) {
+    for (unsigned i = 0; i + 1 < s->n; i++) {
+        worker *victim = &s->workers[wk->victims[i]];
+
+        if (__atomic_load_n(&victim->count, __ATOMIC_RELAXED) && pop_newest(victim, j)) {
+            __atomic_fetch_add(&wk->stolen, 1, __ATOMIC_RELAXED);
+            if (victim->w.node != wk->w.node) __atomic_fetch_add(&wk->remote, 1, __ATOMIC_RELAXED);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* ---- Workers ---- */
+
+static void run_job(pqc_sched *s, worker *wk, job j) {
+    uint64_t t0 = pqc_now_ns();
+
+    __atomic_fetch_sub(&s->queued, 1, __ATOMIC_SEQ_CST);
+    j.fn(&wk->w, j.arg);
+    __atomic_fetch_add(&wk->busy_ns, pqc_now_ns() - t0, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&wk->jobs, 1, __ATOMIC_RELAXED);
+
+    if (__atomic_sub_fetch(&s->pending, 1, __ATOMIC_SEQ_CST) == 0) {
+        pthread_mutex_lock(&s->lock);
+        pthread_cond_broadcast(&s->done);
+        pthread_mutex_unlock(&s->lock);
+    }
+}
+
+static void *worker_main(void *arg) {
+    worker *wk = arg;
+    pqc_sched *s = wk->s;
+    int ok;
+    job j;
+
+    pin(s, wk);
+    wk->w.local = s->cfg.init ? s->cfg.init(&wk->w, s->cfg.arg) : NULL;
+    ok = !s->cfg.init || wk->w.local;
+
+    pthread_mutex_lock(&s->lock);
+    if (!ok) s->init_failed = 1;
+    s->ready++;
+    pthread_cond_broadcast(&s->done);
+    pthread_mutex_unlock(&s->lock);
+    if (!ok) return NULL;
+
+    for (;;) {
+        if (pop_oldest(wk, &j) || steal(s, wk, &j)) {
+            run_job(s, wk, j);
+            continue;
+        }
+
+        /*
+         * Nothing found. Sleep until a submit, unless a job is on its way
+         * into a deque (queued is raised before the push) or we are done.
+         * sleepers and queued are both seq_cst, so either the submitter sees
+         * us sleeping and signals, or we see its job.
+         */
+        pthread_mutex_lock(&s->lock);
+        __atomic_add_fetch(&s->sleepers, 1, __ATOMIC_SEQ_CST);
+        while (!__atomic_load_n(&s->queued, __ATOMIC_SEQ_CST) && !s->shutdown)
+            pthread_cond_wait(&s->wake, &s->lock);
+        __atomic_sub_fetch(&s->sleepers, 1, __ATOMIC_SEQ_CST);
+        if (s->shutdown && !__atomic_load_n(&s->queued, __ATOMIC_SEQ_CST)) {
+            pthread_mutex_unlock(&s->lock);
+            break;
+        }
+        pthread_mutex_unlock(&s->lock);
+        sched_yield();
+    }
+
+    if (s->cfg.fini) s->cfg.fini(&wk->w, s->cfg.arg);
+    return NULL;
+}
+
+/* ---- Scheduler ---- */
+
+static int init_victims(pqc_sched *s, worker *wk) {
+    unsigned k = 0;
+
+    if (!(wk->victims = malloc((s->n ? s->n : 1) * sizeof(*wk->victims)))) return 0;
+    for (int same = 1; same >= 0; same--) {
+        for (unsigned d = 1; d < s->n; d++) {
+            worker *v = &s->workers[(wk->w.id + d) % s->n];
+
+            if ((v->w.node == wk->w.node) == same) wk->victims[k++] = v->w.id;
+        }
+    }
+    return 1;
+}
+
+pqc_sched *pqc_sched_new(const pqc_sched_config *cfg) {
+    pqc_sched *s = calloc(1, sizeof(*s));
+    unsigned started = 0;
+
+    if (!s) return NULL;
+    s->cfg = *cfg;
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->wake, NULL);
+    pthread_cond_init(&s->done, NULL);
+    topology(s);
+    if (cfg->pin == PQC_PIN_NONE) {
+        /* Unpinned workers run anywhere: one node, and no steal is remote */
+        for (unsigned i = 0; i < s->ncpus; i++) s->cpu_node[i] = 0;
+        s->nnodes = 1;
+    }
+
+    s->n = cfg->workers ? cfg->workers : s->ncpus;
+    if (!(s->workers = calloc(s->n, sizeof(*s->workers)))) goto err;
+    for (unsigned i = 0; i < s->n; i++) {
+        worker *wk = &s->workers[i];
+
+        wk->s = s;
+        pthread_mutex_init(&wk->lock, NULL);
+        wk->w.id = i;
+        wk->w.node = s->cpu_node[i % s->ncpus];
+        wk->w.cpu = cfg->pin == PQC_PIN_CORE ? s->cpus[i % s->ncpus] : -1;
+    }
+    for (unsigned i = 0; i < s->n; i++)
+        if (!init_victims(s, &s->workers[i])) goto err;
+
+    for (; started < s->n; started++) {
+        worker *wk = &s->workers[started];
+
+        if (pthread_create(&wk->thread, NULL, worker_main, wk) != 0) break;
+        wk->started = 1;
+    }
+
+    /* Every worker reports in after its init callback */
+    pthread_mutex_lock(&s->lock);
+    while (s->ready < started) pthread_cond_wait(&s->done, &s->lock);
+    pthread_mutex_unlock(&s->lock);
+    if (started < s->n || s->init_failed) goto err;
+    return s;
+
+err:
+    pqc_sched_free(s);
+    return NULL;
+}
+
+void pqc_sched_free(pqc_sched *s) {
+    if (!s) return;
+    pqc_sched_wait(s);
+
+    pthread_mutex_lock(&s->lock);
+    s->shutdown = 1;
+    pthread_cond_broadcast(&s->wake);
+    pthread_mutex_unlock(&s->lock);
+
+    for (unsigned i = 0; s->workers && i < s->n; i++) {
+        worker *wk = &s->workers[i];
+
+        if (wk->started) pthread_join(wk->thread, NULL);
+        pthread_mutex_destroy(&wk->lock);
+        free(wk->ring);
+        free(wk->victims);
+    }
+    free(s->workers);
+    pthread_cond_destroy(&s->done);
+    pthread_cond_destroy(&s->wake);
+    pthread_mutex_destroy(&s->lock);
+    free(s);
+}
+
+int pqc_sched_submit(pqc_sched *s, pqc_job_fn fn, void *arg) {
+    unsigned i = __atomic_fetch_add(&s->next, 1, __ATOMIC_RELAXED) % s->n;
+    job j = { fn, arg };
+
+    __atomic_add_fetch(&s->pending, 1, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&s->queued, 1, __ATOMIC_SEQ_CST);
+    if (!push(&s->workers[i], j)) {
+        __atomic_sub_fetch(&s->queued, 1, __ATOMIC_SEQ_CST);
+        __atomic_sub_fetch(&s->pending, 1, __ATOMIC_SEQ_CST);
+        return 0;
+    }
+    if (__atomic_load_n(&s->sleepers, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&s->lock);
+        pthread_cond_signal(&s->wake);
+        pthread_mutex_unlock(&s->lock);
+    }
+    return 1;
+}
+
+void pqc_sched_wait(pqc_sched *s) {
+    pthread_mutex_lock(&s->lock);
+    while (__atomic_load_n(&s->pending, __ATOMIC_SEQ_CST))
+        pthread_cond_wait(&s->done, &s->lock);
+    pthread_mutex_unlock(&s->lock);
+}
+
+static const char *pin_names[] = { "none", "core", "node" };
+
+int pqc_sched_parse_pin(const char *name, pqc_pin_mode *mode) {
+    for (int i = 0; i < 3; i++) {
+        if (strcmp(name, pin_names[i]) == 0) {
+            *mode = (pqc_pin_mode)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+const char *pqc_sched_pin_name(pqc_pin_mode mode) {
+    return (unsigned)mode < 3 ? pin_names[mode] : "?";
+}
+
+unsigned pqc_sched_workers(const pqc_sched *s) {
+    return s->n;
+}
+
+unsigned pqc_sched_nodes(const pqc_sched *s) {
+    return s->nnodes;
+}
+
+void pqc_sched_get_node_stats(pqc_sched *s, unsigned node, pqc_sched_node_stats *stats) {
+    memset(stats, 0, sizeof(*stats));
+    for (unsigned i = 0; i < s->n; i++) {
+        worker *wk = &s->workers[i];
+
+        if (wk->w.node != node) continue;
+        stats->workers++;
+        stats->jobs += __atomic_load_n(&wk->jobs, __ATOMIC_RELAXED);
+        stats->stolen += __atomic_load_n(&wk->stolen, __ATOMIC_RELAXED);
+        stats->remote += __atomic_load_n(&wk->remote, __ATOMIC_RELAXED);
+        stats->busy_ns += __atomic_load_n(&wk->busy_ns, __ATOMIC_RELAXED);
+    }
+}
+
+void pqc_sched_reset_stats(pqc_sched *s) {
+    for (unsigned i = 0; i < s->n; i++) {
+        worker *wk = &s->workers[i];
+
+        __atomic_store_n(&wk->jobs, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&wk->stolen, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&wk->remote, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&wk->busy_ns, 0, __ATOMIC_RELAXED);
+    }
+}
+
+void pqc_sched_report(pqc_sched *s, uint64_t elapsed_ns) {
+    printf("  %-6s %7s %9s %10s %7s %7s %6s\n", "node", "workers", "jobs", "jobs/s", "stolen", "remote", "busy");
+    for (unsigned node = 0; node < s->nnodes; node++) {
+        pqc_sched_node_stats st;
+
+        pqc_sched_get_node_stats(s, node, &st);
+        if (!st.workers) continue;
+        printf("  %-6u %7u %9llu %10.0f %6.1f%% %6.1f%% %5.0f%%\n", node, st.workers,
+               (unsigned long long)st.jobs, elapsed_ns ? st.jobs * 1e9 / elapsed_ns : 0.0,
+               st.jobs ? 100.0 * st.stolen / st.jobs : 0.0,
+               st.jobs ? 100.0 * st.remote / st.jobs : 0.0,
+               elapsed_ns ? 100.0 * st.busy_ns / ((double)elapsed_ns * st.workers) : 0.0);
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef PQC_SCHED_H
+#define PQC_SCHED_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Work-stealing scheduler with CPU and NUMA-node affinity.
+ *
+ * Each worker thread is pinned to one CPU (PQC_PIN_CORE) or to the CPUs of
+ * one NUMA node (PQC_PIN_NODE), and owns a deque of jobs. Submitted jobs are
+ * spread over the deques; a worker pops from its own deque and, when that
+ * is empty, steals from the other end of another worker's, trying workers on
+ * its own node before remote ones. Workers spread evenly over the nodes.
+ *
+ * Per-worker state: the init callback runs on each worker thread after it
+ * has been pinned, before any job, and its result is the worker's `local`.
+ * Memory the callback allocates and writes (a copy of the secret key, an
+ * arena, per-thread library handles) is placed on the worker's node by
+ * Linux's first-touch policy. fini runs on the same thread at shutdown.
+ *
+ * Topology comes from /sys/devices/system/node and the process's CPU
+ * affinity mask. Elsewhere, or with PQC_PIN_NONE, workers are not pinned
+ * and everything is reported as node 0.
+ *
+ * pqc_sched_submit() and the stats calls may be used from any thread,
+ * including jobs; pqc_sched_free() must not be called from a job.
+ */
+
+#define PQC_SCHED_MAX_NODES 16
+
+typedef enum { PQC_PIN_NONE, PQC_PIN_CORE, PQC_PIN_NODE } pqc_pin_mode;
+
+typedef struct {
+    unsigned id;        /* 0 .. workers - 1 */
+    int cpu;            /* pinned CPU, -1 if not pinned to one */
+    unsigned node;
+    void *local;        /* from the init callback */
+} pqc_worker;
+
+typedef void (*pqc_job_fn)(pqc_worker *w, void *arg);
+
+typedef struct {
+    unsigned workers;                   /* 0: one per CPU in the affinity mask */
+    pqc_pin_mode pin;
+    void *(*init)(pqc_worker *w, void *arg);    /* may be NULL; NULL result fails startup */
+    void (*fini)(pqc_worker *w, void *arg);
+    void *arg;
+} pqc_sched_config;
+
+typedef struct pqc_sched pqc_sched;
+
+/* Starts the workers; NULL if a thread or its init callback failed. */
+pqc_sched *pqc_sched_new(const pqc_sched_config *cfg);
+
+/* Runs the jobs still queued, then stops and joins the workers. */
+void pqc_sched_free(pqc_sched *s);
+
+/* Queues fn(w, arg) to run once on some worker. Returns 1, or 0 on allocation failure. */
+int pqc_sched_submit(pqc_sched *s, pqc_job_fn fn, void *arg);
+
+/* Blocks until every job submitted so far has finished. */
+void pqc_sched_wait(pqc_sched *s);
+
+/* "none", "core" or "node"; 1 if name is one of them. */
+int pqc_sched_parse_pin(const char *name, pqc_pin_mode *mode);
+const char *pqc_sched_pin_name(pqc_pin_mode mode);
+
+unsigned pqc_sched_workers(const pqc_sched *s);
+unsigned pqc_sched_nodes(const pqc_sched *s);
+
+typedef struct {
+    unsigned workers;
+    uint64_t jobs;          /* jobs run by this node's workers */
+    uint64_t stolen;        /* of those, taken from another worker's deque */
+    uint64_t remote;        /* of those, stolen from another node */
+    uint64_t busy_ns;       /* summed time inside jobs */
+} pqc_sched_node_stats;
+
+/* Counters for one node since the scheduler started (or the last reset). */
+void pqc_sched_get_node_stats(pqc_sched *s, unsigned node, pqc_sched_node_stats *stats);
+void pqc_sched_reset_stats(pqc_sched *s);
+
+/* Prints one line per node: workers, jobs, jobs/s over elapsed_ns, steals. */
+void pqc_sched_report(pqc_sched *s, uint64_t elapsed_ns);
+
+#endif /* PQC_SCHED_H */
@@ -0,0 +1,45 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "pqc_timer.h"
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+void pqc_sort_u64(uint64_t *v, size_t n) {
+    qsort(v, n, sizeof(uint64_t), cmp_u64);
+}
+
+uint64_t pqc_percentile(const uint64_t *sorted, size_t n, double p) {
+    if (n == 0) return 0;
+    /* Nearest-rank: the smallest sample with at least p% of samples <= it */
+    size_t rank = (size_t)((p / 100.0) * (double)n + 0.999999);
+    if (rank == 0) rank = 1;
+    if (rank > n) rank = n;
+    return sorted[rank - 1];
+}
+
+void pqc_stats_compute(pqc_stats *out, uint64_t *ns, uint64_t *cycles,
+                       size_t n, uint64_t total_ns) {
+    memset(out, 0, sizeof(*out));
+    out->samples = n;
+    if (n == 0) return;
+
+    pqc_sort_u64(ns, n);
+    if (cycles) pqc_sort_u64(cycles, n);
+
+    double sum = 0;
+    for (size_t i = 0; i < n; i++) sum += (double)ns[i];
+
+    out->min_ns = ns[0];
+    out->max_ns = ns[n - 1];
+    out->median_ns = pqc_percentile(ns, n, 50.0);
+    out->p99_ns = pqc_percentile(ns, n, 99.0);
+    out->mean_ns = sum / (double)n;
+    out->median_cycles = cycles ? pqc_percentile(cycles, n, 50.0) : 0;
+    out->ops_per_sec = total_ns ? (double)n * 1e9 / (double)total_ns : 0.0;
+}
@@ -0,0 +1,64 @@
+#ifndef PQC_TIMER_H
+#define PQC_TIMER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*
+ * Timing helpers shared by the benchmark tools.
+ *
+ * pqc_cycles() reads the cycle counter where one is available (rdtsc on x86,
+ * cntvct_el0 on arm64) and falls back to nanoseconds elsewhere. On x86 the
+ * TSC ticks at a constant reference rate, so "cycles" are reference cycles,
+ * not core cycles under turbo.
+ */
+
+static inline uint64_t pqc_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint64_t pqc_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint64_t)__rdtsc();
+#elif defined(__aarch64__)
+    uint64_t v;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return pqc_now_ns();
+#endif
+}
+
+/* Summary of one benchmarked operation. Latencies are in nanoseconds. */
+typedef struct {
+    size_t   samples;
+    double   ops_per_sec;
+    uint64_t min_ns;
+    uint64_t median_ns;
+    uint64_t p99_ns;
+    uint64_t max_ns;
+    double   mean_ns;
+    uint64_t median_cycles;
+} pqc_stats;
+
+/*
+ * Sorts both sample arrays in place and fills *out. cycles may be NULL.
+ * total_ns is the wall time of the whole loop and is used for ops/sec.
+ */
+void pqc_stats_compute(pqc_stats *out, uint64_t *ns, uint64_t *cycles,
+                       size_t n, uint64_t total_ns);
+
+/* Sorts n samples in ascending order, for pqc_percentile(). */
+void pqc_sort_u64(uint64_t *v, size_t n);
+
+/* Returns the p-th percentile (0..100) of an already sorted array. */
+uint64_t pqc_percentile(const uint64_t *sorted, size_t n, double p);
+
+#endif /* PQC_TIMER_H */
@@ -0,0 +1,266 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include <openssl/evp.h>
+#include <openssl/err.h>
+#include <openssl/crypto.h>
+
+#include "pqc_verify_cache.h"
+#include "pqc_timer.h"
+
+#define DEFAULT_SHARDS 16
+#define NIL ((size_t)-1)
+
+typedef struct {
+    uint8_t key[PQC_VERIFY_KEY_LEN];
+    uint64_t expires_ns;                /* 0: never */
+    size_t prev, next;                  /* LRU list, most recent first */
+    size_t chain;                       /* next entry in the bucket, or on the free list */
+} vc_entry;
+
+/*
+ * One independently locked LRU table. Shards are allocated side by side, so
+ * the padding keeps each shard's lock and counters off its neighbours'
+ * cache lines.
+ */
+typedef struct {
+    CRYPTO_RWLOCK *lock;
+    vc_entry *entries;
+    size_t capacity, used;
+    size_t *buckets;                    /* first entry of each chain, or NIL */
+    size_t mask;
+    size_t head, tail;                  /* most and least recently used */
+    size_t free_list;                   /* entries removed on expiry */
+    size_t count;
+    uint64_t hits, misses, inserts, evictions, expirations;
+    unsigned char pad[64];
+} vc_shard;
+
+struct pqc_verify_cache {
+    EVP_MD *sha3;
+    vc_shard *shards;
+    size_t nshards;
+    uint64_t ttl_ns;
+};
+
+static int shard_init(vc_shard *s, size_t capacity) {
+    size_t nbuckets = 1;
+
+    while (nbuckets < 2 * capacity) nbuckets <<= 1;
+    s->capacity = capacity;
+    s->mask = nbuckets - 1;
+    s->head = s->tail = s->free_list = NIL;
+    s->lock = CRYPTO_THREAD_lock_new();
+    s->entries = OPENSSL_zalloc(capacity * sizeof(*s->entries));
+    s->buckets = OPENSSL_malloc(nbuckets * sizeof(*s->buckets));
+    if (!s->lock || !s->entries || !s->buckets) return 0;
+    for (size_t i = 0; i < nbuckets; i++) s->buckets[i] = NIL;
+    return 1;
+}
+
+pqc_verify_cache *pqc_verify_cache_new(size_t capacity, size_t shards, uint64_t ttl_ms) {
+    pqc_verify_cache *c;
+    size_t n = 1;
+
+    if (capacity == 0) return NULL;
+    if (shards == 0) shards = DEFAULT_SHARDS;
+    while (n < shards && 2 * n <= capacity) n <<= 1;   /* every shard gets an entry */
+
+    if (!(c = OPENSSL_zalloc(sizeof(*c)))) return NULL;
+    c->nshards = n;
+    c->ttl_ns = ttl_ms * 1000000ull;
+    c->sha3 = EVP_MD_fetch(NULL, "SHA3-256", NULL);
+    c->shards = OPENSSL_zalloc(n * sizeof(*c->shards));
+    if (!c->sha3 || !c->shards) goto err;
+    /* The remainder goes one entry each to the first shards: exactly capacity in all */
+    for (size_t i = 0; i < n; i++)
+        if (!shard_init(&c->shards[i], capacity / n + (i < capacity % n))) goto err;
+    return c;
+
+err:
+    pqc_verify_cache_free(c);
+    return NULL;
+}
+
+void pqc_verify_cache_free(pqc_verify_cache *c) {
+    if (!c) return;
+    for (size_t i = 0; c->shards && i < c->nshards; i++) {
+        CRYPTO_THREAD_lock_free(c->shards[i].lock);
+        OPENSSL_free(c->shards[i].entries);
+        OPENSSL_free(c->shards[i].buckets);
+    }
+    OPENSSL_free(c->shards);
+    EVP_MD_free(c->sha3);
+    OPENSSL_free(c);
+}
+
+static int hash_field(EVP_MD_CTX *ctx, const void *data, size_t len) {
+    uint8_t prefix[8];
+
+    for (int i = 7; i >= 0; i--) prefix[7 - i] = (uint8_t)((uint64_t)len >> (8 * i));
+    return EVP_DigestUpdate(ctx, prefix, sizeof(prefix)) > 0
+        && EVP_DigestUpdate(ctx, data, len) > 0;
+}
+
+int pqc_verify_cache_key(const pqc_verify_cache *c, uint8_t key[PQC_VERIFY_KEY_LEN],
+                         const char *alg, const uint8_t *pk, size_t pk_len,
+                         const uint8_t *msg, size_t msg_len,
+                         const uint8_t *sig, size_t sig_len) {
+    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+    int ok;
+
+    /* Length-prefixed, so no two distinct tuples hash the same input */
+    ok = ctx
+        && EVP_DigestInit_ex(ctx, c->sha3, NULL) > 0
+        && hash_field(ctx, alg, strlen(alg))
+        && hash_field(ctx, pk, pk_len)
+        && hash_field(ctx, msg, msg_len)
+        && hash_field(ctx, sig, sig_len)
+        && EVP_DigestFinal_ex(ctx, key, NULL) > 0;
+    if (!ok) ERR_print_errors_fp(stderr);
+    EVP_MD_CTX_free(ctx);
+    return ok;
+}
+
+/* The key is a hash: its first bytes pick the shard, the next the bucket */
+static vc_shard *shard_of(const pqc_verify_cache *c, const uint8_t *key) {
+    uint64_t h;
+
+    memcpy(&h, key, sizeof(h));
+    return &c->shards[h & (c->nshards - 1)];
+}
+
+static size_t bucket_of(const vc_shard *s, const uint8_t *key) {
+    uint64_t h;
+
+    memcpy(&h, key + 8, sizeof(h));
+    return (size_t)h & s->mask;
+}
+
+static void lru_unlink(vc_shard *s, size_t i) {
+    vc_entry *e = &s->entries[i];
+
+    if (e->prev != NIL) s->entries[e->prev].next = e->next;
+    else s->head = e->next;
+    if (e->next != NIL) s->entries[e->next].prev = e->prev;
+    else s->tail = e->prev;
+}
+
+static void lru_push_front(vc_shard *s, size_t i) {
+    vc_entry *e = &s->entries[i];
+
+    e->prev = NIL;
+    e->next = s->head;
+    if (s->head != NIL) s->entries[s->head].prev = i;
+    s->head = i;
+    if (s->tail == NIL) s->tail = i;
+}
+
+static void chain_remove(vc_shard *s, size_t i) {
+    size_t *link = &s->buckets[bucket_of(s, s->entries[i].key)];
+
+    while (*link != i) link = &s->entries[*link].chain;
+    *link = s->entries[i].chain;
+}
+
+static void entry_remove(vc_shard *s, size_t i) {
+    lru_unlink(s, i);
+    chain_remove(s, i);
+    s->count--;
+}
+
+static size_t find(const vc_shard *s, const uint8_t *key) {
+    size_t i;
+
+    for (i = s->buckets[bucket_of(s, key)]; i != NIL; i = s->entries[i].chain)
+        if (memcmp(s->entries[i].key, key, PQC_VERIFY_KEY_LEN) == 0) break;
+    return i;
+}
+
+int pqc_verify_cache_lookup(pqc_verify_cache *c, const uint8_t key[PQC_VERIFY_KEY_LEN]) {
+    vc_shard *s = shard_of(c, key);
+    size_t i;
+    int hit = 0;
+
+    if (!CRYPTO_THREAD_write_lock(s->lock)) return 0;
+    if ((i = find(s, key)) != NIL) {
+        vc_entry *e = &s->entries[i];
+
+        if (e->expires_ns && pqc_now_ns() >= e->expires_ns) {
+            entry_remove(s, i);
+            e->chain = s->free_list;
+            s->free_list = i;
+            s->expirations++;
+        } else {
+            if (s->head != i) {
+                lru_unlink(s, i);
+                lru_push_front(s, i);
+            }
+            hit = 1;
+        }
+    }
+    if (hit) s->hits++;
+    else s->misses++;
+    CRYPTO_THREAD_unlock(s->lock);
+    return hit;
+}
+
+int pqc_verify_cache_insert(pqc_verify_cache *c, const uint8_t key[PQC_VERIFY_KEY_LEN]) {
+    vc_shard *s = shard_of(c, key);
+    uint64_t expires = c->ttl_ns ? pqc_now_ns() + c->ttl_ns : 0;
+    size_t i, b;
+
+    if (!CRYPTO_THREAD_write_lock(s->lock)) return 1;
+
+    /* Another thread may have verified the same tuple meanwhile */
+    if ((i = find(s, key)) != NIL) {
+        s->entries[i].expires_ns = expires;
+        if (s->head != i) {
+            lru_unlink(s, i);
+            lru_push_front(s, i);
+        }
+        CRYPTO_THREAD_unlock(s->lock);
+        return 1;
+    }
+
+    if (s->free_list != NIL) {
+        i = s->free_list;
+        s->free_list = s->entries[i].chain;
+    } else if (s->used < s->capacity) {
+        i = s->used++;
+    } else {
+        i = s->tail;
+        entry_remove(s, i);
+        s->evictions++;
+    }
+
+    b = bucket_of(s, key);
+    memcpy(s->entries[i].key, key, PQC_VERIFY_KEY_LEN);
+    s->entries[i].expires_ns = expires;
+    s->entries[i].chain = s->buckets[b];
+    s->buckets[b] = i;
+    lru_push_front(s, i);
+    s->count++;
+    s->inserts++;
+    CRYPTO_THREAD_unlock(s->lock);
+    return 1;
+}
+
+void pqc_verify_cache_get_stats(pqc_verify_cache *c, pqc_verify_cache_stats *stats) {
+    memset(stats, 0, sizeof(*stats));
+    for (size_t i = 0; i < c->nshards; i++) {
+        vc_shard *s = &c->shards[i];
+
+        if (!CRYPTO_THREAD_read_lock(s->lock)) continue;
+        stats->hits += s->hits;
+        stats->misses += s->misses;
+        stats->inserts += s->inserts;
+        stats->evictions += s->evictions;
+        stats->expirations += s->expirations;
+        stats->entries += s->count;
+        CRYPTO_THREAD_unlock(s->lock);
+    }
+}
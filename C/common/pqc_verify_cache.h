@@ -0,0 +1,65 @@
+#ifndef PQC_VERIFY_CACHE_H
+#define PQC_VERIFY_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Cache of signatures that have already verified.
+ *
+ * Certificate chains, package manifests and the like present the same
+ * (public key, message, signature) tuples again and again, and an SLH-DSA
+ * verification costs thousands of hashes each time. The cache remembers
+ * tuples that verified, keyed by a SHA3-256 hash over the algorithm name,
+ * public key, message and signature, so a repeat costs one hash of the
+ * tuple and a table lookup:
+ *
+ *     pqc_verify_cache_key(c, key, alg, pk, pk_len, msg, msg_len, sig, sig_len);
+ *     ok = pqc_verify_cache_lookup(c, key)
+ *          || (OQS_SIG_verify(...) == OQS_SUCCESS && pqc_verify_cache_insert(c, key));
+ *
+ * Only successful verifications are cached; a failure is recomputed every
+ * time. Entries expire ttl_ms after they were inserted, and each shard
+ * drops its least recently used entry when full. The table is split into
+ * independently locked shards, picked by the key, so threads looking up
+ * different tuples rarely contend. All functions are thread-safe except
+ * pqc_verify_cache_free().
+ */
+
+#define PQC_VERIFY_KEY_LEN 32
+
+typedef struct pqc_verify_cache pqc_verify_cache;
+
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t inserts;
+    uint64_t evictions;     /* dropped to make room */
+    uint64_t expirations;   /* found past their TTL */
+    size_t entries;
+} pqc_verify_cache_stats;
+
+/*
+ * Exactly capacity entries in total, split over shards (rounded up to a
+ * power of two, at most capacity; 0 picks a default). ttl_ms 0 means
+ * entries never expire.
+ */
+pqc_verify_cache *pqc_verify_cache_new(size_t capacity, size_t shards, uint64_t ttl_ms);
+void pqc_verify_cache_free(pqc_verify_cache *c);
+
+/* Cache key of one verification. Returns 1, or 0 if hashing failed. */
+int pqc_verify_cache_key(const pqc_verify_cache *c, uint8_t key[PQC_VERIFY_KEY_LEN],
+                         const char *alg, const uint8_t *pk, size_t pk_len,
+                         const uint8_t *msg, size_t msg_len,
+                         const uint8_t *sig, size_t sig_len);
+
+/* 1 if key verified before and has not expired. */
+int pqc_verify_cache_lookup(pqc_verify_cache *c, const uint8_t key[PQC_VERIFY_KEY_LEN]);
+
+/* Records a successful verification; refreshes the TTL if already present. Returns 1. */
+int pqc_verify_cache_insert(pqc_verify_cache *c, const uint8_t key[PQC_VERIFY_KEY_LEN]);
+
+/* Counters summed over all shards. */
+void pqc_verify_cache_get_stats(pqc_verify_cache *c, pqc_verify_cache_stats *stats);
+
+#endif /* PQC_VERIFY_CACHE_H */
@@ -0,0 +1,244 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <openssl/err.h>
+#include <openssl/rand.h>
+
+#include "ct_check.h"
+#include "pqc_metrics.h"
+#include "pqc_timer.h"
+
+/*
+ * dudect-style timing-leak check (Reparaz, Balasch, Verbauwhede, "Dude, is
+ * my code constant time?", 2017) over the targets in ct_targets.c.
+ *
+ * Measurements alternate between a fixed and a random input class in a
+ * random order. Cycle counts go into Welch's t-test on the raw samples and
+ * on samples cropped at several upper percentiles, which strips the long
+ * tail of interrupts and cache misses; the largest |t| is reported. A |t|
+ * above 4.5 is a likely leak and above 10 a definite one. The first batch
+ * only sets the crop thresholds and is not tested.
+ *
+ * A clean result means no leak was found at this sample size, not that
+ * there is none; run longer (-x) and on an idle machine before trusting it.
+ * The memcmp target is a control that the harness is expected to flag.
+ */
+
+#define CROPS       16
+#define TESTS       (1 + CROPS)
+#define BATCH       10000
+#define T_POSSIBLE  4.5
+#define T_LEAK      10.0
+#define MIN_CLASS_N 50        /* per class, for a test to count */
+
+typedef struct {
+    double n[2], mean[2], m2[2];
+} welch;
+
+static void welch_add(welch *w, int cls, double x) {
+    double d = x - w->mean[cls];
+    w->n[cls] += 1;
+    w->mean[cls] += d / w->n[cls];
+    w->m2[cls] += d * (x - w->mean[cls]);
+}
+
+static double welch_t(const welch *w) {
+    if (w->n[0] < MIN_CLASS_N || w->n[1] < MIN_CLASS_N) return 0;
+    double v0 = w->m2[0] / (w->n[0] - 1), v1 = w->m2[1] / (w->n[1] - 1);
+    double se = sqrt(v0 / w->n[0] + v1 / w->n[1]);
+    return se > 0 ? (w->mean[0] - w->mean[1]) / se : 0;
+}
+
+static void handle_openssl_error(const char *msg) {
+    fprintf(stderr, "ERROR: %s\n", msg);
+    ERR_print_errors_fp(stderr);
+}
+
+typedef struct {
+    double max_t;
+    double mean_cycles[2];
+    size_t measured;
+} ct_result;
+
+/* Times one batch; classes and inputs are drawn before the clock starts. The
+ * nanosecond reads, for the metrics, sit outside the cycle count. */
+static int measure_batch(const ct_target *t, void *state, size_t n, uint8_t *inputs,
+                         uint8_t *classes, uint64_t *cycles, uint64_t *ns) {
+    if (RAND_bytes(classes, (int)n) <= 0) {
+        handle_openssl_error("RAND_bytes failed");
+        return 0;
+    }
+    for (size_t i = 0; i < n; i++) {
+        classes[i] &= 1;
+        t->prepare(state, inputs + i * t->in_len, classes[i]);
+    }
+    for (size_t i = 0; i < n; i++) {
+        uint64_t n0 = pqc_now_ns(), t0 = pqc_cycles();
+        int ok = t->run(state, inputs + i * t->in_len);
+        cycles[i] = pqc_cycles() - t0;
+        ns[i] = pqc_now_ns() - n0;
+        if (!ok) {
+            printf("❌ %s failed during measurement\n", t->name);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* hist, if not NULL, gets the latency of every measurement after the warm-up */
+static int check_target(const ct_target *t, void *state, size_t total, ct_result *res,
+                        pqc_hist *hist) {
+    size_t batch = total / 10 < BATCH ? (total / 10 ? total / 10 : 1) : BATCH;
+    uint8_t *inputs = malloc(batch * t->in_len), *classes = malloc(batch);
+    uint64_t *cycles = malloc(batch * sizeof(uint64_t)), *sorted = malloc(batch * sizeof(uint64_t));
+    uint64_t *ns = malloc(batch * sizeof(uint64_t));
+    uint64_t crop[CROPS];
+    welch w[TESTS];
+    int ok = 0;
+
+    memset(w, 0, sizeof(w));
+    memset(res, 0, sizeof(*res));
+    if (!inputs || !classes || !cycles || !sorted || !ns) goto done;
+
+    /* Warm-up batch: caches, branch predictors, and the crop thresholds */
+    if (!measure_batch(t, state, batch, inputs, classes, cycles, ns)) goto done;
+    memcpy(sorted, cycles, batch * sizeof(uint64_t));
+    pqc_sort_u64(sorted, batch);
+    for (int c = 0; c < CROPS; c++)
+        crop[c] = pqc_percentile(sorted, batch,
+                                 100.0 * (1.0 - pow(0.5, 10.0 * (c + 1) / CROPS)));
+
+    while (res->measured < total) {
+        size_t n = total - res->measured < batch ? total - res->measured : batch;
+        if (!measure_batch(t, state, n, inputs, classes, cycles, ns)) goto done;
+        for (size_t i = 0; i < n; i++) {
+            double x = (double)cycles[i];
+            welch_add(&w[0], classes[i], x);
+            for (int c = 0; c < CROPS; c++)
+                if (cycles[i] < crop[c]) welch_add(&w[1 + c], classes[i], x);
+            if (hist) pqc_hist_record(hist, ns[i]);
+        }
+        res->measured += n;
+    }
+
+    for (int k = 0; k < TESTS; k++) {
+        double tv = fabs(welch_t(&w[k]));
+        if (tv > res->max_t) res->max_t = tv;
+    }
+    res->mean_cycles[0] = w[0].mean[0];
+    res->mean_cycles[1] = w[0].mean[1];
+    ok = 1;
+
+done:
+    free(inputs);
+    free(classes);
+    free(cycles);
+    free(sorted);
+    free(ns);
+    return ok;
+}
+
+/* With PQC_METRICS set, one record per target over both input classes */
+static void emit_target(const ct_target *t, const pqc_hist *hist) {
+    pqc_metrics_sizes sizes = { 0, 0, 0, 0, 0 };
+    const char *op = strcmp(t->family, "KEM") == 0 ? "decaps"
+                   : strcmp(t->family, "signature") == 0 ? "sign" : "compare";
+
+    if (strcmp(t->family, "KEM") == 0) sizes.ct = t->in_len;
+    pqc_metrics_emit(t->alg, op, t->name, hist, 0, &sizes);
+}
+
+static void usage(const char *prog) {
+    printf("Usage: %s [-l] [-f filter] [-x scale] [-n measurements]\n", prog);
+    printf("  -l  list targets\n");
+    printf("  -f  only targets whose name contains filter (e.g. KEM, ML-DSA, memcmp)\n");
+    printf("  -x  multiply every target's default measurement count (default 1)\n");
+    printf("  -n  use this many measurements for every target\n");
+}
+
+int main(int argc, char *argv[]) {
+    const char *filter = NULL;
+    double scale = 1.0;
+    size_t fixed_n = 0;
+    int list = 0, leaks = 0, warnings = 0, missed_controls = 0;
+    pqc_hist *hist = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-l") == 0) list = 1;
+        else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) filter = argv[++i];
+        else if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) scale = atof(argv[++i]);
+        else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) fixed_n = strtoul(argv[++i], NULL, 10);
+        else { usage(argv[0]); return 1; }
+    }
+    if (scale <= 0) scale = 1.0;
+
+    if (list) {
+        for (size_t i = 0; i < ct_n_targets; i++)
+            printf("  %-10s %-42s %9zu\n", ct_targets[i].family, ct_targets[i].name,
+                   ct_targets[i].default_n);
+        return 0;
+    }
+
+    if (pqc_metrics_init("ct_check") && !(hist = pqc_hist_new())) return 1;
+
+    printf("🎯 Constant-Time Check (dudect)\n");
+    printf("===============================\n");
+    printf("fixed vs random inputs, Welch's t over %d percentile crops; |t| > %.1f flags a leak\n\n",
+           CROPS, T_POSSIBLE);
+    printf("  %-42s %10s %12s %12s %8s\n", "target", "samples", "fixed cyc", "random cyc", "max |t|");
+
+    for (size_t i = 0; i < ct_n_targets; i++) {
+        const ct_target *t = &ct_targets[i];
+        size_t n = fixed_n ? fixed_n : (size_t)((double)t->default_n * scale);
+        const char *verdict;
+        ct_result res;
+        void *state;
+
+        if (filter && !strstr(t->name, filter) && !strstr(t->family, filter)) continue;
+        if (n < 4 * MIN_CLASS_N) n = 4 * MIN_CLASS_N;
+
+        state = t->setup(t);
+        if (!state) {
+            ERR_clear_error();
+            printf("  %-42s %10s\n", t->name, "skipped (unavailable)");
+            continue;
+        }
+        if (hist) pqc_hist_reset(hist);
+        int ok = check_target(t, state, n, &res, hist);
+        t->teardown(state);
+        if (!ok) {
+            pqc_hist_free(hist);
+            return 1;
+        }
+        if (hist) emit_target(t, hist);
+
+        if (res.max_t > T_LEAK) verdict = t->expect_leak ? "✅ leak found (control)" : "❌ leak";
+        else if (res.max_t > T_POSSIBLE) verdict = t->expect_leak ? "✅ leak found (control)" : "⚠️  possible leak";
+        else verdict = t->expect_leak ? "⚠️  control not flagged" : "✅";
+
+        if (t->expect_leak) missed_controls += res.max_t <= T_POSSIBLE;
+        else if (res.max_t > T_LEAK) leaks++;
+        else if (res.max_t > T_POSSIBLE) warnings++;
+
+        printf("  %-42s %10zu %12.0f %12.0f %8.2f  %s\n", t->name, res.measured,
+               res.mean_cycles[0], res.mean_cycles[1], res.max_t, verdict);
+        fflush(stdout);
+    }
+
+    printf("\n");
+    if (missed_controls)
+        printf("⚠️  The memcmp control was not flagged: too few samples or too much noise\n");
+    if (leaks || warnings)
+        printf("%s %d leak(s), %d possible leak(s); re-run the flagged targets with -x 10 on an idle machine\n",
+               leaks ? "❌" : "⚠️ ", leaks, warnings);
+    else
+        printf("✅ No timing differences found at this sample size\n");
+
+    printf("\n✨ Check completed!\n");
+    pqc_hist_free(hist);
+    return leaks ? 2 : 0;
+}
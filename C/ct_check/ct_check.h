@@ -0,0 +1,34 @@
+#ifndef CT_CHECK_H
+#define CT_CHECK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Targets for the dudect-style timing-leak harness.
+ *
+ * Each target is one secret-handling operation. The harness asks it for
+ * inputs of two classes, fixed (0) and random (1), in a random interleaving,
+ * times run() on each, and tests whether the two timing distributions
+ * differ. prepare() is not timed.
+ */
+typedef struct ct_target {
+    const char *name;
+    const char *family;         /* "compare", "KEM" or "signature" */
+    const char *alg;            /* argument for setup(); the metrics' algorithm */
+    size_t in_len;              /* input bytes per measurement */
+    size_t default_n;           /* measurements at the default scale */
+    int expect_leak;            /* control target the harness must flag */
+
+    /* NULL if the algorithm is unavailable; the target is then skipped */
+    void *(*setup)(const struct ct_target *t);
+    void (*prepare)(void *state, uint8_t *in, int cls);
+    /* The timed operation; 0 on failure */
+    int (*run)(void *state, const uint8_t *in);
+    void (*teardown)(void *state);
+} ct_target;
+
+extern const ct_target ct_targets[];
+extern const size_t ct_n_targets;
+
+#endif /* CT_CHECK_H */
@@ -0,0 +1,543 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include <openssl/evp.h>
+#include <openssl/err.h>
+#include <openssl/rand.h>
+#include <openssl/crypto.h>
+#include <openssl/core_names.h>
+
+#ifdef PQC_CT_WITH_OQS
+#include "oqs/oqs.h"
+#endif
+
+#include "ct_check.h"
+#include "mlkem_engine.h"
+#include "hybrid_kem.h"
+#include "slh_dsa_par.h"
+#include "mldsa_expanded.h"
+#include "pqc_stream_sign.h"
+
+/*
+ * Every KEM decapsulation and signing path in the tree, plus the secret
+ * comparisons. KEM targets compare a fixed valid ciphertext against random
+ * bytes, which take the implicit-rejection path. Signature targets compare a
+ * fixed key and message against one of several other keys and a random
+ * message; the input is the key index followed by the message.
+ */
+
+#define SIG_KEYS 8
+#define MSG_LEN  32
+
+/* The FO re-encryption check in ML-KEM-768 compares this much */
+#define CMP_LEN  1088
+
+static void random_bytes(uint8_t *buf, size_t len) {
+    if (RAND_bytes(buf, (int)len) <= 0) memset(buf, 0xA5, len);
+}
+
+static void prepare_sig_input(uint8_t *in, int cls, const uint8_t *fixed_msg) {
+    if (cls == 0) {
+        in[0] = 0;
+        memcpy(in + 1, fixed_msg, MSG_LEN);
+    } else {
+        random_bytes(in, 1 + MSG_LEN);
+        in[0] = (uint8_t)(1 + in[0] % (SIG_KEYS - 1));
+    }
+}
+
+/* ---- Comparisons ---- */
+
+typedef int (*cmp_fn)(const void *a, const void *b, size_t len);
+
+typedef struct {
+    cmp_fn cmp;
+    uint8_t ref[CMP_LEN];
+    volatile int sink;
+} cmp_state;
+
+static int libc_memcmp(const void *a, const void *b, size_t len) {
+    return memcmp(a, b, len);
+}
+
+static int openssl_memcmp(const void *a, const void *b, size_t len) {
+    return CRYPTO_memcmp(a, b, len);
+}
+
+#ifdef PQC_CT_WITH_OQS
+static int oqs_bcmp(const void *a, const void *b, size_t len) {
+    return OQS_MEM_secure_bcmp(a, b, len);
+}
+#endif
+
+static void *cmp_setup(const ct_target *t) {
+    cmp_state *s = calloc(1, sizeof(*s));
+
+    if (!s) return NULL;
+    if (strcmp(t->alg, "memcmp") == 0) s->cmp = libc_memcmp;
+    else if (strcmp(t->alg, "CRYPTO_memcmp") == 0) s->cmp = openssl_memcmp;
+#ifdef PQC_CT_WITH_OQS
+    else if (strcmp(t->alg, "OQS_MEM_secure_bcmp") == 0) s->cmp = oqs_bcmp;
+#endif
+    else {
+        free(s);
+        return NULL;
+    }
+    random_bytes(s->ref, CMP_LEN);
+    return s;
+}
+
+/* Fixed: equal to the reference, so every byte is compared. Random: differs early. */
+static void cmp_prepare(void *state, uint8_t *in, int cls) {
+    cmp_state *s = state;
+    if (cls == 0) memcpy(in, s->ref, CMP_LEN);
+    else random_bytes(in, CMP_LEN);
+}
+
+static int cmp_run(void *state, const uint8_t *in) {
+    cmp_state *s = state;
+    s->sink = s->cmp(s->ref, in, CMP_LEN);
+    return 1;
+}
+
+static void cmp_teardown(void *state) {
+    free(state);
+}
+
+/* ---- ML-KEM through mlkem_engine ---- */
+
+typedef struct {
+    mlkem_engine *engine;
+    size_t ct_len;
+    uint8_t *fixed_ct;
+    uint8_t ss[64];
+} kem_state;
+
+static void kem_teardown(void *state) {
+    kem_state *s = state;
+    if (!s) return;
+    mlkem_engine_free(s->engine);
+    OPENSSL_free(s->fixed_ct);
+    OPENSSL_cleanse(s->ss, sizeof(s->ss));
+    free(s);
+}
+
+static void *kem_setup(const ct_target *t) {
+    kem_state *s = calloc(1, sizeof(*s));
+    EVP_PKEY *pkey = EVP_PKEY_Q_keygen(NULL, NULL, t->alg);
+
+    if (!s || !pkey || !(s->engine = mlkem_engine_new(pkey))) goto err;
+    s->ct_len = mlkem_engine_ciphertext_len(s->engine);
+    if (s->ct_len != t->in_len || !(s->fixed_ct = OPENSSL_malloc(s->ct_len))
+        || !mlkem_engine_encapsulate(s->engine, s->fixed_ct, s->ss))
+        goto err;
+    EVP_PKEY_free(pkey);
+    return s;
+
+err:
+    EVP_PKEY_free(pkey);
+    kem_teardown(s);
+    return NULL;
+}
+
+static void kem_prepare(void *state, uint8_t *in, int cls) {
+    kem_state *s = state;
+    if (cls == 0) memcpy(in, s->fixed_ct, s->ct_len);
+    else random_bytes(in, s->ct_len);
+}
+
+static int kem_run(void *state, const uint8_t *in) {
+    kem_state *s = state;
+    return mlkem_engine_decapsulate(s->engine, s->ss, in, s->ct_len);
+}
+
+/* ---- Hybrid X25519 + ML-KEM-768 ---- */
+
+typedef struct {
+    hybrid_kem *server;
+    uint8_t fixed_ct[HYBRID_KEM_CIPHERTEXT_LEN];
+    uint8_t ss[HYBRID_KEM_SECRET_LEN];
+} hybrid_state;
+
+static void hybrid_teardown(void *state) {
+    hybrid_state *s = state;
+    if (!s) return;
+    hybrid_kem_free(s->server);
+    OPENSSL_cleanse(s->ss, sizeof(s->ss));
+    free(s);
+}
+
+static void *hybrid_setup(const ct_target *t) {
+    hybrid_state *s = calloc(1, sizeof(*s));
+    hybrid_kem *client = NULL;
+
+    (void)t;
+    if (!s || !(s->server = hybrid_kem_generate(0))
+        || !(client = hybrid_kem_new_from_public(hybrid_kem_public_key(s->server),
+                                                 HYBRID_KEM_PUBLIC_LEN, 0))
+        || !hybrid_kem_encapsulate(client, s->fixed_ct, s->ss, NULL, 0)) {
+        hybrid_kem_free(client);
+        hybrid_teardown(s);
+        return NULL;
+    }
+    hybrid_kem_free(client);
+    return s;
+}
+
+static void hybrid_prepare(void *state, uint8_t *in, int cls) {
+    hybrid_state *s = state;
+    if (cls == 0) memcpy(in, s->fixed_ct, HYBRID_KEM_CIPHERTEXT_LEN);
+    else random_bytes(in, HYBRID_KEM_CIPHERTEXT_LEN);
+}
+
+static int hybrid_run(void *state, const uint8_t *in) {
+    hybrid_state *s = state;
+    return hybrid_kem_decapsulate(s->server, s->ss, in, HYBRID_KEM_CIPHERTEXT_LEN, NULL, 0);
+}
+
+/* ---- EVP signatures (ML-DSA, SLH-DSA) and streaming ML-DSA ---- */
+
+typedef struct {
+    const char *alg;
+    EVP_PKEY *keys[SIG_KEYS];
+    EVP_PKEY_CTX *ctx[SIG_KEYS];
+    EVP_SIGNATURE *sig_alg;
+    uint8_t *sig;
+    size_t sig_max;
+    uint8_t fixed_msg[MSG_LEN];
+} evp_sig_state;
+
+static void evp_sig_teardown(void *state) {
+    evp_sig_state *s = state;
+    if (!s) return;
+    for (int i = 0; i < SIG_KEYS; i++) {
+        EVP_PKEY_CTX_free(s->ctx[i]);
+        EVP_PKEY_free(s->keys[i]);
+    }
+    EVP_SIGNATURE_free(s->sig_alg);
+    OPENSSL_free(s->sig);
+    free(s);
+}
+
+static void *evp_sig_setup(const ct_target *t) {
+    evp_sig_state *s = calloc(1, sizeof(*s));
+
+    if (!s) return NULL;
+    s->alg = t->alg;
+    s->sig_alg = EVP_SIGNATURE_fetch(NULL, t->alg, NULL);
+    if (!s->sig_alg) goto err;
+    for (int i = 0; i < SIG_KEYS; i++) {
+        s->keys[i] = EVP_PKEY_Q_keygen(NULL, NULL, t->alg);
+        s->ctx[i] = s->keys[i] ? EVP_PKEY_CTX_new_from_pkey(NULL, s->keys[i], NULL) : NULL;
+        if (!s->ctx[i]) goto err;
+    }
+    random_bytes(s->fixed_msg, MSG_LEN);
+    if (EVP_PKEY_sign_message_init(s->ctx[0], s->sig_alg, NULL) <= 0
+        || EVP_PKEY_sign(s->ctx[0], NULL, &s->sig_max, s->fixed_msg, MSG_LEN) <= 0
+        || !(s->sig = OPENSSL_malloc(s->sig_max)))
+        goto err;
+    return s;
+
+err:
+    ERR_clear_error();
+    evp_sig_teardown(s);
+    return NULL;
+}
+
+static void evp_sig_prepare(void *state, uint8_t *in, int cls) {
+    evp_sig_state *s = state;
+    prepare_sig_input(in, cls, s->fixed_msg);
+}
+
+/* Same calls per signature as pqc_bench: init, then one-shot sign */
+static int evp_sig_run(void *state, const uint8_t *in) {
+    evp_sig_state *s = state;
+    size_t sig_len = s->sig_max;
+    EVP_PKEY_CTX *ctx = s->ctx[in[0]];
+
+    return EVP_PKEY_sign_message_init(ctx, s->sig_alg, NULL) > 0
+        && EVP_PKEY_sign(ctx, s->sig, &sig_len, in + 1, MSG_LEN) > 0;
+}
+
+static int stream_sig_run(void *state, const uint8_t *in) {
+    evp_sig_state *s = state;
+    pqc_stream *st = pqc_stream_sign_init(s->keys[in[0]], s->alg, NULL, 0);
+    unsigned char *sig = NULL;
+    size_t sig_len = 0;
+    int ok = st && pqc_stream_update(st, in + 1, MSG_LEN)
+        && pqc_stream_sign_final(st, &sig, &sig_len);
+
+    OPENSSL_free(sig);
+    pqc_stream_free(st);
+    return ok;
+}
+
+/* ---- Parallel SLH-DSA (own hash kernels) ---- */
+
+typedef struct {
+    const slh_params *p;
+    uint8_t *sk[SIG_KEYS];
+    uint8_t *sig;
+    uint8_t addrnd[32];
+    uint8_t fixed_msg[MSG_LEN];
+} slh_state;
+
+static void slh_teardown(void *state) {
+    slh_state *s = state;
+    if (!s) return;
+    for (int i = 0; i < SIG_KEYS; i++) {
+        if (s->sk[i]) OPENSSL_cleanse(s->sk[i], slh_par_sk_len(s->p));
+        free(s->sk[i]);
+    }
+    free(s->sig);
+    free(s);
+}
+
+static void *slh_setup(const ct_target *t) {
+    slh_state *s = calloc(1, sizeof(*s));
+    uint8_t pk[64];
+
+    if (!s || !(s->p = slh_par_params(t->alg))) {
+        free(s);
+        return NULL;
+    }
+    s->sig = malloc(slh_par_sig_len(s->p));
+    if (!s->sig) goto err;
+    for (int i = 0; i < SIG_KEYS; i++) {
+        s->sk[i] = malloc(slh_par_sk_len(s->p));
+        if (!s->sk[i] || !slh_par_keygen(s->p, pk, s->sk[i], 1)) goto err;
+    }
+    random_bytes(s->addrnd, sizeof(s->addrnd));
+    random_bytes(s->fixed_msg, MSG_LEN);
+    return s;
+
+err:
+    slh_teardown(s);
+    return NULL;
+}
+
+static void slh_prepare(void *state, uint8_t *in, int cls) {
+    slh_state *s = state;
+    prepare_sig_input(in, cls, s->fixed_msg);
+}
+
+static int slh_run(void *state, const uint8_t *in) {
+    slh_state *s = state;
+    return slh_par_sign(s->p, s->sig, in + 1, MSG_LEN, NULL, 0, s->sk[in[0]], s->addrnd, 1);
+}
+
+/* ---- ML-DSA with expanded keys ---- */
+
+typedef struct {
+    const mldsa_params *p;
+    mldsa_expanded_key *keys[SIG_KEYS];
+    uint8_t *sig;
+    uint8_t fixed_msg[MSG_LEN];
+} mldsa_exp_state;
+
+static void mldsa_exp_teardown(void *state) {
+    mldsa_exp_state *s = state;
+    if (!s) return;
+    for (int i = 0; i < SIG_KEYS; i++) mldsa_expanded_key_free(s->keys[i]);
+    free(s->sig);
+    free(s);
+}
+
+static void *mldsa_exp_setup(const ct_target *t) {
+    mldsa_exp_state *s = calloc(1, sizeof(*s));
+    uint8_t sk[4896];                  /* ML-DSA-87, the largest */
+    size_t sk_len;
+
+    if (!s || !(s->p = mldsa_params_get(t->alg)) || !(s->sig = malloc(mldsa_sig_len(s->p))))
+        goto err;
+    for (int i = 0; i < SIG_KEYS; i++) {
+        EVP_PKEY *pkey = EVP_PKEY_Q_keygen(NULL, NULL, t->alg);
+        int ok = pkey
+            && EVP_PKEY_get_octet_string_param(pkey, OSSL_PKEY_PARAM_PRIV_KEY, sk, sizeof(sk), &sk_len)
+            && (s->keys[i] = mldsa_expanded_key_new(s->p, sk, sk_len)) != NULL;
+
+        OPENSSL_cleanse(sk, sizeof(sk));
+        EVP_PKEY_free(pkey);
+        if (!ok) goto err;
+    }
+    random_bytes(s->fixed_msg, MSG_LEN);
+    return s;
+
+err:
+    mldsa_exp_teardown(s);
+    return NULL;
+}
+
+static void mldsa_exp_prepare(void *state, uint8_t *in, int cls) {
+    mldsa_exp_state *s = state;
+    prepare_sig_input(in, cls, s->fixed_msg);
+}
+
+static int mldsa_exp_run(void *state, const uint8_t *in) {
+    mldsa_exp_state *s = state;
+    return mldsa_expanded_sign(s->keys[in[0]], s->sig, in + 1, MSG_LEN, NULL, 0, NULL);
+}
+
+/* ---- liboqs ---- */
+
+#ifdef PQC_CT_WITH_OQS
+typedef struct {
+    OQS_KEM *kem;
+    uint8_t *pk, *sk, *fixed_ct, *ss;
+} oqs_kem_state;
+
+static void oqs_kem_teardown(void *state) {
+    oqs_kem_state *s = state;
+    if (!s) return;
+    if (s->kem) {
+        if (s->sk) OQS_MEM_cleanse(s->sk, s->kem->length_secret_key);
+        if (s->ss) OQS_MEM_cleanse(s->ss, s->kem->length_shared_secret);
+    }
+    free(s->pk);
+    free(s->sk);
+    free(s->fixed_ct);
+    free(s->ss);
+    OQS_KEM_free(s->kem);
+    free(s);
+}
+
+static void *oqs_kem_setup(const ct_target *t) {
+    oqs_kem_state *s;
+
+    if (!OQS_KEM_alg_is_enabled(t->alg) || !(s = calloc(1, sizeof(*s)))) return NULL;
+    s->kem = OQS_KEM_new(t->alg);
+    if (!s->kem || s->kem->length_ciphertext != t->in_len) goto err;
+    s->pk = malloc(s->kem->length_public_key);
+    s->sk = malloc(s->kem->length_secret_key);
+    s->fixed_ct = malloc(s->kem->length_ciphertext);
+    s->ss = malloc(s->kem->length_shared_secret);
+    if (!s->pk || !s->sk || !s->fixed_ct || !s->ss
+        || OQS_KEM_keypair(s->kem, s->pk, s->sk) != OQS_SUCCESS
+        || OQS_KEM_encaps(s->kem, s->fixed_ct, s->ss, s->pk) != OQS_SUCCESS)
+        goto err;
+    return s;
+
+err:
+    oqs_kem_teardown(s);
+    return NULL;
+}
+
+static void oqs_kem_prepare(void *state, uint8_t *in, int cls) {
+    oqs_kem_state *s = state;
+    if (cls == 0) memcpy(in, s->fixed_ct, s->kem->length_ciphertext);
+    else random_bytes(in, s->kem->length_ciphertext);
+}
+
+static int oqs_kem_run(void *state, const uint8_t *in) {
+    oqs_kem_state *s = state;
+    return OQS_KEM_decaps(s->kem, s->ss, in, s->sk) == OQS_SUCCESS;
+}
+
+typedef struct {
+    OQS_SIG *sig;
+    uint8_t *sk[SIG_KEYS];
+    uint8_t *pk, *out;
+    uint8_t fixed_msg[MSG_LEN];
+} oqs_sig_state;
+
+static void oqs_sig_teardown(void *state) {
+    oqs_sig_state *s = state;
+    if (!s) return;
+    for (int i = 0; i < SIG_KEYS; i++) {
+        if (s->sk[i]) OQS_MEM_cleanse(s->sk[i], s->sig->length_secret_key);
+        free(s->sk[i]);
+    }
+    free(s->pk);
+    free(s->out);
+    OQS_SIG_free(s->sig);
+    free(s);
+}
+
+static void *oqs_sig_setup(const ct_target *t) {
+    oqs_sig_state *s;
+
+    if (!OQS_SIG_alg_is_enabled(t->alg) || !(s = calloc(1, sizeof(*s)))) return NULL;
+    s->sig = OQS_SIG_new(t->alg);
+    if (!s->sig) {
+        free(s);
+        return NULL;
+    }
+    s->pk = malloc(s->sig->length_public_key);
+    s->out = malloc(s->sig->length_signature);
+    if (!s->pk || !s->out) goto err;
+    for (int i = 0; i < SIG_KEYS; i++) {
+        s->sk[i] = malloc(s->sig->length_secret_key);
+        if (!s->sk[i] || OQS_SIG_keypair(s->sig, s->pk, s->sk[i]) != OQS_SUCCESS) goto err;
+    }
+    random_bytes(s->fixed_msg, MSG_LEN);
+    return s;
+
+err:
+    oqs_sig_teardown(s);
+    return NULL;
+}
+
+static void oqs_sig_prepare(void *state, uint8_t *in, int cls) {
+    oqs_sig_state *s = state;
+    prepare_sig_input(in, cls, s->fixed_msg);
+}
+
+static int oqs_sig_run(void *state, const uint8_t *in) {
+    oqs_sig_state *s = state;
+    size_t len;
+    return OQS_SIG_sign(s->sig, s->out, &len, in + 1, MSG_LEN, s->sk[in[0]]) == OQS_SUCCESS;
+}
+#endif
+
+#define CMP(name, n, leak) \
+    { name, "compare", name, CMP_LEN, n, leak, cmp_setup, cmp_prepare, cmp_run, cmp_teardown }
+#define KEM(alg, ct_len, n) \
+    { alg " decaps", "KEM", alg, ct_len, n, 0, kem_setup, kem_prepare, kem_run, kem_teardown }
+#define EVP_SIG(alg, n) \
+    { alg " sign", "signature", alg, 1 + MSG_LEN, n, 0, \
+      evp_sig_setup, evp_sig_prepare, evp_sig_run, evp_sig_teardown }
+#define SLH_PAR(alg, n) \
+    { alg " sign (slh_dsa_par)", "signature", alg, 1 + MSG_LEN, n, 0, \
+      slh_setup, slh_prepare, slh_run, slh_teardown }
+#define MLDSA_EXP(alg, n) \
+    { alg " sign (mldsa_expanded)", "signature", alg, 1 + MSG_LEN, n, 0, \
+      mldsa_exp_setup, mldsa_exp_prepare, mldsa_exp_run, mldsa_exp_teardown }
+
+const ct_target ct_targets[] = {
+    CMP("memcmp", 1000000, 1),
+    CMP("CRYPTO_memcmp", 1000000, 0),
+#ifdef PQC_CT_WITH_OQS
+    CMP("OQS_MEM_secure_bcmp", 1000000, 0),
+#endif
+
+    KEM("ML-KEM-512", 768, 100000),
+    KEM("ML-KEM-768", 1088, 100000),
+    KEM("ML-KEM-1024", 1568, 100000),
+    { "X25519+ML-KEM-768 decaps (hybrid_kem)", "KEM", "X25519+ML-KEM-768", HYBRID_KEM_CIPHERTEXT_LEN, 20000, 0,
+      hybrid_setup, hybrid_prepare, hybrid_run, hybrid_teardown },
+
+    EVP_SIG("ML-DSA-44", 20000),
+    EVP_SIG("ML-DSA-65", 20000),
+    EVP_SIG("ML-DSA-87", 10000),
+    MLDSA_EXP("ML-DSA-65", 20000),
+    { "ML-DSA-65 sign (pqc_stream, external mu)", "signature", "ML-DSA-65", 1 + MSG_LEN, 10000, 0,
+      evp_sig_setup, evp_sig_prepare, stream_sig_run, evp_sig_teardown },
+    EVP_SIG("SLH-DSA-SHA2-128f", 500),
+    EVP_SIG("SLH-DSA-SHAKE-128f", 500),
+    SLH_PAR("SLH-DSA-SHA2-128f", 500),
+    SLH_PAR("SLH-DSA-SHAKE-128f", 1000),
+
+#ifdef PQC_CT_WITH_OQS
+    { "liboqs ML-KEM-768 decaps", "KEM", "ML-KEM-768", 1088, 100000, 0,
+      oqs_kem_setup, oqs_kem_prepare, oqs_kem_run, oqs_kem_teardown },
+    { "liboqs ML-DSA-65 sign", "signature", "ML-DSA-65", 1 + MSG_LEN, 20000, 0,
+      oqs_sig_setup, oqs_sig_prepare, oqs_sig_run, oqs_sig_teardown },
+    { "liboqs SPHINCS+-SHA2-128f-simple sign", "signature", "SPHINCS+-SHA2-128f-simple",
+      1 + MSG_LEN, 500, 0, oqs_sig_setup, oqs_sig_prepare, oqs_sig_run, oqs_sig_teardown },
+#endif
+};
+
+const size_t ct_n_targets = sizeof(ct_targets) / sizeof(ct_targets[0]);
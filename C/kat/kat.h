@@ -0,0 +1,117 @@
+#ifndef KAT_H
+#define KAT_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pqc_metrics.h"
+
+/*
+ * Deterministic known-answer tests for ML-KEM, ML-DSA and SLH-DSA.
+ *
+ * Every random input of keygen, encapsulation and signing is an explicit
+ * vector field, fed to OpenSSL through the FIPS 203/204/205 seed and
+ * test-entropy parameters:
+ *
+ *   ML-KEM   seed = d || z (64 bytes)   m = encapsulation randomness (32)
+ *   ML-DSA   seed = xi (32 bytes)       rnd = signing randomness (32)
+ *   SLH-DSA  seed = SK.seed || SK.prf || PK.seed (3n)   rnd = addrnd (n)
+ *
+ * A signature vector without rnd uses the deterministic variant. Outputs
+ * are pk, sk, ct and ss (KEM) or pk, sk and sig (signatures).
+ *
+ * Vectors live in NIST .rsp-style files: an "[ALGORITHM]" line, then blocks
+ * of "name = hex" lines, each starting with "count = N". A file may have
+ * several such sections.
+ */
+
+typedef enum { KAT_MLKEM, KAT_MLDSA, KAT_SLHDSA } kat_family;
+
+enum {
+    KAT_SEED, KAT_M, KAT_MSG, KAT_RND, KAT_CTX,     /* inputs */
+    KAT_PK, KAT_SK, KAT_CT, KAT_SS, KAT_SIG,        /* outputs */
+    KAT_FIELDS
+};
+#define KAT_FIRST_OUTPUT KAT_PK
+
+extern const char *const kat_field_names[KAT_FIELDS];
+
+typedef struct {
+    uint8_t *data;
+    size_t len;
+    size_t cap;
+    int present;
+} kat_field;
+
+typedef struct {
+    unsigned long count;
+    kat_field f[KAT_FIELDS];    /* inputs, and expected outputs when checking */
+    kat_field out[KAT_FIELDS];  /* outputs computed by kat_run() */
+    const char *error;          /* NULL if the vector passed */
+} kat_vector;
+
+void kat_vector_clear(kat_vector *v);   /* marks every field absent, keeps buffers */
+void kat_vector_free(kat_vector *v);
+int kat_field_set(kat_field *f, const uint8_t *data, size_t len);
+
+/* ---- Algorithms (kat_alg.c) ---- */
+
+typedef struct kat_alg kat_alg;
+typedef struct kat_worker kat_worker;
+
+/*
+ * impl is "openssl" (EVP for everything) or, for SLH-DSA signing,
+ * "slh_par" or "slh_par:<hash backend>" (see slh_par_set_backend()).
+ */
+kat_alg *kat_alg_new(const char *name, const char *impl);
+void kat_alg_free(kat_alg *alg);
+const char *kat_alg_name(const kat_alg *alg);
+kat_family kat_alg_family(const kat_alg *alg);
+
+/* Fills the inputs of vector number i from a master seed (seed mode). */
+int kat_derive(const kat_alg *alg, const uint8_t *master, size_t master_len,
+               unsigned long i, kat_vector *v);
+
+/* One per thread; holds that thread's OpenSSL contexts. */
+kat_worker *kat_worker_new(const kat_alg *alg);
+void kat_worker_free(kat_worker *w);
+
+/* Operations timed by kat_run() */
+typedef enum {
+    KAT_OP_KEYGEN, KAT_OP_ENCAPS, KAT_OP_DECAPS, KAT_OP_SIGN, KAT_OP_VERIFY,
+    KAT_OPS
+} kat_op;
+
+extern const char *const kat_op_names[KAT_OPS];
+
+/* Latencies of op over the worker's vectors so far; NULL when metrics are off. */
+const pqc_hist *kat_worker_hist(const kat_worker *w, kat_op op);
+
+/*
+ * Computes the outputs from the inputs, checks them for consistency
+ * (decapsulation, verification) and against any expected outputs present.
+ * Returns 1 if the vector passed; otherwise sets v->error.
+ */
+int kat_run(kat_worker *w, kat_vector *v);
+
+/* ---- .rsp files (kat_rsp.c) ---- */
+
+typedef struct kat_rsp_reader kat_rsp_reader;
+
+kat_rsp_reader *kat_rsp_open(FILE *in);
+void kat_rsp_close(kat_rsp_reader *r);
+
+/* Algorithm from the "[...]" line of the section that the vector last
+ * returned by kat_rsp_next() belongs to, or NULL if it has none. */
+const char *kat_rsp_alg(const kat_rsp_reader *r);
+
+/* 1 and fills v with the next vector, 0 at end of file, -1 on a parse error. */
+int kat_rsp_next(kat_rsp_reader *r, kat_vector *v);
+
+void kat_rsp_write_header(FILE *out, const char *alg, const char *comment);
+
+/* Writes the inputs and the computed outputs of v. */
+void kat_rsp_write(FILE *out, const kat_vector *v);
+
+#endif /* KAT_H */
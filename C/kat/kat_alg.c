@@ -0,0 +1,458 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include <openssl/evp.h>
+#include <openssl/err.h>
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+
+#include "kat.h"
+#include "slh_dsa_par.h"
+#include "mldsa_expanded.h"
+#include "pqc_timer.h"
+
+/*
+ * Seed mode derives every input of vector i from the master seed as
+ * SHAKE256(label || 0x00 || master || le32(i)), so a vector can be
+ * recomputed on its own and any thread can take any index. Message lengths
+ * cycle through 33..2112 bytes; every fourth signature vector has a context
+ * string and every eighth uses the deterministic variant (no rnd).
+ */
+
+#define KAT_ML_RND_LEN 32
+
+struct kat_alg {
+    char name[64];
+    kat_family family;
+    const char *seed_param;
+    size_t seed_len;
+    size_t rnd_len;             /* m for ML-KEM, rnd for the signatures */
+    EVP_MD *shake;
+    EVP_SIGNATURE *sig;         /* ML-DSA and SLH-DSA */
+    const slh_params *slh;      /* set when SLH-DSA signs through slh_par */
+    const mldsa_params *mldsa;  /* set when ML-DSA signs through mldsa_expanded */
+};
+
+struct kat_worker {
+    const kat_alg *alg;
+    EVP_PKEY_CTX *keygen;
+    kat_field ss2;              /* decapsulated secret */
+    pqc_hist *hist[KAT_OPS];    /* only with PQC_METRICS set */
+};
+
+const char *const kat_op_names[KAT_OPS] = { "keygen", "encaps", "decaps", "sign", "verify" };
+
+static const char *const mismatch[KAT_FIELDS] = {
+    NULL, NULL, NULL, NULL, NULL,
+    "pk mismatch", "sk mismatch", "ct mismatch", "ss mismatch", "sig mismatch"
+};
+
+static void handle_openssl_error(const char *msg) {
+    fprintf(stderr, "ERROR: %s\n", msg);
+    ERR_print_errors_fp(stderr);
+}
+
+kat_alg *kat_alg_new(const char *name, const char *impl) {
+    kat_alg *alg = calloc(1, sizeof(*alg));
+    EVP_PKEY_CTX *probe = NULL;
+
+    if (!alg || strlen(name) >= sizeof(alg->name)) goto fail;
+    strcpy(alg->name, name);
+
+    if (strncmp(name, "ML-KEM-", 7) == 0) {
+        alg->family = KAT_MLKEM;
+        alg->seed_len = 64;
+        alg->seed_param = OSSL_PKEY_PARAM_ML_KEM_SEED;
+        alg->rnd_len = KAT_ML_RND_LEN;
+    } else if (strncmp(name, "ML-DSA-", 7) == 0) {
+        alg->family = KAT_MLDSA;
+        alg->seed_len = 32;
+        alg->seed_param = OSSL_PKEY_PARAM_ML_DSA_SEED;
+        alg->rnd_len = KAT_ML_RND_LEN;
+        if (impl && strcmp(impl, "mldsa_exp") == 0 && !(alg->mldsa = mldsa_params_get(name)))
+            goto unknown;
+    } else if (strncmp(name, "SLH-DSA-", 8) == 0) {
+        const slh_params *p = slh_par_params(name);
+        if (!p) goto unknown;
+        alg->family = KAT_SLHDSA;
+        alg->seed_len = 3 * p->n;
+        alg->seed_param = OSSL_PKEY_PARAM_SLH_DSA_SEED;
+        alg->rnd_len = p->n;
+        if (impl && strncmp(impl, "slh_par", 7) == 0) {
+            const char *backend = impl[7] == ':' ? impl + 8 : NULL;
+            if (impl[7] != '\0' && !backend) goto bad_impl;
+            if (!slh_par_set_backend(backend)) {
+                fprintf(stderr, "ERROR: slh_par backend '%s' is not supported here\n", backend);
+                goto fail;
+            }
+            alg->slh = p;
+        }
+    } else {
+        goto unknown;
+    }
+    if (impl && strcmp(impl, "openssl") != 0 && !alg->slh && !alg->mldsa) goto bad_impl;
+
+    probe = EVP_PKEY_CTX_new_from_name(NULL, name, NULL);
+    alg->shake = EVP_MD_fetch(NULL, "SHAKE256", NULL);
+    if (alg->family != KAT_MLKEM) alg->sig = EVP_SIGNATURE_fetch(NULL, name, NULL);
+    if (!probe || !alg->shake || (alg->family != KAT_MLKEM && !alg->sig)) {
+        handle_openssl_error("This OpenSSL does not provide the algorithm (3.5 or later is needed)");
+        goto fail;
+    }
+    EVP_PKEY_CTX_free(probe);
+    return alg;
+
+unknown:
+    fprintf(stderr, "ERROR: Unknown algorithm '%s'\n", name);
+    goto fail;
+bad_impl:
+    fprintf(stderr, "ERROR: Implementation '%s' does not apply to %s\n", impl, name);
+fail:
+    EVP_PKEY_CTX_free(probe);
+    kat_alg_free(alg);
+    return NULL;
+}
+
+void kat_alg_free(kat_alg *alg) {
+    if (!alg) return;
+    EVP_MD_free(alg->shake);
+    EVP_SIGNATURE_free(alg->sig);
+    free(alg);
+}
+
+const char *kat_alg_name(const kat_alg *alg) {
+    return alg->name;
+}
+
+kat_family kat_alg_family(const kat_alg *alg) {
+    return alg->family;
+}
+
+static int reserve(kat_field *f, size_t len) {
+    if (len > f->cap) {
+        uint8_t *p = realloc(f->data, len);
+        if (!p) return 0;
+        f->data = p;
+        f->cap = len;
+    }
+    f->len = len;
+    f->present = 1;
+    return 1;
+}
+
+/* Sets f to len bytes of SHAKE256(label || 0 || master || le32(i)) */
+static int derive_field(const kat_alg *alg, EVP_MD_CTX *md, const char *label,
+                        const uint8_t *master, size_t master_len, unsigned long i,
+                        size_t len, kat_field *f) {
+    uint8_t le[4] = { (uint8_t)i, (uint8_t)(i >> 8), (uint8_t)(i >> 16), (uint8_t)(i >> 24) };
+
+    return reserve(f, len)
+        && EVP_DigestInit_ex(md, alg->shake, NULL)
+        && EVP_DigestUpdate(md, label, strlen(label) + 1)
+        && EVP_DigestUpdate(md, master, master_len)
+        && EVP_DigestUpdate(md, le, sizeof(le))
+        && EVP_DigestFinalXOF(md, f->data, len);
+}
+
+int kat_derive(const kat_alg *alg, const uint8_t *master, size_t master_len,
+               unsigned long i, kat_vector *v) {
+    EVP_MD_CTX *md = EVP_MD_CTX_new();
+    int ok = 0;
+
+    kat_vector_clear(v);
+    v->count = i;
+    if (!md) goto cleanup;
+    if (!derive_field(alg, md, "seed", master, master_len, i, alg->seed_len, &v->f[KAT_SEED]))
+        goto cleanup;
+
+    if (alg->family == KAT_MLKEM) {
+        ok = derive_field(alg, md, "m", master, master_len, i, alg->rnd_len, &v->f[KAT_M]);
+        goto cleanup;
+    }
+    if (!derive_field(alg, md, "msg", master, master_len, i, 33 * (i % 64 + 1), &v->f[KAT_MSG]))
+        goto cleanup;
+    if (i % 8 != 7
+        && !derive_field(alg, md, "rnd", master, master_len, i, alg->rnd_len, &v->f[KAT_RND]))
+        goto cleanup;
+    if (i % 4 == 3
+        && !derive_field(alg, md, "ctx", master, master_len, i, i % 255 + 1, &v->f[KAT_CTX]))
+        goto cleanup;
+    ok = 1;
+
+cleanup:
+    if (!ok) v->error = "input derivation failed";
+    EVP_MD_CTX_free(md);
+    return ok;
+}
+
+kat_worker *kat_worker_new(const kat_alg *alg) {
+    kat_worker *w = calloc(1, sizeof(*w));
+
+    if (!w) return NULL;
+    w->alg = alg;
+    if (!(w->keygen = EVP_PKEY_CTX_new_from_name(NULL, alg->name, NULL))) {
+        handle_openssl_error("Failed to create key generation context");
+        kat_worker_free(w);
+        return NULL;
+    }
+    for (int op = 0; pqc_metrics_enabled() && op < KAT_OPS; op++) {
+        if (!(w->hist[op] = pqc_hist_new())) {
+            kat_worker_free(w);
+            return NULL;
+        }
+    }
+    return w;
+}
+
+void kat_worker_free(kat_worker *w) {
+    if (!w) return;
+    EVP_PKEY_CTX_free(w->keygen);
+    free(w->ss2.data);
+    for (int op = 0; op < KAT_OPS; op++) pqc_hist_free(w->hist[op]);
+    free(w);
+}
+
+const pqc_hist *kat_worker_hist(const kat_worker *w, kat_op op) {
+    return w->hist[op];
+}
+
+static void record(kat_worker *w, kat_op op, uint64_t t0) {
+    if (w->hist[op]) pqc_hist_record(w->hist[op], pqc_now_ns() - t0);
+}
+
+static int export_key(EVP_PKEY *pkey, const char *param, kat_field *f) {
+    size_t len = 0;
+
+    return EVP_PKEY_get_octet_string_param(pkey, param, NULL, 0, &len)
+        && reserve(f, len)
+        && EVP_PKEY_get_octet_string_param(pkey, param, f->data, f->cap, &f->len);
+}
+
+/* Key pair from the seed, or imported from an expected sk (NIST sigGen/decap files) */
+static EVP_PKEY *make_key(kat_worker *w, kat_vector *v) {
+    const kat_alg *alg = w->alg;
+    EVP_PKEY *pkey = NULL;
+
+    if (v->f[KAT_SEED].present) {
+        OSSL_PARAM params[2];
+        uint64_t t0 = pqc_now_ns();
+
+        if (v->f[KAT_SEED].len != alg->seed_len) {
+            v->error = "seed has the wrong length";
+            return NULL;
+        }
+        params[0] = OSSL_PARAM_construct_octet_string(alg->seed_param, v->f[KAT_SEED].data,
+                                                      v->f[KAT_SEED].len);
+        params[1] = OSSL_PARAM_construct_end();
+        if (EVP_PKEY_keygen_init(w->keygen) <= 0
+            || !EVP_PKEY_CTX_set_params(w->keygen, params)
+            || EVP_PKEY_generate(w->keygen, &pkey) <= 0) {
+            v->error = "key generation failed";
+            return NULL;
+        }
+        record(w, KAT_OP_KEYGEN, t0);
+    } else if (v->f[KAT_SK].present) {
+        pkey = EVP_PKEY_new_raw_private_key_ex(NULL, alg->name, NULL,
+                                               v->f[KAT_SK].data, v->f[KAT_SK].len);
+        if (!pkey) {
+            v->error = "sk import failed";
+            return NULL;
+        }
+    } else {
+        v->error = "vector has neither seed nor sk";
+        return NULL;
+    }
+
+    if (!export_key(pkey, OSSL_PKEY_PARAM_PUB_KEY, &v->out[KAT_PK])
+        || !export_key(pkey, OSSL_PKEY_PARAM_PRIV_KEY, &v->out[KAT_SK])) {
+        v->error = "key export failed";
+        EVP_PKEY_free(pkey);
+        return NULL;
+    }
+    return pkey;
+}
+
+static int run_kem(kat_worker *w, kat_vector *v, EVP_PKEY *pkey) {
+    const kat_field *ct;
+    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_from_pkey(NULL, pkey, NULL);
+    size_t ct_len = 0, ss_len = 0;
+    uint64_t t0;
+    int ok = 0;
+
+    if (!ctx) goto cleanup;
+
+    if (v->f[KAT_M].present) {
+        OSSL_PARAM params[2];
+
+        if (v->f[KAT_M].len != w->alg->rnd_len) {
+            v->error = "m has the wrong length";
+            goto cleanup;
+        }
+        params[0] = OSSL_PARAM_construct_octet_string(OSSL_KEM_PARAM_IKME,
+                                                      v->f[KAT_M].data, v->f[KAT_M].len);
+        params[1] = OSSL_PARAM_construct_end();
+        t0 = pqc_now_ns();
+        if (EVP_PKEY_encapsulate_init(ctx, params) <= 0
+            || EVP_PKEY_encapsulate(ctx, NULL, &ct_len, NULL, &ss_len) <= 0
+            || !reserve(&v->out[KAT_CT], ct_len) || !reserve(&v->out[KAT_SS], ss_len)
+            || EVP_PKEY_encapsulate(ctx, v->out[KAT_CT].data, &v->out[KAT_CT].len,
+                                    v->out[KAT_SS].data, &v->out[KAT_SS].len) <= 0) {
+            v->error = "encapsulation failed";
+            goto cleanup;
+        }
+        record(w, KAT_OP_ENCAPS, t0);
+        ct = &v->out[KAT_CT];
+    } else if (v->f[KAT_CT].present) {
+        /* Decapsulation-only vector: ss comes from the given ciphertext */
+        if (!kat_field_set(&v->out[KAT_CT], v->f[KAT_CT].data, v->f[KAT_CT].len)) goto cleanup;
+        ct = &v->out[KAT_CT];
+    } else {
+        ok = 1;                 /* key generation only */
+        goto cleanup;
+    }
+
+    t0 = pqc_now_ns();
+    if (EVP_PKEY_decapsulate_init(ctx, NULL) <= 0
+        || EVP_PKEY_decapsulate(ctx, NULL, &ss_len, ct->data, ct->len) <= 0
+        || !reserve(&w->ss2, ss_len)
+        || EVP_PKEY_decapsulate(ctx, w->ss2.data, &w->ss2.len, ct->data, ct->len) <= 0) {
+        v->error = "decapsulation failed";
+        goto cleanup;
+    }
+    record(w, KAT_OP_DECAPS, t0);
+    if (!v->out[KAT_SS].present) {
+        ok = kat_field_set(&v->out[KAT_SS], w->ss2.data, w->ss2.len);
+    } else if (w->ss2.len != v->out[KAT_SS].len
+               || memcmp(w->ss2.data, v->out[KAT_SS].data, w->ss2.len) != 0) {
+        v->error = "decapsulated secret differs from the encapsulated one";
+    } else {
+        ok = 1;
+    }
+
+cleanup:
+    if (!ok && !v->error) v->error = "KEM context setup failed";
+    EVP_PKEY_CTX_free(ctx);
+    return ok;
+}
+
+static int run_sign(kat_worker *w, kat_vector *v, EVP_PKEY *pkey) {
+    const kat_alg *alg = w->alg;
+    const kat_field *msg = &v->f[KAT_MSG], *rnd = &v->f[KAT_RND], *ctxs = &v->f[KAT_CTX];
+    EVP_PKEY_CTX *sctx = NULL, *vctx = NULL;
+    OSSL_PARAM params[3], *p = params;
+    int deterministic = 1;
+    size_t sig_len = 0;
+    uint64_t t0;
+    int ok = 0;
+
+    if (!msg->present) {
+        ok = 1;                 /* key generation only */
+        goto cleanup;
+    }
+    if (rnd->present && rnd->len != alg->rnd_len) {
+        v->error = "rnd has the wrong length";
+        goto cleanup;
+    }
+    if (ctxs->len > 255) {
+        v->error = "ctx is longer than 255 bytes";
+        goto cleanup;
+    }
+
+    t0 = pqc_now_ns();
+    if (alg->slh) {
+        if (!reserve(&v->out[KAT_SIG], slh_par_sig_len(alg->slh))
+            || !slh_par_sign(alg->slh, v->out[KAT_SIG].data, msg->data, msg->len,
+                             ctxs->data, ctxs->len, v->out[KAT_SK].data,
+                             rnd->present ? rnd->data : NULL, 1)) {
+            v->error = "slh_par signing failed";
+            goto cleanup;
+        }
+    } else if (alg->mldsa) {
+        static const uint8_t zero_rnd[KAT_ML_RND_LEN];
+        mldsa_expanded_key *key = mldsa_expanded_key_new(alg->mldsa, v->out[KAT_SK].data,
+                                                         v->out[KAT_SK].len);
+        int signed_ok = key
+            && reserve(&v->out[KAT_SIG], mldsa_sig_len(alg->mldsa))
+            && mldsa_expanded_sign(key, v->out[KAT_SIG].data, msg->data, msg->len,
+                                   ctxs->data, ctxs->len, rnd->present ? rnd->data : zero_rnd);
+
+        mldsa_expanded_key_free(key);
+        if (!signed_ok) {
+            v->error = "mldsa_expanded signing failed";
+            goto cleanup;
+        }
+    } else {
+        if (rnd->present)
+            *p++ = OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_TEST_ENTROPY,
+                                                     rnd->data, rnd->len);
+        else
+            *p++ = OSSL_PARAM_construct_int(OSSL_SIGNATURE_PARAM_DETERMINISTIC, &deterministic);
+        if (ctxs->present)
+            *p++ = OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_CONTEXT_STRING,
+                                                     ctxs->data, ctxs->len);
+        *p = OSSL_PARAM_construct_end();
+
+        if (!(sctx = EVP_PKEY_CTX_new_from_pkey(NULL, pkey, NULL))
+            || EVP_PKEY_sign_message_init(sctx, alg->sig, params) <= 0
+            || EVP_PKEY_sign(sctx, NULL, &sig_len, msg->data, msg->len) <= 0
+            || !reserve(&v->out[KAT_SIG], sig_len)
+            || EVP_PKEY_sign(sctx, v->out[KAT_SIG].data, &v->out[KAT_SIG].len,
+                             msg->data, msg->len) <= 0) {
+            v->error = "signing failed";
+            goto cleanup;
+        }
+    }
+    record(w, KAT_OP_SIGN, t0);
+
+    /* Whichever implementation signed, OpenSSL has to accept the signature */
+    p = params;
+    if (ctxs->present)
+        *p++ = OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_CONTEXT_STRING,
+                                                 ctxs->data, ctxs->len);
+    *p = OSSL_PARAM_construct_end();
+    t0 = pqc_now_ns();
+    if (!(vctx = EVP_PKEY_CTX_new_from_pkey(NULL, pkey, NULL))
+        || EVP_PKEY_verify_message_init(vctx, alg->sig, params) <= 0
+        || EVP_PKEY_verify(vctx, v->out[KAT_SIG].data, v->out[KAT_SIG].len,
+                           msg->data, msg->len) != 1) {
+        v->error = "signature does not verify";
+        goto cleanup;
+    }
+    record(w, KAT_OP_VERIFY, t0);
+    ok = 1;
+
+cleanup:
+    EVP_PKEY_CTX_free(sctx);
+    EVP_PKEY_CTX_free(vctx);
+    return ok;
+}
+
+int kat_run(kat_worker *w, kat_vector *v) {
+    EVP_PKEY *pkey;
+    int ok;
+
+    if (v->error) return 0;
+    if (!(pkey = make_key(w, v))) {
+        ERR_clear_error();
+        return 0;
+    }
+    ok = w->alg->family == KAT_MLKEM ? run_kem(w, v, pkey) : run_sign(w, v, pkey);
+    EVP_PKEY_free(pkey);
+    if (!ok) {
+        ERR_clear_error();
+        return 0;
+    }
+
+    for (int i = KAT_FIRST_OUTPUT; i < KAT_FIELDS; i++) {
+        const kat_field *want = &v->f[i], *got = &v->out[i];
+        if (!want->present) continue;
+        if (!got->present || got->len != want->len || memcmp(got->data, want->data, got->len) != 0) {
+            v->error = mismatch[i];
+            return 0;
+        }
+    }
+    return 1;
+}
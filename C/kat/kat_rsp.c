@@ -0,0 +1,197 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+#include "kat.h"
+
+const char *const kat_field_names[KAT_FIELDS] = {
+    "seed", "m", "msg", "rnd", "ctx", "pk", "sk", "ct", "ss", "sig"
+};
+
+int kat_field_set(kat_field *f, const uint8_t *data, size_t len) {
+    if (len > f->cap) {
+        uint8_t *p = realloc(f->data, len);
+        if (!p) return 0;
+        f->data = p;
+        f->cap = len;
+    }
+    if (len) memcpy(f->data, data, len);
+    f->len = len;
+    f->present = 1;
+    return 1;
+}
+
+void kat_vector_clear(kat_vector *v) {
+    for (int i = 0; i < KAT_FIELDS; i++) {
+        v->f[i].present = 0;
+        v->f[i].len = 0;
+        v->out[i].present = 0;
+        v->out[i].len = 0;
+    }
+    v->count = 0;
+    v->error = NULL;
+}
+
+void kat_vector_free(kat_vector *v) {
+    for (int i = 0; i < KAT_FIELDS; i++) {
+        free(v->f[i].data);
+        free(v->out[i].data);
+    }
+    memset(v, 0, sizeof(*v));
+}
+
+struct kat_rsp_reader {
+    FILE *in;
+    char *line;
+    size_t line_cap;
+    char alg[64];               /* section of the last vector returned */
+    char section[64];           /* last "[...]" line read */
+    unsigned long lineno;
+    int have_pending;           /* a "count" line was read for the next vector */
+    unsigned long pending_count;
+    uint8_t *hex;               /* decode buffer */
+    size_t hex_cap;
+};
+
+kat_rsp_reader *kat_rsp_open(FILE *in) {
+    kat_rsp_reader *r = calloc(1, sizeof(*r));
+    if (r) r->in = in;
+    return r;
+}
+
+void kat_rsp_close(kat_rsp_reader *r) {
+    if (!r) return;
+    free(r->line);
+    free(r->hex);
+    free(r);
+}
+
+const char *kat_rsp_alg(const kat_rsp_reader *r) {
+    return r->alg[0] ? r->alg : NULL;
+}
+
+static int hex_value(int c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static int decode_hex(kat_rsp_reader *r, const char *s, size_t len, kat_field *f) {
+    if (len % 2) return 0;
+    if (len / 2 > r->hex_cap) {
+        uint8_t *p = realloc(r->hex, len / 2);
+        if (!p) return 0;
+        r->hex = p;
+        r->hex_cap = len / 2;
+    }
+    for (size_t i = 0; i < len / 2; i++) {
+        int hi = hex_value(s[2 * i]), lo = hex_value(s[2 * i + 1]);
+        if (hi < 0 || lo < 0) return 0;
+        r->hex[i] = (uint8_t)(hi << 4 | lo);
+    }
+    return kat_field_set(f, r->hex, len / 2);
+}
+
+static char *trim(char *s) {
+    char *e;
+    while (isspace((unsigned char)*s)) s++;
+    e = s + strlen(s);
+    while (e > s && isspace((unsigned char)e[-1])) *--e = '\0';
+    return s;
+}
+
+int kat_rsp_next(kat_rsp_reader *r, kat_vector *v) {
+    int started = 0;
+
+    kat_vector_clear(v);
+    if (r->have_pending) {
+        v->count = r->pending_count;
+        r->have_pending = 0;
+        started = 1;
+        strcpy(r->alg, r->section);
+    }
+
+    while (getline(&r->line, &r->line_cap, r->in) > 0) {
+        char *s = trim(r->line), *eq, *key, *val;
+
+        r->lineno++;
+        if (*s == '\0' || *s == '#') continue;
+        if (*s == '[') {
+            char *end = strchr(s, ']');
+            size_t len = end ? (size_t)(end - s - 1) : 0;
+            if (!end || len == 0 || len >= sizeof(r->section)) goto bad;
+            memcpy(r->section, s + 1, len);
+            r->section[len] = '\0';
+            continue;
+        }
+        if (!(eq = strchr(s, '='))) goto bad;
+        *eq = '\0';
+        key = trim(s);
+        val = trim(eq + 1);
+
+        if (strcmp(key, "count") == 0) {
+            unsigned long count = strtoul(val, NULL, 10);
+            if (started) {
+                r->have_pending = 1;
+                r->pending_count = count;
+                return 1;
+            }
+            v->count = count;
+            started = 1;
+            strcpy(r->alg, r->section);   /* a later "[...]" line is the next vector's */
+            continue;
+        }
+        for (int i = 0; i < KAT_FIELDS; i++) {
+            if (strcmp(key, kat_field_names[i]) == 0) {
+                if (!started || !decode_hex(r, val, strlen(val), &v->f[i])) goto bad;
+                break;
+            }
+        }
+        /* Anything else (mlen, ctxlen, smlen, ...) is implied by the data */
+    }
+    return started;
+
+bad:
+    fprintf(stderr, "ERROR: Cannot parse line %lu\n", r->lineno);
+    return -1;
+}
+
+void kat_rsp_write_header(FILE *out, const char *alg, const char *comment) {
+    if (comment) fprintf(out, "# %s\n", comment);
+    fprintf(out, "[%s]\n\n", alg);
+}
+
+static void write_hex(FILE *out, const char *name, const kat_field *f) {
+    static const char digits[] = "0123456789ABCDEF";
+    char buf[4096];
+    size_t used = 0;
+
+    fprintf(out, "%s = ", name);
+    for (size_t i = 0; i < f->len; i++) {
+        buf[used++] = digits[f->data[i] >> 4];
+        buf[used++] = digits[f->data[i] & 15];
+        if (used == sizeof(buf)) {
+            fwrite(buf, 1, used, out);
+            used = 0;
+        }
+    }
+    fwrite(buf, 1, used, out);
+    fputc('\n', out);
+}
+
+void kat_rsp_write(FILE *out, const kat_vector *v) {
+    fprintf(out, "count = %lu\n", v->count);
+    for (int i = 0; i < KAT_FIRST_OUTPUT; i++) {
+        if (!v->f[i].present) continue;
+        if (i == KAT_MSG) fprintf(out, "mlen = %zu\n", v->f[i].len);
+        write_hex(out, kat_field_names[i], &v->f[i]);
+    }
+    for (int i = KAT_FIRST_OUTPUT; i < KAT_FIELDS; i++) {
+        if (v->out[i].present) write_hex(out, kat_field_names[i], &v->out[i]);
+    }
+    fputc('\n', out);
+}
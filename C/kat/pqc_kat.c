@@ -0,0 +1,334 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "kat.h"
+#include "pqc_timer.h"
+
+/*
+ * Known-answer test driver.
+ *
+ * Seed mode (-a ALG -s SEED -n N) derives N vectors from a master seed,
+ * computes them and streams them out as an .rsp file. Check mode (-c FILE)
+ * reads such a file, or a NIST-style one with the same field names,
+ * recomputes every vector and compares the outputs it contains. Running seed
+ * mode on one build and check mode on another confirms that a new backend
+ * is bit-exact with the old one.
+ *
+ * Vectors are processed in blocks: the threads claim vectors of a block one
+ * at a time, and the block is written out in order once all are done. In
+ * check mode a block ends where the file's [algorithm] section changes.
+ */
+
+#define BLOCK 1024
+#define DEFAULT_VECTORS 100
+#define MAX_SEED 64
+#define MAX_REPORTED 10
+
+typedef struct {
+    const kat_alg *alg;
+    kat_vector *v;
+    size_t n;
+    size_t next;
+    const uint8_t *master;      /* seed mode: derive the inputs first */
+    size_t master_len;
+    unsigned long first;
+} batch;
+
+typedef struct {
+    batch *b;
+    kat_worker *w;
+} batch_thread;
+
+static void *run_batch(void *arg) {
+    batch_thread *t = arg;
+    batch *b = t->b;
+    size_t i;
+
+    while ((i = __atomic_fetch_add(&b->next, 1, __ATOMIC_RELAXED)) < b->n) {
+        if (b->master && !kat_derive(b->alg, b->master, b->master_len, b->first + i, &b->v[i]))
+            continue;
+        kat_run(t->w, &b->v[i]);
+    }
+    return NULL;
+}
+
+/* Runs one block on nthreads threads, the caller being one of them */
+static void process(batch *b, kat_worker **workers, unsigned nthreads) {
+    pthread_t threads[nthreads];
+    batch_thread args[nthreads];
+    unsigned started = 0;
+
+    b->next = 0;
+    for (unsigned i = 0; i < nthreads; i++) {
+        args[i].b = b;
+        args[i].w = workers[i];
+    }
+    for (unsigned i = 1; i < nthreads; i++) {
+        if (pthread_create(&threads[i], NULL, run_batch, &args[i]) != 0) break;
+        started = i;
+    }
+    run_batch(&args[0]);
+    for (unsigned i = 1; i <= started; i++) pthread_join(threads[i], NULL);
+}
+
+typedef struct {
+    size_t vectors, failed;
+    unsigned compared;          /* bit per expected output field seen */
+    pqc_metrics_sizes sizes;    /* of the last vector's outputs */
+} tally;
+
+static void account(tally *t, FILE *log, const kat_vector *v, FILE *out) {
+    t->vectors++;
+    for (int i = KAT_FIRST_OUTPUT; i < KAT_FIELDS; i++)
+        if (v->f[i].present) t->compared |= 1u << i;
+    if (v->out[KAT_PK].present) t->sizes.pk = v->out[KAT_PK].len;
+    if (v->out[KAT_SK].present) t->sizes.sk = v->out[KAT_SK].len;
+    if (v->out[KAT_CT].present) t->sizes.ct = v->out[KAT_CT].len;
+    if (v->out[KAT_SS].present) t->sizes.ss = v->out[KAT_SS].len;
+    if (v->out[KAT_SIG].present) t->sizes.sig = v->out[KAT_SIG].len;
+    if (v->error) {
+        if (t->failed++ < MAX_REPORTED) fprintf(log, "❌ count = %lu: %s\n", v->count, v->error);
+        else if (t->failed == MAX_REPORTED + 1) fprintf(log, "   (further failures not listed)\n");
+    }
+    if (out) kat_rsp_write(out, v);
+}
+
+static int parse_hex(const char *s, uint8_t *out, size_t max, size_t *len) {
+    size_t n = strlen(s);
+
+    if (n == 0 || n % 2 || n / 2 > max) return 0;
+    for (size_t i = 0; i < n / 2; i++) {
+        unsigned int byte;
+        if (sscanf(s + 2 * i, "%2x", &byte) != 1) return 0;
+        out[i] = (uint8_t)byte;
+    }
+    *len = n / 2;
+    return 1;
+}
+
+static kat_worker **make_workers(const kat_alg *alg, unsigned nthreads) {
+    kat_worker **workers = calloc(nthreads, sizeof(*workers));
+
+    for (unsigned i = 0; workers && i < nthreads; i++) {
+        if (!(workers[i] = kat_worker_new(alg))) {
+            while (i--) kat_worker_free(workers[i]);
+            free(workers);
+            return NULL;
+        }
+    }
+    return workers;
+}
+
+/* With PQC_METRICS set, one record per operation of alg, over all workers */
+static void emit_metrics(const kat_alg *alg, kat_worker **workers, unsigned nthreads,
+                         const char *impl, tally *t) {
+    pqc_hist *h;
+
+    if (!alg || !workers || !pqc_metrics_enabled() || !(h = pqc_hist_new())) return;
+    for (int op = 0; op < KAT_OPS; op++) {
+        pqc_hist_reset(h);
+        for (unsigned i = 0; i < nthreads; i++) pqc_hist_merge(h, kat_worker_hist(workers[i], op));
+        if (h->samples)
+            pqc_metrics_emit(kat_alg_name(alg), kat_op_names[op], impl ? impl : "openssl",
+                             h, 0, &t->sizes);
+    }
+    pqc_hist_free(h);
+    memset(&t->sizes, 0, sizeof(t->sizes));
+}
+
+/* Switches alg and the workers to a new algorithm */
+static int open_alg(kat_alg **alg, kat_worker ***workers, unsigned nthreads,
+                    const char *name, const char *impl) {
+    for (unsigned i = 0; *workers && i < nthreads; i++) kat_worker_free((*workers)[i]);
+    free(*workers);
+    *workers = NULL;
+    kat_alg_free(*alg);
+    return (*alg = kat_alg_new(name, impl)) && (*workers = make_workers(*alg, nthreads));
+}
+
+static void usage(const char *prog) {
+    printf("Usage: %s -a algorithm [-s seed] [-n vectors] [options]   (generate)\n", prog);
+    printf("       %s -c file.rsp [options]                           (check)\n", prog);
+    printf("  -a  ML-KEM-*, ML-DSA-* or SLH-DSA-* parameter set\n");
+    printf("  -s  master seed, hex, up to %d bytes (default 000102...1f)\n", MAX_SEED);
+    printf("  -n  number of vectors to generate (default %d)\n", DEFAULT_VECTORS);
+    printf("  -c  recompute the vectors in this file (- for stdin) and compare\n");
+    printf("  -o  write the vectors to this file (generate: default stdout)\n");
+    printf("  -q  generate without writing the vectors (throughput only)\n");
+    printf("  -t  threads (default: one per online CPU)\n");
+    printf("  -i  implementation: openssl (default), or for SLH-DSA signing\n");
+    printf("      slh_par or slh_par:<evp|scalar|avx2|avx512>, for ML-DSA signing mldsa_exp\n");
+}
+
+int main(int argc, char *argv[]) {
+    const char *alg_name = NULL, *check = NULL, *out_path = NULL, *impl = NULL;
+    uint8_t master[MAX_SEED];
+    size_t master_len = 32, n_vectors = DEFAULT_VECTORS;
+    unsigned nthreads = 0;
+    int quiet = 0, ret = 1;
+    FILE *in = NULL, *out = NULL, *log = stdout;
+    kat_rsp_reader *reader = NULL;
+    kat_alg *alg = NULL;
+    kat_worker **workers = NULL;
+    kat_vector *v = NULL;
+    tally t = { 0, 0, 0, { 0, 0, 0, 0, 0 } };
+    batch b;
+    uint64_t t0, elapsed;
+
+    for (size_t i = 0; i < master_len; i++) master[i] = (uint8_t)i;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) alg_name = argv[++i];
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            if (!parse_hex(argv[++i], master, sizeof(master), &master_len)) {
+                fprintf(stderr, "ERROR: Seed must be 1 to %d bytes of hex\n", MAX_SEED);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) n_vectors = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) check = argv[++i];
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) out_path = argv[++i];
+        else if (strcmp(argv[i], "-q") == 0) quiet = 1;
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) nthreads = (unsigned)atoi(argv[++i]);
+        else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) impl = argv[++i];
+        else { usage(argv[0]); return 1; }
+    }
+    if (!alg_name && !check) { usage(argv[0]); return 1; }
+    pqc_metrics_init("pqc_kat");
+    if (nthreads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = cpus > 0 ? (unsigned)cpus : 1;
+    }
+
+    if (out_path) {
+        if (!(out = fopen(out_path, "w"))) {
+            perror(out_path);
+            return 1;
+        }
+    } else if (!check && !quiet) {
+        out = stdout;
+        log = stderr;           /* keep stdout a clean .rsp stream */
+    }
+    if (out) setvbuf(out, NULL, _IOFBF, 1 << 20);
+
+    if (!(v = calloc(BLOCK, sizeof(*v)))) goto cleanup;
+    memset(&b, 0, sizeof(b));
+    b.v = v;
+
+    fprintf(log, "🎯 PQC Known-Answer Tests\n");
+    fprintf(log, "=========================\n");
+
+    if (!check) {
+        char comment[32 + 2 * MAX_SEED];
+
+        if (!(alg = kat_alg_new(alg_name, impl)) || !(workers = make_workers(alg, nthreads)))
+            goto cleanup;
+        fprintf(log, "1️⃣  Generating %zu %s vectors (%s, %u threads)\n", n_vectors, alg_name,
+                impl ? impl : "openssl", nthreads);
+        strcpy(comment, "pqc_kat seed = ");
+        for (size_t i = 0; i < master_len; i++)
+            sprintf(comment + strlen(comment), "%02X", master[i]);
+        if (out) kat_rsp_write_header(out, alg_name, comment);
+
+        b.alg = alg;
+        b.master = master;
+        b.master_len = master_len;
+        t0 = pqc_now_ns();
+        for (size_t first = 0; first < n_vectors; first += BLOCK) {
+            b.first = (unsigned long)first;
+            b.n = n_vectors - first < BLOCK ? n_vectors - first : BLOCK;
+            process(&b, workers, nthreads);
+            for (size_t i = 0; i < b.n; i++) account(&t, log, &v[i], out);
+        }
+    } else {
+        char section[64] = "", opened[64] = "";
+        size_t carry = 0;
+        int r = 1;
+
+        if (strcmp(check, "-") == 0) in = stdin;
+        else if (!(in = fopen(check, "r"))) {
+            perror(check);
+            goto cleanup;
+        }
+        if (!(reader = kat_rsp_open(in))) goto cleanup;
+        fprintf(log, "1️⃣  Checking %s (%s, %u threads)\n", check, impl ? impl : "openssl", nthreads);
+
+        t0 = pqc_now_ns();
+        while (r == 1) {
+            /* v[0] may be a vector carried over from the last block: the first
+             * of a new section */
+            for (b.n = carry, carry = 0; b.n < BLOCK; b.n++) {
+                const char *name;
+
+                if ((r = kat_rsp_next(reader, &v[b.n])) != 1) break;
+                if (!(name = alg_name ? alg_name : kat_rsp_alg(reader))) {
+                    fprintf(stderr, "ERROR: No [algorithm] line in %s; pass -a\n", check);
+                    goto cleanup;
+                }
+                if (b.n == 0) {
+                    snprintf(section, sizeof(section), "%s", name);
+                } else if (strcmp(name, section) != 0) {
+                    carry = 1;
+                    break;
+                }
+            }
+            if (r < 0) goto cleanup;
+            if (b.n == 0) break;
+
+            if (strcmp(section, opened) != 0) {
+                emit_metrics(alg, workers, nthreads, impl, &t);
+                if (!open_alg(&alg, &workers, nthreads, section, impl)) goto cleanup;
+                fprintf(log, "   algorithm: %s\n", section);
+                if (out) kat_rsp_write_header(out, section, opened[0] ? NULL : "regenerated by pqc_kat");
+                strcpy(opened, section);
+            }
+            b.alg = alg;
+            process(&b, workers, nthreads);
+            for (size_t i = 0; i < b.n; i++) account(&t, log, &v[i], out);
+            if (carry) {
+                kat_vector next = v[b.n];
+
+                v[b.n] = v[0];
+                v[0] = next;
+                snprintf(section, sizeof(section), "%s", kat_rsp_alg(reader));
+            }
+        }
+    }
+    elapsed = pqc_now_ns() - t0;
+    emit_metrics(alg, workers, nthreads, impl, &t);
+    if (out && fflush(out) != 0) {
+        perror("write");
+        goto cleanup;
+    }
+
+    fprintf(log, "2️⃣  %zu vectors in %.2f s: %.0f vectors/s\n", t.vectors, elapsed / 1e9,
+            elapsed ? t.vectors * 1e9 / elapsed : 0.0);
+    if (check) {
+        fprintf(log, "   compared:");
+        for (int i = KAT_FIRST_OUTPUT; i < KAT_FIELDS; i++)
+            if (t.compared & 1u << i) fprintf(log, " %s", kat_field_names[i]);
+        fprintf(log, "%s\n", t.compared ? "" : " nothing (no expected outputs, consistency only)");
+    }
+    if (t.failed) {
+        fprintf(log, "❌ %zu of %zu vectors failed\n", t.failed, t.vectors);
+        goto cleanup;
+    }
+    fprintf(log, "✅ All %zu vectors %s\n", t.vectors, check ? "match" : "are self-consistent");
+    fprintf(log, "\n✨ Known-answer tests completed!\n");
+    ret = 0;
+
+cleanup:
+    for (unsigned i = 0; workers && i < nthreads; i++) kat_worker_free(workers[i]);
+    free(workers);
+    for (size_t i = 0; v && i < BLOCK; i++) kat_vector_free(&v[i]);
+    free(v);
+    kat_alg_free(alg);
+    kat_rsp_close(reader);
+    if (in && in != stdin) fclose(in);
+    if (out && out != stdout) fclose(out);
+    return ret;
+}
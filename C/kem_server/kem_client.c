@@ -0,0 +1,314 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include "oqs/oqs.h"
+
+#include <openssl/crypto.h>
+
+#include "kem_proto.h"
+#include "pqc_metrics.h"
+#include "pqc_timer.h"
+
+/*
+ * Load generator for kem_server. Keeps a fixed number of connections in
+ * flight from a single epoll loop; each connection does one handshake
+ * (read public key, encapsulate, send ciphertext, check the confirmation)
+ * and is replaced by a new one until the requested number of handshakes is
+ * done. Latency is measured from connect() to a verified confirmation.
+ *
+ * Without -c it runs at 1, 10, 100 and 1000 concurrent connections.
+ */
+
+#define DEFAULT_HANDSHAKES 2000
+#define MAX_EVENTS 256
+
+typedef enum { CL_CONNECTING, CL_READ_PK, CL_SEND_CT, CL_READ_CONFIRM } client_state;
+
+typedef struct {
+    int fd;                     /* -1 when the slot is idle */
+    client_state state;
+    size_t off;
+    uint64_t t0;
+    uint8_t *pk;
+    uint8_t *ct;
+    uint8_t *ss;
+    uint8_t confirm[KEM_CONFIRM_LEN];
+} client_conn;
+
+typedef struct {
+    const OQS_KEM *kem;
+    struct sockaddr_in addr;
+    int epfd;
+    client_conn *conns;
+    size_t concurrency;
+    size_t started, completed, failed, target;
+    uint64_t *latency_ns;
+} load;
+
+static void handle_error(const char *msg) {
+    fprintf(stderr, "ERROR: %s: %s\n", msg, strerror(errno));
+}
+
+static void slot_close(load *l, client_conn *c, int ok) {
+    if (c->fd >= 0) {
+        epoll_ctl(l->epfd, EPOLL_CTL_DEL, c->fd, NULL);
+        close(c->fd);
+    }
+    c->fd = -1;
+    if (ok) l->latency_ns[l->completed++] = pqc_now_ns() - c->t0;
+    else l->failed++;
+}
+
+static int watch(load *l, client_conn *c, uint32_t events) {
+    struct epoll_event ev = { .events = events, .data.ptr = c };
+    return epoll_ctl(l->epfd, EPOLL_CTL_MOD, c->fd, &ev);
+}
+
+/* Opens the next connection in slot c, if any handshakes are left to start */
+static void slot_start(load *l, client_conn *c) {
+    int one = 1;
+
+    while (l->started < l->target) {
+        struct epoll_event ev = { .events = EPOLLOUT, .data.ptr = c };
+
+        l->started++;
+        c->t0 = pqc_now_ns();
+        c->fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (c->fd < 0 || !kem_set_nonblocking(c->fd)) {
+            slot_close(l, c, 0);
+            continue;
+        }
+        setsockopt(c->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        if (connect(c->fd, (struct sockaddr *)&l->addr, sizeof(l->addr)) != 0
+            && errno != EINPROGRESS) {
+            slot_close(l, c, 0);
+            continue;
+        }
+        if (epoll_ctl(l->epfd, EPOLL_CTL_ADD, c->fd, &ev) != 0) {
+            slot_close(l, c, 0);
+            continue;
+        }
+        c->state = CL_CONNECTING;
+        c->off = 0;
+        return;
+    }
+}
+
+/* Reads into buf until len bytes are there; -1 on error or EOF, 0 if short */
+static int recv_some(client_conn *c, uint8_t *buf, size_t len) {
+    while (c->off < len) {
+        ssize_t n = read(c->fd, buf + c->off, len - c->off);
+        if (n > 0) c->off += (size_t)n;
+        else if (n < 0 && errno == EINTR) continue;
+        else return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+    return 1;
+}
+
+static void slot_step(load *l, client_conn *c) {
+    const OQS_KEM *kem = l->kem;
+    uint8_t expected[KEM_CONFIRM_LEN];
+    int r, err = 0;
+    socklen_t len = sizeof(err);
+
+    switch (c->state) {
+    case CL_CONNECTING:
+        if (getsockopt(c->fd, SOL_SOCKET, SO_ERROR, &err, &len) != 0 || err != 0) break;
+        c->state = CL_READ_PK;
+        c->off = 0;
+        watch(l, c, EPOLLIN);
+        return;
+    case CL_READ_PK:
+        if ((r = recv_some(c, c->pk, kem->length_public_key)) <= 0) {
+            if (r == 0) return;
+            break;
+        }
+        if (OQS_KEM_encaps(kem, c->ct, c->ss, c->pk) != OQS_SUCCESS) break;
+        c->state = CL_SEND_CT;
+        c->off = 0;
+        /* fall through */
+    case CL_SEND_CT:
+        while (c->off < kem->length_ciphertext) {
+            ssize_t n = write(c->fd, c->ct + c->off, kem->length_ciphertext - c->off);
+            if (n >= 0) {
+                c->off += (size_t)n;
+            } else if (errno == EINTR) {
+                continue;
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                watch(l, c, EPOLLOUT);
+                return;
+            } else {
+                goto failed;
+            }
+        }
+        c->state = CL_READ_CONFIRM;
+        c->off = 0;
+        watch(l, c, EPOLLIN);
+        return;
+    case CL_READ_CONFIRM:
+        if ((r = recv_some(c, c->confirm, KEM_CONFIRM_LEN)) <= 0) {
+            if (r == 0) return;
+            break;
+        }
+        kem_confirm(c->ss, kem->length_shared_secret, expected);
+        OQS_MEM_cleanse(c->ss, kem->length_shared_secret);
+        if (CRYPTO_memcmp(expected, c->confirm, KEM_CONFIRM_LEN) != 0) break;
+        slot_close(l, c, 1);
+        slot_start(l, c);
+        return;
+    }
+
+failed:
+    slot_close(l, c, 0);
+    slot_start(l, c);
+}
+
+static int run_level(const OQS_KEM *kem, const struct sockaddr_in *addr,
+                     size_t concurrency, size_t handshakes) {
+    struct epoll_event events[MAX_EVENTS];
+    load l;
+    pqc_stats st;
+    size_t per_conn = kem->length_public_key + kem->length_ciphertext + kem->length_shared_secret;
+    uint8_t *bufs = NULL;
+    uint64_t t0, total;
+    int ret = 0;
+
+    memset(&l, 0, sizeof(l));
+    l.kem = kem;
+    l.addr = *addr;
+    l.concurrency = concurrency;
+    l.target = handshakes;
+    l.epfd = epoll_create1(0);
+    l.conns = calloc(concurrency, sizeof(client_conn));
+    l.latency_ns = malloc(handshakes * sizeof(uint64_t));
+    bufs = malloc(concurrency * per_conn);
+    if (l.epfd < 0 || !l.conns || !l.latency_ns || !bufs) {
+        handle_error("Setting up the load generator failed");
+        goto cleanup;
+    }
+    for (size_t i = 0; i < concurrency; i++) {
+        client_conn *c = &l.conns[i];
+        c->fd = -1;
+        c->pk = bufs + i * per_conn;
+        c->ct = c->pk + kem->length_public_key;
+        c->ss = c->ct + kem->length_ciphertext;
+    }
+
+    t0 = pqc_now_ns();
+    for (size_t i = 0; i < concurrency; i++) slot_start(&l, &l.conns[i]);
+
+    while (l.completed + l.failed < l.target) {
+        int n = epoll_wait(l.epfd, events, MAX_EVENTS, 5000);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            handle_error("epoll_wait");
+            goto cleanup;
+        }
+        if (n == 0) {
+            printf("❌ No progress for 5 s (%zu done, %zu failed); is kem_server running?\n",
+                   l.completed, l.failed);
+            goto cleanup;
+        }
+        for (int i = 0; i < n; i++) slot_step(&l, events[i].data.ptr);
+    }
+
+    total = pqc_now_ns() - t0;
+    if (pqc_metrics_enabled()) {
+        pqc_metrics_sizes sizes = { kem->length_public_key, 0, kem->length_ciphertext, kem->length_shared_secret, 0 };
+        char impl[32];
+
+        snprintf(impl, sizeof(impl), "concurrency=%zu", concurrency);
+        pqc_metrics_emit_samples(kem->method_name, "handshake", impl, l.latency_ns, l.completed, total, &sizes);
+    }
+    pqc_stats_compute(&st, l.latency_ns, NULL, l.completed, total);
+    printf("  %11zu %12.0f %10.2f %10.2f %10.2f %10.2f %8zu\n", concurrency, st.ops_per_sec,
+           st.median_ns / 1e6, pqc_percentile(l.latency_ns, l.completed, 90.0) / 1e6,
+           st.p99_ns / 1e6, st.max_ns / 1e6, l.failed);
+    ret = l.completed > 0;
+
+cleanup:
+    for (size_t i = 0; l.conns && i < concurrency; i++)
+        if (l.conns[i].fd >= 0) close(l.conns[i].fd);
+    if (bufs) OQS_MEM_cleanse(bufs, concurrency * per_conn);
+    free(bufs);
+    free(l.latency_ns);
+    free(l.conns);
+    if (l.epfd >= 0) close(l.epfd);
+    return ret;
+}
+
+static void usage(const char *prog) {
+    printf("Usage: %s [-a algorithm] [-p port] [-n handshakes] [-c concurrency]\n", prog);
+    printf("  -a  KEM algorithm, must match the server (default %s)\n", KEM_DEFAULT_ALG);
+    printf("  -p  server port on 127.0.0.1 (default %d)\n", KEM_DEFAULT_PORT);
+    printf("  -n  handshakes per concurrency level (default %d)\n", DEFAULT_HANDSHAKES);
+    printf("  -c  concurrent connections (default: 1, 10, 100 and 1000 in turn)\n");
+}
+
+int main(int argc, char *argv[]) {
+    static const size_t levels[] = { 1, 10, 100, 1000 };
+    const char *alg = KEM_DEFAULT_ALG;
+    int port = KEM_DEFAULT_PORT;
+    size_t handshakes = DEFAULT_HANDSHAKES, concurrency = 0;
+    struct sockaddr_in addr;
+    OQS_KEM *kem = NULL;
+    long fd_limit;
+    int ret = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) alg = argv[++i];
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) port = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) handshakes = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) concurrency = strtoul(argv[++i], NULL, 10);
+        else { usage(argv[0]); return 1; }
+    }
+    if (handshakes < 1) handshakes = 1;
+    pqc_metrics_init("kem_client");
+
+    printf("🎯 ML-KEM Handshake Load Test\n");
+    printf("=============================\n");
+
+    if (!OQS_KEM_alg_is_enabled(alg) || !(kem = OQS_KEM_new(alg))) {
+        printf("❌ Algorithm '%s' is not enabled\n", alg);
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN);
+    fd_limit = kem_raise_fd_limit();
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    printf("Server: 127.0.0.1:%d, %s, %zu handshakes per level\n\n", port, alg, handshakes);
+    printf("  %11s %12s %10s %10s %10s %10s %8s\n", "concurrency", "handshake/s",
+           "p50 ms", "p90 ms", "p99 ms", "max ms", "failed");
+
+    for (size_t i = 0; i < sizeof(levels) / sizeof(levels[0]); i++) {
+        size_t c = concurrency ? concurrency : levels[i];
+
+        if (fd_limit > 0 && c + 16 > (size_t)fd_limit) {
+            printf("  %11zu  skipped: open file limit is %ld\n", c, fd_limit);
+        } else if (!run_level(kem, &addr, c, handshakes)) {
+            goto cleanup;
+        }
+        if (concurrency) break;
+    }
+
+    printf("\n✨ Load test completed!\n");
+    ret = 0;
+
+cleanup:
+    OQS_KEM_free(kem);
+    return ret;
+}
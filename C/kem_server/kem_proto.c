@@ -0,0 +1,42 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <sys/resource.h>
+
+#include <openssl/evp.h>
+
+#include "kem_proto.h"
+
+static const char confirm_label[] = "kem_server key confirmation";
+
+void kem_confirm(const uint8_t *ss, size_t ss_len, uint8_t confirm[KEM_CONFIRM_LEN]) {
+    EVP_MD_CTX *md = EVP_MD_CTX_new();
+    unsigned int len = KEM_CONFIRM_LEN;
+
+    if (!md
+        || !EVP_DigestInit_ex(md, EVP_sha256(), NULL)
+        || !EVP_DigestUpdate(md, confirm_label, sizeof(confirm_label) - 1)
+        || !EVP_DigestUpdate(md, ss, ss_len)
+        || !EVP_DigestFinal_ex(md, confirm, &len)) {
+        /* An all-zero confirmation never matches a real one */
+        for (int i = 0; i < KEM_CONFIRM_LEN; i++) confirm[i] = 0;
+    }
+    EVP_MD_CTX_free(md);
+}
+
+int kem_set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+long kem_raise_fd_limit(void) {
+    struct rlimit rl;
+
+    if (getrlimit(RLIMIT_NOFILE, &rl) != 0) return -1;
+    if (rl.rlim_cur < rl.rlim_max) {
+        rl.rlim_cur = rl.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &rl);
+        getrlimit(RLIMIT_NOFILE, &rl);
+    }
+    return (long)rl.rlim_cur;
+}
@@ -0,0 +1,32 @@
+#ifndef KEM_PROTO_H
+#define KEM_PROTO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Wire protocol shared by kem_server and kem_client. One handshake per TCP
+ * connection, the mlkem_example.c flow split across two processes:
+ *
+ *   server -> client   public key          (kem->length_public_key bytes)
+ *   client -> server   ciphertext          (kem->length_ciphertext bytes)
+ *   server -> client   key confirmation    (KEM_CONFIRM_LEN bytes)
+ *
+ * Both sides know the algorithm, so there is no framing. The confirmation is
+ * SHA-256 over a label and the decapsulated secret; the client compares it
+ * with its own, which stands in for the memcmp of the two secrets without
+ * sending the secret over the wire.
+ */
+
+#define KEM_DEFAULT_ALG  "ML-KEM-768"
+#define KEM_DEFAULT_PORT 9443
+#define KEM_CONFIRM_LEN  32
+
+void kem_confirm(const uint8_t *ss, size_t ss_len, uint8_t confirm[KEM_CONFIRM_LEN]);
+
+int kem_set_nonblocking(int fd);
+
+/* Raises the soft open-file limit to the hard limit; returns the new limit. */
+long kem_raise_fd_limit(void);
+
+#endif /* KEM_PROTO_H */
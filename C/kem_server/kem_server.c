@@ -0,0 +1,424 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include "oqs/oqs.h"
+
+#include "kem_proto.h"
+#include "pqc_arena.h"
+#include "pqc_metrics.h"
+#include "pqc_sched.h"
+#include "pqc_timer.h"
+
+/*
+ * ML-KEM handshake server. One thread runs an epoll loop that accepts
+ * connections, sends the public key and reads ciphertexts; decapsulation,
+ * the expensive part, goes to a pqc_sched work-stealing pool whose workers
+ * are pinned per CPU or per NUMA node (-P). Each worker decapsulates with its
+ * own copy of the secret key, allocated on its node. Finished connections
+ * come back to the loop through a completion list and an eventfd, and the
+ * loop writes the confirmation and closes. Only the loop touches sockets and
+ * epoll, only workers call OQS_KEM_decaps.
+ */
+
+#define MAX_EVENTS 256
+
+typedef enum { CONN_SEND_PK, CONN_READ_CT, CONN_DECAPS, CONN_SEND_CONFIRM } conn_state;
+
+typedef struct conn {
+    int fd;
+    conn_state state;
+    struct server *srv;         /* for the decapsulation job */
+    size_t off;                 /* bytes of the current message done */
+    int ok;                     /* decapsulation succeeded */
+    uint8_t confirm[KEM_CONFIRM_LEN];
+    struct conn *next;          /* completion list link */
+    uint8_t ct[];               /* kem->length_ciphertext bytes */
+} conn;
+
+typedef struct server {
+    OQS_KEM *kem;
+    uint8_t *pk;
+    uint8_t *sk;
+
+    int epfd;
+    int listen_fd;
+    int done_fd;                /* eventfd: workers -> loop */
+
+    pthread_mutex_t lock;       /* done list and decaps */
+    conn *done;                 /* finished, not yet picked up by the loop */
+    pqc_hist *decaps;           /* workers' latencies, merged as they stop; NULL without PQC_METRICS */
+
+    pqc_sched *sched;
+
+    uint64_t handshakes;
+    uint64_t failures;
+} server;
+
+/* Tags for the two non-connection fds in epoll_event.data.ptr */
+static char listen_tag, done_tag;
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig) {
+    (void)sig;
+    stop = 1;
+}
+
+/* Per-worker state: the secret key and shared secret buffer, node-local */
+typedef struct {
+    pqc_arena *arena;
+    uint8_t *sk;
+    uint8_t *ss;
+    pqc_hist *decaps;           /* with PQC_METRICS set */
+} worker_keys;
+
+static void *worker_init(pqc_worker *w, void *arg) {
+    server *s = arg;
+    size_t sk_len = s->kem->length_secret_key, ss_len = s->kem->length_shared_secret;
+    worker_keys *k = malloc(sizeof(*k));
+
+    (void)w;
+    if (!k) return NULL;
+    /* Allocated and written on the pinned thread, so first touch places it on its node */
+    if (!(k->arena = pqc_arena_new(pqc_arena_size(sk_len) + pqc_arena_size(ss_len)))) {
+        free(k);
+        return NULL;
+    }
+    k->sk = pqc_arena_alloc_secret(k->arena, sk_len);
+    k->ss = pqc_arena_alloc_secret(k->arena, ss_len);
+    memcpy(k->sk, s->sk, sk_len);
+    k->decaps = NULL;
+    if (s->decaps && !(k->decaps = pqc_hist_new())) {
+        pqc_arena_free(k->arena);
+        free(k);
+        return NULL;
+    }
+    return k;
+}
+
+static void worker_fini(pqc_worker *w, void *arg) {
+    server *s = arg;
+    worker_keys *k = w->local;
+
+    if (k->decaps) {
+        pthread_mutex_lock(&s->lock);
+        pqc_hist_merge(s->decaps, k->decaps);
+        pthread_mutex_unlock(&s->lock);
+        pqc_hist_free(k->decaps);
+    }
+    pqc_arena_free(k->arena);
+    free(k);
+}
+
+static void decaps_run(pqc_worker *w, void *arg) {
+    conn *c = arg;
+    server *s = c->srv;
+    worker_keys *k = w->local;
+    uint64_t one = 1, t0 = pqc_now_ns();
+
+    c->ok = OQS_KEM_decaps(s->kem, k->ss, c->ct, k->sk) == OQS_SUCCESS;
+    if (c->ok && k->decaps) pqc_hist_record(k->decaps, pqc_now_ns() - t0);
+    if (c->ok) kem_confirm(k->ss, s->kem->length_shared_secret, c->confirm);
+    OQS_MEM_cleanse(k->ss, s->kem->length_shared_secret);
+
+    pthread_mutex_lock(&s->lock);
+    c->next = s->done;
+    s->done = c;
+    pthread_mutex_unlock(&s->lock);
+    if (write(s->done_fd, &one, sizeof(one)) < 0 && errno != EAGAIN)
+        perror("eventfd write");
+}
+
+static void conn_close(server *s, conn *c) {
+    epoll_ctl(s->epfd, EPOLL_CTL_DEL, c->fd, NULL);
+    close(c->fd);
+    free(c);
+}
+
+static int conn_watch(server *s, conn *c, uint32_t events) {
+    struct epoll_event ev = { .events = events, .data.ptr = c };
+    return epoll_ctl(s->epfd, EPOLL_CTL_MOD, c->fd, &ev);
+}
+
+/* Writes as much of buf as the socket takes; 1 when all of it is out */
+static int send_some(conn *c, const uint8_t *buf, size_t len, int *err) {
+    while (c->off < len) {
+        ssize_t n = write(c->fd, buf + c->off, len - c->off);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            *err = errno != EAGAIN && errno != EWOULDBLOCK;
+            return 0;
+        }
+        c->off += (size_t)n;
+    }
+    return 1;
+}
+
+/* Drives one connection as far as it can go without blocking */
+static void conn_step(server *s, conn *c) {
+    int err = 0;
+
+    switch (c->state) {
+    case CONN_SEND_PK:
+        if (!send_some(c, s->pk, s->kem->length_public_key, &err)) break;
+        c->state = CONN_READ_CT;
+        c->off = 0;
+        conn_watch(s, c, EPOLLIN);
+        /* The ciphertext may already be there */
+        /* fall through */
+    case CONN_READ_CT:
+        while (c->off < s->kem->length_ciphertext) {
+            ssize_t n = read(c->fd, c->ct + c->off, s->kem->length_ciphertext - c->off);
+            if (n > 0) {
+                c->off += (size_t)n;
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else {
+                err = n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+                break;
+            }
+        }
+        if (err || c->off < s->kem->length_ciphertext) break;
+
+        /* Out of epoll while a worker has it, or a hangup would spin the loop */
+        c->state = CONN_DECAPS;
+        epoll_ctl(s->epfd, EPOLL_CTL_DEL, c->fd, NULL);
+        c->srv = s;
+        if (!pqc_sched_submit(s->sched, decaps_run, c)) {
+            s->failures++;
+            close(c->fd);
+            free(c);
+        }
+        return;
+    case CONN_DECAPS:
+        return;
+    case CONN_SEND_CONFIRM:
+        if (!send_some(c, c->confirm, KEM_CONFIRM_LEN, &err)) break;
+        s->handshakes++;
+        conn_close(s, c);
+        return;
+    }
+
+    if (err) {
+        s->failures++;
+        conn_close(s, c);
+    } else if (c->state != CONN_READ_CT) {
+        conn_watch(s, c, EPOLLOUT);
+    }
+}
+
+static void accept_all(server *s) {
+    size_t size = sizeof(conn) + s->kem->length_ciphertext;
+
+    for (;;) {
+        int fd = accept(s->listen_fd, NULL, NULL), one = 1;
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) perror("accept");
+            return;
+        }
+
+        conn *c = malloc(size);
+        struct epoll_event ev = { .events = 0, .data.ptr = c };
+        if (!c || !kem_set_nonblocking(fd)
+            || epoll_ctl(s->epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            free(c);
+            close(fd);
+            s->failures++;
+            continue;
+        }
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        c->fd = fd;
+        c->state = CONN_SEND_PK;
+        c->off = 0;
+        conn_step(s, c);
+    }
+}
+
+/* Picks up connections the workers have finished with */
+static void collect_done(server *s) {
+    uint64_t count;
+    conn *c, *next;
+
+    if (read(s->done_fd, &count, sizeof(count)) < 0 && errno != EAGAIN) perror("eventfd read");
+
+    pthread_mutex_lock(&s->lock);
+    c = s->done;
+    s->done = NULL;
+    pthread_mutex_unlock(&s->lock);
+
+    for (; c; c = next) {
+        struct epoll_event ev = { .events = 0, .data.ptr = c };
+
+        next = c->next;
+        if (!c->ok || epoll_ctl(s->epfd, EPOLL_CTL_ADD, c->fd, &ev) != 0) {
+            s->failures++;
+            conn_close(s, c);
+            continue;
+        }
+        c->state = CONN_SEND_CONFIRM;
+        c->off = 0;
+        conn_step(s, c);
+    }
+}
+
+static int listen_on(int port) {
+    struct sockaddr_in addr;
+    int fd = socket(AF_INET, SOCK_STREAM, 0), one = 1;
+
+    if (fd < 0) return -1;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0
+        || listen(fd, 4096) != 0 || !kem_set_nonblocking(fd)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void usage(const char *prog) {
+    printf("Usage: %s [-a algorithm] [-p port] [-w workers] [-P none|core|node]\n", prog);
+    printf("  -a  KEM algorithm (default %s)\n", KEM_DEFAULT_ALG);
+    printf("  -p  TCP port on 127.0.0.1 (default %d)\n", KEM_DEFAULT_PORT);
+    printf("  -w  decapsulation worker threads (default: one per CPU)\n");
+    printf("  -P  pin workers to a CPU or to a NUMA node (default core)\n");
+}
+
+int main(int argc, char *argv[]) {
+    const char *alg = KEM_DEFAULT_ALG;
+    int port = KEM_DEFAULT_PORT;
+    pqc_sched_config sc = { 0, PQC_PIN_CORE, worker_init, worker_fini, NULL };
+    uint64_t started, t0, keygen_ns;
+    pqc_metrics_sizes sizes = { 0, 0, 0, 0, 0 };
+    char impl[48];
+    struct epoll_event events[MAX_EVENTS];
+    struct sigaction sa;
+    server s;
+    int ret = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) alg = argv[++i];
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) port = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) sc.workers = (unsigned)atoi(argv[++i]);
+        else if (strcmp(argv[i], "-P") == 0 && i + 1 < argc && pqc_sched_parse_pin(argv[i + 1], &sc.pin)) i++;
+        else { usage(argv[0]); return 1; }
+    }
+
+    memset(&s, 0, sizeof(s));
+    s.epfd = s.listen_fd = s.done_fd = -1;
+    pthread_mutex_init(&s.lock, NULL);
+
+    printf("🎯 ML-KEM Handshake Server\n");
+    printf("==========================\n");
+
+    if (pqc_metrics_init("kem_server") && !(s.decaps = pqc_hist_new())) goto cleanup;
+
+    if (!OQS_KEM_alg_is_enabled(alg) || !(s.kem = OQS_KEM_new(alg))) {
+        printf("❌ Algorithm '%s' is not enabled\n", alg);
+        goto cleanup;
+    }
+    sizes.pk = s.kem->length_public_key;
+    sizes.sk = s.kem->length_secret_key;
+    sizes.ct = s.kem->length_ciphertext;
+    sizes.ss = s.kem->length_shared_secret;
+
+    printf("1. 🔑 Generating %s key pair...\n", alg);
+    s.pk = malloc(s.kem->length_public_key);
+    s.sk = malloc(s.kem->length_secret_key);
+    t0 = pqc_now_ns();
+    if (!s.pk || !s.sk || OQS_KEM_keypair(s.kem, s.pk, s.sk) != OQS_SUCCESS) {
+        printf("❌ Key generation failed\n");
+        goto cleanup;
+    }
+    keygen_ns = pqc_now_ns() - t0;
+    pqc_metrics_emit_samples(s.kem->method_name, "keygen", "liboqs", &keygen_ns, 1, 0, &sizes);
+
+    kem_raise_fd_limit();
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;         /* no SA_RESTART: epoll_wait returns EINTR */
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    s.listen_fd = listen_on(port);
+    s.epfd = epoll_create1(0);
+    s.done_fd = eventfd(0, EFD_NONBLOCK);
+    struct epoll_event lev = { .events = EPOLLIN, .data.ptr = &listen_tag };
+    struct epoll_event dev = { .events = EPOLLIN, .data.ptr = &done_tag };
+    if (s.listen_fd < 0 || s.epfd < 0 || s.done_fd < 0
+        || epoll_ctl(s.epfd, EPOLL_CTL_ADD, s.listen_fd, &lev) != 0
+        || epoll_ctl(s.epfd, EPOLL_CTL_ADD, s.done_fd, &dev) != 0) {
+        printf("❌ Cannot listen on 127.0.0.1:%d: %s\n", port, strerror(errno));
+        goto cleanup;
+    }
+
+    sc.arg = &s;
+    if (!(s.sched = pqc_sched_new(&sc))) {
+        printf("❌ Failed to start the decapsulation workers\n");
+        goto cleanup;
+    }
+
+    printf("2. 🌐 Listening on 127.0.0.1:%d, %u decapsulation worker(s) on %u NUMA node(s), pinned per %s\n",
+           port, pqc_sched_workers(s.sched), pqc_sched_nodes(s.sched), pqc_sched_pin_name(sc.pin));
+    printf("   Ctrl-C to stop\n");
+    fflush(stdout);
+
+    started = pqc_now_ns();
+    while (!stop) {
+        int n = epoll_wait(s.epfd, events, MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("epoll_wait");
+            break;
+        }
+        for (int i = 0; i < n; i++) {
+            void *tag = events[i].data.ptr;
+            if (tag == &listen_tag) accept_all(&s);
+            else if (tag == &done_tag) collect_done(&s);
+            else conn_step(&s, tag);
+        }
+    }
+
+    printf("\n3. 📊 Served %llu handshakes, %llu failed\n",
+           (unsigned long long)s.handshakes, (unsigned long long)s.failures);
+    pqc_sched_report(s.sched, pqc_now_ns() - started);
+    printf("\n✨ Server stopped\n");
+    ret = 0;
+
+cleanup:
+    /* Before done_fd closes: queued jobs still run and post their completions */
+    pqc_sched_free(s.sched);
+    /* Workers merged their decapsulation latencies as they stopped */
+    if (s.decaps && s.decaps->samples) {
+        snprintf(impl, sizeof(impl), "liboqs,pin=%s", pqc_sched_pin_name(sc.pin));
+        pqc_metrics_emit(s.kem->method_name, "decaps", impl, s.decaps, 0, &sizes);
+    }
+    pqc_hist_free(s.decaps);
+    /* Connections still open are reclaimed by the kernel and the allocator at exit */
+    if (s.done_fd >= 0) close(s.done_fd);
+    if (s.epfd >= 0) close(s.epfd);
+    if (s.listen_fd >= 0) close(s.listen_fd);
+    if (s.sk) OQS_MEM_cleanse(s.sk, s.kem->length_secret_key);
+    free(s.sk);
+    free(s.pk);
+    OQS_KEM_free(s.kem);
+    pthread_mutex_destroy(&s.lock);
+    return ret;
+}
@@ -0,0 +1,232 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/err.h>
+#include <openssl/rand.h>
+
+#include "pqc_keystore.h"
+#include "pqc_metrics.h"
+#include "pqc_timer.h"
+
+/*
+ * Multi-tenant keystore benchmark. Every tenant gets an ML-DSA-65 signing
+ * key and an ML-KEM-768 key. Generating 100k real key pairs would dominate
+ * the run, so a small pool of real keys is generated and reused across
+ * tenants; the keystore stores every copy separately, so file size and
+ * lookup costs are those of distinct keys.
+ *
+ * Measures: writing the keystore, opening it (the startup cost), ID lookups,
+ * and turning a stored key into an EVP_PKEY, against PEM parsing of the same
+ * key. With "seed" as the third argument private keys are stored as seeds.
+ *
+ * The keystore holds real private keys, so without a path (or with "-") it
+ * is a scratch file, deleted at exit (pqc_keystore_demo_path()).
+ */
+
+#define REAL_KEYS 8
+#define LOADS     1000
+
+static const char *const algs[] = { "ML-DSA-65", "ML-KEM-768" };
+
+static void handle_openssl_error(const char *msg) {
+    fprintf(stderr, "ERROR: %s\n", msg);
+    ERR_print_errors_fp(stderr);
+}
+
+static void key_id(char *out, size_t tenant, int kem) {
+    snprintf(out, PQC_KEYSTORE_ID_LEN + 1, "tenant-%07zu/%s", tenant, kem ? "kem" : "sig");
+}
+
+/* Signs with the loaded ML-DSA key and verifies with the original */
+static int check_roundtrip(EVP_PKEY *loaded, EVP_PKEY *original) {
+    static const unsigned char msg[] = "keystore round trip";
+    unsigned char sig[4096];
+    size_t sig_len = sizeof(sig);
+    EVP_PKEY_CTX *sctx = EVP_PKEY_CTX_new_from_pkey(NULL, loaded, NULL);
+    EVP_PKEY_CTX *vctx = EVP_PKEY_CTX_new_from_pkey(NULL, original, NULL);
+    EVP_SIGNATURE *alg = EVP_SIGNATURE_fetch(NULL, "ML-DSA-65", NULL);
+    int ok = sctx && vctx && alg
+        && EVP_PKEY_sign_message_init(sctx, alg, NULL) > 0
+        && EVP_PKEY_sign(sctx, sig, &sig_len, msg, sizeof(msg) - 1) > 0
+        && EVP_PKEY_verify_message_init(vctx, alg, NULL) > 0
+        && EVP_PKEY_verify(vctx, sig, sig_len, msg, sizeof(msg) - 1) == 1;
+
+    EVP_SIGNATURE_free(alg);
+    EVP_PKEY_CTX_free(vctx);
+    EVP_PKEY_CTX_free(sctx);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    size_t tenants = argc > 1 ? strtoul(argv[1], NULL, 10) : 50000;
+    const char *path = argc > 2 && strcmp(argv[2], "-") != 0 ? argv[2] : NULL;
+    unsigned flags = argc > 3 && strcmp(argv[3], "seed") == 0 ? PQC_KEYSTORE_SEED : 0;
+    EVP_PKEY *pool[2][REAL_KEYS] = { { NULL } };
+    pqc_keystore_writer *w = NULL;
+    pqc_keystore *ks = NULL;
+    BIO *pem = NULL;
+    pqc_hist *hist = NULL;
+    pqc_metrics_sizes sizes = { 0, 0, 0, 0, 0 };
+    pqc_key_ref ref;
+    char id[PQC_KEYSTORE_ID_LEN + 1], scratch_path[4096];
+    uint64_t t0, ns;
+    int ret = 1, scratch = 0;
+
+    if (pqc_metrics_init("keystore_bench") && !(hist = pqc_hist_new())) goto cleanup;
+    if (!path) {
+        if (!pqc_keystore_demo_path(scratch_path, sizeof(scratch_path), "keystore_bench.pqks", &scratch)) {
+            fprintf(stderr, "ERROR: Cannot create a scratch directory for the keystore\n");
+            goto cleanup;
+        }
+        path = scratch_path;
+    }
+    printf("🎯 Memory-Mapped Keystore\n");
+    printf("=========================\n");
+    if (tenants < 1) tenants = 1;
+
+    printf("1. 🔑 Generating %d real key pairs per algorithm...\n", REAL_KEYS);
+    for (int a = 0; a < 2; a++) {
+        for (int i = 0; i < REAL_KEYS; i++) {
+            pool[a][i] = EVP_PKEY_Q_keygen(NULL, NULL, algs[a]);
+            if (!pool[a][i]) {
+                handle_openssl_error("Key generation failed");
+                goto cleanup;
+            }
+        }
+    }
+
+    printf("2. 💾 Writing %zu keys (%zu tenants x %s + %s), private keys as %s...\n",
+           2 * tenants, tenants, algs[0], algs[1], flags ? "seeds" : "expanded keys");
+    w = pqc_keystore_writer_new();
+    t0 = pqc_now_ns();
+    for (size_t t = 0; t < tenants && w; t++) {
+        for (int a = 0; a < 2; a++) {
+            key_id(id, t, a);
+            if (!pqc_keystore_writer_add_pkey(w, id, pool[a][t % REAL_KEYS], flags)) {
+                handle_openssl_error("Failed to add key");
+                goto cleanup;
+            }
+        }
+    }
+    if (!w || !pqc_keystore_writer_commit(w, path)) {
+        printf("❌ Failed to write %s\n", path);
+        goto cleanup;
+    }
+    struct stat st;
+    ns = pqc_now_ns() - t0;
+    if (stat(path, &st) != 0) st.st_size = 0;
+    printf("✅ Wrote %s in %.1f ms: %.1f MB, %.0f bytes per tenant\n", path, (double)ns / 1e6,
+           (double)st.st_size / 1e6, (double)st.st_size / (double)tenants);
+    pqc_keystore_writer_free(w);
+    w = NULL;
+
+    printf("\n3. 📂 Opening keystore...\n");
+    t0 = pqc_now_ns();
+    ks = pqc_keystore_open(path);
+    ns = pqc_now_ns() - t0;
+    if (!ks || pqc_keystore_count(ks) != 2 * tenants) {
+        printf("❌ Failed to open %s\n", path);
+        goto cleanup;
+    }
+    printf("✅ %zu keys ready in %.3f ms\n", pqc_keystore_count(ks), (double)ns / 1e6);
+
+    printf("\n4. 🔍 Random lookups by key ID...\n");
+    size_t lookups = 2 * tenants < 200000 ? 2 * tenants : 200000, found = 0;
+    unsigned touched = 0;
+    t0 = pqc_now_ns();
+    for (size_t i = 0; i < lookups; i++) {
+        uint32_t r;
+        RAND_bytes((unsigned char *)&r, sizeof(r));
+        key_id(id, r % tenants, (int)(i & 1));
+        if (pqc_keystore_find(ks, id, &ref)) {
+            found++;
+            touched += ref.priv[0] + ref.pub[ref.pub_len - 1];  /* fault in the key pages */
+        }
+    }
+    ns = pqc_now_ns() - t0;
+    printf("✅ %zu/%zu found, %.0f ns per lookup (incl. RNG)\n",
+           found, lookups, (double)ns / (double)lookups);
+    (void)touched;
+    if (found != lookups || pqc_keystore_find(ks, "tenant-missing/sig", &ref)) {
+        printf("❌ Lookup results are wrong\n");
+        goto cleanup;
+    }
+
+    printf("\n5. ⚙️  Loading %s keys into OpenSSL (%d each)...\n", algs[0], LOADS);
+    pem = BIO_new(BIO_s_mem());
+    if (!pem || !PEM_write_bio_PrivateKey(pem, pool[0][0], NULL, NULL, 0, NULL, NULL)) {
+        handle_openssl_error("Failed to write PEM");
+        goto cleanup;
+    }
+    char *pem_data;
+    long pem_len = BIO_get_mem_data(pem, &pem_data);
+
+    key_id(id, 0, 0);           /* tenant 0 holds pool[0][0] */
+    if (pqc_keystore_find(ks, id, &ref)) {
+        sizes.pk = ref.pub_len;
+        sizes.sk = ref.priv_len;
+    }
+
+    t0 = pqc_now_ns();
+    for (int i = 0; i < LOADS; i++) {
+        uint64_t t = pqc_now_ns();
+        BIO *in = BIO_new_mem_buf(pem_data, (int)pem_len);
+        EVP_PKEY *k = in ? PEM_read_bio_PrivateKey(in, NULL, NULL, NULL) : NULL;
+        BIO_free(in);
+        if (!k) {
+            handle_openssl_error("PEM parse failed");
+            goto cleanup;
+        }
+        EVP_PKEY_free(k);
+        if (hist) pqc_hist_record(hist, pqc_now_ns() - t);
+    }
+    ns = pqc_now_ns() - t0;
+    double pem_us = (double)ns / 1e3 / LOADS;
+    if (hist) {
+        pqc_metrics_emit(algs[0], "load", "pem", hist, ns, &sizes);
+        pqc_hist_reset(hist);
+    }
+
+    t0 = pqc_now_ns();
+    for (int i = 0; i < LOADS; i++) {
+        uint64_t t = pqc_now_ns();
+        EVP_PKEY *k = pqc_keystore_load(ks, NULL, id);
+        if (!k) {
+            handle_openssl_error("Keystore load failed");
+            goto cleanup;
+        }
+        EVP_PKEY_free(k);
+        if (hist) pqc_hist_record(hist, pqc_now_ns() - t);
+    }
+    ns = pqc_now_ns() - t0;
+    double ks_us = (double)ns / 1e3 / LOADS;
+    if (hist) pqc_metrics_emit(algs[0], "load", flags ? "keystore-seed" : "keystore", hist, ns, &sizes);
+
+    printf("  %-22s %10.1f µs/key\n", "PEM_read_bio_PrivateKey", pem_us);
+    printf("  %-22s %10.1f µs/key (%.2fx)\n", "pqc_keystore_load", ks_us, pem_us / ks_us);
+
+    EVP_PKEY *loaded = pqc_keystore_load(ks, NULL, id);
+    int same = loaded && EVP_PKEY_eq(loaded, pool[0][0]) == 1 && check_roundtrip(loaded, pool[0][0]);
+    EVP_PKEY_free(loaded);
+    printf("%s Loaded key matches the generated one and signs\n", same ? "✅" : "❌");
+    if (!same) goto cleanup;
+
+    printf("\n✨ Benchmark completed!\n");
+    ret = 0;
+
+cleanup:
+    pqc_hist_free(hist);
+    BIO_free(pem);
+    pqc_keystore_close(ks);
+    pqc_keystore_writer_free(w);
+    if (scratch) pqc_keystore_remove_scratch(path);
+    for (int a = 0; a < 2; a++)
+        for (int i = 0; i < REAL_KEYS; i++) EVP_PKEY_free(pool[a][i]);
+    return ret;
+}
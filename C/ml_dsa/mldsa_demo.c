@@ -1,3 +1,5 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -9,74 +11,121 @@
 #include <openssl/params.h>
 #include <openssl/ec.h>
 
+#include "pqc_handle_cache.h"
+#include "pqc_keystore.h"
+#include "pqc_metrics.h"
+#include "pqc_timer.h"
+
 static void hexdump(const char *label, const unsigned char *buf, size_t len) {
     printf("%s (%zu bytes): ", label, len);
     for (size_t i = 0; i < len; i++) printf("%02X", buf[i]);
     printf("\n");
 }
 
-static EVP_PKEY *generate_keys(unsigned char *type) {
- 
+/* One metrics record per operation with PQC_METRICS=json|csv (pqc_metrics.h) */
+static pqc_metrics_sizes sizes;
+
+static void emit(const unsigned char *type, const char *op, uint64_t ns) {
+    pqc_metrics_emit_samples((const char *)type, op, "openssl", &ns, 1, 0, &sizes);
+}
 
-    EVP_PKEY *pkey = NULL;
+/* Key pairs are persisted to a keystore and read back through its mapping;
+ * PQC_KEYSTORE=file keeps it, else it is a scratch file (pqc_keystore.h) */
+#define KEYSTORE_NAME "mldsa_keys.pqks"
 
-    EVP_PKEY_CTX *kctx = EVP_PKEY_CTX_new_from_name(NULL, type, NULL);
+static EVP_PKEY *generate_keys(unsigned char *type) {
+ 
 
+    EVP_PKEY *pkey = NULL, *stored = NULL;
+    pqc_keystore_writer *w = pqc_keystore_writer_new();
+    pqc_keystore *ks = NULL;
+    pqc_key_ref ref;
+    char path[4096];
+    int scratch = 0;
+    uint64_t t0, keygen_ns;
 
-    EVP_PKEY_keygen_init(kctx);
+    EVP_PKEY_CTX *kctx = pqc_handle_cache_keygen_ctx(NULL, (const char *)type);
 
+    t0 = pqc_now_ns();
     EVP_PKEY_keygen(kctx, &pkey);
+    keygen_ns = pqc_now_ns() - t0;
 
 
     printf("Type: %s\n\n",type);
 
-    uint8_t pub[2592], priv[4896];
-    size_t priv_len, pub_len;
-
-
-    EVP_PKEY_get_octet_string_param(pkey, OSSL_PKEY_PARAM_PRIV_KEY,
-                                priv, sizeof(priv), &priv_len);
-    EVP_PKEY_get_octet_string_param(pkey, OSSL_PKEY_PARAM_PUB_KEY,
-                                pub, sizeof(pub), &pub_len);
-
-
-    printf("Private key length: [%d]\n",priv_len);
-    if (priv_len>500) hexdump("Private key (truncated to 500 bytes):",priv,500);
-    else hexdump("Private key:",priv,priv_len);
-
-    printf("\nPublic key length: [%d]\n",pub_len);
-    if (pub_len>500) hexdump("Public key (truncated to 500 bytes):",pub,500);
-    else hexdump("Private key:",pub,pub_len);
-
-
-
+    /* The key ID is the algorithm name; the raw keys are exported straight into the writer */
+    if (!pqc_keystore_demo_path(path, sizeof(path), KEYSTORE_NAME, &scratch)) goto cleanup;
+    if (!w || !pqc_keystore_writer_add_pkey(w, (const char *)type, pkey, 0)
+        || !pqc_keystore_writer_commit(w, path)
+        || !(ks = pqc_keystore_open(path))
+        || !pqc_keystore_find(ks, (const char *)type, &ref)) {
+        fprintf(stderr, "Failed to persist key to %s\n", path);
+        goto cleanup;
+    }
+    printf("Key pair saved to %s (key ID %s)\n\n", path, type);
+    sizes.pk = ref.pub_len;
+    sizes.sk = ref.priv_len;
+    emit(type, "keygen", keygen_ns);
+
+
+    /* ref points into the mapped file: nothing is copied to print it */
+    printf("Private key length: [%zu]\n",ref.priv_len);
+    if (ref.priv_len>500) hexdump("Private key (truncated to 500 bytes):",ref.priv,500);
+    else hexdump("Private key:",ref.priv,ref.priv_len);
+
+    printf("\nPublic key length: [%zu]\n",ref.pub_len);
+    if (ref.pub_len>500) hexdump("Public key (truncated to 500 bytes):",ref.pub,500);
+    else hexdump("Public key:",ref.pub,ref.pub_len);
+
+    stored = pqc_keystore_load(ks, NULL, (const char *)type);
+
+cleanup:
+    pqc_keystore_close(ks);
+    if (scratch) pqc_keystore_remove_scratch(path);
+    pqc_keystore_writer_free(w);
+    EVP_PKEY_free(pkey);
     EVP_PKEY_CTX_free(kctx);
-    return pkey;
+    return stored;
 }
 
 void do_sign(EVP_PKEY *pkey, unsigned char *msg, size_t msg_len,unsigned char *type )
 {
     size_t sig_len;
     unsigned char *sig = NULL;
+    uint64_t t0, ns;
+    int verified;
     const OSSL_PARAM params[] = {
-        OSSL_PARAM_octet_string("context-string", (unsigned char *)"Context string", 33),
+        OSSL_PARAM_octet_string("context-string", (unsigned char *)"Context string", 14),
         OSSL_PARAM_END
     };
-    EVP_PKEY_CTX *sctx = EVP_PKEY_CTX_new_from_pkey(NULL, pkey, NULL);
-    EVP_SIGNATURE *sig_alg = EVP_SIGNATURE_fetch(NULL, type, NULL);
+    /* Both come from the process-wide cache; sig_alg is borrowed, not freed */
+    EVP_PKEY_CTX *sctx = pqc_handle_cache_pkey_ctx(pkey);
+    EVP_SIGNATURE *sig_alg = pqc_handle_cache_signature(NULL, (const char *)type);
 
     EVP_PKEY_sign_message_init(sctx, sig_alg, params);
 
     /* Get size of signature */
     EVP_PKEY_sign(sctx, NULL, &sig_len, msg, msg_len);
     sig = OPENSSL_zalloc(sig_len);
+    t0 = pqc_now_ns();
     EVP_PKEY_sign(sctx, sig, &sig_len, msg, msg_len);
+    ns = pqc_now_ns() - t0;
+    sizes.sig = sig_len;
+    emit(type, "sign", ns);
 
     printf("\nMessage: [%s]\n",msg);  
     printf("\nSignature length: [%d]\n",sig_len);  
     if (sig_len>500) hexdump("Signature (truncated to 500 bytes):",sig,500);
     else hexdump("Signature:",sig,sig_len);
 
+    /* Same context string; the signing context is reused for verification */
+    t0 = pqc_now_ns();
+    verified = EVP_PKEY_verify_message_init(sctx, sig_alg, params) > 0
+        && EVP_PKEY_verify(sctx, sig, sig_len, msg, msg_len) == 1;
+    ns = pqc_now_ns() - t0;
+    printf("\nSignature verified: [%s]\n", verified ? "yes" : "no");
+    if (verified) emit(type, "verify", ns);
+
     OPENSSL_free(sig);
 
     EVP_PKEY_CTX_free(sctx);
@@ -88,6 +137,7 @@ int main(int argc, char** argv) {
 
     ERR_load_crypto_strings();
     OpenSSL_add_all_algorithms();
+    pqc_metrics_init("mldsa_demo");
 
     unsigned char *type="mldsa87";
     unsigned char *msg="Hello";
@@ -97,8 +147,13 @@ int main(int argc, char** argv) {
     if (argc > 2) msg  =  argv[2];
 
     EVP_PKEY *key = generate_keys(type);
+    if (!key) return EXIT_FAILURE;
     do_sign(key, msg, strlen(msg),type); 
 
+    pqc_handle_cache_forget_pkey(key);
+    EVP_PKEY_free(key);
+    pqc_handle_cache_cleanup();
+
     return EXIT_SUCCESS;
 }
 
@@ -116,4 +171,6 @@ Message: [Hello World!]
 Signature length: [4627]
 Signature (truncated to 500 bytes): (500 bytes): A6CBD1297B8A5B11F355C03E500D5F93CCD6F0AE3B5828687042070C322DE792DD0682FD4438AA9B7D1ECFF14139E4F4A0ED75A8E221E97336AF9F14DECA58BFEFE4CF28D5555C8143F0D874966A4D5EFE57584BA84BB708FFD98898C490BBB98B6E9926814BDB6EF3E9CA14D344EDEF4A691E1C917690CC31B1E646EE137FCEB66AC8BD8C20E3E310C7055AAA98B4A97D4C6F899634BE24626865C98A485622D5D132C9671EEAE002EBC9E6934C2F9BD4C9ECE7F39315D432DEA210467E24C126A5C9E75956B507A31DFB771451EF62FC5B442C9E40A50ECCE5604F75E899C2C5109BFD5012FB61555E0FBCA70D661F081F2B23E5F84179CAF597C4AF9EE0C11556A62DA9E4E178255BCED41EF9A8769355496E29712F86AACB3DD86E76AD35E4D6D4E43AB9C367DB1941CCBF98FAFD2387369BD53C68843E6500F64A0DF2DA7B33F6A077F0E39124BB55FED269CA206757A0841A0B77D01448BB59C2A889C6A43D1525FF18F7834941872B5DCEAF40DB660710EC89DD360B1555DB5DAEFE7A50FAA9E0A46F997689EA075D79B775824BCEC3B7B1B1740650E5CB33AD115E8894C1E8E5B0F376F7BCE2C0B80617081E9612529964153105E45F18AFC1C469C8094814EB583804EDA6530D2BC3354A7054472F1D77E3B1FBE5F7911AF4165196286E2EC743EB3E2203DAB57818E517FBAA5369EB
 
+Signature verified: [yes]
+
 */
\ No newline at end of file
@@ -0,0 +1,511 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <strings.h>
+
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/crypto.h>
+
+#include "mldsa_expanded.h"
+
+#define N 256
+#define Q 8380417
+#define QINV 58728449               /* q^-1 mod 2^32 */
+#define D 13                        /* dropped bits of t */
+#define MAX_K 8
+#define MAX_L 7
+
+#define SEED_BYTES 32
+#define TR_BYTES 64
+#define MU_BYTES 64
+#define SHAKE128_RATE 168
+#define SHAKE256_RATE 136
+#define MAX_Z_BYTES (N * 20 / 8)
+#define MAX_W1_BYTES (MAX_K * N * 6 / 8)
+
+static const mldsa_params param_sets[] = {
+    { "ML-DSA-44", 4, 4, 2, 39,  78, 17, (Q - 1) / 88, 80, 32 },
+    { "ML-DSA-65", 6, 5, 4, 49, 196, 19, (Q - 1) / 32, 55, 48 },
+    { "ML-DSA-87", 8, 7, 2, 60, 120, 19, (Q - 1) / 32, 75, 64 },
+};
+
+const mldsa_params *mldsa_params_get(const char *name) {
+    for (size_t i = 0; i < sizeof(param_sets) / sizeof(param_sets[0]); i++) {
+        if (strcasecmp(name, param_sets[i].name) == 0) return &param_sets[i];
+    }
+    return NULL;
+}
+
+static unsigned eta_bits(const mldsa_params *p) {
+    return p->eta == 2 ? 3 : 4;
+}
+
+static unsigned w1_bits(const mldsa_params *p) {
+    return p->gamma2 == (Q - 1) / 88 ? 6 : 4;
+}
+
+size_t mldsa_sk_len(const mldsa_params *p) {
+    return 2 * SEED_BYTES + TR_BYTES + (p->k + p->l) * N * eta_bits(p) / 8 + p->k * N * D / 8;
+}
+
+size_t mldsa_sig_len(const mldsa_params *p) {
+    return p->ctilde + p->l * N * (p->gamma1_bits + 1) / 8 + p->omega + p->k;
+}
+
+/* ---- Arithmetic mod q, as in the FIPS 204 reference code ---- */
+
+typedef struct {
+    int32_t c[N];
+} poly;
+
+/* zetas[i] = 2^32 * 1753^brv(i) mod q, centred */
+static const int32_t zetas[N] = {
+    0, 25847, -2608894, -518909, 237124, -777960, -876248, 466468,
+    1826347, 2353451, -359251, -2091905, 3119733, -2884855, 3111497, 2680103,
+    2725464, 1024112, -1079900, 3585928, -549488, -1119584, 2619752, -2108549,
+    -2118186, -3859737, -1399561, -3277672, 1757237, -19422, 4010497, 280005,
+    2706023, 95776, 3077325, 3530437, -1661693, -3592148, -2537516, 3915439,
+    -3861115, -3043716, 3574422, -2867647, 3539968, -300467, 2348700, -539299,
+    -1699267, -1643818, 3505694, -3821735, 3507263, -2140649, -1600420, 3699596,
+    811944, 531354, 954230, 3881043, 3900724, -2556880, 2071892, -2797779,
+    -3930395, -1528703, -3677745, -3041255, -1452451, 3475950, 2176455, -1585221,
+    -1257611, 1939314, -4083598, -1000202, -3190144, -3157330, -3632928, 126922,
+    3412210, -983419, 2147896, 2715295, -2967645, -3693493, -411027, -2477047,
+    -671102, -1228525, -22981, -1308169, -381987, 1349076, 1852771, -1430430,
+    -3343383, 264944, 508951, 3097992, 44288, -1100098, 904516, 3958618,
+    -3724342, -8578, 1653064, -3249728, 2389356, -210977, 759969, -1316856,
+    189548, -3553272, 3159746, -1851402, -2409325, -177440, 1315589, 1341330,
+    1285669, -1584928, -812732, -1439742, -3019102, -3881060, -3628969, 3839961,
+    2091667, 3407706, 2316500, 3817976, -3342478, 2244091, -2446433, -3562462,
+    266997, 2434439, -1235728, 3513181, -3520352, -3759364, -1197226, -3193378,
+    900702, 1859098, 909542, 819034, 495491, -1613174, -43260, -522500,
+    -655327, -3122442, 2031748, 3207046, -3556995, -525098, -768622, -3595838,
+    342297, 286988, -2437823, 4108315, 3437287, -3342277, 1735879, 203044,
+    2842341, 2691481, -2590150, 1265009, 4055324, 1247620, 2486353, 1595974,
+    -3767016, 1250494, 2635921, -3548272, -2994039, 1869119, 1903435, -1050970,
+    -1333058, 1237275, -3318210, -1430225, -451100, 1312455, 3306115, -1962642,
+    -1279661, 1917081, -2546312, -1374803, 1500165, 777191, 2235880, 3406031,
+    -542412, -2831860, -1671176, -1846953, -2584293, -3724270, 594136, -3776993,
+    -2013608, 2432395, 2454455, -164721, 1957272, 3369112, 185531, -1207385,
+    -3183426, 162844, 1616392, 3014001, 810149, 1652634, -3694233, -1799107,
+    -3038916, 3523897, 3866901, 269760, 2213111, -975884, 1717735, 472078,
+    -426683, 1723600, -1803090, 1910376, -1667432, -1104333, -260646, -3833893,
+    -2939036, -2235985, -420899, -2286327, 183443, -976891, 1612842, -3545687,
+    -554416, 3919660, -48306, -1362209, 3937738, 1400424, -846154, 1976782,
+};
+
+static int32_t montgomery_reduce(int64_t a) {
+    int32_t t = (int32_t)((int64_t)(int32_t)a * QINV);
+
+    return (int32_t)((a - (int64_t)t * Q) >> 32);
+}
+
+static int32_t reduce32(int32_t a) {
+    int32_t t = (a + (1 << 22)) >> 23;
+
+    return a - t * Q;
+}
+
+static int32_t caddq(int32_t a) {
+    return a + ((a >> 31) & Q);
+}
+
+static void ntt(poly *a) {
+    unsigned k = 0;
+
+    for (unsigned len = 128; len > 0; len >>= 1) {
+        for (unsigned start = 0; start < N; start += 2 * len) {
+            int32_t zeta = zetas[++k];
+
+            for (unsigned j = start; j < start + len; j++) {
+                int32_t t = montgomery_reduce((int64_t)zeta * a->c[j + len]);
+                a->c[j + len] = a->c[j] - t;
+                a->c[j] = a->c[j] + t;
+            }
+        }
+    }
+}
+
+/* Inverse NTT, leaving the result multiplied by 2^32 */
+static void invntt_tomont(poly *a) {
+    const int32_t f = 41978;        /* 2^64 / 256 mod q */
+    unsigned k = N;
+
+    for (unsigned len = 1; len < N; len <<= 1) {
+        for (unsigned start = 0; start < N; start += 2 * len) {
+            int32_t zeta = -zetas[--k];
+
+            for (unsigned j = start; j < start + len; j++) {
+                int32_t t = a->c[j];
+                a->c[j] = t + a->c[j + len];
+                a->c[j + len] = montgomery_reduce((int64_t)zeta * (t - a->c[j + len]));
+            }
+        }
+    }
+    for (unsigned j = 0; j < N; j++) a->c[j] = montgomery_reduce((int64_t)f * a->c[j]);
+}
+
+/* c = a * b / 2^32 coefficient-wise (NTT domain) */
+static void pointwise(poly *c, const poly *a, const poly *b) {
+    for (unsigned i = 0; i < N; i++) c->c[i] = montgomery_reduce((int64_t)a->c[i] * b->c[i]);
+}
+
+static void pointwise_acc(poly *c, const poly *a, const poly *b) {
+    for (unsigned i = 0; i < N; i++) c->c[i] += montgomery_reduce((int64_t)a->c[i] * b->c[i]);
+}
+
+static void poly_reduce(poly *a) {
+    for (unsigned i = 0; i < N; i++) a->c[i] = reduce32(a->c[i]);
+}
+
+/* 1 if any coefficient has absolute value >= bound */
+static int poly_chknorm(const poly *a, int32_t bound) {
+    for (unsigned i = 0; i < N; i++) {
+        int32_t t = a->c[i] >> 31;
+        t = a->c[i] - (t & 2 * a->c[i]);
+        if (t >= bound) return 1;
+    }
+    return 0;
+}
+
+/* a = a1 * 2 * gamma2 + a0 with a0 centred, for a in [0, q) */
+static int32_t decompose(int32_t *a0, int32_t a, int32_t gamma2) {
+    int32_t a1 = (a + 127) >> 7;
+
+    if (gamma2 == (Q - 1) / 32) {
+        a1 = (a1 * 1025 + (1 << 21)) >> 22;
+        a1 &= 15;
+    } else {
+        a1 = (a1 * 11275 + (1 << 23)) >> 24;
+        a1 ^= ((43 - a1) >> 31) & a1;
+    }
+    *a0 = a - a1 * 2 * gamma2;
+    *a0 -= (((Q - 1) / 2 - *a0) >> 31) & Q;
+    return a1;
+}
+
+static int make_hint(int32_t a0, int32_t a1, int32_t gamma2) {
+    return a0 > gamma2 || a0 < -gamma2 || (a0 == -gamma2 && a1 != 0);
+}
+
+/* ---- Encodings ---- */
+
+/* r[i] = offset - (next bits-bit little-endian field of a) */
+static void bits_unpack(poly *r, const uint8_t *a, unsigned bits, int32_t offset) {
+    uint64_t acc = 0;
+    unsigned have = 0;
+    uint32_t mask = (1u << bits) - 1;
+
+    for (unsigned i = 0; i < N; i++) {
+        while (have < bits) {
+            acc |= (uint64_t)*a++ << have;
+            have += 8;
+        }
+        r->c[i] = offset - (int32_t)(acc & mask);
+        acc >>= bits;
+        have -= bits;
+    }
+}
+
+static void bits_pack(uint8_t *r, const uint32_t *v, unsigned bits) {
+    uint64_t acc = 0;
+    unsigned have = 0;
+
+    for (unsigned i = 0; i < N; i++) {
+        acc |= (uint64_t)v[i] << have;
+        for (have += bits; have >= 8; have -= 8) {
+            *r++ = (uint8_t)acc;
+            acc >>= 8;
+        }
+    }
+}
+
+/* ---- Sampling ---- */
+
+/* A-hat[i][j] = RejNTTPoly(rho || j || i) */
+static int sample_uniform(EVP_MD_CTX *md, const EVP_MD *shake128, poly *a,
+                          const uint8_t *rho, unsigned i, unsigned j) {
+    uint8_t seed[SEED_BYTES + 2], buf[5 * SHAKE128_RATE];
+    size_t len = sizeof(buf);
+    unsigned n = 0;
+
+    memcpy(seed, rho, SEED_BYTES);
+    seed[SEED_BYTES] = (uint8_t)j;
+    seed[SEED_BYTES + 1] = (uint8_t)i;
+    if (!EVP_DigestInit_ex2(md, shake128, NULL) || !EVP_DigestUpdate(md, seed, sizeof(seed)))
+        return 0;
+
+    /* The rate is a multiple of 3, so squeezing in blocks keeps samples whole */
+    while (n < N) {
+        if (!EVP_DigestSqueeze(md, buf, len)) return 0;
+        for (size_t b = 0; b + 3 <= len && n < N; b += 3) {
+            uint32_t t = buf[b] | (uint32_t)buf[b + 1] << 8 | (uint32_t)(buf[b + 2] & 0x7f) << 16;
+            if (t < Q) a->c[n++] = (int32_t)t;
+        }
+        len = SHAKE128_RATE;
+    }
+    return 1;
+}
+
+/* y = ExpandMask(rho'', kappa) for one polynomial */
+static int sample_mask(EVP_MD_CTX *md, const EVP_MD *shake256, const mldsa_params *p,
+                       poly *y, const uint8_t *rhopp, unsigned nonce) {
+    uint8_t buf[MAX_Z_BYTES], le[2] = { (uint8_t)nonce, (uint8_t)(nonce >> 8) };
+    size_t len = N * (p->gamma1_bits + 1) / 8;
+    int ok = EVP_DigestInit_ex2(md, shake256, NULL)
+        && EVP_DigestUpdate(md, rhopp, MU_BYTES)
+        && EVP_DigestUpdate(md, le, sizeof(le))
+        && EVP_DigestFinalXOF(md, buf, len);
+
+    if (ok) bits_unpack(y, buf, p->gamma1_bits + 1, 1 << p->gamma1_bits);
+    OPENSSL_cleanse(buf, sizeof(buf));
+    return ok;
+}
+
+/* c = SampleInBall(c~): tau coefficients of +-1 */
+static int sample_in_ball(EVP_MD_CTX *md, const EVP_MD *shake256, const mldsa_params *p,
+                          poly *c, const uint8_t *ctilde) {
+    uint8_t buf[SHAKE256_RATE];
+    uint64_t signs = 0;
+    unsigned pos = 8;
+
+    if (!EVP_DigestInit_ex2(md, shake256, NULL) || !EVP_DigestUpdate(md, ctilde, p->ctilde)
+        || !EVP_DigestSqueeze(md, buf, sizeof(buf)))
+        return 0;
+    for (unsigned i = 0; i < 8; i++) signs |= (uint64_t)buf[i] << 8 * i;
+
+    memset(c, 0, sizeof(*c));
+    for (unsigned i = N - p->tau; i < N; i++) {
+        unsigned b;
+
+        do {
+            if (pos == sizeof(buf)) {
+                if (!EVP_DigestSqueeze(md, buf, sizeof(buf))) return 0;
+                pos = 0;
+            }
+            b = buf[pos++];
+        } while (b > i);
+        c->c[i] = c->c[b];
+        c->c[b] = 1 - 2 * (int32_t)(signs & 1);
+        signs >>= 1;
+    }
+    return 1;
+}
+
+/* ---- Expanded keys ---- */
+
+struct mldsa_expanded_key {
+    const mldsa_params *p;
+    EVP_MD *shake256;
+    size_t size;                    /* bytes allocated, wiped on free */
+    uint8_t key[SEED_BYTES];        /* K, seeds rho'' */
+    uint8_t tr[TR_BYTES];           /* H(pk), prefixes mu */
+    poly *a_hat;                    /* k x l, row-major */
+    poly *s1_hat, *s2_hat, *t0_hat;
+    poly polys[];
+};
+
+mldsa_expanded_key *mldsa_expanded_key_new(const mldsa_params *p,
+                                           const uint8_t *sk, size_t sk_len) {
+    size_t npolys = p->k * p->l + p->l + 2 * p->k, size;
+    unsigned eb = eta_bits(p);
+    mldsa_expanded_key *key = NULL;
+    EVP_MD *shake128 = NULL;
+    EVP_MD_CTX *md = NULL;
+    const uint8_t *rho = sk, *s;
+    int ok = 0;
+
+    if (sk_len != mldsa_sk_len(p)) return NULL;
+    size = sizeof(*key) + npolys * sizeof(poly);
+    if (!(key = OPENSSL_zalloc(size))) return NULL;
+    key->p = p;
+    key->size = size;
+    key->a_hat = key->polys;
+    key->s1_hat = key->a_hat + p->k * p->l;
+    key->s2_hat = key->s1_hat + p->l;
+    key->t0_hat = key->s2_hat + p->k;
+
+    memcpy(key->key, sk + SEED_BYTES, SEED_BYTES);
+    memcpy(key->tr, sk + 2 * SEED_BYTES, TR_BYTES);
+    s = sk + 2 * SEED_BYTES + TR_BYTES;
+
+    /* s1 and s2 are consecutive in both the encoding and the key */
+    for (unsigned i = 0; i < p->l + p->k; i++, s += N * eb / 8) {
+        poly *a = &key->s1_hat[i];
+
+        bits_unpack(a, s, eb, (int32_t)p->eta);
+        for (unsigned j = 0; j < N; j++)
+            if (a->c[j] < -(int32_t)p->eta) goto cleanup;
+        ntt(a);
+    }
+    for (unsigned i = 0; i < p->k; i++, s += N * D / 8) {
+        bits_unpack(&key->t0_hat[i], s, D, 1 << (D - 1));
+        ntt(&key->t0_hat[i]);
+    }
+
+    if (!(shake128 = EVP_MD_fetch(NULL, "SHAKE128", NULL))
+        || !(key->shake256 = EVP_MD_fetch(NULL, "SHAKE256", NULL))
+        || !(md = EVP_MD_CTX_new()))
+        goto cleanup;
+    for (unsigned i = 0; i < p->k; i++)
+        for (unsigned j = 0; j < p->l; j++)
+            if (!sample_uniform(md, shake128, &key->a_hat[i * p->l + j], rho, i, j)) goto cleanup;
+    ok = 1;
+
+cleanup:
+    EVP_MD_CTX_free(md);
+    EVP_MD_free(shake128);
+    if (!ok) {
+        mldsa_expanded_key_free(key);
+        return NULL;
+    }
+    return key;
+}
+
+void mldsa_expanded_key_free(mldsa_expanded_key *key) {
+    if (!key) return;
+    EVP_MD_free(key->shake256);
+    OPENSSL_clear_free(key, key->size);
+}
+
+const mldsa_params *mldsa_expanded_key_params(const mldsa_expanded_key *key) {
+    return key->p;
+}
+
+size_t mldsa_expanded_key_size(const mldsa_expanded_key *key) {
+    return key->size;
+}
+
+/* ---- Signing (FIPS 204, Algorithm 7) ---- */
+
+typedef struct {
+    poly y[MAX_L], z[MAX_L];
+    poly w0[MAX_K], w1[MAX_K], h[MAX_K];
+    poly c;
+    uint8_t rhopp[MU_BYTES];
+    uint8_t seed[SEED_BYTES + 32 + MU_BYTES];   /* K || rnd || mu */
+} sign_state;
+
+/* One attempt with mask nonce kappa. 1: signed, 0: rejected, -1: error. */
+static int sign_attempt(const mldsa_expanded_key *key, EVP_MD_CTX *md, sign_state *st,
+                        const uint8_t *mu, unsigned kappa, uint8_t *sig) {
+    const mldsa_params *p = key->p;
+    uint8_t w1_packed[MAX_W1_BYTES];
+    uint32_t v[N];
+    size_t w1_len = p->k * N * w1_bits(p) / 8, off;
+    unsigned hints = 0;
+
+    /* w = A * y, split into high bits w1 and low bits w0 */
+    for (unsigned j = 0; j < p->l; j++) {
+        if (!sample_mask(md, key->shake256, p, &st->y[j], st->rhopp, kappa + j)) return -1;
+        st->z[j] = st->y[j];
+        ntt(&st->z[j]);
+    }
+    for (unsigned i = 0; i < p->k; i++) {
+        poly *w = &st->w1[i];
+
+        pointwise(w, &key->a_hat[i * p->l], &st->z[0]);
+        for (unsigned j = 1; j < p->l; j++) pointwise_acc(w, &key->a_hat[i * p->l + j], &st->z[j]);
+        poly_reduce(w);
+        invntt_tomont(w);
+        for (unsigned n = 0; n < N; n++) {
+            w->c[n] = decompose(&st->w0[i].c[n], caddq(w->c[n]), p->gamma2);
+            v[n] = (uint32_t)w->c[n];
+        }
+        bits_pack(w1_packed + i * N * w1_bits(p) / 8, v, w1_bits(p));
+    }
+
+    /* c~ = H(mu || w1), c = SampleInBall(c~) */
+    if (!EVP_DigestInit_ex2(md, key->shake256, NULL) || !EVP_DigestUpdate(md, mu, MU_BYTES)
+        || !EVP_DigestUpdate(md, w1_packed, w1_len) || !EVP_DigestFinalXOF(md, sig, p->ctilde)
+        || !sample_in_ball(md, key->shake256, p, &st->c, sig))
+        return -1;
+    ntt(&st->c);
+
+    /* z = y + c * s1 */
+    for (unsigned j = 0; j < p->l; j++) {
+        pointwise(&st->z[j], &st->c, &key->s1_hat[j]);
+        invntt_tomont(&st->z[j]);
+        for (unsigned n = 0; n < N; n++) st->z[j].c[n] += st->y[j].c[n];
+        poly_reduce(&st->z[j]);
+        if (poly_chknorm(&st->z[j], (1 << p->gamma1_bits) - (int32_t)p->beta)) return 0;
+    }
+
+    /* r0 = LowBits(w - c * s2) */
+    for (unsigned i = 0; i < p->k; i++) {
+        pointwise(&st->h[i], &st->c, &key->s2_hat[i]);
+        invntt_tomont(&st->h[i]);
+        for (unsigned n = 0; n < N; n++) st->w0[i].c[n] -= st->h[i].c[n];
+        poly_reduce(&st->w0[i]);
+        if (poly_chknorm(&st->w0[i], p->gamma2 - (int32_t)p->beta)) return 0;
+    }
+
+    /* Hints for w - c * s2 + c * t0 */
+    for (unsigned i = 0; i < p->k; i++) {
+        pointwise(&st->h[i], &st->c, &key->t0_hat[i]);
+        invntt_tomont(&st->h[i]);
+        poly_reduce(&st->h[i]);
+        if (poly_chknorm(&st->h[i], p->gamma2)) return 0;
+        for (unsigned n = 0; n < N; n++) {
+            st->h[i].c[n] = make_hint(st->w0[i].c[n] + st->h[i].c[n], st->w1[i].c[n], p->gamma2);
+            hints += (unsigned)st->h[i].c[n];
+        }
+    }
+    if (hints > p->omega) return 0;
+
+    /* sig = c~ || z || h */
+    off = p->ctilde;
+    for (unsigned j = 0; j < p->l; j++, off += N * (p->gamma1_bits + 1) / 8) {
+        for (unsigned n = 0; n < N; n++) v[n] = (uint32_t)((1 << p->gamma1_bits) - st->z[j].c[n]);
+        bits_pack(sig + off, v, p->gamma1_bits + 1);
+    }
+    memset(sig + off, 0, p->omega + p->k);
+    hints = 0;
+    for (unsigned i = 0; i < p->k; i++) {
+        for (unsigned n = 0; n < N; n++)
+            if (st->h[i].c[n]) sig[off + hints++] = (uint8_t)n;
+        sig[off + p->omega + i] = (uint8_t)hints;
+    }
+    return 1;
+}
+
+int mldsa_expanded_sign(const mldsa_expanded_key *key, uint8_t *sig,
+                        const uint8_t *msg, size_t msg_len,
+                        const uint8_t *ctx, size_t ctx_len, const uint8_t *rnd) {
+    const mldsa_params *p = key->p;
+    sign_state *st = NULL;
+    EVP_MD_CTX *md = NULL;
+    uint8_t pre[2] = { 0, (uint8_t)ctx_len }, *mu;
+    int ok = 0, r = 0;
+
+    if (ctx_len > 255) return 0;
+    if (!(st = OPENSSL_malloc(sizeof(*st))) || !(md = EVP_MD_CTX_new())) goto cleanup;
+    mu = st->seed + SEED_BYTES + 32;
+
+    /* mu = H(tr || 0 || |ctx| || ctx || M), rho'' = H(K || rnd || mu) */
+    memcpy(st->seed, key->key, SEED_BYTES);
+    if (rnd) memcpy(st->seed + SEED_BYTES, rnd, 32);
+    else if (RAND_bytes(st->seed + SEED_BYTES, 32) <= 0) goto cleanup;
+    if (!EVP_DigestInit_ex2(md, key->shake256, NULL)
+        || !EVP_DigestUpdate(md, key->tr, TR_BYTES)
+        || !EVP_DigestUpdate(md, pre, sizeof(pre))
+        || (ctx_len && !EVP_DigestUpdate(md, ctx, ctx_len))
+        || !EVP_DigestUpdate(md, msg, msg_len)
+        || !EVP_DigestFinalXOF(md, mu, MU_BYTES)
+        || !EVP_DigestInit_ex2(md, key->shake256, NULL)
+        || !EVP_DigestUpdate(md, st->seed, sizeof(st->seed))
+        || !EVP_DigestFinalXOF(md, st->rhopp, MU_BYTES))
+        goto cleanup;
+
+    for (unsigned kappa = 0; r == 0; kappa += p->l)
+        r = sign_attempt(key, md, st, mu, kappa, sig);
+    ok = r == 1;
+
+cleanup:
+    EVP_MD_CTX_free(md);
+    OPENSSL_clear_free(st, sizeof(*st));
+    return ok;
+}
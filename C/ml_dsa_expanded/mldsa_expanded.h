@@ -0,0 +1,66 @@
+#ifndef MLDSA_EXPANDED_H
+#define MLDSA_EXPANDED_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * ML-DSA (FIPS 204) signing with an expanded, resident signing key.
+ *
+ * A signing call that takes the encoded secret key (OQS_SIG_sign, or
+ * OpenSSL's EVP signing, which keeps the key decoded but not expanded) first
+ * unpacks s1, s2 and t0, moves them into the NTT domain and expands the
+ * matrix A from rho: K * L SHAKE128 samplings and K + L + K forward NTTs
+ * before the first rejection-sampling attempt. An mldsa_expanded_key does
+ * that once and keeps A-hat, s1-hat, s2-hat and t0-hat, so each signature
+ * starts at the mu and rho'' hashes.
+ *
+ * Signatures are byte-identical to any other FIPS 204 implementation given
+ * the same key, message, context and randomness. The key is read-only while
+ * signing, so one key can be shared by any number of signing threads. It is
+ * wiped when freed; it holds everything needed to sign.
+ *
+ * Keys use the FIPS 204 encoding: sk = rho || K || tr || s1 || s2 || t0.
+ */
+
+typedef struct {
+    const char *name;   /* e.g. "ML-DSA-65" */
+    unsigned k, l;      /* A is k x l */
+    unsigned eta;
+    unsigned tau;       /* nonzero coefficients of the challenge */
+    unsigned beta;      /* tau * eta */
+    unsigned gamma1_bits;
+    int32_t gamma2;
+    unsigned omega;     /* maximum hint weight */
+    unsigned ctilde;    /* commitment hash bytes, lambda / 4 */
+} mldsa_params;
+
+/* NULL if name is not ML-DSA-44, ML-DSA-65 or ML-DSA-87. */
+const mldsa_params *mldsa_params_get(const char *name);
+
+size_t mldsa_sk_len(const mldsa_params *p);
+size_t mldsa_sig_len(const mldsa_params *p);
+
+typedef struct mldsa_expanded_key mldsa_expanded_key;
+
+/* Unpacks and expands an encoded secret key. NULL on a malformed key. */
+mldsa_expanded_key *mldsa_expanded_key_new(const mldsa_params *p,
+                                           const uint8_t *sk, size_t sk_len);
+void mldsa_expanded_key_free(mldsa_expanded_key *key);
+
+const mldsa_params *mldsa_expanded_key_params(const mldsa_expanded_key *key);
+
+/* Bytes held by the expanded key, for sizing a key cache. */
+size_t mldsa_expanded_key_size(const mldsa_expanded_key *key);
+
+/*
+ * Pure ML-DSA signature over msg with context ctx (at most 255 bytes).
+ * rnd is 32 bytes of fresh randomness, or NULL to draw it from RAND_bytes;
+ * 32 zero bytes give the deterministic variant. sig must hold
+ * mldsa_sig_len() bytes. Returns 1 on success, 0 on failure.
+ */
+int mldsa_expanded_sign(const mldsa_expanded_key *key, uint8_t *sig,
+                        const uint8_t *msg, size_t msg_len,
+                        const uint8_t *ctx, size_t ctx_len, const uint8_t *rnd);
+
+#endif /* MLDSA_EXPANDED_H */
@@ -0,0 +1,221 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include <openssl/evp.h>
+#include <openssl/err.h>
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#include <openssl/rand.h>
+
+#include "mldsa_expanded.h"
+#include "pqc_metrics.h"
+#include "pqc_timer.h"
+
+/* Parameter names from OpenSSL 3.5 core_names.h */
+#ifndef OSSL_SIGNATURE_PARAM_CONTEXT_STRING
+#define OSSL_SIGNATURE_PARAM_CONTEXT_STRING "context-string"
+#endif
+#ifndef OSSL_SIGNATURE_PARAM_TEST_ENTROPY
+#define OSSL_SIGNATURE_PARAM_TEST_ENTROPY "test-entropy"
+#endif
+
+/*
+ * A token issuer signing short messages with one long-lived key. Each path
+ * signs the same stream of tokens:
+ *
+ *   evp-import  encoded key in, imported per call (OQS_SIG_sign-style)
+ *   evp         EVP_PKEY held across calls; A and the NTTs redone per call
+ *   expand      mldsa_expanded_key_new() + sign + free per call
+ *   expanded    one resident mldsa_expanded_key
+ *
+ * Before timing, signatures from the expanded key are compared byte for byte
+ * with OpenSSL's over the same key, context and randomness.
+ */
+
+#define CHECKS 8
+
+static const unsigned char context[] = "token-issuer";
+
+static void handle_openssl_error(const char *msg) {
+    fprintf(stderr, "ERROR: %s\n", msg);
+    ERR_print_errors_fp(stderr);
+}
+
+/* OpenSSL's signature over msg, optionally with fixed randomness */
+static int evp_sign(EVP_PKEY *pkey, EVP_SIGNATURE *alg, uint8_t *sig, size_t *sig_len,
+                    const uint8_t *msg, size_t msg_len, const uint8_t *rnd) {
+    OSSL_PARAM params[3], *p = params;
+    EVP_PKEY_CTX *pctx = EVP_PKEY_CTX_new_from_pkey(NULL, pkey, NULL);
+    int ok;
+
+    *p++ = OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_CONTEXT_STRING,
+                                             (void *)context, sizeof(context) - 1);
+    if (rnd) *p++ = OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_TEST_ENTROPY,
+                                                      (void *)rnd, 32);
+    *p = OSSL_PARAM_construct_end();
+    ok = pctx
+        && EVP_PKEY_sign_message_init(pctx, alg, params) > 0
+        && EVP_PKEY_sign(pctx, sig, sig_len, msg, msg_len) > 0;
+    EVP_PKEY_CTX_free(pctx);
+    return ok;
+}
+
+static int evp_verify(EVP_PKEY *pkey, EVP_SIGNATURE *alg, const uint8_t *sig, size_t sig_len,
+                      const uint8_t *msg, size_t msg_len) {
+    OSSL_PARAM params[2];
+    EVP_PKEY_CTX *pctx = EVP_PKEY_CTX_new_from_pkey(NULL, pkey, NULL);
+    int ok;
+
+    params[0] = OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_CONTEXT_STRING,
+                                                  (void *)context, sizeof(context) - 1);
+    params[1] = OSSL_PARAM_construct_end();
+    ok = pctx
+        && EVP_PKEY_verify_message_init(pctx, alg, params) > 0
+        && EVP_PKEY_verify(pctx, sig, sig_len, msg, msg_len) == 1;
+    EVP_PKEY_CTX_free(pctx);
+    return ok;
+}
+
+static size_t token(uint8_t *msg, size_t i) {
+    return (size_t)snprintf((char *)msg, 64, "{\"sub\":\"user-%zu\",\"exp\":1792108800}", i);
+}
+
+/* Same key, message, context and randomness must give OpenSSL's signature */
+static int check(const mldsa_expanded_key *key, EVP_PKEY *pkey, EVP_SIGNATURE *alg) {
+    const mldsa_params *p = mldsa_expanded_key_params(key);
+    size_t sig_len = mldsa_sig_len(p), ref_len;
+    uint8_t *sig = malloc(sig_len), *ref = malloc(sig_len), msg[64], rnd[32];
+    int ok = sig && ref;
+
+    for (size_t i = 0; ok && i < CHECKS; i++) {
+        size_t msg_len = token(msg, i);
+
+        /* the first check is the deterministic variant */
+        if (i == 0) memset(rnd, 0, sizeof(rnd));
+        else if (RAND_bytes(rnd, sizeof(rnd)) <= 0) ok = 0;
+        ref_len = sig_len;
+        ok = ok
+            && mldsa_expanded_sign(key, sig, msg, msg_len, context, sizeof(context) - 1, rnd)
+            && evp_sign(pkey, alg, ref, &ref_len, msg, msg_len, rnd)
+            && ref_len == sig_len && memcmp(sig, ref, sig_len) == 0;
+    }
+    /* and with fresh randomness, OpenSSL must accept it */
+    ok = ok
+        && mldsa_expanded_sign(key, sig, msg, token(msg, 0), context, sizeof(context) - 1, NULL)
+        && evp_verify(pkey, alg, sig, sig_len, msg, token(msg, 0));
+    free(sig);
+    free(ref);
+    return ok;
+}
+
+typedef enum { PATH_EVP_IMPORT, PATH_EVP, PATH_EXPAND, PATH_EXPANDED } sign_path;
+
+static const char *path_names[] = { "evp-import", "evp", "expand", "expanded" };
+
+static int run(sign_path path, const mldsa_params *p, EVP_PKEY *pkey, EVP_SIGNATURE *alg,
+               const uint8_t *sk, const mldsa_expanded_key *key, size_t n,
+               uint64_t *ns, uint64_t *total) {
+    size_t sk_len = mldsa_sk_len(p), sig_len = mldsa_sig_len(p);
+    uint8_t *sig = malloc(sig_len), msg[64];
+    uint64_t start = pqc_now_ns();
+    int ok = sig != NULL;
+
+    for (size_t i = 0; ok && i < n; i++) {
+        size_t msg_len = token(msg, i), len = sig_len;
+        uint64_t t0 = pqc_now_ns();
+
+        if (path == PATH_EVP_IMPORT) {
+            EVP_PKEY *k = EVP_PKEY_new_raw_private_key_ex(NULL, p->name, NULL, sk, sk_len);
+            ok = k && evp_sign(k, alg, sig, &len, msg, msg_len, NULL);
+            EVP_PKEY_free(k);
+        } else if (path == PATH_EVP) {
+            ok = evp_sign(pkey, alg, sig, &len, msg, msg_len, NULL);
+        } else if (path == PATH_EXPAND) {
+            mldsa_expanded_key *k = mldsa_expanded_key_new(p, sk, sk_len);
+            ok = k && mldsa_expanded_sign(k, sig, msg, msg_len, context, sizeof(context) - 1, NULL);
+            mldsa_expanded_key_free(k);
+        } else {
+            ok = mldsa_expanded_sign(key, sig, msg, msg_len, context, sizeof(context) - 1, NULL);
+        }
+        ns[i] = pqc_now_ns() - t0;
+    }
+    *total = pqc_now_ns() - start;
+    free(sig);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    const char *name = argc > 1 ? argv[1] : "ML-DSA-65";
+    size_t n = argc > 2 ? strtoul(argv[2], NULL, 10) : 2000;
+    const mldsa_params *p = mldsa_params_get(name);
+    EVP_PKEY *pkey = NULL;
+    EVP_SIGNATURE *alg = NULL;
+    mldsa_expanded_key *key = NULL;
+    uint8_t *sk = NULL;
+    uint64_t *ns = NULL, total, base = 0;
+    size_t sk_len;
+    pqc_metrics_sizes sizes = { 0, 0, 0, 0, 0 };
+    int ret = 1;
+
+    pqc_metrics_init("mldsa_expanded_bench");
+    printf("🔑 ML-DSA Expanded Signing Key Benchmark\n");
+    printf("=======================================\n");
+
+    if (!p) {
+        printf("❌ Unknown parameter set %s (ML-DSA-44, ML-DSA-65, ML-DSA-87)\n", name);
+        return 1;
+    }
+    if (n == 0) n = 1;
+    sk_len = mldsa_sk_len(p);
+    sizes.sk = sk_len;
+    sizes.sig = mldsa_sig_len(p);
+
+    if (!(pkey = EVP_PKEY_Q_keygen(NULL, NULL, p->name))
+        || !(alg = EVP_SIGNATURE_fetch(NULL, p->name, NULL))
+        || !(sk = OPENSSL_secure_malloc(sk_len))
+        || !EVP_PKEY_get_octet_string_param(pkey, OSSL_PKEY_PARAM_PRIV_KEY, sk, sk_len, &sk_len)) {
+        handle_openssl_error("key generation failed");
+        goto cleanup;
+    }
+    if (!(key = mldsa_expanded_key_new(p, sk, sk_len)) || !(ns = malloc(n * sizeof(*ns)))) {
+        printf("❌ Key expansion failed\n");
+        goto cleanup;
+    }
+
+    printf("Algorithm: %s, %zu signatures per path\n", p->name, n);
+    printf("Encoded key: %zu bytes, expanded key: %zu bytes\n\n", sk_len, mldsa_expanded_key_size(key));
+
+    if (!check(key, pkey, alg)) {
+        printf("❌ Expanded-key signatures differ from OpenSSL's\n");
+        goto cleanup;
+    }
+    printf("✅ %d signatures match OpenSSL byte for byte\n\n", CHECKS);
+
+    printf("  %-10s %9s %9s %10s %9s\n", "path", "p50 us", "p99 us", "signs/s", "speedup");
+    for (int path = PATH_EVP_IMPORT; path <= PATH_EXPANDED; path++) {
+        pqc_stats st;
+
+        if (!run((sign_path)path, p, pkey, alg, sk, key, n, ns, &total)) {
+            printf("❌ Signing failed on the %s path\n", path_names[path]);
+            goto cleanup;
+        }
+        pqc_metrics_emit_samples(p->name, "sign", path_names[path], ns, n, total, &sizes);
+        pqc_stats_compute(&st, ns, NULL, n, total);
+        if (!base) base = st.median_ns;
+        printf("  %-10s %9.1f %9.1f %10.0f %8.2fx\n", path_names[path], st.median_ns / 1e3,
+               st.p99_ns / 1e3, st.ops_per_sec, base / (double)st.median_ns);
+    }
+    printf("\n✨ Benchmark completed!\n");
+    ret = 0;
+
+cleanup:
+    mldsa_expanded_key_free(key);
+    OPENSSL_secure_clear_free(sk, mldsa_sk_len(p));
+    EVP_SIGNATURE_free(alg);
+    EVP_PKEY_free(pkey);
+    free(ns);
+    return ret;
+}
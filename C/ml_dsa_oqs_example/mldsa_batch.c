@@ -0,0 +1,182 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "oqs/oqs.h"
+
+#include "mldsa_batch.h"
+
+/* Items claimed per grab; small enough to balance, large enough to amortise */
+#define VERIFY_CHUNK 8
+
+struct mldsa_verify_pool {
+    OQS_SIG *sig;
+    unsigned nthreads;          /* verifying threads, including the caller */
+    pthread_t *workers;         /* nthreads - 1 background threads */
+
+    pthread_mutex_t run_lock;   /* one batch at a time */
+    pthread_mutex_t lock;
+    pthread_cond_t work_cv;
+    pthread_cond_t done_cv;
+    unsigned long generation;
+    unsigned active;
+    int shutdown;
+
+    /* Current batch */
+    const mldsa_verify_item *items;
+    size_t n;
+    uint8_t *bitmap;
+    size_t next;
+    long valid;
+};
+
+static void verify_chunks(mldsa_verify_pool *pool) {
+    const OQS_SIG *sig = pool->sig;
+    long valid = 0;
+    size_t start;
+
+    while ((start = __atomic_fetch_add(&pool->next, VERIFY_CHUNK, __ATOMIC_RELAXED)) < pool->n) {
+        size_t end = start + VERIFY_CHUNK < pool->n ? start + VERIFY_CHUNK : pool->n;
+
+        for (size_t i = start; i < end; i++) {
+            const mldsa_verify_item *it = &pool->items[i];
+            if (OQS_SIG_verify(sig, it->message, it->message_len,
+                               it->signature, it->signature_len,
+                               it->public_key) == OQS_SUCCESS) {
+                __atomic_fetch_or(&pool->bitmap[i / 8], (uint8_t)(1u << (i % 8)), __ATOMIC_RELAXED);
+                valid++;
+            }
+        }
+    }
+    __atomic_fetch_add(&pool->valid, valid, __ATOMIC_RELAXED);
+}
+
+static void *worker_main(void *arg) {
+    mldsa_verify_pool *pool = arg;
+    unsigned long seen = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->shutdown && pool->generation == seen)
+            pthread_cond_wait(&pool->work_cv, &pool->lock);
+        if (pool->shutdown) {
+            pthread_mutex_unlock(&pool->lock);
+            return NULL;
+        }
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        verify_chunks(pool);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->active == 0) pthread_cond_signal(&pool->done_cv);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+mldsa_verify_pool *mldsa_verify_pool_new(const char *sig_name, unsigned nthreads) {
+    mldsa_verify_pool *pool;
+
+    if (!OQS_SIG_alg_is_enabled(sig_name)) {
+        fprintf(stderr, "ERROR: %s is not enabled in this build\n", sig_name);
+        return NULL;
+    }
+
+    if (nthreads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = cpus > 0 ? (unsigned)cpus : 1;
+    }
+
+    pool = calloc(1, sizeof(*pool));
+    if (!pool) return NULL;
+
+    pool->sig = OQS_SIG_new(sig_name);
+    pool->workers = calloc(nthreads, sizeof(pthread_t));
+    if (!pool->sig || !pool->workers) {
+        OQS_SIG_free(pool->sig);
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->run_lock, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_cv, NULL);
+    pthread_cond_init(&pool->done_cv, NULL);
+
+    /* The caller verifies too, so only nthreads - 1 background workers */
+    pool->nthreads = 1;
+    for (unsigned i = 0; i + 1 < nthreads; i++) {
+        if (pthread_create(&pool->workers[i], NULL, worker_main, pool) != 0) {
+            fprintf(stderr, "ERROR: Failed to start verify worker %u\n", i);
+            break;
+        }
+        pool->nthreads++;
+    }
+
+    return pool;
+}
+
+void mldsa_verify_pool_free(mldsa_verify_pool *pool) {
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->work_cv);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (unsigned i = 0; i + 1 < pool->nthreads; i++)
+        pthread_join(pool->workers[i], NULL);
+
+    pthread_cond_destroy(&pool->work_cv);
+    pthread_cond_destroy(&pool->done_cv);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_mutex_destroy(&pool->run_lock);
+    OQS_SIG_free(pool->sig);
+    free(pool->workers);
+    free(pool);
+}
+
+unsigned mldsa_verify_pool_threads(const mldsa_verify_pool *pool) {
+    return pool->nthreads;
+}
+
+long mldsa_verify_pool_run(mldsa_verify_pool *pool, const mldsa_verify_item *items,
+                           size_t n, uint8_t *bitmap) {
+    long valid;
+
+    if (!pool || (n && (!items || !bitmap))) return -1;
+    if (n == 0) return 0;
+
+    pthread_mutex_lock(&pool->run_lock);
+
+    memset(bitmap, 0, mldsa_verify_bitmap_size(n));
+    pool->items = items;
+    pool->n = n;
+    pool->bitmap = bitmap;
+    pool->next = 0;
+    pool->valid = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->active = pool->nthreads - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_cv);
+    pthread_mutex_unlock(&pool->lock);
+
+    verify_chunks(pool);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->active > 0)
+        pthread_cond_wait(&pool->done_cv, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+
+    valid = __atomic_load_n(&pool->valid, __ATOMIC_RELAXED);
+    pool->items = NULL;
+    pool->bitmap = NULL;
+
+    pthread_mutex_unlock(&pool->run_lock);
+    return valid;
+}
@@ -0,0 +1,51 @@
+#ifndef MLDSA_BATCH_H
+#define MLDSA_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Batch ML-DSA signature verification over a fixed worker pool.
+ *
+ * A pool is created once for one algorithm (e.g. "ML-DSA-65") and a fixed
+ * number of threads. Each mldsa_verify_pool_run() call spreads the batch over
+ * the workers (the calling thread helps too) and returns a bitmap with bit i
+ * set when item i verified.
+ *
+ * One batch runs at a time per pool; concurrent callers are serialised.
+ */
+
+typedef struct {
+    const uint8_t *message;
+    size_t message_len;
+    const uint8_t *signature;
+    size_t signature_len;
+    const uint8_t *public_key;
+} mldsa_verify_item;
+
+typedef struct mldsa_verify_pool mldsa_verify_pool;
+
+/* nthreads == 0 uses one worker per online CPU. */
+mldsa_verify_pool *mldsa_verify_pool_new(const char *sig_name, unsigned nthreads);
+void mldsa_verify_pool_free(mldsa_verify_pool *pool);
+
+unsigned mldsa_verify_pool_threads(const mldsa_verify_pool *pool);
+
+/* Bytes needed for the result bitmap of an n-item batch. */
+static inline size_t mldsa_verify_bitmap_size(size_t n) {
+    return (n + 7) / 8;
+}
+
+static inline int mldsa_verify_bitmap_get(const uint8_t *bitmap, size_t i) {
+    return (bitmap[i / 8] >> (i % 8)) & 1;
+}
+
+/*
+ * Verifies items[0..n) and writes the results to bitmap, which must hold
+ * mldsa_verify_bitmap_size(n) bytes. Returns the number of valid signatures,
+ * or -1 on error.
+ */
+long mldsa_verify_pool_run(mldsa_verify_pool *pool, const mldsa_verify_item *items,
+                           size_t n, uint8_t *bitmap);
+
+#endif /* MLDSA_BATCH_H */
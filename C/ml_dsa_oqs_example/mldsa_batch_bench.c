@@ -0,0 +1,153 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "oqs/oqs.h"
+
+#include "mldsa_batch.h"
+#include "pqc_metrics.h"
+#include "pqc_timer.h"
+
+#define NUM_KEYS    16
+#define MESSAGE_LEN 64
+
+/*
+ * Measures how batch verification throughput scales with the number of
+ * verifying threads. Every batch contains one tampered message, so each run
+ * also checks that the bitmap flags exactly that item.
+ */
+
+static int run_scaling(const char *alg, const pqc_metrics_sizes *sizes, const mldsa_verify_item *items,
+                       size_t n, size_t tampered, unsigned threads, double *base_rate) {
+    mldsa_verify_pool *pool = mldsa_verify_pool_new(alg, threads);
+    uint8_t *bitmap = malloc(mldsa_verify_bitmap_size(n));
+    pqc_hist *hist = pqc_metrics_enabled() ? pqc_hist_new() : NULL;
+    size_t batches = 0;
+    int ok = 0;
+
+    if (!pool || !bitmap || (pqc_metrics_enabled() && !hist)) goto cleanup;
+
+    /* Warm up, and check the results once */
+    long valid = mldsa_verify_pool_run(pool, items, n, bitmap);
+    if (valid != (long)n - 1 || mldsa_verify_bitmap_get(bitmap, tampered)) {
+        printf("❌ Wrong batch result with %u threads: %ld of %zu valid\n", threads, valid, n);
+        goto cleanup;
+    }
+
+    uint64_t start = pqc_now_ns(), elapsed;
+    do {
+        uint64_t t = pqc_now_ns();
+
+        mldsa_verify_pool_run(pool, items, n, bitmap);
+        batches++;
+        elapsed = pqc_now_ns() - start;
+        if (hist) pqc_hist_record(hist, start + elapsed - t);
+    } while (elapsed < 1000000000ull);
+
+    double rate = (double)(batches * n) * 1e9 / (double)elapsed;
+    if (*base_rate == 0) *base_rate = rate;
+
+    printf("  %7u %14.0f %10.2fx %10.0f%%\n", mldsa_verify_pool_threads(pool), rate,
+           rate / *base_rate, 100.0 * rate / *base_rate / mldsa_verify_pool_threads(pool));
+    if (hist) {
+        /* One sample per batch of n signatures */
+        char impl[48];
+
+        snprintf(impl, sizeof(impl), "threads=%u,batch=%zu", mldsa_verify_pool_threads(pool), n);
+        pqc_metrics_emit(alg, "batch-verify", impl, hist, elapsed, sizes);
+    }
+    ok = 1;
+
+cleanup:
+    pqc_hist_free(hist);
+    mldsa_verify_pool_free(pool);
+    free(bitmap);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    const char *alg = argc > 1 ? argv[1] : "ML-DSA-65";
+    size_t n = argc > 2 ? strtoul(argv[2], NULL, 10) : 4096;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    OQS_SIG *sig = NULL;
+    uint8_t *pks = NULL, *sks = NULL, *msgs = NULL, *sigs = NULL;
+    mldsa_verify_item *items = NULL;
+    int ret = 1;
+
+    pqc_metrics_init("mldsa_batch_bench");
+    printf("🎯 ML-DSA Batch Verification Benchmark\n");
+    printf("=====================================\n");
+
+    if (n < 2) n = 2;
+    if (cpus < 1) cpus = 1;
+
+    if (!OQS_SIG_alg_is_enabled(alg) || !(sig = OQS_SIG_new(alg))) {
+        printf("❌ %s is not enabled in this build\n", alg);
+        return 1;
+    }
+
+    pqc_metrics_sizes sizes = { sig->length_public_key, 0, 0, 0, sig->length_signature };
+
+    pks = malloc(NUM_KEYS * sig->length_public_key);
+    sks = malloc(NUM_KEYS * sig->length_secret_key);
+    msgs = malloc(n * MESSAGE_LEN);
+    sigs = malloc(n * sig->length_signature);
+    items = calloc(n, sizeof(*items));
+    if (!pks || !sks || !msgs || !sigs || !items) {
+        printf("❌ Memory allocation failed\n");
+        goto cleanup;
+    }
+
+    printf("Algorithm: %s, batch: %zu signatures over %d keys\n", alg, n, NUM_KEYS);
+    printf("1. 🔑 Generating keys and signing the batch...\n");
+    for (int k = 0; k < NUM_KEYS; k++) {
+        if (OQS_SIG_keypair(sig, pks + k * sig->length_public_key,
+                            sks + k * sig->length_secret_key) != OQS_SUCCESS) {
+            printf("❌ Key generation failed\n");
+            goto cleanup;
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        size_t k = i % NUM_KEYS;
+        uint8_t *msg = msgs + i * MESSAGE_LEN;
+
+        for (size_t j = 0; j < MESSAGE_LEN; j++) msg[j] = (uint8_t)(i * 31 + j);
+        items[i].message = msg;
+        items[i].message_len = MESSAGE_LEN;
+        items[i].signature = sigs + i * sig->length_signature;
+        items[i].public_key = pks + k * sig->length_public_key;
+        if (OQS_SIG_sign(sig, sigs + i * sig->length_signature, &items[i].signature_len,
+                         msg, MESSAGE_LEN, sks + k * sig->length_secret_key) != OQS_SUCCESS) {
+            printf("❌ Signing failed\n");
+            goto cleanup;
+        }
+    }
+
+    /* Tamper with one message after signing */
+    size_t tampered = n / 2;
+    msgs[tampered * MESSAGE_LEN] ^= 0x01;
+
+    printf("2. ⏱️  Verifying with 1..%ld threads\n\n", cpus);
+    printf("  %7s %14s %11s %11s\n", "threads", "verifies/sec", "speedup", "efficiency");
+
+    double base_rate = 0;
+    unsigned threads;
+    for (threads = 1; threads < (unsigned)cpus; threads *= 2) {
+        if (!run_scaling(alg, &sizes, items, n, tampered, threads, &base_rate)) goto cleanup;
+    }
+    if (!run_scaling(alg, &sizes, items, n, tampered, (unsigned)cpus, &base_rate)) goto cleanup;
+
+    printf("\n✨ Benchmark completed!\n");
+    ret = 0;
+
+cleanup:
+    OQS_SIG_free(sig);
+    free(pks);
+    free(sks);
+    free(msgs);
+    free(sigs);
+    free(items);
+    return ret;
+}
@@ -1,8 +1,14 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include "oqs/oqs.h"
 
+#include "pqc_metrics.h"
+#include "pqc_oqs_registry.h"
+#include "pqc_timer.h"
+
 void print_hex(const char* label, const uint8_t* data, size_t len) {
     printf("%s (%zu bytes): ", label, len);
     for (size_t i = 0; i < len && i < 16; i++) {
@@ -12,11 +18,17 @@ void print_hex(const char* label, const uint8_t* data, size_t len) {
     printf("\n");
 }
 
+/* One metrics record per operation with PQC_METRICS=json|csv (pqc_metrics.h) */
+static void emit(const OQS_SIG* sig, const char* op, uint64_t ns, size_t sig_len) {
+    pqc_metrics_sizes sizes = { sig->length_public_key, sig->length_secret_key, 0, 0, sig_len };
+    pqc_metrics_emit_samples(sig->method_name, op, "liboqs", &ns, 1, 0, &sizes);
+}
+
 void demonstrate_ml_dsa(const char* sig_name) {
     printf("\n📝 Testing %s\n", sig_name);
     printf("================\n");
     
-    if (!OQS_SIG_alg_is_enabled(sig_name)) {
+    if (!pqc_oqs_sig_find(sig_name)) {
         printf("❌ %s is not enabled in this build\n", sig_name);
         return;
     }
@@ -36,7 +48,8 @@ void demonstrate_ml_dsa(const char* sig_name) {
     uint8_t* public_key = malloc(sig->length_public_key);
     uint8_t* secret_key = malloc(sig->length_secret_key);
     uint8_t* signature = malloc(sig->length_signature);
-    size_t signature_len;
+    size_t signature_len = 0;
+    uint64_t t0;
     
     if (!public_key || !secret_key || !signature) {
         printf("❌ Memory allocation failed\n");
@@ -45,10 +58,12 @@ void demonstrate_ml_dsa(const char* sig_name) {
     
     // Step 1: Key generation
     printf("1. 🔑 Generating key pair...\n");
+    t0 = pqc_now_ns();
     if (OQS_SIG_keypair(sig, public_key, secret_key) != OQS_SUCCESS) {
         printf("❌ Key generation failed\n");
         goto cleanup;
     }
+    emit(sig, "keygen", pqc_now_ns() - t0, 0);
     printf("✅ Key pair generated\n");
     
     // Step 2: Create message to sign
@@ -58,21 +73,25 @@ void demonstrate_ml_dsa(const char* sig_name) {
     
     // Step 3: Sign the message
     printf("3. ✍️  Signing message...\n");
+    t0 = pqc_now_ns();
     if (OQS_SIG_sign(sig, signature, &signature_len, 
                     (const uint8_t*)message, message_len, secret_key) != OQS_SUCCESS) {
         printf("❌ Signing failed\n");
         goto cleanup;
     }
+    emit(sig, "sign", pqc_now_ns() - t0, signature_len);
     printf("✅ Message signed\n");
     print_hex("   Signature", signature, signature_len);
     
     // Step 4: Verify the signature
     printf("4. ✅ Verifying signature...\n");
+    t0 = pqc_now_ns();
     if (OQS_SIG_verify(sig, (const uint8_t*)message, message_len, 
                       signature, signature_len, public_key) != OQS_SUCCESS) {
         printf("❌ Signature verification failed\n");
         goto cleanup;
     }
+    emit(sig, "verify", pqc_now_ns() - t0, signature_len);
     printf("✅ Signature verified successfully\n");
     
     // Step 5: Test tamper detection
@@ -105,16 +124,12 @@ void list_available_signatures() {
     printf("==================================\n");
     
     int count = 0;
-    for (int i = 0; i < OQS_SIG_alg_count(); i++) {
-        const char* alg_name = OQS_SIG_alg_identifier(i);
-        if (OQS_SIG_alg_is_enabled(alg_name)) {
-            OQS_SIG* sig = OQS_SIG_new(alg_name);
-            if (sig) {
-                printf("  %2d. %s\n", ++count, alg_name);
-                printf("      Public: %4zu bytes, Secret: %4zu bytes, Signature: %4zu bytes\n", 
-                       sig->length_public_key, sig->length_secret_key, sig->length_signature);
-                OQS_SIG_free(sig);
-            }
+    for (size_t i = 0; i < pqc_oqs_sig_count(); i++) {
+        const pqc_oqs_sig_info* info = pqc_oqs_sig_at(i);
+        if (info) {
+            printf("  %2d. %s\n", ++count, info->name);
+            printf("      Public: %4zu bytes, Secret: %4zu bytes, Signature: %4zu bytes\n", 
+                   info->length_public_key, info->length_secret_key, info->length_signature);
         }
     }
     
@@ -126,9 +141,15 @@ void list_available_signatures() {
 int main(int argc, char* argv[]) {
     printf("🎯 ML-DSA (Dilithium) Signature Demonstration\n");
     printf("============================================\n");
+    pqc_metrics_init("mldsa_example");
     
-    // List available algorithms
-    list_available_signatures();
+    // Listing reads every enabled algorithm's sizes; only on request
+    if (argc > 1 && strcmp(argv[1], "--list") == 0) {
+        list_available_signatures();
+        return 0;
+    }
+    printf("📋 %zu signature algorithms in this liboqs build (--list shows their sizes)\n",
+           pqc_oqs_sig_count());
     
     const char* algorithm = "Dilithium2";
     if (argc > 1) {
@@ -0,0 +1,343 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include <openssl/evp.h>
+#include <openssl/err.h>
+#include <openssl/crypto.h>
+#include <openssl/core_names.h>
+
+#include "hybrid_kem.h"
+#include "mlkem_engine.h"
+
+/* Domain separation for the combiner, hashed last */
+static const unsigned char combiner_label[] = "X25519-ML-KEM-768 hybrid v1";
+
+enum { X_IDLE, X_RUN, X_DONE, X_STOP };
+
+struct hybrid_kem {
+    mlkem_engine *mlkem;
+    EVP_PKEY *x_key;            /* own X25519 key pair, or the peer's public key */
+    EVP_PKEY_CTX *x_keygen;     /* ephemeral keys for encapsulation */
+    EVP_PKEY_CTX *x_derive;     /* bound to the private key, NULL if public-only */
+    EVP_MD *sha3;
+    EVP_MD_CTX *md;
+    unsigned char pub[HYBRID_KEM_PUBLIC_LEN];
+
+    /* The X25519 half of the current operation */
+    int x_decaps;
+    unsigned char *x_ct_out;    /* encaps: ephemeral public key goes here */
+    const unsigned char *x_ct_in;   /* decaps: the sender's ephemeral key */
+    unsigned char x_ss[HYBRID_KEM_X25519_LEN];
+    int x_ok;
+
+    /* Helper thread for the X25519 half when concurrent */
+    int concurrent;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int state;
+};
+
+/* Ephemeral-static X25519: a fresh key pair, whose public key is the ciphertext */
+static int x25519_encaps(hybrid_kem *k) {
+    EVP_PKEY *eph = NULL;
+    EVP_PKEY_CTX *dctx = NULL;
+    size_t pub_len = HYBRID_KEM_X25519_LEN, ss_len = HYBRID_KEM_X25519_LEN;
+    int ok = EVP_PKEY_keygen(k->x_keygen, &eph) > 0
+        && EVP_PKEY_get_raw_public_key(eph, k->x_ct_out, &pub_len) > 0
+        && (dctx = EVP_PKEY_CTX_new_from_pkey(NULL, eph, NULL)) != NULL
+        && EVP_PKEY_derive_init(dctx) > 0
+        && EVP_PKEY_derive_set_peer(dctx, k->x_key) > 0
+        && EVP_PKEY_derive(dctx, k->x_ss, &ss_len) > 0;
+
+    EVP_PKEY_CTX_free(dctx);
+    EVP_PKEY_free(eph);
+    return ok;
+}
+
+static int x25519_decaps(hybrid_kem *k) {
+    EVP_PKEY *peer;
+    size_t ss_len = HYBRID_KEM_X25519_LEN;
+    int ok;
+
+    peer = EVP_PKEY_new_raw_public_key_ex(NULL, "X25519", NULL, k->x_ct_in, HYBRID_KEM_X25519_LEN);
+    ok = peer
+        && EVP_PKEY_derive_set_peer(k->x_derive, peer) > 0
+        && EVP_PKEY_derive(k->x_derive, k->x_ss, &ss_len) > 0;    /* rejects all-zero output */
+    EVP_PKEY_free(peer);
+    return ok;
+}
+
+static void x25519_run(hybrid_kem *k) {
+    k->x_ok = k->x_decaps ? x25519_decaps(k) : x25519_encaps(k);
+}
+
+static void *x25519_main(void *arg) {
+    hybrid_kem *k = arg;
+
+    pthread_mutex_lock(&k->lock);
+    for (;;) {
+        while (k->state != X_RUN && k->state != X_STOP)
+            pthread_cond_wait(&k->cond, &k->lock);
+        if (k->state == X_STOP) break;
+        pthread_mutex_unlock(&k->lock);
+
+        x25519_run(k);
+
+        pthread_mutex_lock(&k->lock);
+        k->state = X_DONE;
+        pthread_cond_broadcast(&k->cond);
+    }
+    pthread_mutex_unlock(&k->lock);
+    return NULL;
+}
+
+/* Runs the X25519 half alongside mlkem_half; returns 1 if both succeeded */
+static int run_halves(hybrid_kem *k, int (*mlkem_half)(hybrid_kem *, void *), void *arg) {
+    int mlkem_ok;
+
+    if (!k->concurrent) {
+        x25519_run(k);
+        return mlkem_half(k, arg) && k->x_ok;
+    }
+
+    pthread_mutex_lock(&k->lock);
+    k->state = X_RUN;
+    pthread_cond_broadcast(&k->cond);
+    pthread_mutex_unlock(&k->lock);
+
+    mlkem_ok = mlkem_half(k, arg);
+
+    pthread_mutex_lock(&k->lock);
+    while (k->state != X_DONE)
+        pthread_cond_wait(&k->cond, &k->lock);
+    k->state = X_IDLE;
+    pthread_mutex_unlock(&k->lock);
+
+    return mlkem_ok && k->x_ok;
+}
+
+/* SHA3-256 over the secrets, the X25519 values and the caller's transcript */
+static int combine(hybrid_kem *k, unsigned char *ss, const unsigned char *ss_mlkem,
+                   const unsigned char *ct_x, const hybrid_kem_iov *transcript, size_t n) {
+    const unsigned char *pk_x = k->pub + HYBRID_KEM_MLKEM_PUBLIC_LEN;
+    unsigned int out_len = HYBRID_KEM_SECRET_LEN;
+
+    if (EVP_DigestInit_ex2(k->md, k->sha3, NULL) <= 0
+        || EVP_DigestUpdate(k->md, ss_mlkem, HYBRID_KEM_SECRET_LEN) <= 0
+        || EVP_DigestUpdate(k->md, k->x_ss, HYBRID_KEM_X25519_LEN) <= 0
+        || EVP_DigestUpdate(k->md, ct_x, HYBRID_KEM_X25519_LEN) <= 0
+        || EVP_DigestUpdate(k->md, pk_x, HYBRID_KEM_X25519_LEN) <= 0)
+        return 0;
+
+    for (size_t i = 0; i < n; i++) {
+        unsigned char len_be[8];
+        uint64_t len = transcript[i].len;
+
+        for (int b = 7; b >= 0; b--, len >>= 8) len_be[b] = (unsigned char)len;
+        if (EVP_DigestUpdate(k->md, len_be, sizeof(len_be)) <= 0
+            || EVP_DigestUpdate(k->md, transcript[i].data, transcript[i].len) <= 0)
+            return 0;
+    }
+
+    return EVP_DigestUpdate(k->md, combiner_label, sizeof(combiner_label) - 1) > 0
+        && EVP_DigestFinal_ex(k->md, ss, &out_len) > 0;
+}
+
+static hybrid_kem *hybrid_new(EVP_PKEY *mlkem_key, EVP_PKEY *x_key, int concurrent) {
+    hybrid_kem *k;
+    size_t len = HYBRID_KEM_MLKEM_PUBLIC_LEN, x_len = HYBRID_KEM_X25519_LEN;
+
+    k = OPENSSL_zalloc(sizeof(*k));
+    if (!k) return NULL;
+    pthread_mutex_init(&k->lock, NULL);
+    pthread_cond_init(&k->cond, NULL);
+
+    if (EVP_PKEY_get_octet_string_param(mlkem_key, OSSL_PKEY_PARAM_PUB_KEY,
+                                        k->pub, len, &len) <= 0
+        || len != HYBRID_KEM_MLKEM_PUBLIC_LEN
+        || EVP_PKEY_get_raw_public_key(x_key, k->pub + HYBRID_KEM_MLKEM_PUBLIC_LEN, &x_len) <= 0) {
+        fprintf(stderr, "ERROR: Failed to export hybrid public key\n");
+        goto err;
+    }
+
+    k->mlkem = mlkem_engine_new(mlkem_key);
+    if (!k->mlkem || mlkem_engine_ciphertext_len(k->mlkem) != HYBRID_KEM_MLKEM_CIPHERTEXT_LEN
+        || mlkem_engine_secret_len(k->mlkem) != HYBRID_KEM_SECRET_LEN) {
+        fprintf(stderr, "ERROR: Failed to set up ML-KEM-768\n");
+        goto err;
+    }
+
+    if (!EVP_PKEY_up_ref(x_key)) goto err;
+    k->x_key = x_key;
+
+    k->x_keygen = EVP_PKEY_CTX_new_from_name(NULL, "X25519", NULL);
+    k->sha3 = EVP_MD_fetch(NULL, "SHA3-256", NULL);
+    k->md = EVP_MD_CTX_new();
+    if (!k->x_keygen || EVP_PKEY_keygen_init(k->x_keygen) <= 0 || !k->sha3 || !k->md) {
+        fprintf(stderr, "ERROR: Failed to set up X25519 and SHA3-256 contexts\n");
+        goto err;
+    }
+
+    /* Public-only X25519 keys cannot derive; they only encapsulate */
+    if (mlkem_engine_can_decapsulate(k->mlkem)) {
+        k->x_derive = EVP_PKEY_CTX_new_from_pkey(NULL, x_key, NULL);
+        if (!k->x_derive || EVP_PKEY_derive_init(k->x_derive) <= 0) {
+            fprintf(stderr, "ERROR: Failed to set up X25519 derivation\n");
+            goto err;
+        }
+    }
+
+    if (concurrent) {
+        if (pthread_create(&k->thread, NULL, x25519_main, k) != 0) {
+            fprintf(stderr, "ERROR: Failed to start X25519 thread\n");
+            goto err;
+        }
+        k->concurrent = 1;
+    }
+    return k;
+
+err:
+    ERR_print_errors_fp(stderr);
+    hybrid_kem_free(k);
+    return NULL;
+}
+
+hybrid_kem *hybrid_kem_generate(int concurrent) {
+    EVP_PKEY *mlkem_key = EVP_PKEY_Q_keygen(NULL, NULL, "ML-KEM-768");
+    EVP_PKEY *x_key = EVP_PKEY_Q_keygen(NULL, NULL, "X25519");
+    hybrid_kem *k = NULL;
+
+    if (!mlkem_key || !x_key) {
+        fprintf(stderr, "ERROR: Hybrid key generation failed\n");
+        ERR_print_errors_fp(stderr);
+    } else {
+        k = hybrid_new(mlkem_key, x_key, concurrent);
+    }
+    EVP_PKEY_free(mlkem_key);
+    EVP_PKEY_free(x_key);
+    return k;
+}
+
+hybrid_kem *hybrid_kem_new_from_public(const unsigned char *pub, size_t pub_len,
+                                       int concurrent) {
+    EVP_PKEY *mlkem_key = NULL, *x_key = NULL;
+    hybrid_kem *k = NULL;
+
+    if (pub_len != HYBRID_KEM_PUBLIC_LEN) {
+        fprintf(stderr, "ERROR: Hybrid public key length %zu, expected %d\n",
+                pub_len, HYBRID_KEM_PUBLIC_LEN);
+        return NULL;
+    }
+
+    mlkem_key = EVP_PKEY_new_raw_public_key_ex(NULL, "ML-KEM-768", NULL,
+                                               pub, HYBRID_KEM_MLKEM_PUBLIC_LEN);
+    x_key = EVP_PKEY_new_raw_public_key_ex(NULL, "X25519", NULL,
+                                           pub + HYBRID_KEM_MLKEM_PUBLIC_LEN,
+                                           HYBRID_KEM_X25519_LEN);
+    if (!mlkem_key || !x_key) {
+        fprintf(stderr, "ERROR: Failed to import hybrid public key\n");
+        ERR_print_errors_fp(stderr);
+    } else {
+        k = hybrid_new(mlkem_key, x_key, concurrent);
+    }
+    EVP_PKEY_free(mlkem_key);
+    EVP_PKEY_free(x_key);
+    return k;
+}
+
+void hybrid_kem_free(hybrid_kem *k) {
+    if (!k) return;
+
+    if (k->concurrent) {
+        pthread_mutex_lock(&k->lock);
+        k->state = X_STOP;
+        pthread_cond_broadcast(&k->cond);
+        pthread_mutex_unlock(&k->lock);
+        pthread_join(k->thread, NULL);
+    }
+    pthread_cond_destroy(&k->cond);
+    pthread_mutex_destroy(&k->lock);
+
+    mlkem_engine_free(k->mlkem);
+    EVP_PKEY_CTX_free(k->x_keygen);
+    EVP_PKEY_CTX_free(k->x_derive);
+    EVP_PKEY_free(k->x_key);
+    EVP_MD_CTX_free(k->md);
+    EVP_MD_free(k->sha3);
+    OPENSSL_clear_free(k, sizeof(*k));
+}
+
+const unsigned char *hybrid_kem_public_key(const hybrid_kem *k) {
+    return k->pub;
+}
+
+int hybrid_kem_can_decapsulate(const hybrid_kem *k) {
+    return k->x_derive != NULL;
+}
+
+typedef struct {
+    unsigned char *ss;
+    unsigned char *ct;
+    const unsigned char *ct_in;
+} mlkem_args;
+
+static int mlkem_encaps_half(hybrid_kem *k, void *arg) {
+    mlkem_args *a = arg;
+    return mlkem_engine_encapsulate(k->mlkem, a->ct, a->ss);
+}
+
+static int mlkem_decaps_half(hybrid_kem *k, void *arg) {
+    mlkem_args *a = arg;
+    return mlkem_engine_decapsulate(k->mlkem, a->ss, a->ct_in, HYBRID_KEM_MLKEM_CIPHERTEXT_LEN);
+}
+
+int hybrid_kem_encapsulate(hybrid_kem *k, unsigned char *ct, unsigned char *ss,
+                           const hybrid_kem_iov *transcript, size_t n) {
+    unsigned char ss_mlkem[HYBRID_KEM_SECRET_LEN];
+    mlkem_args a = { ss_mlkem, ct, NULL };
+    int ok;
+
+    /* Both halves write straight into their part of the caller's ct */
+    k->x_decaps = 0;
+    k->x_ct_out = ct + HYBRID_KEM_MLKEM_CIPHERTEXT_LEN;
+    ok = run_halves(k, mlkem_encaps_half, &a)
+        && combine(k, ss, ss_mlkem, k->x_ct_out, transcript, n);
+    if (!ok) ERR_print_errors_fp(stderr);
+
+    OPENSSL_cleanse(ss_mlkem, sizeof(ss_mlkem));
+    OPENSSL_cleanse(k->x_ss, sizeof(k->x_ss));
+    return ok;
+}
+
+int hybrid_kem_decapsulate(hybrid_kem *k, unsigned char *ss,
+                           const unsigned char *ct, size_t ct_len,
+                           const hybrid_kem_iov *transcript, size_t n) {
+    unsigned char ss_mlkem[HYBRID_KEM_SECRET_LEN];
+    mlkem_args a = { ss_mlkem, NULL, ct };
+    int ok;
+
+    if (!k->x_derive) {
+        fprintf(stderr, "ERROR: Key has no private part, cannot decapsulate\n");
+        return 0;
+    }
+    if (ct_len != HYBRID_KEM_CIPHERTEXT_LEN) {
+        fprintf(stderr, "ERROR: Ciphertext length %zu, expected %d\n",
+                ct_len, HYBRID_KEM_CIPHERTEXT_LEN);
+        return 0;
+    }
+
+    k->x_decaps = 1;
+    k->x_ct_in = ct + HYBRID_KEM_MLKEM_CIPHERTEXT_LEN;
+    ok = run_halves(k, mlkem_decaps_half, &a)
+        && combine(k, ss, ss_mlkem, k->x_ct_in, transcript, n);
+    if (!ok) ERR_print_errors_fp(stderr);
+
+    OPENSSL_cleanse(ss_mlkem, sizeof(ss_mlkem));
+    OPENSSL_cleanse(k->x_ss, sizeof(k->x_ss));
+    return ok;
+}
@@ -0,0 +1,71 @@
+#ifndef HYBRID_KEM_H
+#define HYBRID_KEM_H
+
+#include <stddef.h>
+
+/*
+ * Hybrid X25519 + ML-KEM-768 key encapsulation.
+ *
+ * Public keys and ciphertexts are the ML-KEM-768 encoding followed by the
+ * 32-byte X25519 value, the same layout as the X25519MLKEM768 TLS group. The
+ * classical half is an ephemeral-static X25519 exchange: the sender's
+ * ephemeral public key is its ciphertext.
+ *
+ * Unlike the TLS group, which hands both secrets to the TLS key schedule, the
+ * two secrets are combined here with SHA3-256 in the style of X-Wing:
+ *
+ *   ss = SHA3-256(ss_mlkem || ss_x25519 || ct_x25519 || pk_x25519 ||
+ *                 len(t_1) || t_1 || ... || len(t_n) || t_n || label)
+ *
+ * where t_1..t_n is the caller's handshake transcript, hashed straight from
+ * the caller's buffers with 64-bit big-endian length prefixes; nothing is
+ * copied or concatenated first.
+ *
+ * With concurrent set, the X25519 half runs on a helper thread owned by the
+ * context while the calling thread does the ML-KEM half. That only pays off
+ * with a spare core; on a single CPU the handoff is pure overhead.
+ *
+ * A context is not safe for concurrent use; create one per thread.
+ */
+
+#define HYBRID_KEM_MLKEM_PUBLIC_LEN     1184
+#define HYBRID_KEM_MLKEM_CIPHERTEXT_LEN 1088
+#define HYBRID_KEM_X25519_LEN           32
+#define HYBRID_KEM_PUBLIC_LEN     (HYBRID_KEM_MLKEM_PUBLIC_LEN + HYBRID_KEM_X25519_LEN)
+#define HYBRID_KEM_CIPHERTEXT_LEN (HYBRID_KEM_MLKEM_CIPHERTEXT_LEN + HYBRID_KEM_X25519_LEN)
+#define HYBRID_KEM_SECRET_LEN     32
+
+typedef struct hybrid_kem hybrid_kem;
+
+/* One piece of the transcript; the caller keeps ownership. */
+typedef struct {
+    const void *data;
+    size_t len;
+} hybrid_kem_iov;
+
+/* Generates a fresh X25519 and ML-KEM-768 key pair. */
+hybrid_kem *hybrid_kem_generate(int concurrent);
+
+/* Encapsulate-only context for a peer's HYBRID_KEM_PUBLIC_LEN-byte key. */
+hybrid_kem *hybrid_kem_new_from_public(const unsigned char *pub, size_t pub_len,
+                                       int concurrent);
+
+void hybrid_kem_free(hybrid_kem *k);
+
+/* HYBRID_KEM_PUBLIC_LEN bytes, valid for the lifetime of k. */
+const unsigned char *hybrid_kem_public_key(const hybrid_kem *k);
+
+int hybrid_kem_can_decapsulate(const hybrid_kem *k);
+
+/*
+ * ct must hold HYBRID_KEM_CIPHERTEXT_LEN bytes and ss HYBRID_KEM_SECRET_LEN
+ * bytes. transcript may be NULL when n is 0. Both sides must pass the same
+ * transcript to agree on ss. Return 1 on success, 0 on error.
+ */
+int hybrid_kem_encapsulate(hybrid_kem *k, unsigned char *ct, unsigned char *ss,
+                           const hybrid_kem_iov *transcript, size_t n);
+int hybrid_kem_decapsulate(hybrid_kem *k, unsigned char *ss,
+                           const unsigned char *ct, size_t ct_len,
+                           const hybrid_kem_iov *transcript, size_t n);
+
+#endif /* HYBRID_KEM_H */
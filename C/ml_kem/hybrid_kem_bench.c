@@ -0,0 +1,207 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <openssl/evp.h>
+#include <openssl/err.h>
+#include <openssl/rand.h>
+#include <openssl/crypto.h>
+#include <openssl/core_names.h>
+
+#include "hybrid_kem.h"
+#include "mlkem_engine.h"
+#include "pqc_metrics.h"
+#include "pqc_timer.h"
+
+/*
+ * Per-handshake latency of the hybrid X25519 + ML-KEM-768 KEM against plain
+ * ML-KEM-768. A handshake is the client encapsulating to the server's public
+ * key plus the server decapsulating, both with cached contexts, and for the
+ * hybrid both binding the same transcript (a ClientHello-sized buffer and
+ * the server's public key, hashed in place).
+ */
+
+#define HANDSHAKES 2000
+
+static void handle_openssl_error(const char *msg) {
+    fprintf(stderr, "ERROR: %s\n", msg);
+    ERR_print_errors_fp(stderr);
+}
+
+static void report(const char *name, const char *alg, const char *impl, const pqc_metrics_sizes *sizes,
+                   uint64_t *ns, int n, double base_p50) {
+    pqc_stats st;
+
+    pqc_metrics_emit_samples(alg, "handshake", impl, ns, (size_t)n, 0, sizes);
+    pqc_stats_compute(&st, ns, NULL, (size_t)n, 0);
+    double p50 = (double)st.median_ns / 1e3, p99 = (double)st.p99_ns / 1e3;
+    printf("  %-24s %9.1f %9.1f %9.1f %9.2fx\n", name, st.mean_ns / 1e3, p50, p99,
+           base_p50 > 0 ? p50 / base_p50 : 1.0);
+}
+
+/* Plain ML-KEM-768 handshakes through mlkem_engine */
+static int bench_mlkem(int n, uint64_t *ns) {
+    EVP_PKEY *pkey = EVP_PKEY_Q_keygen(NULL, NULL, "ML-KEM-768");
+    mlkem_engine *server = NULL, *client = NULL;
+    unsigned char pub[HYBRID_KEM_MLKEM_PUBLIC_LEN], ct[HYBRID_KEM_MLKEM_CIPHERTEXT_LEN];
+    unsigned char ss_c[HYBRID_KEM_SECRET_LEN], ss_s[HYBRID_KEM_SECRET_LEN];
+    size_t pub_len = sizeof(pub);
+    int ok = 0;
+
+    if (!pkey || EVP_PKEY_get_octet_string_param(pkey, OSSL_PKEY_PARAM_PUB_KEY,
+                                                 pub, sizeof(pub), &pub_len) <= 0) {
+        handle_openssl_error("ML-KEM-768 key generation failed");
+        goto cleanup;
+    }
+    server = mlkem_engine_new(pkey);
+    client = mlkem_engine_new_from_public("ML-KEM-768", pub, pub_len);
+    if (!server || !client) goto cleanup;
+
+    for (int i = 0; i < n; i++) {
+        uint64_t t0 = pqc_now_ns();
+        if (!mlkem_engine_encapsulate(client, ct, ss_c)
+            || !mlkem_engine_decapsulate(server, ss_s, ct, sizeof(ct))
+            || CRYPTO_memcmp(ss_c, ss_s, sizeof(ss_c)) != 0) {
+            printf("❌ ML-KEM-768 handshake failed\n");
+            goto cleanup;
+        }
+        ns[i] = pqc_now_ns() - t0;
+    }
+    ok = 1;
+
+cleanup:
+    mlkem_engine_free(client);
+    mlkem_engine_free(server);
+    EVP_PKEY_free(pkey);
+    return ok;
+}
+
+static int bench_hybrid(int n, uint64_t *ns, int concurrent, const unsigned char *hello,
+                        size_t hello_len) {
+    hybrid_kem *server = hybrid_kem_generate(concurrent);
+    hybrid_kem *client = NULL;
+    unsigned char ct[HYBRID_KEM_CIPHERTEXT_LEN];
+    unsigned char ss_c[HYBRID_KEM_SECRET_LEN], ss_s[HYBRID_KEM_SECRET_LEN];
+    int ok = 0;
+
+    if (!server) goto cleanup;
+    client = hybrid_kem_new_from_public(hybrid_kem_public_key(server),
+                                        HYBRID_KEM_PUBLIC_LEN, concurrent);
+    if (!client) goto cleanup;
+
+    hybrid_kem_iov transcript[2] = {
+        { hello, hello_len },
+        { hybrid_kem_public_key(server), HYBRID_KEM_PUBLIC_LEN },
+    };
+
+    for (int i = 0; i < n; i++) {
+        uint64_t t0 = pqc_now_ns();
+        if (!hybrid_kem_encapsulate(client, ct, ss_c, transcript, 2)
+            || !hybrid_kem_decapsulate(server, ss_s, ct, sizeof(ct), transcript, 2)
+            || CRYPTO_memcmp(ss_c, ss_s, sizeof(ss_c)) != 0) {
+            printf("❌ Hybrid handshake failed\n");
+            goto cleanup;
+        }
+        ns[i] = pqc_now_ns() - t0;
+    }
+    ok = 1;
+
+cleanup:
+    hybrid_kem_free(client);
+    hybrid_kem_free(server);
+    return ok;
+}
+
+/* Agreement, and a different secret for a changed transcript or ciphertext */
+static int check_binding(const unsigned char *hello, size_t hello_len) {
+    hybrid_kem *server = hybrid_kem_generate(0), *client = NULL;
+    unsigned char ct[HYBRID_KEM_CIPHERTEXT_LEN];
+    unsigned char ss_c[HYBRID_KEM_SECRET_LEN], ss_s[HYBRID_KEM_SECRET_LEN];
+    int ok = 0;
+
+    if (!server) return 0;
+    client = hybrid_kem_new_from_public(hybrid_kem_public_key(server), HYBRID_KEM_PUBLIC_LEN, 0);
+    hybrid_kem_iov t[1] = { { hello, hello_len } };
+    hybrid_kem_iov t2[1] = { { hello, hello_len - 1 } };
+    if (!client || hybrid_kem_can_decapsulate(client)
+        || !hybrid_kem_encapsulate(client, ct, ss_c, t, 1)
+        || !hybrid_kem_decapsulate(server, ss_s, ct, sizeof(ct), t, 1)
+        || CRYPTO_memcmp(ss_c, ss_s, sizeof(ss_c)) != 0)
+        goto cleanup;
+    printf("✅ Client and server agree\n");
+
+    if (!hybrid_kem_decapsulate(server, ss_s, ct, sizeof(ct), t2, 1)
+        || CRYPTO_memcmp(ss_c, ss_s, sizeof(ss_c)) == 0)
+        goto cleanup;
+    printf("✅ A different transcript gives a different secret\n");
+
+    /* Flip a bit of the X25519 share; ML-KEM alone would still agree */
+    ct[HYBRID_KEM_MLKEM_CIPHERTEXT_LEN] ^= 0x01;
+    if (hybrid_kem_decapsulate(server, ss_s, ct, sizeof(ct), t, 1)
+        && CRYPTO_memcmp(ss_c, ss_s, sizeof(ss_c)) == 0)
+        goto cleanup;
+    printf("✅ A modified X25519 share gives a different secret\n");
+    ok = 1;
+
+cleanup:
+    hybrid_kem_free(client);
+    hybrid_kem_free(server);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : HANDSHAKES;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned char hello[512];
+    uint64_t *ns[3] = { NULL, NULL, NULL };
+    double base_p50;
+    int ret = 1;
+    const pqc_metrics_sizes mlkem_sizes = { HYBRID_KEM_MLKEM_PUBLIC_LEN, 0, HYBRID_KEM_MLKEM_CIPHERTEXT_LEN,
+                                            HYBRID_KEM_SECRET_LEN, 0 };
+    const pqc_metrics_sizes hybrid_sizes = { HYBRID_KEM_PUBLIC_LEN, 0, HYBRID_KEM_CIPHERTEXT_LEN,
+                                             HYBRID_KEM_SECRET_LEN, 0 };
+
+    pqc_metrics_init("hybrid_kem_bench");
+    printf("🎯 Hybrid X25519 + ML-KEM-768\n");
+    printf("==============================\n");
+    if (n < 100) n = 100;
+
+    for (int i = 0; i < 3; i++) {
+        ns[i] = malloc((size_t)n * sizeof(uint64_t));
+        if (!ns[i]) goto cleanup;
+    }
+    if (RAND_bytes(hello, sizeof(hello)) <= 0) {
+        handle_openssl_error("RAND_bytes failed");
+        goto cleanup;
+    }
+
+    printf("1. 🔑 Checking the combiner...\n");
+    if (!check_binding(hello, sizeof(hello))) {
+        printf("❌ Hybrid KEM check failed\n");
+        goto cleanup;
+    }
+
+    printf("\n2. ⏱️  %d handshakes each (encapsulate + decapsulate), %ld CPU(s)\n\n", n, cpus);
+    if (!bench_mlkem(n, ns[0])
+        || !bench_hybrid(n, ns[1], 0, hello, sizeof(hello))
+        || !bench_hybrid(n, ns[2], 1, hello, sizeof(hello)))
+        goto cleanup;
+
+    printf("  %-24s %9s %9s %9s %10s\n", "", "mean µs", "p50 µs", "p99 µs", "vs ML-KEM");
+    report("ML-KEM-768", "ML-KEM-768", "mlkem_engine", &mlkem_sizes, ns[0], n, 0);
+    base_p50 = (double)ns[0][n / 2] / 1e3;
+    report("hybrid, sequential", "X25519MLKEM768", "sequential", &hybrid_sizes, ns[1], n, base_p50);
+    report("hybrid, concurrent", "X25519MLKEM768", "concurrent", &hybrid_sizes, ns[2], n, base_p50);
+    if (cpus < 2)
+        printf("\n💡 One CPU: the concurrent X25519 half cannot overlap with ML-KEM here\n");
+
+    printf("\n✨ Benchmark completed!\n");
+    ret = 0;
+
+cleanup:
+    for (int i = 0; i < 3; i++) free(ns[i]);
+    return ret;
+}
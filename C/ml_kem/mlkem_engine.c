@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <openssl/evp.h>
+#include <openssl/err.h>
+
+#include "mlkem_engine.h"
+
+struct mlkem_engine {
+    EVP_PKEY *pkey;
+    EVP_PKEY_CTX *encaps_ctx;
+    EVP_PKEY_CTX *decaps_ctx;   /* NULL for public-only keys */
+    size_t ct_len;
+    size_t ss_len;
+};
+
+mlkem_engine *mlkem_engine_new(EVP_PKEY *pkey) {
+    mlkem_engine *engine;
+
+    if (!pkey) return NULL;
+
+    engine = OPENSSL_zalloc(sizeof(*engine));
+    if (!engine) return NULL;
+
+    if (!EVP_PKEY_up_ref(pkey)) {
+        OPENSSL_free(engine);
+        return NULL;
+    }
+    engine->pkey = pkey;
+
+    engine->encaps_ctx = EVP_PKEY_CTX_new_from_pkey(NULL, pkey, NULL);
+    if (!engine->encaps_ctx || EVP_PKEY_encapsulate_init(engine->encaps_ctx, NULL) <= 0) {
+        fprintf(stderr, "ERROR: Failed to initialize encapsulation context\n");
+        ERR_print_errors_fp(stderr);
+        goto err;
+    }
+
+    /* Query output sizes once instead of on every call */
+    if (EVP_PKEY_encapsulate(engine->encaps_ctx, NULL, &engine->ct_len,
+                             NULL, &engine->ss_len) <= 0) {
+        fprintf(stderr, "ERROR: Failed to query KEM output sizes\n");
+        ERR_print_errors_fp(stderr);
+        goto err;
+    }
+
+    /* Decapsulation needs the private key; public-only keys just skip it */
+    engine->decaps_ctx = EVP_PKEY_CTX_new_from_pkey(NULL, pkey, NULL);
+    if (!engine->decaps_ctx || EVP_PKEY_decapsulate_init(engine->decaps_ctx, NULL) <= 0) {
+        EVP_PKEY_CTX_free(engine->decaps_ctx);
+        engine->decaps_ctx = NULL;
+        ERR_clear_error();
+    }
+
+    return engine;
+
+err:
+    mlkem_engine_free(engine);
+    return NULL;
+}
+
+mlkem_engine *mlkem_engine_new_from_public(const char *type,
+                                           const unsigned char *pub, size_t pub_len) {
+    EVP_PKEY *pkey;
+    mlkem_engine *engine;
+
+    pkey = EVP_PKEY_new_raw_public_key_ex(NULL, type, NULL, pub, pub_len);
+    if (!pkey) {
+        fprintf(stderr, "ERROR: Failed to import %s public key\n", type);
+        ERR_print_errors_fp(stderr);
+        return NULL;
+    }
+
+    engine = mlkem_engine_new(pkey);
+    EVP_PKEY_free(pkey);
+    return engine;
+}
+
+mlkem_engine *mlkem_engine_dup(const mlkem_engine *src) {
+    mlkem_engine *engine;
+
+    if (!src) return NULL;
+
+    engine = OPENSSL_zalloc(sizeof(*engine));
+    if (!engine) return NULL;
+
+    if (!EVP_PKEY_up_ref(src->pkey)) {
+        OPENSSL_free(engine);
+        return NULL;
+    }
+    engine->pkey = src->pkey;
+    engine->ct_len = src->ct_len;
+    engine->ss_len = src->ss_len;
+
+    engine->encaps_ctx = EVP_PKEY_CTX_dup(src->encaps_ctx);
+    if (!engine->encaps_ctx) goto err;
+
+    if (src->decaps_ctx) {
+        engine->decaps_ctx = EVP_PKEY_CTX_dup(src->decaps_ctx);
+        if (!engine->decaps_ctx) goto err;
+    }
+    return engine;
+
+err:
+    ERR_print_errors_fp(stderr);
+    mlkem_engine_free(engine);
+    return NULL;
+}
+
+void mlkem_engine_free(mlkem_engine *engine) {
+    if (!engine) return;
+    EVP_PKEY_CTX_free(engine->encaps_ctx);
+    EVP_PKEY_CTX_free(engine->decaps_ctx);
+    EVP_PKEY_free(engine->pkey);
+    OPENSSL_free(engine);
+}
+
+size_t mlkem_engine_ciphertext_len(const mlkem_engine *engine) {
+    return engine->ct_len;
+}
+
+size_t mlkem_engine_secret_len(const mlkem_engine *engine) {
+    return engine->ss_len;
+}
+
+int mlkem_engine_can_decapsulate(const mlkem_engine *engine) {
+    return engine->decaps_ctx != NULL;
+}
+
+int mlkem_engine_encapsulate(mlkem_engine *engine,
+                             unsigned char *ct, unsigned char *ss) {
+    size_t ct_len = engine->ct_len;
+    size_t ss_len = engine->ss_len;
+
+    if (EVP_PKEY_encapsulate(engine->encaps_ctx, ct, &ct_len, ss, &ss_len) <= 0) {
+        ERR_print_errors_fp(stderr);
+        return 0;
+    }
+    return 1;
+}
+
+int mlkem_engine_decapsulate(mlkem_engine *engine, unsigned char *ss,
+                             const unsigned char *ct, size_t ct_len) {
+    size_t ss_len = engine->ss_len;
+
+    if (!engine->decaps_ctx) {
+        fprintf(stderr, "ERROR: Key has no private part, cannot decapsulate\n");
+        return 0;
+    }
+    if (ct_len != engine->ct_len) {
+        fprintf(stderr, "ERROR: Ciphertext length %zu, expected %zu\n", ct_len, engine->ct_len);
+        return 0;
+    }
+    if (EVP_PKEY_decapsulate(engine->decaps_ctx, ss, &ss_len, ct, ct_len) <= 0) {
+        ERR_print_errors_fp(stderr);
+        return 0;
+    }
+    return 1;
+}
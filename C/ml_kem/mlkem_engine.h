@@ -0,0 +1,44 @@
+#ifndef MLKEM_ENGINE_H
+#define MLKEM_ENGINE_H
+
+#include <stddef.h>
+
+#include <openssl/evp.h>
+
+/*
+ * ML-KEM encapsulation/decapsulation engine with cached contexts.
+ *
+ * An engine wraps one key. The EVP_PKEY_CTX for encapsulation (and for
+ * decapsulation, when the key has a private half) is created and initialised
+ * once in mlkem_engine_new() and then reused for every operation, so a
+ * long-lived server key pays the provider context setup only at startup.
+ *
+ * An engine is not safe for concurrent use. Give each thread its own copy
+ * with mlkem_engine_dup(), which duplicates the initialised contexts.
+ */
+typedef struct mlkem_engine mlkem_engine;
+
+/* Takes a reference on pkey; the caller keeps its own reference. */
+mlkem_engine *mlkem_engine_new(EVP_PKEY *pkey);
+
+/* Builds an encapsulate-only engine from a peer's raw public key. */
+mlkem_engine *mlkem_engine_new_from_public(const char *type,
+                                           const unsigned char *pub, size_t pub_len);
+
+mlkem_engine *mlkem_engine_dup(const mlkem_engine *engine);
+void mlkem_engine_free(mlkem_engine *engine);
+
+size_t mlkem_engine_ciphertext_len(const mlkem_engine *engine);
+size_t mlkem_engine_secret_len(const mlkem_engine *engine);
+int mlkem_engine_can_decapsulate(const mlkem_engine *engine);
+
+/*
+ * ct must hold mlkem_engine_ciphertext_len() bytes and ss
+ * mlkem_engine_secret_len() bytes. Return 1 on success, 0 on error.
+ */
+int mlkem_engine_encapsulate(mlkem_engine *engine,
+                             unsigned char *ct, unsigned char *ss);
+int mlkem_engine_decapsulate(mlkem_engine *engine, unsigned char *ss,
+                             const unsigned char *ct, size_t ct_len);
+
+#endif /* MLKEM_ENGINE_H */
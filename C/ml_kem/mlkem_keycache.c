@@ -0,0 +1,157 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include <openssl/evp.h>
+#include <openssl/err.h>
+
+#include "mlkem_keycache.h"
+
+#define DIGEST_LEN 32
+#define NIL ((size_t)-1)
+
+typedef struct {
+    unsigned char digest[DIGEST_LEN];   /* SHA3-256 of the public key */
+    mlkem_engine *engine;
+    size_t prev, next;                  /* LRU list, most recent first */
+    size_t chain;                       /* next entry in the same bucket */
+} cache_entry;
+
+struct mlkem_keycache {
+    char type[32];
+    EVP_MD *sha3;
+    cache_entry *entries;
+    size_t capacity, used;
+    size_t *buckets;                    /* first entry of each chain, or NIL */
+    size_t mask;
+    size_t head, tail;                  /* most and least recently used */
+    uint64_t hits, misses, evictions;
+};
+
+mlkem_keycache *mlkem_keycache_new(const char *type, size_t capacity) {
+    mlkem_keycache *c;
+    size_t nbuckets = 1;
+
+    if (capacity == 0 || strlen(type) >= sizeof(c->type)) return NULL;
+    if (!(c = OPENSSL_zalloc(sizeof(*c)))) return NULL;
+    strcpy(c->type, type);
+    c->capacity = capacity;
+    c->head = c->tail = NIL;
+
+    /* At most one entry per two buckets on average */
+    while (nbuckets < 2 * capacity) nbuckets <<= 1;
+    c->mask = nbuckets - 1;
+
+    c->sha3 = EVP_MD_fetch(NULL, "SHA3-256", NULL);
+    c->entries = OPENSSL_zalloc(capacity * sizeof(*c->entries));
+    c->buckets = OPENSSL_malloc(nbuckets * sizeof(*c->buckets));
+    if (!c->sha3 || !c->entries || !c->buckets) {
+        mlkem_keycache_free(c);
+        return NULL;
+    }
+    for (size_t i = 0; i < nbuckets; i++) c->buckets[i] = NIL;
+    return c;
+}
+
+void mlkem_keycache_free(mlkem_keycache *c) {
+    if (!c) return;
+    for (size_t i = 0; i < c->used; i++) mlkem_engine_free(c->entries[i].engine);
+    OPENSSL_free(c->entries);
+    OPENSSL_free(c->buckets);
+    EVP_MD_free(c->sha3);
+    OPENSSL_free(c);
+}
+
+static size_t bucket_of(const mlkem_keycache *c, const unsigned char *digest) {
+    uint64_t h;
+
+    memcpy(&h, digest, sizeof(h));
+    return (size_t)h & c->mask;
+}
+
+static void lru_unlink(mlkem_keycache *c, size_t i) {
+    cache_entry *e = &c->entries[i];
+
+    if (e->prev != NIL) c->entries[e->prev].next = e->next;
+    else c->head = e->next;
+    if (e->next != NIL) c->entries[e->next].prev = e->prev;
+    else c->tail = e->prev;
+}
+
+static void lru_push_front(mlkem_keycache *c, size_t i) {
+    cache_entry *e = &c->entries[i];
+
+    e->prev = NIL;
+    e->next = c->head;
+    if (c->head != NIL) c->entries[c->head].prev = i;
+    c->head = i;
+    if (c->tail == NIL) c->tail = i;
+}
+
+static void chain_remove(mlkem_keycache *c, size_t i) {
+    size_t *link = &c->buckets[bucket_of(c, c->entries[i].digest)];
+
+    while (*link != i) link = &c->entries[*link].chain;
+    *link = c->entries[i].chain;
+}
+
+mlkem_engine *mlkem_keycache_get(mlkem_keycache *c,
+                                 const unsigned char *pub, size_t pub_len) {
+    unsigned char digest[DIGEST_LEN];
+    mlkem_engine *engine;
+    size_t b, i;
+
+    if (EVP_Digest(pub, pub_len, digest, NULL, c->sha3, NULL) <= 0) {
+        ERR_print_errors_fp(stderr);
+        return NULL;
+    }
+
+    b = bucket_of(c, digest);
+    for (i = c->buckets[b]; i != NIL; i = c->entries[i].chain) {
+        if (memcmp(c->entries[i].digest, digest, DIGEST_LEN) == 0) {
+            c->hits++;
+            if (c->head != i) {
+                lru_unlink(c, i);
+                lru_push_front(c, i);
+            }
+            return c->entries[i].engine;
+        }
+    }
+
+    c->misses++;
+    if (!(engine = mlkem_engine_new_from_public(c->type, pub, pub_len))) return NULL;
+
+    if (c->used < c->capacity) {
+        i = c->used++;
+    } else {
+        i = c->tail;
+        lru_unlink(c, i);
+        chain_remove(c, i);
+        mlkem_engine_free(c->entries[i].engine);
+        c->evictions++;
+    }
+
+    memcpy(c->entries[i].digest, digest, DIGEST_LEN);
+    c->entries[i].engine = engine;
+    c->entries[i].chain = c->buckets[b];
+    c->buckets[b] = i;
+    lru_push_front(c, i);
+    return engine;
+}
+
+int mlkem_keycache_encapsulate(mlkem_keycache *c,
+                               const unsigned char *pub, size_t pub_len,
+                               unsigned char *ct, unsigned char *ss) {
+    mlkem_engine *engine = mlkem_keycache_get(c, pub, pub_len);
+
+    return engine && mlkem_engine_encapsulate(engine, ct, ss);
+}
+
+void mlkem_keycache_get_stats(const mlkem_keycache *c, mlkem_keycache_stats *stats) {
+    stats->hits = c->hits;
+    stats->misses = c->misses;
+    stats->evictions = c->evictions;
+    stats->entries = c->used;
+}
@@ -0,0 +1,52 @@
+#ifndef MLKEM_KEYCACHE_H
+#define MLKEM_KEYCACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mlkem_engine.h"
+
+/*
+ * LRU cache of prepared ML-KEM encapsulation keys.
+ *
+ * Importing a raw ML-KEM public key is where OpenSSL decodes t-hat and
+ * expands the matrix A from its seed, which is most of the cost of a
+ * one-shot encapsulation. A prepared key is an mlkem_engine over the
+ * imported key, so encapsulating to the same recipient again skips both.
+ *
+ * Keys are looked up by SHA3-256 of the raw public key, the H(ek) that
+ * ML-KEM itself uses. When the cache is full, the least recently used
+ * key is evicted.
+ *
+ * Like the engines it holds, a cache is not thread-safe: give each thread
+ * its own.
+ */
+typedef struct mlkem_keycache mlkem_keycache;
+
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;            /* imports, including failed ones */
+    uint64_t evictions;
+    size_t entries;
+} mlkem_keycache_stats;
+
+/* type is the ML-KEM parameter set, e.g. "ML-KEM-768". */
+mlkem_keycache *mlkem_keycache_new(const char *type, size_t capacity);
+void mlkem_keycache_free(mlkem_keycache *cache);
+
+/*
+ * The prepared key for pub, imported on a miss. The engine belongs to the
+ * cache and stays valid until the next call on the cache. NULL if pub is
+ * not a valid public key.
+ */
+mlkem_engine *mlkem_keycache_get(mlkem_keycache *cache,
+                                 const unsigned char *pub, size_t pub_len);
+
+/* mlkem_keycache_get() and mlkem_engine_encapsulate() in one call. */
+int mlkem_keycache_encapsulate(mlkem_keycache *cache,
+                               const unsigned char *pub, size_t pub_len,
+                               unsigned char *ct, unsigned char *ss);
+
+void mlkem_keycache_get_stats(const mlkem_keycache *cache, mlkem_keycache_stats *stats);
+
+#endif /* MLKEM_KEYCACHE_H */
@@ -0,0 +1,240 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include <openssl/evp.h>
+#include <openssl/err.h>
+#include <openssl/crypto.h>
+#include <openssl/core_names.h>
+
+#include "mlkem_engine.h"
+#include "mlkem_keycache.h"
+#include "pqc_metrics.h"
+#include "pqc_timer.h"
+
+/*
+ * Clients encapsulating to a handful of server keys over and over. Each
+ * operation picks one of NKEYS recipients round-robin and encapsulates:
+ *
+ *   one-shot  import the raw key, encapsulate, free (what a stateless
+ *             OQS_KEM_encaps-style call does every time)
+ *   cached    mlkem_keycache_encapsulate(): hash, lookup, encapsulate
+ *   engine    an mlkem_engine held per key by the caller, for reference
+ *
+ * Memory per cached key is measured by counting OpenSSL's allocations while
+ * MEMKEYS distinct keys are imported into a cache.
+ */
+
+#define NKEYS 4
+#define MEMKEYS 64
+#define MAX_PUB 1568
+#define MAX_CT 1568
+
+/* ---- Allocation accounting through CRYPTO_set_mem_functions ---- */
+
+#define HDR 16                  /* keeps the caller's pointer 16-byte aligned */
+
+static size_t live_bytes;
+
+static void *count_malloc(size_t n, const char *file, int line) {
+    unsigned char *p = malloc(n + HDR);
+
+    (void)file; (void)line;
+    if (!p) return NULL;
+    memcpy(p, &n, sizeof(n));
+    live_bytes += n;
+    return p + HDR;
+}
+
+static void count_free(void *ptr, const char *file, int line) {
+    size_t n;
+
+    (void)file; (void)line;
+    if (!ptr) return;
+    memcpy(&n, (unsigned char *)ptr - HDR, sizeof(n));
+    live_bytes -= n;
+    free((unsigned char *)ptr - HDR);
+}
+
+static void *count_realloc(void *ptr, size_t n, const char *file, int line) {
+    unsigned char *p;
+    size_t old = 0;
+
+    if (!ptr) return count_malloc(n, file, line);
+    memcpy(&old, (unsigned char *)ptr - HDR, sizeof(old));
+    if (!(p = realloc((unsigned char *)ptr - HDR, n + HDR))) return NULL;
+    memcpy(p, &n, sizeof(n));
+    live_bytes = live_bytes - old + n;
+    return p + HDR;
+}
+
+/* ---- Benchmark ---- */
+
+typedef struct {
+    EVP_PKEY *pkey;
+    unsigned char pub[MAX_PUB];
+    size_t pub_len;
+} server_key;
+
+static int make_key(const char *alg, server_key *k) {
+    k->pkey = EVP_PKEY_Q_keygen(NULL, NULL, alg);
+    k->pub_len = sizeof(k->pub);
+    return k->pkey && EVP_PKEY_get_octet_string_param(k->pkey, OSSL_PKEY_PARAM_PUB_KEY,
+                                                      k->pub, sizeof(k->pub), &k->pub_len) > 0;
+}
+
+/* Prints one row and returns its median, the baseline for later rows */
+static uint64_t report(const char *alg, const pqc_metrics_sizes *sizes, const char *name,
+                       uint64_t *ns, size_t n, uint64_t total, uint64_t base_p50) {
+    pqc_stats st;
+
+    pqc_metrics_emit_samples(alg, "encaps", name, ns, n, total, sizes);
+    pqc_stats_compute(&st, ns, NULL, n, total);
+    printf("  %-10s %9.1f %9.1f %10.0f %8.2fx\n", name, st.median_ns / 1e3, st.p99_ns / 1e3,
+           st.ops_per_sec, base_p50 ? base_p50 / (double)st.median_ns : 1.0);
+    return st.median_ns;
+}
+
+/* mode 0: one-shot, 1: cache, 2: per-key engines */
+static int run(int mode, const char *alg, server_key *keys, mlkem_engine **engines,
+               mlkem_keycache *cache, size_t n, uint64_t *ns, uint64_t *total) {
+    unsigned char ct[MAX_CT], ss[32];
+    uint64_t start = pqc_now_ns();
+
+    for (size_t i = 0; i < n; i++) {
+        server_key *k = &keys[i % NKEYS];
+        uint64_t t0 = pqc_now_ns();
+        int ok;
+
+        if (mode == 0) {
+            mlkem_engine *e = mlkem_engine_new_from_public(alg, k->pub, k->pub_len);
+            ok = e && mlkem_engine_encapsulate(e, ct, ss);
+            mlkem_engine_free(e);
+        } else if (mode == 1) {
+            ok = mlkem_keycache_encapsulate(cache, k->pub, k->pub_len, ct, ss);
+        } else {
+            ok = mlkem_engine_encapsulate(engines[i % NKEYS], ct, ss);
+        }
+        if (!ok) return 0;
+        ns[i] = pqc_now_ns() - t0;
+    }
+    *total = pqc_now_ns() - start;
+    return 1;
+}
+
+/* A cached key's ciphertext must decapsulate to the same secret */
+static int check(const char *alg, server_key *k, mlkem_keycache *cache) {
+    mlkem_engine *server = mlkem_engine_new(k->pkey);
+    unsigned char ct[MAX_CT], ss_c[32], ss_s[32];
+    int ok = server
+        && mlkem_keycache_encapsulate(cache, k->pub, k->pub_len, ct, ss_c)
+        && mlkem_engine_decapsulate(server, ss_s, ct, mlkem_engine_ciphertext_len(server))
+        && CRYPTO_memcmp(ss_c, ss_s, sizeof(ss_c)) == 0;
+
+    if (!ok) printf("❌ %s: cached key does not round-trip\n", alg);
+    mlkem_engine_free(server);
+    return ok;
+}
+
+/* Bytes held per cached key, or 0 when allocations are not being counted */
+static double bytes_per_key(const char *alg, int counting) {
+    server_key *keys = calloc(MEMKEYS, sizeof(*keys));
+    mlkem_keycache *cache = NULL;
+    size_t before;
+    double per_key = -1;
+
+    if (!keys) return -1;
+    for (size_t i = 0; i < MEMKEYS; i++)
+        if (!make_key(alg, &keys[i])) goto cleanup;
+
+    if (!(cache = mlkem_keycache_new(alg, MEMKEYS))) goto cleanup;
+    mlkem_keycache_get(cache, keys[0].pub, keys[0].pub_len);    /* warm lazy provider state */
+    before = live_bytes;
+    for (size_t i = 1; i < MEMKEYS; i++)
+        if (!mlkem_keycache_get(cache, keys[i].pub, keys[i].pub_len)) goto cleanup;
+    per_key = counting ? (double)(live_bytes - before) / (MEMKEYS - 1) : 0;
+
+cleanup:
+    mlkem_keycache_free(cache);
+    for (size_t i = 0; i < MEMKEYS; i++) EVP_PKEY_free(keys[i].pkey);
+    free(keys);
+    return per_key;
+}
+
+static int bench(const char *alg, size_t n, int counting) {
+    server_key keys[NKEYS] = { 0 };
+    mlkem_engine *engines[NKEYS] = { 0 };
+    mlkem_keycache *cache = NULL;
+    mlkem_keycache_stats st;
+    pqc_metrics_sizes sizes = { 0, 0, 0, 0, 0 };
+    uint64_t *ns = malloc(n * sizeof(*ns)), total, base_p50;
+    double per_key;
+    int ok = 0;
+
+    printf("\n%s, %d recipients, %zu encapsulations\n", alg, NKEYS, n);
+    if (!ns) goto cleanup;
+    for (int i = 0; i < NKEYS; i++) {
+        if (!make_key(alg, &keys[i])
+            || !(engines[i] = mlkem_engine_new_from_public(alg, keys[i].pub, keys[i].pub_len))) {
+            printf("❌ %s key setup failed\n", alg);
+            ERR_print_errors_fp(stderr);
+            goto cleanup;
+        }
+    }
+    if (!(cache = mlkem_keycache_new(alg, NKEYS)) || !check(alg, &keys[0], cache)) goto cleanup;
+    sizes.pk = keys[0].pub_len;
+    sizes.ct = mlkem_engine_ciphertext_len(engines[0]);
+    sizes.ss = mlkem_engine_secret_len(engines[0]);
+
+    printf("  %-10s %9s %9s %10s %9s\n", "path", "p50 us", "p99 us", "ops/s", "speedup");
+    if (!run(0, alg, keys, engines, cache, n, ns, &total)) goto cleanup;
+    base_p50 = report(alg, &sizes, "one-shot", ns, n, total, 0);
+    if (!run(1, alg, keys, engines, cache, n, ns, &total)) goto cleanup;
+    report(alg, &sizes, "cached", ns, n, total, base_p50);
+    if (!run(2, alg, keys, engines, cache, n, ns, &total)) goto cleanup;
+    report(alg, &sizes, "engine", ns, n, total, base_p50);
+
+    mlkem_keycache_get_stats(cache, &st);
+    printf("  cache: %llu hits, %llu misses, %llu evictions\n",
+           (unsigned long long)st.hits, (unsigned long long)st.misses,
+           (unsigned long long)st.evictions);
+
+    per_key = bytes_per_key(alg, counting);
+    if (per_key > 0)
+        printf("  memory: %.0f bytes per cached key (%d keys imported)\n", per_key, MEMKEYS - 1);
+    else if (per_key == 0)
+        printf("  memory: not measured (OpenSSL allocated before the counters were installed)\n");
+    ok = per_key >= 0;
+
+cleanup:
+    mlkem_keycache_free(cache);
+    for (int i = 0; i < NKEYS; i++) {
+        mlkem_engine_free(engines[i]);
+        EVP_PKEY_free(keys[i].pkey);
+    }
+    free(ns);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    /* Must run before OpenSSL allocates anything */
+    int counting = CRYPTO_set_mem_functions(count_malloc, count_realloc, count_free);
+    const char *algs[] = { "ML-KEM-512", "ML-KEM-768", "ML-KEM-1024" };
+    size_t n = argc > 2 ? strtoul(argv[2], NULL, 10) : 20000;
+    int ret = 0;
+
+    pqc_metrics_init("mlkem_keycache_bench");
+    printf("🗝️  ML-KEM Prepared Key Cache Benchmark\n");
+    printf("======================================\n");
+    if (n == 0) n = 1;
+
+    for (size_t i = 0; i < sizeof(algs) / sizeof(algs[0]); i++) {
+        if (argc > 1 && strcmp(argv[1], "all") != 0 && strcmp(argv[1], algs[i]) != 0) continue;
+        if (!bench(algs[i], n, counting)) ret = 1;
+    }
+
+    printf(ret ? "\n❌ Benchmark failed\n" : "\n✨ Benchmark completed!\n");
+    return ret;
+}
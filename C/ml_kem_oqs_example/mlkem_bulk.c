@@ -0,0 +1,117 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "oqs/oqs.h"
+
+#include "mlkem_bulk.h"
+
+#define BULK_ALIGN 64
+#define BULK_RUN 8              /* entries claimed at a time */
+
+typedef struct {
+    const OQS_KEM *kem;
+    mlkem_bulk_batch *batch;
+    size_t next;                /* first unclaimed entry */
+    size_t failed;
+} bulk_work;
+
+static void *aligned_array(size_t count, size_t size) {
+    void *p = NULL;
+    size_t len = count * size;
+
+    if (size && len / size != count) return NULL;
+    if (posix_memalign(&p, BULK_ALIGN, len ? len : 1) != 0) return NULL;
+    return p;
+}
+
+mlkem_bulk_batch *mlkem_bulk_batch_new(const OQS_KEM *kem, size_t n) {
+    mlkem_bulk_batch *b = calloc(1, sizeof(*b));
+
+    if (!b) return NULL;
+    b->n = n;
+    b->pk_len = kem->length_public_key;
+    b->ct_len = kem->length_ciphertext;
+    b->ss_len = kem->length_shared_secret;
+    b->public_keys = aligned_array(n, b->pk_len);
+    b->ciphertexts = aligned_array(n, b->ct_len);
+    b->shared_secrets = aligned_array(n, b->ss_len);
+    b->status = aligned_array(n, 1);
+    if (!b->public_keys || !b->ciphertexts || !b->shared_secrets || !b->status) {
+        mlkem_bulk_batch_free(b);
+        return NULL;
+    }
+    memset(b->status, 0, n);
+    return b;
+}
+
+void mlkem_bulk_batch_free(mlkem_bulk_batch *batch) {
+    if (!batch) return;
+    if (batch->shared_secrets) OQS_MEM_cleanse(batch->shared_secrets, batch->n * batch->ss_len);
+    free(batch->public_keys);
+    free(batch->ciphertexts);
+    free(batch->shared_secrets);
+    free(batch->status);
+    free(batch);
+}
+
+static void *bulk_worker(void *arg) {
+    bulk_work *w = arg;
+    mlkem_bulk_batch *b = w->batch;
+    size_t failed = 0, start;
+
+    while ((start = __atomic_fetch_add(&w->next, BULK_RUN, __ATOMIC_RELAXED)) < b->n) {
+        size_t end = start + BULK_RUN < b->n ? start + BULK_RUN : b->n;
+        uint8_t status[BULK_RUN];
+
+        for (size_t i = start; i < end; i++) {
+            uint8_t *ct = mlkem_bulk_ciphertext(b, i), *ss = mlkem_bulk_shared_secret(b, i);
+            int ok = OQS_KEM_encaps(w->kem, ct, ss, mlkem_bulk_public_key(b, i)) == OQS_SUCCESS;
+
+            if (!ok) {
+                OQS_MEM_cleanse(ss, b->ss_len);
+                memset(ct, 0, b->ct_len);
+                failed++;
+            }
+            status[i - start] = (uint8_t)ok;
+        }
+        /* status[] lines are shared between runs: touch them once per run */
+        memcpy(b->status + start, status, end - start);
+    }
+    if (failed) __atomic_fetch_add(&w->failed, failed, __ATOMIC_RELAXED);
+    return NULL;
+}
+
+OQS_STATUS mlkem_bulk_encaps(const OQS_KEM *kem, mlkem_bulk_batch *batch, unsigned nthreads) {
+    bulk_work w = { kem, batch, 0, 0 };
+    pthread_t *threads = NULL;
+    unsigned started = 0;
+    size_t runs;
+
+    if (batch->pk_len != kem->length_public_key || batch->ct_len != kem->length_ciphertext
+        || batch->ss_len != kem->length_shared_secret)
+        return OQS_ERROR;
+
+    if (nthreads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = cpus > 0 ? (unsigned)cpus : 1;
+    }
+    /* No more threads than runs of entries to hand out */
+    runs = (batch->n + BULK_RUN - 1) / BULK_RUN;
+    if (nthreads > runs) nthreads = runs ? (unsigned)runs : 1;
+
+    if (nthreads > 1 && (threads = calloc(nthreads - 1, sizeof(pthread_t)))) {
+        for (unsigned i = 0; i + 1 < nthreads; i++) {
+            if (pthread_create(&threads[i], NULL, bulk_worker, &w) != 0) break;
+            started++;
+        }
+    }
+    bulk_worker(&w);
+    for (unsigned i = 0; i < started; i++) pthread_join(threads[i], NULL);
+    free(threads);
+
+    return w.failed ? OQS_ERROR : OQS_SUCCESS;
+}
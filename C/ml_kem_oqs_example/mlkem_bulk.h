@@ -0,0 +1,62 @@
+#ifndef MLKEM_BULK_H
+#define MLKEM_BULK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "oqs/oqs.h"
+
+/*
+ * Bulk ML-KEM encapsulation: one call encapsulates to N recipients, e.g. to
+ * wrap one content key for every recipient of a broadcast message.
+ *
+ * A batch is laid out as a structure of arrays. Public keys, ciphertexts,
+ * shared secrets and status flags each live in their own contiguous array,
+ * and entry i sits at i * length in each. Arrays from mlkem_bulk_batch_new()
+ * start on a 64-byte boundary, so a vectorised kernel can later take the
+ * same batch unchanged.
+ */
+
+typedef struct {
+    size_t n;
+    size_t pk_len, ct_len, ss_len;  /* strides; must match the OQS_KEM */
+    uint8_t *public_keys;           /* n * pk_len, filled by the caller */
+    uint8_t *ciphertexts;           /* n * ct_len */
+    uint8_t *shared_secrets;        /* n * ss_len */
+    uint8_t *status;                /* n flags, 1 if entry i was encapsulated */
+} mlkem_bulk_batch;
+
+/*
+ * Allocates a batch for n recipients with the strides of kem. The caller may
+ * instead fill in a batch of its own arrays; it then frees them itself.
+ */
+mlkem_bulk_batch *mlkem_bulk_batch_new(const OQS_KEM *kem, size_t n);
+
+/* Zeroizes the shared secrets and frees the batch. */
+void mlkem_bulk_batch_free(mlkem_bulk_batch *batch);
+
+static inline uint8_t *mlkem_bulk_public_key(const mlkem_bulk_batch *b, size_t i) {
+    return b->public_keys + i * b->pk_len;
+}
+
+static inline uint8_t *mlkem_bulk_ciphertext(const mlkem_bulk_batch *b, size_t i) {
+    return b->ciphertexts + i * b->ct_len;
+}
+
+static inline uint8_t *mlkem_bulk_shared_secret(const mlkem_bulk_batch *b, size_t i) {
+    return b->shared_secrets + i * b->ss_len;
+}
+
+/*
+ * Encapsulates to every public key in the batch, on nthreads threads (the
+ * caller is one of them; 0 means one per online CPU). Threads claim runs of
+ * 8 consecutive entries. For every ML-KEM set a run of ciphertexts or
+ * shared secrets is a whole number of 64-byte lines, so threads never write
+ * the same line there. A run's 8 status flags do share a line with other
+ * runs; each thread writes them in one store when its run is done.
+ *
+ * Returns OQS_SUCCESS if every entry succeeded. Otherwise status[] says which
+ * failed; their ciphertext and shared secret are zeroed.
+ */
+OQS_STATUS mlkem_bulk_encaps(const OQS_KEM *kem, mlkem_bulk_batch *batch, unsigned nthreads);
+
+#endif /* MLKEM_BULK_H */
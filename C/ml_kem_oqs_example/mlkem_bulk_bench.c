@@ -0,0 +1,151 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "oqs/oqs.h"
+
+#include "mlkem_bulk.h"
+#include "pqc_metrics.h"
+#include "pqc_timer.h"
+
+#define ROUNDS 5
+
+/*
+ * Broadcast key wrapping: encapsulate to N recipients, each with their own
+ * key pair. Times the single-call loop against mlkem_bulk_encaps() at
+ * 1, 2, 4, ... threads (best of ROUNDS), then decapsulates every entry with
+ * the recipient's secret key to check the batch.
+ */
+
+static uint64_t time_loop(const OQS_KEM *kem, mlkem_bulk_batch *b) {
+    uint64_t t0 = pqc_now_ns();
+
+    for (size_t i = 0; i < b->n; i++) {
+        if (OQS_KEM_encaps(kem, mlkem_bulk_ciphertext(b, i), mlkem_bulk_shared_secret(b, i),
+                           mlkem_bulk_public_key(b, i)) != OQS_SUCCESS)
+            return 0;
+    }
+    return pqc_now_ns() - t0;
+}
+
+static uint64_t time_bulk(const OQS_KEM *kem, mlkem_bulk_batch *b, unsigned nthreads) {
+    uint64_t t0 = pqc_now_ns();
+
+    if (mlkem_bulk_encaps(kem, b, nthreads) != OQS_SUCCESS) return 0;
+    return pqc_now_ns() - t0;
+}
+
+static void report(const char *label, unsigned nthreads, uint64_t ns, size_t n, uint64_t base_ns) {
+    printf("  %-6s %7u %10.2f %12.0f %8.2fx\n", label, nthreads, ns / 1e6,
+           n / (ns / 1e9), base_ns / (double)ns);
+}
+
+/* One metrics record per path, one sample per round (a batch of n encapsulations) */
+static void emit_rounds(const OQS_KEM *kem, const char *label, unsigned nthreads, size_t n,
+                        const uint64_t *ns) {
+    pqc_metrics_sizes sizes = { kem->length_public_key, 0, kem->length_ciphertext,
+                                kem->length_shared_secret, 0 };
+    char impl[48];
+
+    snprintf(impl, sizeof(impl), "%s,threads=%u,batch=%zu", label, nthreads, n);
+    pqc_metrics_emit_samples(kem->method_name, "batch-encaps", impl, ns, ROUNDS, 0, &sizes);
+}
+
+int main(int argc, char *argv[]) {
+    const char *alg = argc > 1 ? argv[1] : "ML-KEM-768";
+    size_t n = argc > 2 ? strtoul(argv[2], NULL, 10) : 4096;
+    unsigned max_threads = argc > 3 ? (unsigned)strtoul(argv[3], NULL, 10) : 0;
+    OQS_KEM *kem = NULL;
+    mlkem_bulk_batch *b = NULL;
+    uint8_t *sks = NULL, *ss = NULL;
+    uint64_t base = UINT64_MAX, rounds[ROUNDS];
+    size_t bad = 0;
+    int ret = 1;
+
+    pqc_metrics_init("mlkem_bulk_bench");
+    printf("📦 ML-KEM Bulk Encapsulation Benchmark\n");
+    printf("======================================\n");
+
+    if (n == 0) n = 1;
+    if (max_threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        max_threads = cpus > 0 ? (unsigned)cpus : 1;
+    }
+    if (!OQS_KEM_alg_is_enabled(alg) || !(kem = OQS_KEM_new(alg))) {
+        printf("❌ %s is not enabled in liboqs\n", alg);
+        return 1;
+    }
+
+    b = mlkem_bulk_batch_new(kem, n);
+    sks = malloc(n * kem->length_secret_key);
+    ss = malloc(kem->length_shared_secret);
+    if (!b || !sks || !ss) {
+        printf("❌ Memory allocation failed\n");
+        goto cleanup;
+    }
+
+    printf("Algorithm: %s, %zu recipients, up to %u threads\n", alg, n, max_threads);
+    printf("Batch: %zu B public keys, %zu B ciphertexts, %zu B shared secrets\n\n",
+           n * b->pk_len, n * b->ct_len, n * b->ss_len);
+
+    for (size_t i = 0; i < n; i++) {
+        if (OQS_KEM_keypair(kem, mlkem_bulk_public_key(b, i), sks + i * kem->length_secret_key) != OQS_SUCCESS) {
+            printf("❌ Key generation failed for recipient %zu\n", i);
+            goto cleanup;
+        }
+    }
+
+    printf("  %-6s %7s %10s %12s %9s\n", "path", "threads", "ms", "encaps/s", "speedup");
+    for (int r = 0; r < ROUNDS; r++) {
+        uint64_t ns = time_loop(kem, b);
+        if (!ns) {
+            printf("❌ Encapsulation failed\n");
+            goto cleanup;
+        }
+        if (ns < base) base = ns;
+        rounds[r] = ns;
+    }
+    report("loop", 1, base, n, base);
+    emit_rounds(kem, "loop", 1, n, rounds);
+
+    for (unsigned t = 1; ; t = t * 2 < max_threads ? t * 2 : max_threads) {
+        uint64_t best = UINT64_MAX;
+
+        for (int r = 0; r < ROUNDS; r++) {
+            uint64_t ns = time_bulk(kem, b, t);
+            if (!ns) {
+                printf("❌ Bulk encapsulation failed\n");
+                goto cleanup;
+            }
+            if (ns < best) best = ns;
+            rounds[r] = ns;
+        }
+        report("bulk", t, best, n, base);
+        emit_rounds(kem, "bulk", t, n, rounds);
+        if (t == max_threads) break;
+    }
+
+    /* Every recipient must recover the secret from the last batch */
+    for (size_t i = 0; i < n; i++) {
+        if (!b->status[i]
+            || OQS_KEM_decaps(kem, ss, mlkem_bulk_ciphertext(b, i), sks + i * kem->length_secret_key) != OQS_SUCCESS
+            || OQS_MEM_secure_bcmp(ss, mlkem_bulk_shared_secret(b, i), kem->length_shared_secret) != 0)
+            bad++;
+    }
+    if (bad) {
+        printf("\n❌ %zu of %zu recipients could not decapsulate\n", bad, n);
+        goto cleanup;
+    }
+    printf("\n✅ All %zu recipients decapsulated the same shared secret\n", n);
+    printf("\n✨ Benchmark completed!\n");
+    ret = 0;
+
+cleanup:
+    if (sks) OQS_MEM_secure_free(sks, n * kem->length_secret_key);
+    if (ss) OQS_MEM_secure_free(ss, kem->length_shared_secret);
+    mlkem_bulk_batch_free(b);
+    OQS_KEM_free(kem);
+    return ret;
+}
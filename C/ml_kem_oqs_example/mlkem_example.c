@@ -1,8 +1,14 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include "oqs/oqs.h"
 
+#include "pqc_arena.h"
+#include "pqc_metrics.h"
+#include "pqc_timer.h"
+
 void print_hex(const char* label, const uint8_t* data, size_t len) {
     printf("%s (%zu bytes): ", label, len);
     for (size_t i = 0; i < len && i < 16; i++) {
@@ -12,9 +18,17 @@ void print_hex(const char* label, const uint8_t* data, size_t len) {
     printf("\n");
 }
 
+/* One metrics record per operation with PQC_METRICS=json|csv (pqc_metrics.h) */
+static void emit(const OQS_KEM* kem, const char* op, uint64_t ns) {
+    pqc_metrics_sizes sizes = { kem->length_public_key, kem->length_secret_key,
+                                kem->length_ciphertext, kem->length_shared_secret, 0 };
+    pqc_metrics_emit_samples(kem->method_name, op, "liboqs", &ns, 1, 0, &sizes);
+}
+
 int main(int argc, char* argv[]) {
     printf("🎯 ML-KEM Demonstration\n");
     printf("======================\n");
+    pqc_metrics_init("mlkem_example");
     
     const char* algorithm = "Kyber512";
     if (argc > 1) {
@@ -48,46 +62,59 @@ int main(int argc, char* argv[]) {
     printf("   Ciphertext size: %zu bytes\n", kem->length_ciphertext);
     printf("   Shared secret size: %zu bytes\n", kem->length_shared_secret);
     
-    // Allocate memory
-    uint8_t* public_key = malloc(kem->length_public_key);
-    uint8_t* secret_key = malloc(kem->length_secret_key);
-    uint8_t* ciphertext = malloc(kem->length_ciphertext);
-    uint8_t* shared_secret_e = malloc(kem->length_shared_secret);
-    uint8_t* shared_secret_d = malloc(kem->length_shared_secret);
+    // Carve all buffers out of one arena sized for this KEM
+    pqc_arena* arena = pqc_arena_new(pqc_arena_size(kem->length_public_key) +
+                                     pqc_arena_size(kem->length_secret_key) +
+                                     pqc_arena_size(kem->length_ciphertext) +
+                                     2 * pqc_arena_size(kem->length_shared_secret));
+    uint8_t* public_key = pqc_arena_alloc(arena, kem->length_public_key);
+    uint8_t* secret_key = pqc_arena_alloc_secret(arena, kem->length_secret_key);
+    uint8_t* ciphertext = pqc_arena_alloc(arena, kem->length_ciphertext);
+    uint8_t* shared_secret_e = pqc_arena_alloc_secret(arena, kem->length_shared_secret);
+    uint8_t* shared_secret_d = pqc_arena_alloc_secret(arena, kem->length_shared_secret);
     
     if (!public_key || !secret_key || !ciphertext || !shared_secret_e || !shared_secret_d) {
         printf("❌ Memory allocation failed\n");
+        pqc_arena_free(arena);
         OQS_KEM_free(kem);
         return 1;
     }
     
+    uint64_t t0;
+
     // Step 1: Key generation
     printf("\n1. 🔑 Generating key pair...\n");
+    t0 = pqc_now_ns();
     if (OQS_KEM_keypair(kem, public_key, secret_key) != OQS_SUCCESS) {
         printf("❌ Key generation failed\n");
         goto cleanup;
     }
+    emit(kem, "keygen", pqc_now_ns() - t0);
     printf("✅ Key pair generated\n");
     
     // Step 2: Encapsulation
     printf("2. 🔒 Encapsulating shared secret...\n");
+    t0 = pqc_now_ns();
     if (OQS_KEM_encaps(kem, ciphertext, shared_secret_e, public_key) != OQS_SUCCESS) {
         printf("❌ Encapsulation failed\n");
         goto cleanup;
     }
+    emit(kem, "encaps", pqc_now_ns() - t0);
     printf("✅ Key encapsulated\n");
     
     // Step 3: Decapsulation
     printf("3. 🔓 Decapsulating shared secret...\n");
+    t0 = pqc_now_ns();
     if (OQS_KEM_decaps(kem, shared_secret_d, ciphertext, secret_key) != OQS_SUCCESS) {
         printf("❌ Decapsulation failed\n");
         goto cleanup;
     }
+    emit(kem, "decaps", pqc_now_ns() - t0);
     printf("✅ Key decapsulated\n");
     
     // Step 4: Verification
     printf("4. ✅ Verifying shared secrets...\n");
-    if (memcmp(shared_secret_e, shared_secret_d, kem->length_shared_secret) == 0) {
+    if (OQS_MEM_secure_bcmp(shared_secret_e, shared_secret_d, kem->length_shared_secret) == 0) {
         printf("✅ SUCCESS: Shared secrets match!\n");
         print_hex("   Shared secret", shared_secret_e, kem->length_shared_secret);
         
@@ -101,11 +128,7 @@ int main(int argc, char* argv[]) {
     
 cleanup:
     OQS_KEM_free(kem);
-    free(public_key);
-    free(secret_key);
-    free(ciphertext);
-    free(shared_secret_e);
-    free(shared_secret_d);
+    pqc_arena_free(arena);  // wipes the secret key and shared secrets
     
     printf("\n✨ Demonstration completed!\n");
     return 0;
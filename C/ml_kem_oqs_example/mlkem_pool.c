@@ -0,0 +1,267 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <openssl/err.h>
+#include "oqs/oqs.h"
+
+#include "mlkem_pool.h"
+#include "pqc_timer.h"
+
+#define CACHE_LINE 64
+/* Consecutive keygen failures before the refill thread gives up */
+#define MAX_KEYGEN_ATTEMPTS 3
+
+/*
+ * Bounded MPMC queue of slot indices (Vyukov). Each cell's sequence number
+ * says whether it is ready to be written (seq == pos) or read (seq == pos + 1)
+ * at a given position, so push and pop need a single CAS each.
+ */
+typedef struct {
+    size_t seq;
+    size_t value;
+} ring_cell;
+
+typedef struct {
+    ring_cell *cells;
+    size_t mask;
+    char pad0[CACHE_LINE];
+    size_t tail;                /* next push position */
+    char pad1[CACHE_LINE];
+    size_t head;                /* next pop position */
+    char pad2[CACHE_LINE];
+} index_ring;
+
+struct mlkem_pool {
+    OQS_KEM *kem;
+    size_t capacity;
+    uint8_t *slots;             /* capacity * (public key || secret key) */
+    size_t slot_size;
+
+    index_ring ready;           /* slots holding an unused keypair */
+    index_ring empty;           /* slots waiting for the refill thread */
+
+    pthread_t refill_thread;
+    pthread_mutex_t lock;       /* only guards refill thread sleep/wake */
+    pthread_cond_t wake;
+    size_t pending;             /* empty slots not yet claimed by the refill thread */
+    int shutdown;
+    int refill_stopped;         /* keygen kept failing; misses generate inline */
+
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t refills;
+    uint64_t created_ns;
+};
+
+static int ring_init(index_ring *r, size_t capacity) {
+    memset(r, 0, sizeof(*r));
+    r->cells = calloc(capacity, sizeof(ring_cell));
+    if (!r->cells) return 0;
+    for (size_t i = 0; i < capacity; i++) r->cells[i].seq = i;
+    r->mask = capacity - 1;
+    return 1;
+}
+
+static int ring_push(index_ring *r, size_t value) {
+    size_t pos = __atomic_load_n(&r->tail, __ATOMIC_RELAXED);
+
+    for (;;) {
+        ring_cell *c = &r->cells[pos & r->mask];
+        size_t seq = __atomic_load_n(&c->seq, __ATOMIC_ACQUIRE);
+        long dif = (long)(seq - pos);
+
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&r->tail, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                c->value = value;
+                __atomic_store_n(&c->seq, pos + 1, __ATOMIC_RELEASE);
+                return 1;
+            }
+        } else if (dif < 0) {
+            return 0;           /* full */
+        } else {
+            pos = __atomic_load_n(&r->tail, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static int ring_pop(index_ring *r, size_t *value) {
+    size_t pos = __atomic_load_n(&r->head, __ATOMIC_RELAXED);
+
+    for (;;) {
+        ring_cell *c = &r->cells[pos & r->mask];
+        size_t seq = __atomic_load_n(&c->seq, __ATOMIC_ACQUIRE);
+        long dif = (long)(seq - (pos + 1));
+
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&r->head, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                *value = c->value;
+                __atomic_store_n(&c->seq, pos + r->mask + 1, __ATOMIC_RELEASE);
+                return 1;
+            }
+        } else if (dif < 0) {
+            return 0;           /* empty */
+        } else {
+            pos = __atomic_load_n(&r->head, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static size_t ring_size(const index_ring *r) {
+    size_t tail = __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE);
+    size_t head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+    return tail > head ? tail - head : 0;
+}
+
+static void *refill_main(void *arg) {
+    mlkem_pool *pool = arg;
+    const OQS_KEM *kem = pool->kem;
+    unsigned failures = 0;
+    size_t idx;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->shutdown && __atomic_load_n(&pool->pending, __ATOMIC_ACQUIRE) == 0)
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        if (pool->shutdown) {
+            pthread_mutex_unlock(&pool->lock);
+            return NULL;
+        }
+        pthread_mutex_unlock(&pool->lock);
+
+        __atomic_fetch_sub(&pool->pending, 1, __ATOMIC_ACQ_REL);
+        if (!ring_pop(&pool->empty, &idx)) continue;
+
+        uint8_t *pk = pool->slots + idx * pool->slot_size;
+        if (OQS_KEM_keypair(kem, pk, pk + kem->length_public_key) != OQS_SUCCESS) {
+            ring_push(&pool->empty, idx);
+            if (++failures < MAX_KEYGEN_ATTEMPTS) {
+                __atomic_fetch_add(&pool->pending, 1, __ATOMIC_ACQ_REL);
+                continue;
+            }
+            /* liboqs takes its randomness and hashing from OpenSSL */
+            fprintf(stderr, "ERROR: Background key generation failed %u times; refill stopped\n",
+                    failures);
+            ERR_print_errors_fp(stderr);
+            __atomic_store_n(&pool->refill_stopped, 1, __ATOMIC_RELEASE);
+            return NULL;
+        }
+        failures = 0;
+        ring_push(&pool->ready, idx);
+        __atomic_fetch_add(&pool->refills, 1, __ATOMIC_RELAXED);
+    }
+}
+
+mlkem_pool *mlkem_pool_new(const char *kem_name, size_t capacity) {
+    mlkem_pool *pool;
+    size_t cap = 2;
+
+    if (!OQS_KEM_alg_is_enabled(kem_name)) {
+        fprintf(stderr, "ERROR: %s is not enabled in this build\n", kem_name);
+        return NULL;
+    }
+    while (cap < capacity) cap <<= 1;
+
+    pool = calloc(1, sizeof(*pool));
+    if (!pool) return NULL;
+
+    pool->kem = OQS_KEM_new(kem_name);
+    if (!pool->kem) goto err;
+
+    pool->capacity = cap;
+    pool->slot_size = pool->kem->length_public_key + pool->kem->length_secret_key;
+    pool->slots = calloc(cap, pool->slot_size);
+    if (!pool->slots || !ring_init(&pool->ready, cap) || !ring_init(&pool->empty, cap))
+        goto err;
+
+    for (size_t i = 0; i < cap; i++) ring_push(&pool->empty, i);
+    pool->pending = cap;
+    pool->created_ns = pqc_now_ns();
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    if (pthread_create(&pool->refill_thread, NULL, refill_main, pool) != 0) {
+        fprintf(stderr, "ERROR: Failed to start refill thread\n");
+        pthread_cond_destroy(&pool->wake);
+        pthread_mutex_destroy(&pool->lock);
+        goto err;
+    }
+    return pool;
+
+err:
+    OQS_KEM_free(pool->kem);
+    free(pool->slots);
+    free(pool->ready.cells);
+    free(pool->empty.cells);
+    free(pool);
+    return NULL;
+}
+
+void mlkem_pool_free(mlkem_pool *pool) {
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_signal(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    pthread_join(pool->refill_thread, NULL);
+
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    OQS_MEM_secure_free(pool->slots, pool->capacity * pool->slot_size);
+    free(pool->ready.cells);
+    free(pool->empty.cells);
+    OQS_KEM_free(pool->kem);
+    free(pool);
+}
+
+const OQS_KEM *mlkem_pool_kem(const mlkem_pool *pool) {
+    return pool->kem;
+}
+
+size_t mlkem_pool_capacity(const mlkem_pool *pool) {
+    return pool->capacity;
+}
+
+size_t mlkem_pool_available(const mlkem_pool *pool) {
+    return ring_size(&pool->ready);
+}
+
+OQS_STATUS mlkem_pool_get(mlkem_pool *pool, uint8_t *public_key, uint8_t *secret_key) {
+    const OQS_KEM *kem = pool->kem;
+    size_t idx;
+
+    if (!ring_pop(&pool->ready, &idx)) {
+        __atomic_fetch_add(&pool->misses, 1, __ATOMIC_RELAXED);
+        return OQS_KEM_keypair(kem, public_key, secret_key);
+    }
+
+    uint8_t *slot = pool->slots + idx * pool->slot_size;
+    memcpy(public_key, slot, kem->length_public_key);
+    memcpy(secret_key, slot + kem->length_public_key, kem->length_secret_key);
+    OQS_MEM_cleanse(slot + kem->length_public_key, kem->length_secret_key);
+    __atomic_fetch_add(&pool->hits, 1, __ATOMIC_RELAXED);
+
+    ring_push(&pool->empty, idx);
+    /* Only the 0 -> 1 transition can find the refill thread asleep */
+    if (__atomic_fetch_add(&pool->pending, 1, __ATOMIC_ACQ_REL) == 0) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_signal(&pool->wake);
+        pthread_mutex_unlock(&pool->lock);
+    }
+    return OQS_SUCCESS;
+}
+
+void mlkem_pool_get_stats(const mlkem_pool *pool, mlkem_pool_stats *stats) {
+    double elapsed = (double)(pqc_now_ns() - pool->created_ns) / 1e9;
+
+    stats->hits = __atomic_load_n(&pool->hits, __ATOMIC_RELAXED);
+    stats->misses = __atomic_load_n(&pool->misses, __ATOMIC_RELAXED);
+    stats->refills = __atomic_load_n(&pool->refills, __ATOMIC_RELAXED);
+    stats->refill_rate = elapsed > 0 ? (double)stats->refills / elapsed : 0;
+    stats->refill_stopped = __atomic_load_n(&pool->refill_stopped, __ATOMIC_ACQUIRE);
+}
@@ -0,0 +1,52 @@
+#ifndef MLKEM_POOL_H
+#define MLKEM_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "oqs/oqs.h"
+
+/*
+ * Bounded pool of pre-generated ephemeral ML-KEM keypairs.
+ *
+ * A background thread keeps the pool topped up; consumers take keypairs from
+ * a lock-free queue, so keygen runs off the handshake's critical path. When
+ * the pool is empty mlkem_pool_get() falls back to generating inline and
+ * counts a miss. If background keygen fails a few times in a row, the
+ * thread reports the error and stops; every get is then a miss.
+ *
+ * Each keypair is handed out exactly once and its secret key is wiped from
+ * the pool as soon as it has been copied out.
+ */
+
+typedef struct mlkem_pool mlkem_pool;
+
+typedef struct {
+    uint64_t hits;          /* keypairs served from the pool */
+    uint64_t misses;        /* pool empty, generated inline */
+    uint64_t refills;       /* keypairs generated by the background thread */
+    double refill_rate;     /* refills per second since the pool was created */
+    int refill_stopped;     /* background keygen kept failing and was stopped */
+} mlkem_pool_stats;
+
+/* capacity is rounded up to a power of two. */
+mlkem_pool *mlkem_pool_new(const char *kem_name, size_t capacity);
+void mlkem_pool_free(mlkem_pool *pool);
+
+/* Sizes of the keys, ciphertext and shared secret. */
+const OQS_KEM *mlkem_pool_kem(const mlkem_pool *pool);
+
+size_t mlkem_pool_capacity(const mlkem_pool *pool);
+
+/* Keypairs ready to be served right now. */
+size_t mlkem_pool_available(const mlkem_pool *pool);
+
+/*
+ * Copies a fresh keypair into the caller's buffers. Safe to call from any
+ * number of threads. Returns OQS_SUCCESS, or OQS_ERROR if inline keygen
+ * failed on a miss.
+ */
+OQS_STATUS mlkem_pool_get(mlkem_pool *pool, uint8_t *public_key, uint8_t *secret_key);
+
+void mlkem_pool_get_stats(const mlkem_pool *pool, mlkem_pool_stats *stats);
+
+#endif /* MLKEM_POOL_H */
@@ -0,0 +1,143 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include "oqs/oqs.h"
+
+#include "mlkem_pool.h"
+#include "pqc_metrics.h"
+#include "pqc_timer.h"
+
+#define POOL_CAPACITY 64
+
+/*
+ * Simulates the server side of ephemeral-key handshakes: take a keypair,
+ * let the peer encapsulate, decapsulate. Between handshakes the thread idles
+ * for gap_us, standing in for network round trips; that idle time is what
+ * the refill thread uses. Latency is reported with keygen inline and with
+ * keypairs taken from the pool.
+ */
+
+typedef struct {
+    const OQS_KEM *kem;
+    uint8_t *pk, *sk, *ct, *ss_e, *ss_d;
+} handshake_bufs;
+
+static void idle_us(unsigned us) {
+    struct timespec ts = { 0, (long)us * 1000 };
+    if (us) nanosleep(&ts, NULL);
+}
+
+static int handshake(const handshake_bufs *b, mlkem_pool *pool) {
+    const OQS_KEM *kem = b->kem;
+    OQS_STATUS rc = pool ? mlkem_pool_get(pool, b->pk, b->sk)
+                         : OQS_KEM_keypair(kem, b->pk, b->sk);
+
+    return rc == OQS_SUCCESS
+        && OQS_KEM_encaps(kem, b->ct, b->ss_e, b->pk) == OQS_SUCCESS
+        && OQS_KEM_decaps(kem, b->ss_d, b->ct, b->sk) == OQS_SUCCESS
+        && OQS_MEM_secure_bcmp(b->ss_e, b->ss_d, kem->length_shared_secret) == 0;
+}
+
+static int run(const char *label, const handshake_bufs *b, mlkem_pool *pool,
+               size_t n, unsigned gap_us, uint64_t *ns) {
+    pqc_stats st;
+    uint64_t total = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t t0 = pqc_now_ns();
+        if (!handshake(b, pool)) {
+            printf("❌ Handshake %zu failed\n", i);
+            return 0;
+        }
+        ns[i] = pqc_now_ns() - t0;
+        total += ns[i];
+        idle_us(gap_us);
+    }
+
+    if (pqc_metrics_enabled()) {
+        const OQS_KEM *kem = b->kem;
+        pqc_metrics_sizes sizes = { kem->length_public_key, kem->length_secret_key,
+                                    kem->length_ciphertext, kem->length_shared_secret, 0 };
+
+        pqc_metrics_emit_samples(kem->method_name, "handshake", label, ns, n, total, &sizes);
+    }
+    pqc_stats_compute(&st, ns, NULL, n, total);
+    printf("  %-8s %10.1f %10.1f %10.1f %10.1f\n", label,
+           st.median_ns / 1e3, st.p99_ns / 1e3,
+           pqc_percentile(ns, n, 99.9) / 1e3, st.max_ns / 1e3);
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    const char *alg = argc > 1 ? argv[1] : "ML-KEM-768";
+    size_t n = argc > 2 ? strtoul(argv[2], NULL, 10) : 5000;
+    unsigned gap_us = argc > 3 ? (unsigned)strtoul(argv[3], NULL, 10) : 200;
+    mlkem_pool *pool = NULL;
+    handshake_bufs b = { 0 };
+    uint64_t *ns = NULL;
+    int ret = 1;
+
+    pqc_metrics_init("mlkem_pool_bench");
+    printf("🎯 ML-KEM Keypair Pool Benchmark\n");
+    printf("================================\n");
+
+    if (n == 0) n = 1;
+    pool = mlkem_pool_new(alg, POOL_CAPACITY);
+    if (!pool) {
+        printf("❌ Failed to create keypair pool for %s\n", alg);
+        return 1;
+    }
+
+    b.kem = mlkem_pool_kem(pool);
+    b.pk = malloc(b.kem->length_public_key);
+    b.sk = malloc(b.kem->length_secret_key);
+    b.ct = malloc(b.kem->length_ciphertext);
+    b.ss_e = malloc(b.kem->length_shared_secret);
+    b.ss_d = malloc(b.kem->length_shared_secret);
+    ns = malloc(n * sizeof(*ns));
+    if (!b.pk || !b.sk || !b.ct || !b.ss_e || !b.ss_d || !ns) {
+        printf("❌ Memory allocation failed\n");
+        goto cleanup;
+    }
+
+    printf("Algorithm: %s, %zu handshakes, %u us between handshakes\n", alg, n, gap_us);
+    printf("Pool capacity: %zu keypairs\n\n", mlkem_pool_capacity(pool));
+
+    /* Let the refill thread fill the pool before measuring */
+    while (mlkem_pool_available(pool) < mlkem_pool_capacity(pool)) {
+        mlkem_pool_stats fill;
+        mlkem_pool_get_stats(pool, &fill);
+        if (fill.refill_stopped) {
+            printf("❌ The pool could not be filled\n");
+            goto cleanup;
+        }
+        idle_us(1000);
+    }
+
+    printf("  %-8s %10s %10s %10s %10s\n", "keygen", "p50 us", "p99 us", "p99.9 us", "max us");
+    if (!run("inline", &b, NULL, n, gap_us, ns)) goto cleanup;
+    if (!run("pool", &b, pool, n, gap_us, ns)) goto cleanup;
+
+    mlkem_pool_stats st;
+    mlkem_pool_get_stats(pool, &st);
+    printf("\n📊 Pool: %llu hits, %llu misses (%.1f%% hit rate), %llu refills at %.0f/s\n",
+           (unsigned long long)st.hits, (unsigned long long)st.misses,
+           100.0 * st.hits / (double)(st.hits + st.misses ? st.hits + st.misses : 1),
+           (unsigned long long)st.refills, st.refill_rate);
+
+    printf("\n✨ Benchmark completed!\n");
+    ret = 0;
+
+cleanup:
+    if (b.sk) OQS_MEM_secure_free(b.sk, b.kem->length_secret_key);
+    free(b.pk);
+    free(b.ct);
+    free(b.ss_e);
+    free(b.ss_d);
+    free(ns);
+    mlkem_pool_free(pool);
+    return ret;
+}
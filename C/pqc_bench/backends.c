@@ -0,0 +1,14 @@
+#include <stddef.h>
+
+#include "pqc_backend.h"
+
+/* pqc_bench's backends, in default preference order (see pqc_backend.h) */
+const pqc_backend *const pqc_backends[] = {
+    &pqc_backend_evp,
+#if PQC_BACKEND_WITH_OQS
+    &pqc_backend_oqs,
+#endif
+    &pqc_backend_slh_par,
+    &pqc_backend_oqsprovider,
+    NULL
+};
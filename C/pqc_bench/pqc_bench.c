@@ -0,0 +1,471 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <openssl/crypto.h>
+
+#include "pqc_backend.h"
+#include "pqc_metrics.h"
+#include "pqc_sched.h"
+#include "pqc_timer.h"
+
+/*
+ * pqc_bench - tight-loop benchmark for every algorithm the demos exercise.
+ *
+ * Each operation runs in a loop until either the iteration count or the time
+ * budget is reached, and every iteration is timed individually so that we can
+ * report median and p99 latency alongside ops/sec and cycles/op.
+ *
+ * Every algorithm runs on every backend that has it (see pqc_backend.h).
+ * Keys, ciphertexts and signatures are then exchanged between the backends
+ * to check that they agree. The fastest backend is recorded as the
+ * default for this machine. The score is the median of encaps + decaps,
+ * or of sign + verify.
+ *
+ * With -T, each algorithm then also runs on a pqc_sched worker pool, on the
+ * fastest backend: every job is one encaps + decaps or sign + verify, each
+ * worker has its own handle and copy of the key pair, and the pass reports
+ * throughput per NUMA node.
+ *
+ * PQC_METRICS=json|csv adds one record per operation with its latency
+ * histogram and the algorithm's sizes (see pqc_metrics.h).
+ */
+
+typedef int (*bench_fn)(void *arg);
+
+static struct {
+    size_t iterations;
+    size_t warmup;
+    double max_seconds;
+    size_t msg_len;
+    const char *filter;
+    const char *backend;        /* NULL: all of them */
+    int record;
+    int parallel;               /* -T given */
+    unsigned threads;           /* 0: one per CPU */
+    pqc_pin_mode pin;
+} opts = { 1000, 10, 2.0, 32, NULL, NULL, 1, 0, 0, PQC_PIN_CORE };
+
+static unsigned char *bench_msg;
+
+/* Standard names first; the pre-standard ones only exist in liboqs */
+static const char *algs[] = {
+    "ML-KEM-512", "ML-KEM-768", "ML-KEM-1024",
+    "ML-DSA-44", "ML-DSA-65", "ML-DSA-87",
+    "SLH-DSA-SHA2-128s", "SLH-DSA-SHA2-128f",
+    "SLH-DSA-SHA2-192s", "SLH-DSA-SHA2-192f",
+    "SLH-DSA-SHA2-256s", "SLH-DSA-SHA2-256f",
+    "SLH-DSA-SHAKE-128s", "SLH-DSA-SHAKE-128f",
+    "Kyber512", "Kyber768", "Kyber1024",
+    "Dilithium2", "Dilithium3", "Dilithium5",
+    "Falcon-512", "Falcon-1024",
+    "SPHINCS+-SHA2-128f-simple", "SPHINCS+-SHA2-192f-simple", "SPHINCS+-SHA2-256f-simple",
+    NULL
+};
+
+static int selected(const char *alg) {
+    return opts.filter == NULL || strstr(alg, opts.filter) != NULL;
+}
+
+static void print_header(void) {
+    printf("%-12s %-28s %-8s %8s %12s %12s %12s %14s\n",
+           "Backend", "Algorithm", "Op", "Iters", "ops/sec", "median(us)", "p99(us)", "cycles/op");
+    printf("------------------------------------------------------------"
+           "------------------------------------------------------\n");
+}
+
+static int run_op(const char *backend, const char *alg, const char *op, const pqc_alg_info *info,
+                  bench_fn fn, void *arg, pqc_stats *st) {
+    uint64_t *ns = malloc(opts.iterations * sizeof(uint64_t));
+    uint64_t *cyc = malloc(opts.iterations * sizeof(uint64_t));
+    if (!ns || !cyc) {
+        free(ns);
+        free(cyc);
+        fprintf(stderr, "ERROR: out of memory\n");
+        return 0;
+    }
+
+    for (size_t i = 0; i < opts.warmup; i++) {
+        if (!fn(arg)) {
+            printf("%-12s %-28s %-8s   ❌ operation failed\n", backend, alg, op);
+            free(ns);
+            free(cyc);
+            return 0;
+        }
+    }
+
+    uint64_t budget = (uint64_t)(opts.max_seconds * 1e9);
+    uint64_t start = pqc_now_ns();
+    size_t n = 0;
+
+    while (n < opts.iterations) {
+        uint64_t c0 = pqc_cycles();
+        uint64_t t0 = pqc_now_ns();
+        int ok = fn(arg);
+        uint64_t t1 = pqc_now_ns();
+        uint64_t c1 = pqc_cycles();
+
+        if (!ok) {
+            printf("%-12s %-28s %-8s   ❌ operation failed\n", backend, alg, op);
+            free(ns);
+            free(cyc);
+            return 0;
+        }
+        ns[n] = t1 - t0;
+        cyc[n] = c1 - c0;
+        n++;
+
+        if (t1 - start > budget) break;
+    }
+
+    uint64_t total = pqc_now_ns() - start;
+    pqc_metrics_sizes sizes = { info->pk_len, info->sk_len, info->ct_len, info->ss_len, info->sig_len };
+
+    pqc_stats_compute(st, ns, cyc, n, total);
+    pqc_metrics_emit_samples(alg, op, backend, ns, n, total, &sizes);
+
+    printf("%-12s %-28s %-8s %8zu %12.1f %12.2f %12.2f %14llu\n",
+           backend, alg, op, st->samples, st->ops_per_sec,
+           st->median_ns / 1000.0, st->p99_ns / 1000.0,
+           (unsigned long long)st->median_cycles);
+
+    free(ns);
+    free(cyc);
+    return 1;
+}
+
+/* ---------------------------------------------------------------------- */
+/* One algorithm on one backend                                           */
+/* ---------------------------------------------------------------------- */
+
+typedef struct {
+    pqc_alg *a;
+    const pqc_alg_info *info;
+    uint8_t *pk, *sk, *ct, *ss_e, *ss_d, *sig;
+    size_t sig_len;
+    uint64_t score_ns;          /* 0 if an operation failed */
+} bench_state;
+
+static int op_keygen(void *arg) {
+    bench_state *s = arg;
+    return pqc_keypair(s->a, s->pk, s->sk);
+}
+
+static int op_encaps(void *arg) {
+    bench_state *s = arg;
+    return pqc_encaps(s->a, s->ct, s->ss_e, s->pk);
+}
+
+static int op_decaps(void *arg) {
+    bench_state *s = arg;
+    return pqc_decaps(s->a, s->ss_d, s->ct, s->sk);
+}
+
+static int op_sign(void *arg) {
+    bench_state *s = arg;
+    return pqc_sign(s->a, s->sig, &s->sig_len, bench_msg, opts.msg_len, s->sk);
+}
+
+static int op_verify(void *arg) {
+    bench_state *s = arg;
+    return pqc_verify(s->a, bench_msg, opts.msg_len, s->sig, s->sig_len, s->pk);
+}
+
+static void state_free(bench_state *s) {
+    if (s->sk) OPENSSL_cleanse(s->sk, s->info->sk_len);
+    free(s->pk);
+    free(s->sk);
+    free(s->ct);
+    free(s->ss_e);
+    free(s->ss_d);
+    free(s->sig);
+    pqc_alg_close(s->a);
+    memset(s, 0, sizeof(*s));
+}
+
+static int state_init(bench_state *s, const char *alg, const pqc_backend *b) {
+    memset(s, 0, sizeof(*s));
+    if (!(s->a = pqc_alg_open(alg, b->name))) return 0;
+    s->info = pqc_alg_info_get(s->a);
+    s->pk = malloc(s->info->pk_len);
+    s->sk = malloc(s->info->sk_len);
+    if (s->info->kind == PQC_KEM) {
+        s->ct = malloc(s->info->ct_len);
+        s->ss_e = malloc(s->info->ss_len);
+        s->ss_d = malloc(s->info->ss_len);
+    } else {
+        s->sig = malloc(s->info->sig_len);
+    }
+    if (!s->pk || !s->sk || (s->info->kind == PQC_KEM ? !s->ct || !s->ss_e || !s->ss_d : !s->sig)) {
+        state_free(s);
+        return 0;
+    }
+    return 1;
+}
+
+static void bench_backend(bench_state *s, const char *backend, const char *alg) {
+    pqc_stats kg, op1, op2;
+
+    /* keygen leaves the last key pair in s->pk / s->sk for the other ops */
+    if (!run_op(backend, alg, "keygen", s->info, op_keygen, s, &kg)) return;
+    if (s->info->kind == PQC_KEM) {
+        if (run_op(backend, alg, "encaps", s->info, op_encaps, s, &op1)
+            && run_op(backend, alg, "decaps", s->info, op_decaps, s, &op2))
+            s->score_ns = op1.median_ns + op2.median_ns;
+    } else {
+        if (run_op(backend, alg, "sign", s->info, op_sign, s, &op1)
+            && run_op(backend, alg, "verify", s->info, op_verify, s, &op2))
+            s->score_ns = op1.median_ns + op2.median_ns;
+    }
+}
+
+/*
+ * A/B check between the reference backend r and x: each side uses the
+ * other's key and output. Both use r's key pair.
+ */
+static int cross_check(bench_state *r, bench_state *x) {
+    const pqc_alg_info *in = r->info;
+    uint8_t *buf = malloc(in->kind == PQC_KEM ? in->ct_len + 2 * in->ss_len : in->sig_len);
+    size_t sig_len = 0;
+    int ok = 0;
+
+    if (!buf || !pqc_keypair(r->a, r->pk, r->sk)) goto done;
+    if (in->kind == PQC_KEM) {
+        uint8_t *ct = buf, *ss1 = buf + in->ct_len, *ss2 = ss1 + in->ss_len;
+        ok = pqc_encaps(x->a, ct, ss1, r->pk) && pqc_decaps(r->a, ss2, ct, r->sk)
+             && CRYPTO_memcmp(ss1, ss2, in->ss_len) == 0
+             && pqc_encaps(r->a, ct, ss1, r->pk) && pqc_decaps(x->a, ss2, ct, r->sk)
+             && CRYPTO_memcmp(ss1, ss2, in->ss_len) == 0;
+    } else {
+        ok = pqc_sign(x->a, buf, &sig_len, bench_msg, opts.msg_len, r->sk)
+             && pqc_verify(r->a, bench_msg, opts.msg_len, buf, sig_len, r->pk)
+             && pqc_sign(r->a, buf, &sig_len, bench_msg, opts.msg_len, r->sk)
+             && pqc_verify(x->a, bench_msg, opts.msg_len, buf, sig_len, r->pk);
+    }
+
+done:
+    if (buf) OPENSSL_cleanse(buf, in->kind == PQC_KEM ? in->ct_len + 2 * in->ss_len : in->sig_len);
+    free(buf);
+    return ok;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Throughput on the worker pool                                          */
+/* ---------------------------------------------------------------------- */
+
+typedef struct {
+    const char *alg;
+    const pqc_backend *b;
+    const uint8_t *pk, *sk;     /* the key pair every worker copies */
+    int failed;
+} par_ctx;
+
+/* Runs on the pinned worker, so its handle and keys live on its node */
+static void *par_init(pqc_worker *w, void *arg) {
+    par_ctx *p = arg;
+    bench_state *s = malloc(sizeof(*s));
+
+    (void)w;
+    if (!s || !state_init(s, p->alg, p->b)) {
+        free(s);
+        return NULL;
+    }
+    memcpy(s->pk, p->pk, s->info->pk_len);
+    memcpy(s->sk, p->sk, s->info->sk_len);
+    return s;
+}
+
+static void par_fini(pqc_worker *w, void *arg) {
+    (void)arg;
+    state_free(w->local);
+    free(w->local);
+}
+
+static void par_job(pqc_worker *w, void *arg) {
+    par_ctx *p = arg;
+    bench_state *s = w->local;
+    int ok;
+
+    if (s->info->kind == PQC_KEM)
+        ok = op_encaps(s) && op_decaps(s) && CRYPTO_memcmp(s->ss_e, s->ss_d, s->info->ss_len) == 0;
+    else
+        ok = op_sign(s) && op_verify(s);
+    if (!ok) __atomic_store_n(&p->failed, 1, __ATOMIC_RELAXED);
+}
+
+static void bench_parallel(bench_state *ref, const char *alg) {
+    par_ctx p = { alg, pqc_alg_backend(ref->a), ref->pk, ref->sk, 0 };
+    pqc_sched_config cfg = { opts.threads, opts.pin, par_init, par_fini, &p };
+    const char *op = ref->info->kind == PQC_KEM ? "enc+dec" : "sign+vfy";
+    pqc_sched *sched;
+    uint64_t budget = (uint64_t)(opts.max_seconds * 1e9), elapsed, start;
+    size_t n = 0, batch;
+
+    if (!pqc_keypair(ref->a, ref->pk, ref->sk) || !(sched = pqc_sched_new(&cfg))) {
+        printf("%-12s %-28s %-8s   ❌ worker pool setup failed\n", p.b->name, alg, op);
+        return;
+    }
+
+    /* Batches keep every worker busy between checks of the time budget */
+    batch = 4 * pqc_sched_workers(sched);
+    start = pqc_now_ns();
+    while (n < opts.iterations * pqc_sched_workers(sched) && pqc_now_ns() - start < budget
+           && !__atomic_load_n(&p.failed, __ATOMIC_RELAXED)) {
+        for (size_t i = 0; i < batch; i++)
+            if (pqc_sched_submit(sched, par_job, &p)) n++;
+        pqc_sched_wait(sched);
+    }
+    elapsed = pqc_now_ns() - start;
+
+    if (p.failed) {
+        printf("%-12s %-28s %-8s   ❌ operation failed\n", p.b->name, alg, op);
+    } else {
+        printf("%-12s %-28s %-8s %8zu %12.1f   ⚙️  %u workers, pinned per %s\n", p.b->name, alg, op, n,
+               n * 1e9 / elapsed, pqc_sched_workers(sched), pqc_sched_pin_name(opts.pin));
+        pqc_sched_report(sched, elapsed);
+    }
+    pqc_sched_free(sched);
+}
+
+static void bench_alg(const char *alg) {
+    size_t nb = pqc_backend_count(), ran = 0, best = 0;
+    bench_state *s = calloc(nb, sizeof(*s));
+
+    if (!s) return;
+    for (size_t i = 0; i < nb; i++) {
+        const pqc_backend *b = pqc_backend_at(i);
+
+        if (opts.backend && strcmp(opts.backend, b->name) != 0) continue;
+        if (!state_init(&s[i], alg, b)) {
+            if (opts.backend) printf("%-12s %-28s   ⚠️  not available from this backend\n", b->name, alg);
+            continue;
+        }
+        bench_backend(&s[i], b->name, alg);
+        ran++;
+    }
+
+    /* A/B: everything against the first backend that has the algorithm */
+    for (size_t r = 0; r < nb && ran > 1; r++) {
+        if (!s[r].a) continue;
+        for (size_t x = r + 1; x < nb; x++) {
+            if (!s[x].a) continue;
+            if (cross_check(&s[r], &s[x]))
+                printf("%-12s %-28s   🔁 interoperates with %s\n", pqc_backend_at(x)->name, alg,
+                       pqc_backend_at(r)->name);
+            else
+                printf("%-12s %-28s   ❌ disagrees with %s\n", pqc_backend_at(x)->name, alg,
+                       pqc_backend_at(r)->name);
+        }
+        break;
+    }
+
+    for (size_t i = 0; i < nb; i++)
+        if (s[i].score_ns && (!s[best].score_ns || s[i].score_ns < s[best].score_ns)) best = i;
+    if (ran > 1 && s[best].score_ns) {
+        printf("%-12s %-28s   🏆 fastest (%s %.2f us)\n", pqc_backend_at(best)->name, alg,
+               s[best].info->kind == PQC_KEM ? "encaps+decaps" : "sign+verify",
+               s[best].score_ns / 1000.0);
+    }
+    /* Only a run over every backend says which one is fastest */
+    if (opts.record && !opts.backend && s[best].score_ns)
+        pqc_backend_record(alg, pqc_backend_at(best)->name, s[best].score_ns);
+    if (opts.parallel && s[best].score_ns) bench_parallel(&s[best], alg);
+
+    for (size_t i = 0; i < nb; i++)
+        if (s[i].a) state_free(&s[i]);
+    free(s);
+}
+
+static void list_backends(void) {
+    printf("Backends:\n");
+    for (size_t i = 0; i < pqc_backend_count(); i++)
+        printf("  %-12s %s\n", pqc_backend_at(i)->name, pqc_backend_at(i)->description);
+    printf("\nRecorded choices (%s):\n", pqc_backend_fingerprint());
+    for (int i = 0; algs[i] != NULL; i++) {
+        uint64_t score = 0;
+        const char *b = pqc_backend_cached(algs[i], &score);
+        if (b) printf("  %-28s %-12s %10.2f us\n", algs[i], b, score / 1000.0);
+    }
+}
+
+static void usage(const char *prog) {
+    printf("Usage: %s [-n iterations] [-w warmup] [-t seconds] [-m msg_len] [-b backend] [-a filter]\n"
+           "       [-T threads] [-P none|core|node] [-R] [-l]\n", prog);
+    printf("  -n  max timed iterations per operation (default %zu)\n", opts.iterations);
+    printf("  -w  untimed warmup iterations (default %zu)\n", opts.warmup);
+    printf("  -t  time budget per operation in seconds (default %.1f)\n", opts.max_seconds);
+    printf("  -m  message length for sign/verify (default %zu)\n", opts.msg_len);
+    printf("  -b  run only one backend (evp, oqsprovider, oqs, slh_par)\n");
+    printf("  -a  run only algorithms whose name contains this string\n");
+    printf("  -T  also measure throughput on this many pinned workers (0: one per CPU)\n");
+    printf("  -P  pin the -T workers to a CPU or to a NUMA node (default core)\n");
+    printf("  -R  do not record the fastest backends\n");
+    printf("  -l  list the backends and the recorded choices\n");
+}
+
+int main(int argc, char **argv) {
+    int c, list = 0;
+
+    while ((c = getopt(argc, argv, "n:w:t:m:b:a:T:P:Rlh")) != -1) {
+        switch (c) {
+        case 'n': opts.iterations = strtoul(optarg, NULL, 10); break;
+        case 'w': opts.warmup = strtoul(optarg, NULL, 10); break;
+        case 't': opts.max_seconds = atof(optarg); break;
+        case 'm': opts.msg_len = strtoul(optarg, NULL, 10); break;
+        case 'b': opts.backend = optarg; break;
+        case 'a': opts.filter = optarg; break;
+        case 'T':
+            opts.parallel = 1;
+            opts.threads = (unsigned)strtoul(optarg, NULL, 10);
+            break;
+        case 'P':
+            if (!pqc_sched_parse_pin(optarg, &opts.pin)) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'R': opts.record = 0; break;
+        case 'l': list = 1; break;
+        default:
+            usage(argv[0]);
+            return c == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    if (opts.iterations == 0) opts.iterations = 1;
+    if (list) {
+        list_backends();
+        return EXIT_SUCCESS;
+    }
+    if (opts.backend && !pqc_backend_find(opts.backend)) {
+        printf("❌ Backend '%s' is not built in; available:", opts.backend);
+        for (size_t i = 0; i < pqc_backend_count(); i++) printf(" %s", pqc_backend_at(i)->name);
+        printf("\n");
+        if (strcmp(opts.backend, "oqs") == 0)
+            printf("💡 liboqs support not compiled in, rebuild with: make WITH_OQS=1\n");
+        return EXIT_FAILURE;
+    }
+
+    pqc_metrics_init("pqc_bench");
+    bench_msg = malloc(opts.msg_len ? opts.msg_len : 1);
+    if (!bench_msg) return EXIT_FAILURE;
+    for (size_t i = 0; i < opts.msg_len; i++) bench_msg[i] = (unsigned char)i;
+
+    printf("🚀 PQC Benchmark\n");
+    printf("================\n");
+    printf("Iterations: %zu (max %.1fs per op), message: %zu bytes\n\n",
+           opts.iterations, opts.max_seconds, opts.msg_len);
+    print_header();
+
+    for (int i = 0; algs[i] != NULL; i++)
+        if (selected(algs[i])) bench_alg(algs[i]);
+
+    if (opts.record && !opts.backend)
+        printf("\n💾 Fastest backends recorded for %s (pqc_bench -l to list)\n",
+               pqc_backend_fingerprint());
+
+    free(bench_msg);
+    return EXIT_SUCCESS;
+}
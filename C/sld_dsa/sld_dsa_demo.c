@@ -1,3 +1,5 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -9,6 +11,11 @@
 #include <openssl/params.h>
 #include <openssl/ec.h>
 
+#include "pqc_handle_cache.h"
+#include "pqc_keystore.h"
+#include "pqc_metrics.h"
+#include "pqc_timer.h"
+
 static void hexdump(const char *label, const unsigned char *buf, size_t len) {
     printf("%s (%zu bytes): ", label, len);
     size_t display_len = (len > 32) ? 32 : len;
@@ -22,51 +29,78 @@ static void handle_openssl_error(const char *msg) {
     ERR_print_errors_fp(stderr);
 }
 
+/* One metrics record per operation with PQC_METRICS=json|csv (pqc_metrics.h) */
+static pqc_metrics_sizes sizes;
+
+static void emit(const char *type, const char *op, uint64_t ns) {
+    pqc_metrics_emit_samples(type, op, "openssl", &ns, 1, 0, &sizes);
+}
+
+/* Key pairs are persisted to a keystore and read back through its mapping;
+ * PQC_KEYSTORE=file keeps it, else it is a scratch file (pqc_keystore.h) */
+#define KEYSTORE_NAME "slh_dsa_keys.pqks"
+
 static EVP_PKEY *generate_keys(const char *type) {
-    EVP_PKEY *pkey = NULL;
+    EVP_PKEY *pkey = NULL, *stored = NULL;
     EVP_PKEY_CTX *kctx = NULL;
+    pqc_keystore_writer *w = NULL;
+    pqc_keystore *ks = NULL;
+    pqc_key_ref ref;
+    char path[4096];
+    int scratch = 0;
+    uint64_t t0, keygen_ns;
 
     printf("🔐 Generating keys for: %s\n", type);
     
-    kctx = EVP_PKEY_CTX_new_from_name(NULL, type, NULL);
+    kctx = pqc_handle_cache_keygen_ctx(NULL, type);
     if (!kctx) {
-        handle_openssl_error("Failed to create context");
-        return NULL;
-    }
-
-    if (EVP_PKEY_keygen_init(kctx) <= 0) {
-        handle_openssl_error("Failed to initialize key generation");
-        EVP_PKEY_CTX_free(kctx);
+        handle_openssl_error("Failed to create key generation context");
         return NULL;
     }
 
+    t0 = pqc_now_ns();
     if (EVP_PKEY_keygen(kctx, &pkey) <= 0) {
         handle_openssl_error("Failed to generate key pair");
         EVP_PKEY_CTX_free(kctx);
         return NULL;
     }
-
-    uint8_t pub[2592], priv[4896];
-    size_t priv_len = 0, pub_len = 0;
-
-    if (EVP_PKEY_get_octet_string_param(pkey, OSSL_PKEY_PARAM_PRIV_KEY,
-                                priv, sizeof(priv), &priv_len) <= 0) {
-        handle_openssl_error("Failed to get private key");
-    } else {
-        printf("✅ Private key length: %zu bytes\n", priv_len);
-        hexdump("Private key", priv, priv_len);
+    keygen_ns = pqc_now_ns() - t0;
+
+    /* Export the raw keys straight into the keystore, keyed by algorithm name */
+    if (!pqc_keystore_demo_path(path, sizeof(path), KEYSTORE_NAME, &scratch)) goto cleanup;
+    w = pqc_keystore_writer_new();
+    if (!w || !pqc_keystore_writer_add_pkey(w, type, pkey, 0)
+        || !pqc_keystore_writer_commit(w, path)) {
+        handle_openssl_error("Failed to write keystore");
+        goto cleanup;
     }
+    printf("💾 Key pair saved to %s\n", path);
 
-    if (EVP_PKEY_get_octet_string_param(pkey, OSSL_PKEY_PARAM_PUB_KEY,
-                                pub, sizeof(pub), &pub_len) <= 0) {
-        handle_openssl_error("Failed to get public key");
-    } else {
-        printf("✅ Public key length: %zu bytes\n", pub_len);
-        hexdump("Public key", pub, pub_len);
+    ks = pqc_keystore_open(path);
+    if (!ks || !pqc_keystore_find(ks, type, &ref)) {
+        fprintf(stderr, "ERROR: Failed to read back %s\n", path);
+        goto cleanup;
     }
 
+    /* Printed straight from the mapped file */
+    sizes.pk = ref.pub_len;
+    sizes.sk = ref.priv_len;
+    emit(type, "keygen", keygen_ns);
+    printf("✅ Private key length: %zu bytes\n", ref.priv_len);
+    hexdump("Private key", ref.priv, ref.priv_len);
+    printf("✅ Public key length: %zu bytes\n", ref.pub_len);
+    hexdump("Public key", ref.pub, ref.pub_len);
+
+    stored = pqc_keystore_load(ks, NULL, type);
+    if (!stored) handle_openssl_error("Failed to load key from keystore");
+
+cleanup:
+    pqc_keystore_close(ks);
+    if (scratch) pqc_keystore_remove_scratch(path);
+    pqc_keystore_writer_free(w);
+    EVP_PKEY_free(pkey);
     EVP_PKEY_CTX_free(kctx);
-    return pkey;
+    return stored;
 }
 
 int do_sign(EVP_PKEY *pkey, const char *msg, size_t msg_len, const char *type) {
@@ -74,6 +108,7 @@ int do_sign(EVP_PKEY *pkey, const char *msg, size_t msg_len, const char *type) {
     unsigned char *sig = NULL;
     EVP_PKEY_CTX *sctx = NULL;
     EVP_SIGNATURE *sig_alg = NULL;
+    uint64_t t0, ns;
     int ret = 0;
 
     printf("\n📝 Signing message with %s\n", type);
@@ -84,13 +119,14 @@ int do_sign(EVP_PKEY *pkey, const char *msg, size_t msg_len, const char *type) {
         OSSL_PARAM_END
     };
 
-    sctx = EVP_PKEY_CTX_new_from_pkey(NULL, pkey, NULL);
+    sctx = pqc_handle_cache_pkey_ctx(pkey);
     if (!sctx) {
         handle_openssl_error("Failed to create signing context");
         return 0;
     }
 
-    sig_alg = EVP_SIGNATURE_fetch(NULL, type, NULL);
+    /* Borrowed from the process-wide cache, so it is not freed here */
+    sig_alg = pqc_handle_cache_signature(NULL, type);
     if (!sig_alg) {
         handle_openssl_error("Failed to fetch signature algorithm");
         EVP_PKEY_CTX_free(sctx);
@@ -114,18 +150,32 @@ int do_sign(EVP_PKEY *pkey, const char *msg, size_t msg_len, const char *type) {
         goto cleanup;
     }
 
+    t0 = pqc_now_ns();
     if (EVP_PKEY_sign(sctx, sig, &sig_len, (const unsigned char *)msg, msg_len) <= 0) {
         handle_openssl_error("Failed to sign message");
         goto cleanup;
     }
+    ns = pqc_now_ns() - t0;
+    sizes.sig = sig_len;
+    emit(type, "sign", ns);
 
     printf("✅ Signature length: %zu bytes\n", sig_len);
     hexdump("Signature", sig, sig_len);
+
+    /* Same context string; the signing context is reused for verification */
+    t0 = pqc_now_ns();
+    if (EVP_PKEY_verify_message_init(sctx, sig_alg, params) <= 0
+        || EVP_PKEY_verify(sctx, sig, sig_len, (const unsigned char *)msg, msg_len) != 1) {
+        handle_openssl_error("Failed to verify signature");
+        goto cleanup;
+    }
+    ns = pqc_now_ns() - t0;
+    emit(type, "verify", ns);
+    printf("✅ Signature verified\n");
     ret = 1;
 
 cleanup:
     if (sig) OPENSSL_free(sig);
-    if (sig_alg) EVP_SIGNATURE_free(sig_alg);
     if (sctx) EVP_PKEY_CTX_free(sctx);
     return ret;
 }
@@ -137,6 +187,7 @@ int main(int argc, char** argv) {
     // Initialize OpenSSL
     ERR_load_crypto_strings();
     OpenSSL_add_all_algorithms();
+    pqc_metrics_init("sld_dsa_demo");
 
     const char *type = "SLH-DSA-SHA2-128f";
     const char *msg = "Hello";
@@ -164,13 +215,16 @@ int main(int argc, char** argv) {
 
     if (!do_sign(key, msg, msg_len, type)) {
         fprintf(stderr, "\n❌ Signing failed!\n");
+        pqc_handle_cache_forget_pkey(key);
         EVP_PKEY_free(key);
         return EXIT_FAILURE;
     }
 
     printf("\n🎉 SLH-DSA operations completed successfully!\n");
 
+    pqc_handle_cache_forget_pkey(key);
     EVP_PKEY_free(key);
+    pqc_handle_cache_cleanup();
     
     // Cleanup
     EVP_cleanup();
@@ -185,6 +239,7 @@ int main(int argc, char** argv) {
 Using algorithm: SLH-DSA-SHA2-128f
 Using message: "Hello"
 🔐 Generating keys for: SLH-DSA-SHA2-128f
+💾 Key pair saved to /tmp/pqc_keystore.Xk3F9a/slh_dsa_keys.pqks
 ✅ Private key length: 64 bytes
 Private key (64 bytes): 21CCD0D6BEB275D514BCE4BDBBA225FB80E2C66BAA379CCE2BD9AF4A2D407DC4...
 ✅ Public key length: 32 bytes
@@ -194,6 +249,7 @@ Public key (32 bytes): 0011B76588D78F28533E8299DFAF098EA8C0CCBE7AFAE14FAE3B482DD
 Message: "Hello" (5 bytes)
 ✅ Signature length: 17088 bytes
 Signature (17088 bytes): AEB92B796BEA9D198EF86AFF703E3D271C48392BE43245ECAD7190E665371D4D...
+✅ Signature verified
 
 🎉 SLH-DSA operations completed successfully!
 */
\ No newline at end of file
@@ -0,0 +1,369 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include <openssl/evp.h>
+#include <openssl/err.h>
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+
+#include "slh_batch.h"
+#include "pqc_timer.h"
+
+/* Parameter names from OpenSSL 3.5 core_names.h */
+#ifndef OSSL_SIGNATURE_PARAM_CONTEXT_STRING
+#define OSSL_SIGNATURE_PARAM_CONTEXT_STRING "context-string"
+#endif
+
+#define H SLH_BATCH_HASH_LEN
+#define ROOT_MSG_LEN (8 + 4 + H)        /* seq || n || root */
+#define PROOF_HDR 16                    /* seq || n || index */
+
+static const unsigned char batch_context[] = "slh-batch-v1";
+
+/* ---- Tree hashing ---- */
+
+typedef struct {
+    EVP_MD *md;
+    EVP_MD_CTX *ctx;
+    int xof;                            /* SHAKE256, squeezed to 32 bytes */
+} tree_hash;
+
+static int tree_hash_init(tree_hash *th, const char *alg) {
+    th->xof = strstr(alg, "SHAKE") != NULL;
+    th->md = EVP_MD_fetch(NULL, th->xof ? "SHAKE256" : "SHA256", NULL);
+    th->ctx = EVP_MD_CTX_new();
+    return th->md && th->ctx;
+}
+
+static void tree_hash_cleanup(tree_hash *th) {
+    EVP_MD_CTX_free(th->ctx);
+    EVP_MD_free(th->md);
+}
+
+/* out = H(prefix || a || b); b may be NULL */
+static int tree_hash_do(tree_hash *th, unsigned char prefix, const uint8_t *a, size_t a_len,
+                        const uint8_t *b, size_t b_len, uint8_t *out) {
+    return EVP_DigestInit_ex(th->ctx, th->md, NULL) > 0
+        && EVP_DigestUpdate(th->ctx, &prefix, 1) > 0
+        && EVP_DigestUpdate(th->ctx, a, a_len) > 0
+        && (!b || EVP_DigestUpdate(th->ctx, b, b_len) > 0)
+        && (th->xof ? EVP_DigestFinalXOF(th->ctx, out, H) > 0
+                    : EVP_DigestFinal_ex(th->ctx, out, NULL) > 0);
+}
+
+static int hash_leaf(tree_hash *th, const uint8_t *record, size_t len, uint8_t *out) {
+    return tree_hash_do(th, 0x00, record, len, NULL, 0, out);
+}
+
+static int hash_node(tree_hash *th, const uint8_t *left, const uint8_t *right, uint8_t *out) {
+    return tree_hash_do(th, 0x01, left, H, right, H, out);
+}
+
+static void put_be(uint8_t *p, uint64_t v, int bytes) {
+    for (int i = bytes - 1; i >= 0; i--, v >>= 8) p[i] = (uint8_t)v;
+}
+
+static uint64_t get_be(const uint8_t *p, int bytes) {
+    uint64_t v = 0;
+
+    for (int i = 0; i < bytes; i++) v = v << 8 | p[i];
+    return v;
+}
+
+static void root_message(uint8_t *msg, uint64_t seq, size_t n, const uint8_t *root) {
+    put_be(msg, seq, 8);
+    put_be(msg + 8, n, 4);
+    memcpy(msg + 12, root, H);
+}
+
+/* ---- Signer ---- */
+
+struct slh_batch_signer {
+    EVP_PKEY *pkey;
+    EVP_SIGNATURE *sig_alg;
+    tree_hash th;
+    size_t max_records;
+    uint64_t window_ns;
+    uint8_t *leaves;                    /* max_records leaf hashes */
+    size_t n;
+    uint64_t seq;
+    uint64_t opened_ns;                 /* time of the open batch's first record */
+};
+
+struct slh_batch {
+    uint64_t seq;
+    size_t n;
+    size_t depth;
+    size_t level[SLH_BATCH_MAX_DEPTH + 1];  /* offset of each level in nodes, leaves first */
+    uint8_t *nodes;
+    uint8_t *sig;
+    size_t sig_len;
+};
+
+slh_batch_signer *slh_batch_signer_new(EVP_PKEY *pkey, const char *alg,
+                                       size_t max_records, uint64_t window_ms) {
+    slh_batch_signer *s;
+
+    /* Proofs carry n in 4 bytes and at most SLH_BATCH_MAX_DEPTH siblings */
+    if (max_records == 0 || max_records > 0xffffffffu) return NULL;
+    if (!(s = OPENSSL_zalloc(sizeof(*s)))) return NULL;
+    s->max_records = max_records;
+    s->window_ns = window_ms * 1000000ULL;
+
+    if (!EVP_PKEY_up_ref(pkey)) {
+        OPENSSL_free(s);
+        return NULL;
+    }
+    s->pkey = pkey;
+    s->sig_alg = EVP_SIGNATURE_fetch(NULL, alg, NULL);
+    s->leaves = OPENSSL_malloc(max_records * H);
+    if (!tree_hash_init(&s->th, alg) || !s->sig_alg || !s->leaves) {
+        slh_batch_signer_free(s);
+        return NULL;
+    }
+    return s;
+}
+
+void slh_batch_signer_free(slh_batch_signer *s) {
+    if (!s) return;
+    OPENSSL_free(s->leaves);
+    tree_hash_cleanup(&s->th);
+    EVP_SIGNATURE_free(s->sig_alg);
+    EVP_PKEY_free(s->pkey);
+    OPENSSL_free(s);
+}
+
+int slh_batch_add(slh_batch_signer *s, const uint8_t *record, size_t len, size_t *index) {
+    if (s->n == s->max_records) return 0;
+    if (!hash_leaf(&s->th, record, len, s->leaves + s->n * H)) {
+        ERR_print_errors_fp(stderr);
+        return 0;
+    }
+    if (s->n == 0) s->opened_ns = pqc_now_ns();
+    if (index) *index = s->n;
+    s->n++;
+    return 1;
+}
+
+size_t slh_batch_pending(const slh_batch_signer *s) {
+    return s->n;
+}
+
+int slh_batch_due(const slh_batch_signer *s) {
+    if (s->n == 0) return 0;
+    return s->n == s->max_records
+        || (s->window_ns && pqc_now_ns() - s->opened_ns >= s->window_ns);
+}
+
+static int sign_root(slh_batch_signer *s, slh_batch *b, const uint8_t *msg) {
+    OSSL_PARAM params[2];
+    EVP_PKEY_CTX *pctx = EVP_PKEY_CTX_new_from_pkey(NULL, s->pkey, NULL);
+    int ok = 0;
+
+    params[0] = OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_CONTEXT_STRING,
+                                                  (void *)batch_context, sizeof(batch_context) - 1);
+    params[1] = OSSL_PARAM_construct_end();
+    if (!pctx
+        || EVP_PKEY_sign_message_init(pctx, s->sig_alg, params) <= 0
+        || EVP_PKEY_sign(pctx, NULL, &b->sig_len, msg, ROOT_MSG_LEN) <= 0
+        || !(b->sig = OPENSSL_malloc(b->sig_len))
+        || EVP_PKEY_sign(pctx, b->sig, &b->sig_len, msg, ROOT_MSG_LEN) <= 0)
+        goto cleanup;
+    ok = 1;
+
+cleanup:
+    EVP_PKEY_CTX_free(pctx);
+    return ok;
+}
+
+slh_batch *slh_batch_seal(slh_batch_signer *s) {
+    slh_batch *b;
+    uint8_t msg[ROOT_MSG_LEN];
+    size_t total = 0, m;
+
+    if (s->n == 0) return NULL;
+    if (!(b = OPENSSL_zalloc(sizeof(*b)))) return NULL;
+    b->seq = s->seq;
+    b->n = s->n;
+
+    /* Level sizes: n, ceil(n / 2), ..., 1 */
+    for (m = b->n; ; m = (m + 1) / 2) {
+        b->level[b->depth] = total;
+        total += m;
+        if (m == 1) break;
+        b->depth++;
+    }
+    if (!(b->nodes = OPENSSL_malloc(total * H))) goto err;
+    memcpy(b->nodes, s->leaves, b->n * H);
+
+    m = b->n;
+    for (size_t d = 0; d < b->depth; d++, m = (m + 1) / 2) {
+        const uint8_t *in = b->nodes + b->level[d] * H;
+        uint8_t *out = b->nodes + b->level[d + 1] * H;
+
+        for (size_t i = 0; i + 1 < m; i += 2)
+            if (!hash_node(&s->th, in + i * H, in + (i + 1) * H, out + i / 2 * H)) goto err;
+        if (m & 1) memcpy(out + m / 2 * H, in + (m - 1) * H, H);
+    }
+
+    root_message(msg, b->seq, b->n, b->nodes + b->level[b->depth] * H);
+    if (!sign_root(s, b, msg)) goto err;
+
+    s->seq++;
+    s->n = 0;
+    return b;
+
+err:
+    ERR_print_errors_fp(stderr);
+    slh_batch_free(b);
+    return NULL;
+}
+
+void slh_batch_free(slh_batch *b) {
+    if (!b) return;
+    OPENSSL_free(b->nodes);
+    OPENSSL_free(b->sig);
+    OPENSSL_free(b);
+}
+
+uint64_t slh_batch_seq(const slh_batch *b) {
+    return b->seq;
+}
+
+size_t slh_batch_count(const slh_batch *b) {
+    return b->n;
+}
+
+const uint8_t *slh_batch_signature(const slh_batch *b, size_t *len) {
+    *len = b->sig_len;
+    return b->sig;
+}
+
+size_t slh_batch_proof(const slh_batch *b, size_t i, uint8_t *out) {
+    uint8_t *p = out + PROOF_HDR;
+
+    if (i >= b->n) return 0;
+    put_be(out, b->seq, 8);
+    put_be(out + 8, b->n, 4);
+    put_be(out + 12, i, 4);
+
+    for (size_t d = 0, m = b->n; d < b->depth; d++, m = (m + 1) / 2, i /= 2) {
+        if ((i ^ 1) >= m) continue;     /* carried up without a sibling */
+        memcpy(p, b->nodes + (b->level[d] + (i ^ 1)) * H, H);
+        p += H;
+    }
+    return (size_t)(p - out);
+}
+
+/* ---- Verifier ---- */
+
+typedef struct {
+    uint8_t msg[ROOT_MSG_LEN];          /* a verified seq || n || root */
+    int valid;
+} root_entry;
+
+struct slh_batch_verifier {
+    EVP_PKEY *pkey;
+    EVP_SIGNATURE *sig_alg;
+    tree_hash th;
+    root_entry *cache;                  /* direct-mapped on the root's first bytes */
+    size_t cache_size;
+    uint64_t records, root_verifications, cache_hits;
+};
+
+slh_batch_verifier *slh_batch_verifier_new(EVP_PKEY *pkey, const char *alg, size_t cache_size) {
+    slh_batch_verifier *v;
+
+    if (cache_size == 0) return NULL;
+    if (!(v = OPENSSL_zalloc(sizeof(*v)))) return NULL;
+    if (!EVP_PKEY_up_ref(pkey)) {
+        OPENSSL_free(v);
+        return NULL;
+    }
+    v->pkey = pkey;
+    v->cache_size = cache_size;
+    v->sig_alg = EVP_SIGNATURE_fetch(NULL, alg, NULL);
+    v->cache = OPENSSL_zalloc(cache_size * sizeof(*v->cache));
+    if (!tree_hash_init(&v->th, alg) || !v->sig_alg || !v->cache) {
+        slh_batch_verifier_free(v);
+        return NULL;
+    }
+    return v;
+}
+
+void slh_batch_verifier_free(slh_batch_verifier *v) {
+    if (!v) return;
+    OPENSSL_free(v->cache);
+    tree_hash_cleanup(&v->th);
+    EVP_SIGNATURE_free(v->sig_alg);
+    EVP_PKEY_free(v->pkey);
+    OPENSSL_free(v);
+}
+
+static int verify_root(slh_batch_verifier *v, const uint8_t *msg, const uint8_t *sig, size_t sig_len) {
+    OSSL_PARAM params[2];
+    EVP_PKEY_CTX *pctx = EVP_PKEY_CTX_new_from_pkey(NULL, v->pkey, NULL);
+    int ok;
+
+    params[0] = OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_CONTEXT_STRING,
+                                                  (void *)batch_context, sizeof(batch_context) - 1);
+    params[1] = OSSL_PARAM_construct_end();
+    ok = pctx
+        && EVP_PKEY_verify_message_init(pctx, v->sig_alg, params) > 0
+        && EVP_PKEY_verify(pctx, sig, sig_len, msg, ROOT_MSG_LEN) == 1;
+    EVP_PKEY_CTX_free(pctx);
+    v->root_verifications++;
+    return ok;
+}
+
+int slh_batch_verify(slh_batch_verifier *v, const uint8_t *record, size_t len,
+                     const uint8_t *proof, size_t proof_len,
+                     const uint8_t *sig, size_t sig_len) {
+    uint8_t node[H], msg[ROOT_MSG_LEN];
+    const uint8_t *sib;
+    uint64_t seq, h;
+    size_t n, i, siblings = 0;
+    root_entry *e;
+
+    v->records++;
+    if (proof_len < PROOF_HDR) return 0;
+    seq = get_be(proof, 8);
+    n = (size_t)get_be(proof + 8, 4);
+    i = (size_t)get_be(proof + 12, 4);
+    if (n == 0 || i >= n) return 0;
+
+    /* The path length follows from n and i; the proof must match it exactly */
+    for (size_t m = n, j = i; m > 1; m = (m + 1) / 2, j /= 2)
+        if ((j ^ 1) < m) siblings++;
+    if (proof_len != PROOF_HDR + siblings * H) return 0;
+
+    if (!hash_leaf(&v->th, record, len, node)) return 0;
+    sib = proof + PROOF_HDR;
+    for (size_t m = n; m > 1; m = (m + 1) / 2, i /= 2) {
+        if ((i ^ 1) >= m) continue;
+        if (!(i & 1 ? hash_node(&v->th, sib, node, node) : hash_node(&v->th, node, sib, node)))
+            return 0;
+        sib += H;
+    }
+
+    root_message(msg, seq, n, node);
+    memcpy(&h, node, sizeof(h));
+    e = &v->cache[h % v->cache_size];
+    if (e->valid && memcmp(e->msg, msg, ROOT_MSG_LEN) == 0) {
+        v->cache_hits++;
+        return 1;
+    }
+    if (!verify_root(v, msg, sig, sig_len)) return 0;
+    memcpy(e->msg, msg, ROOT_MSG_LEN);
+    e->valid = 1;
+    return 1;
+}
+
+void slh_batch_verifier_get_stats(const slh_batch_verifier *v, slh_batch_verify_stats *stats) {
+    stats->records = v->records;
+    stats->root_verifications = v->root_verifications;
+    stats->cache_hits = v->cache_hits;
+}
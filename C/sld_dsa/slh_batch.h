@@ -0,0 +1,105 @@
+#ifndef SLH_BATCH_H
+#define SLH_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <openssl/evp.h>
+
+/*
+ * Merkle batch signing: one SLH-DSA signature covers a whole batch of
+ * records.
+ *
+ * Records go into an open batch, which keeps only each record's leaf hash.
+ * When the batch is full or its time window has passed (slh_batch_due()),
+ * slh_batch_seal() builds a Merkle tree over the leaves and signs
+ *     seq (8 bytes) || n (4) || root (32),     big-endian integers,
+ * with SLH-DSA under the context string "slh-batch-v1". Every record then
+ * gets an inclusion proof,
+ *     seq (8) || n (4) || index (4) || sibling hashes,
+ * at most ceil(log2 n) * 32 bytes of siblings, and shares the batch's one
+ * root signature.
+ *
+ * Hashes are SHA-256 for the SHA2 parameter sets and 32-byte SHAKE256 for
+ * the SHAKE ones. Leaves are H(0x00 || record) and nodes
+ * H(0x01 || left || right), as in RFC 6962; a node without a sibling at the
+ * end of a level moves up unchanged.
+ *
+ * The tree hash is 32 bytes for every parameter set, not the set's n. A
+ * Merkle tree rests on collision resistance, which an n-byte hash halves:
+ * 64 bits for the 128-bit sets, too weak once records are attacker-chosen.
+ * With 32 bytes it is 128 bits (NIST category 2) for all sets. That is
+ * above what the 128-bit sets need and costs them 16 bytes per proof level;
+ * for the 192 and 256-bit sets it makes the tree, not SLH-DSA, the weakest
+ * link.
+ *
+ * The verifier recomputes the root from a record and its proof, at most
+ * ceil(log2 n) + 1 hashes, and verifies the root signature only the first
+ * time it meets that root. Verified roots are cached.
+ *
+ * None of the objects are thread-safe.
+ */
+
+#define SLH_BATCH_HASH_LEN  32
+#define SLH_BATCH_MAX_DEPTH 32
+#define SLH_BATCH_PROOF_MAX (16 + SLH_BATCH_MAX_DEPTH * SLH_BATCH_HASH_LEN)
+
+typedef struct slh_batch_signer slh_batch_signer;
+typedef struct slh_batch slh_batch;
+typedef struct slh_batch_verifier slh_batch_verifier;
+
+/*
+ * alg is the SLH-DSA parameter set of pkey, e.g. "SLH-DSA-SHA2-128f". A
+ * batch is due at max_records records, or window_ms after its first record
+ * (0: no time limit).
+ */
+slh_batch_signer *slh_batch_signer_new(EVP_PKEY *pkey, const char *alg,
+                                       size_t max_records, uint64_t window_ms);
+void slh_batch_signer_free(slh_batch_signer *s);
+
+/* Adds a record to the open batch and sets *index. 0 if the batch is full. */
+int slh_batch_add(slh_batch_signer *s, const uint8_t *record, size_t len, size_t *index);
+
+/* Records in the open batch. */
+size_t slh_batch_pending(const slh_batch_signer *s);
+
+/* 1 when the open batch is full or its window has passed. */
+int slh_batch_due(const slh_batch_signer *s);
+
+/*
+ * Builds the tree over the open batch, signs its root and opens the next
+ * batch. NULL if the batch is empty or signing fails.
+ */
+slh_batch *slh_batch_seal(slh_batch_signer *s);
+void slh_batch_free(slh_batch *b);
+
+uint64_t slh_batch_seq(const slh_batch *b);
+size_t slh_batch_count(const slh_batch *b);
+
+/* The root signature shared by every record in the batch. */
+const uint8_t *slh_batch_signature(const slh_batch *b, size_t *len);
+
+/*
+ * Writes the proof for record i to out, which must hold SLH_BATCH_PROOF_MAX
+ * bytes, and returns its length (0 if i is out of range).
+ */
+size_t slh_batch_proof(const slh_batch *b, size_t i, uint8_t *out);
+
+/* cache_size verified roots are remembered. */
+slh_batch_verifier *slh_batch_verifier_new(EVP_PKEY *pkey, const char *alg, size_t cache_size);
+void slh_batch_verifier_free(slh_batch_verifier *v);
+
+/* 1 if record is in a batch whose root signature verifies, 0 otherwise. */
+int slh_batch_verify(slh_batch_verifier *v, const uint8_t *record, size_t len,
+                     const uint8_t *proof, size_t proof_len,
+                     const uint8_t *sig, size_t sig_len);
+
+typedef struct {
+    uint64_t records;           /* slh_batch_verify() calls */
+    uint64_t root_verifications;
+    uint64_t cache_hits;
+} slh_batch_verify_stats;
+
+void slh_batch_verifier_get_stats(const slh_batch_verifier *v, slh_batch_verify_stats *stats);
+
+#endif /* SLH_BATCH_H */
@@ -0,0 +1,278 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include <openssl/evp.h>
+#include <openssl/err.h>
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+
+#include "pqc_metrics.h"
+#include "slh_batch.h"
+#include "pqc_timer.h"
+
+/* Parameter names from OpenSSL 3.5 core_names.h */
+#ifndef OSSL_SIGNATURE_PARAM_CONTEXT_STRING
+#define OSSL_SIGNATURE_PARAM_CONTEXT_STRING "context-string"
+#endif
+
+/*
+ * An audit log signing a stream of small records. Two paths sign and verify
+ * the same records:
+ *
+ *   per-record  one SLH-DSA signature per record (sampled; too slow to run
+ *               over the whole stream)
+ *   batch       records grouped into Merkle batches of up to BATCH records,
+ *               one SLH-DSA signature per batch, an inclusion proof per
+ *               record; verified with one slh_batch_verifier
+ *
+ * Before timing, the batch verifier must reject a modified record, a
+ * modified proof, a proof moved to another record and a forged signature.
+ */
+
+#define RECORD_MAX 96
+#define SAMPLES 16
+
+static const unsigned char context[] = "audit-log";
+
+static void handle_openssl_error(const char *msg) {
+    fprintf(stderr, "ERROR: %s\n", msg);
+    ERR_print_errors_fp(stderr);
+}
+
+static size_t record(uint8_t *buf, size_t i) {
+    return (size_t)snprintf((char *)buf, RECORD_MAX,
+                            "{\"ts\":%zu,\"user\":\"user-%zu\",\"action\":\"login\"}",
+                            1792108800 + i, i % 97);
+}
+
+static int sign_one(EVP_PKEY *pkey, EVP_SIGNATURE *alg, uint8_t *sig, size_t *sig_len,
+                    const uint8_t *msg, size_t msg_len) {
+    OSSL_PARAM params[2];
+    EVP_PKEY_CTX *pctx = EVP_PKEY_CTX_new_from_pkey(NULL, pkey, NULL);
+    int ok;
+
+    params[0] = OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_CONTEXT_STRING,
+                                                  (void *)context, sizeof(context) - 1);
+    params[1] = OSSL_PARAM_construct_end();
+    ok = pctx
+        && EVP_PKEY_sign_message_init(pctx, alg, params) > 0
+        && EVP_PKEY_sign(pctx, sig, sig_len, msg, msg_len) > 0;
+    EVP_PKEY_CTX_free(pctx);
+    return ok;
+}
+
+static int verify_one(EVP_PKEY *pkey, EVP_SIGNATURE *alg, const uint8_t *sig, size_t sig_len,
+                      const uint8_t *msg, size_t msg_len) {
+    OSSL_PARAM params[2];
+    EVP_PKEY_CTX *pctx = EVP_PKEY_CTX_new_from_pkey(NULL, pkey, NULL);
+    int ok;
+
+    params[0] = OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_CONTEXT_STRING,
+                                                  (void *)context, sizeof(context) - 1);
+    params[1] = OSSL_PARAM_construct_end();
+    ok = pctx
+        && EVP_PKEY_verify_message_init(pctx, alg, params) > 0
+        && EVP_PKEY_verify(pctx, sig, sig_len, msg, msg_len) == 1;
+    EVP_PKEY_CTX_free(pctx);
+    return ok;
+}
+
+/* Per-record signing and verification rates over SAMPLES records; h may be NULL */
+static int per_record(EVP_PKEY *pkey, EVP_SIGNATURE *alg, double *sign_rate, double *verify_rate,
+                      size_t *sig_len, pqc_hist *h[2]) {
+    int size = EVP_PKEY_get_size(pkey);
+    size_t max_len = size > 0 ? (size_t)size : 0;
+    uint8_t *sig = max_len ? malloc(max_len) : NULL, msg[RECORD_MAX];
+    uint64_t t0, t, sign_ns = 0, verify_ns = 0;
+    int ok = 1;
+
+    if (!sig) return 0;
+    for (size_t i = 0; ok && i < SAMPLES; i++) {
+        size_t msg_len = record(msg, i), len = max_len;
+
+        t0 = pqc_now_ns();
+        ok = sign_one(pkey, alg, sig, &len, msg, msg_len);
+        sign_ns += t = pqc_now_ns() - t0;
+        if (h) pqc_hist_record(h[0], t);
+        t0 = pqc_now_ns();
+        ok = ok && verify_one(pkey, alg, sig, len, msg, msg_len);
+        verify_ns += t = pqc_now_ns() - t0;
+        if (h) pqc_hist_record(h[1], t);
+        *sig_len = len;
+    }
+    free(sig);
+    *sign_rate = SAMPLES * 1e9 / sign_ns;
+    *verify_rate = SAMPLES * 1e9 / verify_ns;
+    return ok;
+}
+
+/* Tampered inputs against the first two records of a sealed batch */
+static int check(EVP_PKEY *pkey, const char *alg, slh_batch *b) {
+    slh_batch_verifier *v = slh_batch_verifier_new(pkey, alg, 4);
+    uint8_t msg[RECORD_MAX], other[RECORD_MAX], proof[SLH_BATCH_PROOF_MAX], *bad_sig = NULL;
+    size_t msg_len = record(msg, 0), other_len = record(other, 1), sig_len;
+    size_t proof_len = slh_batch_proof(b, 0, proof);
+    const uint8_t *sig = slh_batch_signature(b, &sig_len);
+    int ok = v && proof_len && (bad_sig = malloc(sig_len));
+
+    if (!ok) goto cleanup;
+    memcpy(bad_sig, sig, sig_len);
+    bad_sig[sig_len / 2] ^= 1;
+
+    /* A forged signature on an unseen root is rejected and not cached */
+    ok = !slh_batch_verify(v, msg, msg_len, proof, proof_len, bad_sig, sig_len)
+        && slh_batch_verify(v, msg, msg_len, proof, proof_len, sig, sig_len)
+        && !slh_batch_verify(v, other, other_len, proof, proof_len, sig, sig_len);
+    msg[0] ^= 1;
+    ok = ok && !slh_batch_verify(v, msg, msg_len, proof, proof_len, sig, sig_len);
+    msg[0] ^= 1;
+    proof[proof_len - 1] ^= 1;
+    ok = ok && !slh_batch_verify(v, msg, msg_len, proof, proof_len, sig, sig_len);
+    proof[proof_len - 1] ^= 1;
+    ok = ok && !slh_batch_verify(v, msg, msg_len, proof, proof_len - 1, sig, sig_len);
+
+cleanup:
+    free(bad_sig);
+    slh_batch_verifier_free(v);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    const char *alg = argc > 1 ? argv[1] : "SLH-DSA-SHA2-128f";
+    size_t n = argc > 2 ? strtoul(argv[2], NULL, 10) : 4096;
+    size_t batch = argc > 3 ? strtoul(argv[3], NULL, 10) : 1024;
+    EVP_PKEY *pkey = NULL;
+    EVP_SIGNATURE *sig_alg = NULL;
+    slh_batch_signer *signer = NULL;
+    slh_batch_verifier *verifier = NULL;
+    slh_batch **batches = NULL;
+    slh_batch_verify_stats vst;
+    uint8_t msg[RECORD_MAX], *proofs = NULL;
+    size_t *proof_lens = NULL, nbatches = 0, sig_len = 0, proof_bytes = 0;
+    double sign_rate, verify_rate, batch_sign_rate, batch_verify_rate;
+    pqc_hist *hist[4] = { NULL, NULL, NULL, NULL };     /* per-record sign, verify; batch sign, verify */
+    pqc_metrics_sizes sizes = { 0, 0, 0, 0, 0 };
+    uint64_t t0, sign_ns, verify_ns;
+    int ret = 1, metrics = pqc_metrics_init("slh_batch_bench");
+
+    printf("🌲 SLH-DSA Merkle Batch Signing Benchmark\n");
+    printf("=========================================\n");
+
+    if (n == 0) n = 1;
+    if (batch == 0) batch = 1;
+    if (!(pkey = EVP_PKEY_Q_keygen(NULL, NULL, alg))
+        || !(sig_alg = EVP_SIGNATURE_fetch(NULL, alg, NULL))) {
+        handle_openssl_error("key generation failed");
+        goto cleanup;
+    }
+    batches = calloc((n + batch - 1) / batch, sizeof(*batches));
+    proofs = malloc(n * SLH_BATCH_PROOF_MAX);
+    proof_lens = malloc(n * sizeof(*proof_lens));
+    for (int i = 0; metrics && i < 4; i++)
+        if (!(hist[i] = pqc_hist_new())) goto cleanup;
+    if (!batches || !proofs || !proof_lens
+        || !(signer = slh_batch_signer_new(pkey, alg, batch, 0))
+        || !(verifier = slh_batch_verifier_new(pkey, alg, 64))) {
+        printf("❌ Setup failed\n");
+        goto cleanup;
+    }
+    printf("Algorithm: %s, %zu records, batches of up to %zu\n\n", alg, n, batch);
+
+    if (!per_record(pkey, sig_alg, &sign_rate, &verify_rate, &sig_len, metrics ? hist : NULL)) {
+        handle_openssl_error("per-record signing failed");
+        goto cleanup;
+    }
+
+    /* Sign: add every record, seal each batch as it becomes due */
+    t0 = pqc_now_ns();
+    for (size_t i = 0; i < n; i++) {
+        size_t msg_len = record(msg, i);
+        uint64_t t = metrics ? pqc_now_ns() : 0;
+
+        if (!slh_batch_add(signer, msg, msg_len, NULL)) goto sign_failed;
+        if ((slh_batch_due(signer) || i + 1 == n)
+            && !(batches[nbatches++] = slh_batch_seal(signer)))
+            goto sign_failed;
+        if (metrics) pqc_hist_record(hist[2], pqc_now_ns() - t);    /* the sealing record carries the signature */
+    }
+    for (size_t k = 0, first = 0; k < nbatches; first += slh_batch_count(batches[k++]))
+        for (size_t j = 0; j < slh_batch_count(batches[k]); j++) {
+            proof_lens[first + j] = slh_batch_proof(batches[k], j, proofs + (first + j) * SLH_BATCH_PROOF_MAX);
+            proof_bytes += proof_lens[first + j];
+        }
+    sign_ns = pqc_now_ns() - t0;
+    batch_sign_rate = n * 1e9 / sign_ns;
+
+    if (!check(pkey, alg, batches[0])) {
+        printf("❌ Batch verifier accepted a tampered record, proof or signature\n");
+        goto cleanup;
+    }
+    printf("✅ Tampered records, proofs and signatures rejected\n\n");
+
+    /* Verify: every record against its batch's shared signature */
+    t0 = pqc_now_ns();
+    for (size_t k = 0, i = 0; k < nbatches; k++) {
+        size_t len;
+        const uint8_t *sig = slh_batch_signature(batches[k], &len);
+
+        for (size_t j = 0; j < slh_batch_count(batches[k]); j++, i++) {
+            size_t msg_len = record(msg, i);
+            uint64_t t = metrics ? pqc_now_ns() : 0;
+
+            if (!slh_batch_verify(verifier, msg, msg_len, proofs + i * SLH_BATCH_PROOF_MAX,
+                                  proof_lens[i], sig, len)) {
+                printf("❌ Record %zu failed to verify\n", i);
+                goto cleanup;
+            }
+            if (metrics) pqc_hist_record(hist[3], pqc_now_ns() - t);
+        }
+    }
+    verify_ns = pqc_now_ns() - t0;
+    batch_verify_rate = n * 1e9 / verify_ns;
+    slh_batch_verifier_get_stats(verifier, &vst);
+
+    printf("  %-10s %11s %11s %12s\n", "path", "signed/s", "verified/s", "bytes/record");
+    printf("  %-10s %11.0f %11.0f %12zu\n", "per-record", sign_rate, verify_rate, sig_len);
+    printf("  %-10s %11.0f %11.0f %12.0f\n", "batch", batch_sign_rate, batch_verify_rate,
+           (proof_bytes + (double)nbatches * sig_len) / n);
+    printf("  speedup:  %.0fx signing, %.0fx verification\n",
+           batch_sign_rate / sign_rate, batch_verify_rate / verify_rate);
+    printf("  verifier: %zu batches, %llu root signatures checked, %llu cached roots reused\n",
+           nbatches, (unsigned long long)vst.root_verifications,
+           (unsigned long long)vst.cache_hits);
+
+    if (metrics) {
+        char impl[32];
+
+        /* sig is the bytes stored per record: the whole signature, or a proof plus a share of one */
+        EVP_PKEY_get_raw_public_key(pkey, NULL, &sizes.pk);
+        sizes.sig = sig_len;
+        pqc_metrics_emit(alg, "sign", "per-record", hist[0], 0, &sizes);
+        pqc_metrics_emit(alg, "verify", "per-record", hist[1], 0, &sizes);
+        snprintf(impl, sizeof(impl), "batch=%zu", batch);
+        sizes.sig = (size_t)((proof_bytes + (double)nbatches * sig_len) / n + 0.5);
+        pqc_metrics_emit(alg, "sign", impl, hist[2], sign_ns, &sizes);
+        pqc_metrics_emit(alg, "verify", impl, hist[3], verify_ns, &sizes);
+    }
+    printf("\n✨ Benchmark completed!\n");
+    ret = 0;
+    goto cleanup;
+
+sign_failed:
+    handle_openssl_error("batch signing failed");
+
+cleanup:
+    for (int i = 0; i < 4; i++) pqc_hist_free(hist[i]);
+    for (size_t k = 0; batches && k < nbatches; k++) slh_batch_free(batches[k]);
+    free(batches);
+    free(proofs);
+    free(proof_lens);
+    slh_batch_verifier_free(verifier);
+    slh_batch_signer_free(signer);
+    EVP_SIGNATURE_free(sig_alg);
+    EVP_PKEY_free(pkey);
+    return ret;
+}
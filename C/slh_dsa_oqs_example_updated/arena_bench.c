@@ -0,0 +1,234 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "oqs/oqs.h"
+
+#include "pqc_arena.h"
+#include "pqc_metrics.h"
+#include "pqc_timer.h"
+
+#define ITERATIONS 20000
+#define PAGE       4096
+
+/*
+ * Compares per-operation buffer management with malloc/free against a
+ * thread-local arena, for one signature scheme and one KEM. "buffers" only
+ * sets up and releases the buffers (touching each page once so first-touch
+ * faults are counted); "sign+verify" and "kem round" include the operation.
+ * The arena variant also zeroizes the secret key on every release.
+ */
+
+typedef struct {
+    const OQS_SIG *sig;
+    const OQS_KEM *kem;
+    const uint8_t *sig_pk, *sig_sk;     /* generated once, copied in per round */
+    int use_arena;
+    int with_op;
+} bench_ctx;
+
+static const uint8_t message[] = "arena benchmark message";
+
+static void touch(uint8_t *p, size_t len) {
+    for (size_t i = 0; i < len; i += PAGE) p[i] = (uint8_t)i;
+}
+
+static int sig_round(const bench_ctx *b) {
+    const OQS_SIG *sig = b->sig;
+    pqc_arena *arena = NULL;
+    uint8_t *pk, *sk, *s;
+    size_t s_len;
+    int ok = 1;
+
+    if (b->use_arena) {
+        arena = pqc_arena_thread(pqc_arena_size(sig->length_public_key) +
+                                 pqc_arena_size(sig->length_secret_key) +
+                                 pqc_arena_size(sig->length_signature));
+        pk = pqc_arena_alloc(arena, sig->length_public_key);
+        sk = pqc_arena_alloc_secret(arena, sig->length_secret_key);
+        s = pqc_arena_alloc(arena, sig->length_signature);
+    } else {
+        pk = malloc(sig->length_public_key);
+        sk = malloc(sig->length_secret_key);
+        s = malloc(sig->length_signature);
+    }
+    if (!pk || !sk || !s) return 0;
+
+    if (b->with_op) {
+        /* Keygen would dominate SLH-DSA; load the key as a server would */
+        memcpy(pk, b->sig_pk, sig->length_public_key);
+        memcpy(sk, b->sig_sk, sig->length_secret_key);
+        ok = OQS_SIG_sign(sig, s, &s_len, message, sizeof(message), sk) == OQS_SUCCESS
+          && OQS_SIG_verify(sig, message, sizeof(message), s, s_len, pk) == OQS_SUCCESS;
+    } else {
+        touch(pk, sig->length_public_key);
+        touch(sk, sig->length_secret_key);
+        touch(s, sig->length_signature);
+    }
+
+    if (arena) {
+        pqc_arena_reset(arena);
+    } else {
+        free(pk);
+        free(sk);
+        free(s);
+    }
+    return ok;
+}
+
+static int kem_round(const bench_ctx *b) {
+    const OQS_KEM *kem = b->kem;
+    pqc_arena *arena = NULL;
+    uint8_t *pk, *sk, *ct, *ss_e, *ss_d;
+    int ok = 1;
+
+    if (b->use_arena) {
+        arena = pqc_arena_thread(pqc_arena_size(kem->length_public_key) +
+                                 pqc_arena_size(kem->length_secret_key) +
+                                 pqc_arena_size(kem->length_ciphertext) +
+                                 2 * pqc_arena_size(kem->length_shared_secret));
+        pk = pqc_arena_alloc(arena, kem->length_public_key);
+        sk = pqc_arena_alloc_secret(arena, kem->length_secret_key);
+        ct = pqc_arena_alloc(arena, kem->length_ciphertext);
+        ss_e = pqc_arena_alloc_secret(arena, kem->length_shared_secret);
+        ss_d = pqc_arena_alloc_secret(arena, kem->length_shared_secret);
+    } else {
+        pk = malloc(kem->length_public_key);
+        sk = malloc(kem->length_secret_key);
+        ct = malloc(kem->length_ciphertext);
+        ss_e = malloc(kem->length_shared_secret);
+        ss_d = malloc(kem->length_shared_secret);
+    }
+    if (!pk || !sk || !ct || !ss_e || !ss_d) return 0;
+
+    if (b->with_op) {
+        ok = OQS_KEM_keypair(kem, pk, sk) == OQS_SUCCESS
+          && OQS_KEM_encaps(kem, ct, ss_e, pk) == OQS_SUCCESS
+          && OQS_KEM_decaps(kem, ss_d, ct, sk) == OQS_SUCCESS;
+    } else {
+        touch(pk, kem->length_public_key);
+        touch(sk, kem->length_secret_key);
+        touch(ct, kem->length_ciphertext);
+        touch(ss_e, kem->length_shared_secret);
+        touch(ss_d, kem->length_shared_secret);
+    }
+
+    if (arena) {
+        pqc_arena_reset(arena);
+    } else {
+        free(pk);
+        free(sk);
+        free(ct);
+        free(ss_e);
+        free(ss_d);
+    }
+    return ok;
+}
+
+static int run(const char *label, int (*round)(const bench_ctx *), bench_ctx *b,
+               size_t n, uint64_t *ns, uint64_t *cycles) {
+    static const char *const impls[] = { "malloc", "arena" };
+    pqc_stats st[2];
+    pqc_metrics_sizes sizes = { 0, 0, 0, 0, 0 };
+    const char *alg;
+
+    if (round == sig_round) {
+        alg = b->sig->method_name;
+        sizes = (pqc_metrics_sizes){ b->sig->length_public_key, b->sig->length_secret_key, 0, 0,
+                                     b->sig->length_signature };
+    } else {
+        alg = b->kem->method_name;
+        sizes = (pqc_metrics_sizes){ b->kem->length_public_key, b->kem->length_secret_key,
+                                     b->kem->length_ciphertext, b->kem->length_shared_secret, 0 };
+    }
+
+    for (int a = 0; a < 2; a++) {
+        uint64_t start = pqc_now_ns(), total;
+
+        b->use_arena = a;
+        for (size_t i = 0; i < n; i++) {
+            uint64_t t0 = pqc_now_ns(), c0 = pqc_cycles();
+            if (!round(b)) {
+                printf("❌ %s failed\n", label);
+                return 0;
+            }
+            cycles[i] = pqc_cycles() - c0;
+            ns[i] = pqc_now_ns() - t0;
+        }
+        total = pqc_now_ns() - start;
+        pqc_metrics_emit_samples(alg, label, impls[a], ns, n, total, &sizes);
+        pqc_stats_compute(&st[a], ns, cycles, n, total);
+    }
+
+    printf("  %-14s %12llu %12llu %12.1f %12.1f %8.2fx\n", label,
+           (unsigned long long)st[0].median_cycles, (unsigned long long)st[1].median_cycles,
+           st[0].p99_ns / 1e3, st[1].p99_ns / 1e3,
+           (double)st[0].median_cycles / (double)(st[1].median_cycles ? st[1].median_cycles : 1));
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    const char *sig_name = argc > 1 ? argv[1] : "SPHINCS+-SHA2-128f-simple";
+    const char *kem_name = argc > 2 ? argv[2] : "ML-KEM-768";
+    size_t n = argc > 3 ? strtoul(argv[3], NULL, 10) : ITERATIONS;
+    uint64_t *ns = NULL, *cycles = NULL;
+    uint8_t *sig_pk = NULL, *sig_sk = NULL;
+    bench_ctx b = { 0 };
+    int ret = 1;
+
+    pqc_metrics_init("arena_bench");
+    printf("🎯 Arena vs malloc Benchmark\n");
+    printf("============================\n");
+
+    if (n == 0) n = 1;
+    if (!OQS_SIG_alg_is_enabled(sig_name) || !OQS_KEM_alg_is_enabled(kem_name)) {
+        printf("❌ %s or %s is not enabled in this build\n", sig_name, kem_name);
+        return 1;
+    }
+
+    OQS_SIG *sig = OQS_SIG_new(sig_name);
+    OQS_KEM *kem = OQS_KEM_new(kem_name);
+    ns = malloc(n * sizeof(*ns));
+    cycles = malloc(n * sizeof(*cycles));
+    if (sig) {
+        sig_pk = malloc(sig->length_public_key);
+        sig_sk = malloc(sig->length_secret_key);
+    }
+    if (!sig || !kem || !ns || !cycles || !sig_pk || !sig_sk
+        || OQS_SIG_keypair(sig, sig_pk, sig_sk) != OQS_SUCCESS) {
+        printf("❌ Initialisation failed\n");
+        goto cleanup;
+    }
+    b.sig = sig;
+    b.kem = kem;
+    b.sig_pk = sig_pk;
+    b.sig_sk = sig_sk;
+
+    printf("Signature: %s (%zu byte signatures)\n", sig_name, sig->length_signature);
+    printf("KEM: %s\n", kem_name);
+    printf("Iterations: %zu (signing rounds: %zu)\n\n", n, n / 100 ? n / 100 : 1);
+
+    printf("  %-14s %12s %12s %12s %12s %9s\n", "", "malloc cyc", "arena cyc",
+           "malloc p99us", "arena p99us", "speedup");
+
+    b.with_op = 0;
+    if (!run("sig buffers", sig_round, &b, n, ns, cycles)) goto cleanup;
+    if (!run("kem buffers", kem_round, &b, n, ns, cycles)) goto cleanup;
+
+    b.with_op = 1;
+    if (!run("sign+verify", sig_round, &b, n / 100 ? n / 100 : 1, ns, cycles)) goto cleanup;
+    if (!run("kem round", kem_round, &b, n, ns, cycles)) goto cleanup;
+
+    printf("\n✨ Benchmark completed!\n");
+    ret = 0;
+
+cleanup:
+    if (sig_sk) OQS_MEM_secure_free(sig_sk, sig->length_secret_key);
+    free(sig_pk);
+    OQS_SIG_free(sig);
+    OQS_KEM_free(kem);
+    free(ns);
+    free(cycles);
+    return ret;
+}
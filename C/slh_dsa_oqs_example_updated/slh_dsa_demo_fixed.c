@@ -1,8 +1,16 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include "oqs/oqs.h"
 
+#include "pqc_arena.h"
+#include "pqc_metrics.h"
+#include "pqc_oqs_registry.h"
+#include "pqc_timer.h"
+#include "pqc_verify_cache.h"
+
 void print_hex(const char* label, const uint8_t* data, size_t len) {
     printf("%s (%zu bytes): ", label, len);
     for (size_t i = 0; i < len && i < 32; i++) {
@@ -12,37 +20,54 @@ void print_hex(const char* label, const uint8_t* data, size_t len) {
     printf("\n");
 }
 
+/* One metrics record per operation with PQC_METRICS=json|csv (pqc_metrics.h) */
+static void emit(const OQS_SIG* sig, const char* op, uint64_t ns, size_t sig_len) {
+    pqc_metrics_sizes sizes = { sig->length_public_key, sig->length_secret_key, 0, 0, sig_len };
+    pqc_metrics_emit_samples(sig->method_name, op, "liboqs", &ns, 1, 0, &sizes);
+}
+
 void list_available_signatures() {
     printf("📋 Available Signature Algorithms:\n");
     printf("==================================\n");
     
-    int count = 0;
+    size_t count = pqc_oqs_sig_count();
     int enabled_count = 0;
     
-    for (int i = 0; i < OQS_SIG_alg_count(); i++) {
-        const char* alg_name = OQS_SIG_alg_identifier(i);
-        int enabled = OQS_SIG_alg_is_enabled(alg_name);
-        printf("  %2d. %s - %s\n", ++count, alg_name, enabled ? "✅ ENABLED" : "❌ DISABLED");
+    for (size_t i = 0; i < count; i++) {
+        const pqc_oqs_sig_info* info = pqc_oqs_sig_at(i);
+        printf("  %2zu. %s - %s\n", i + 1, pqc_oqs_sig_name(i), info ? "✅ ENABLED" : "❌ DISABLED");
         
-        if (enabled) {
+        if (info) {
             enabled_count++;
-            OQS_SIG* sig = OQS_SIG_new(alg_name);
-            if (sig) {
-                printf("      Public: %4zu bytes, Secret: %4zu bytes, Signature: %4zu bytes\n", 
-                       sig->length_public_key, sig->length_secret_key, sig->length_signature);
-                OQS_SIG_free(sig);
-            }
+            printf("      Public: %4zu bytes, Secret: %4zu bytes, Signature: %4zu bytes\n", 
+                   info->length_public_key, info->length_secret_key, info->length_signature);
         }
     }
     
-    printf("\n✅ %d of %d signature algorithms enabled\n", enabled_count, count);
+    printf("\n✅ %d of %zu signature algorithms enabled\n", enabled_count, count);
+}
+
+// OQS_SIG_verify, skipped when the same tuple has verified before
+int verify_cached(pqc_verify_cache* cache, const OQS_SIG* sig, const uint8_t* message, size_t message_len,
+                  const uint8_t* signature, size_t signature_len, const uint8_t* public_key) {
+    uint8_t key[PQC_VERIFY_KEY_LEN];
+    
+    if (!pqc_verify_cache_key(cache, key, sig->method_name, public_key, sig->length_public_key,
+                              message, message_len, signature, signature_len)) {
+        return 0;
+    }
+    if (pqc_verify_cache_lookup(cache, key)) {
+        return 1;
+    }
+    return OQS_SIG_verify(sig, message, message_len, signature, signature_len, public_key) == OQS_SUCCESS
+        && pqc_verify_cache_insert(cache, key);
 }
 
 void demonstrate_signature(const char* sig_name) {
     printf("\n🔐 Testing %s\n", sig_name);
     printf("================\n");
     
-    if (!OQS_SIG_alg_is_enabled(sig_name)) {
+    if (!pqc_oqs_sig_find(sig_name)) {
         printf("❌ %s is not enabled in this build\n", sig_name);
         return;
     }
@@ -58,11 +83,15 @@ void demonstrate_signature(const char* sig_name) {
     printf("   Secret key: %zu bytes\n", sig->length_secret_key);
     printf("   Signature: %zu bytes\n", sig->length_signature);
     
-    // Allocate memory
-    uint8_t* public_key = malloc(sig->length_public_key);
-    uint8_t* secret_key = malloc(sig->length_secret_key);
-    uint8_t* signature = malloc(sig->length_signature);
-    size_t signature_len;
+    // Carve all buffers out of this thread's arena
+    pqc_arena* arena = pqc_arena_thread(pqc_arena_size(sig->length_public_key) +
+                                        pqc_arena_size(sig->length_secret_key) +
+                                        pqc_arena_size(sig->length_signature));
+    uint8_t* public_key = pqc_arena_alloc(arena, sig->length_public_key);
+    uint8_t* secret_key = pqc_arena_alloc_secret(arena, sig->length_secret_key);
+    uint8_t* signature = pqc_arena_alloc(arena, sig->length_signature);
+    size_t signature_len = 0;
+    uint64_t t0;
     
     if (!public_key || !secret_key || !signature) {
         printf("❌ Memory allocation failed\n");
@@ -71,10 +100,12 @@ void demonstrate_signature(const char* sig_name) {
     
     // Step 1: Key generation
     printf("1. 🔑 Generating key pair...\n");
+    t0 = pqc_now_ns();
     if (OQS_SIG_keypair(sig, public_key, secret_key) != OQS_SUCCESS) {
         printf("❌ Key generation failed\n");
         goto cleanup;
     }
+    emit(sig, "keygen", pqc_now_ns() - t0, 0);
     printf("✅ Key pair generated\n");
     
     // Step 2: Create messages to sign
@@ -87,23 +118,43 @@ void demonstrate_signature(const char* sig_name) {
     
     // Step 3: Sign the first message
     printf("3. ✍️  Signing message 1...\n");
+    t0 = pqc_now_ns();
     if (OQS_SIG_sign(sig, signature, &signature_len, 
                     (const uint8_t*)message1, message1_len, secret_key) != OQS_SUCCESS) {
         printf("❌ Signing failed\n");
         goto cleanup;
     }
+    emit(sig, "sign", pqc_now_ns() - t0, signature_len);
     printf("✅ Message 1 signed\n");
     print_hex("   Signature", signature, signature_len);
     
     // Step 4: Verify the first signature
     printf("4. ✅ Verifying signature 1...\n");
+    t0 = pqc_now_ns();
     if (OQS_SIG_verify(sig, (const uint8_t*)message1, message1_len, 
                       signature, signature_len, public_key) != OQS_SUCCESS) {
         printf("❌ Signature verification failed\n");
         goto cleanup;
     }
+    emit(sig, "verify", pqc_now_ns() - t0, signature_len);
     printf("✅ Signature 1 verified successfully!\n");
     
+    // Step 4b: Verify it again, as a service re-checking the same chain would
+    printf("   ♻️  Re-verifying signature 1 through the verification cache...\n");
+    pqc_verify_cache* cache = pqc_verify_cache_new(64, 1, 60000);
+    if (!cache
+        || !verify_cached(cache, sig, (const uint8_t*)message1, message1_len, signature, signature_len, public_key)
+        || !verify_cached(cache, sig, (const uint8_t*)message1, message1_len, signature, signature_len, public_key)) {
+        printf("❌ Cached verification failed\n");
+        pqc_verify_cache_free(cache);
+        goto cleanup;
+    }
+    pqc_verify_cache_stats stats;
+    pqc_verify_cache_get_stats(cache, &stats);
+    printf("✅ Verified twice: %llu full verification, %llu cache hit\n",
+           (unsigned long long)stats.misses, (unsigned long long)stats.hits);
+    pqc_verify_cache_free(cache);
+    
     // Step 5: Sign and verify a second message
     printf("5. 📄 Message 2: \"%s\" (%zu bytes)\n", message2, message2_len);
     printf("   ✍️  Signing message 2...\n");
@@ -150,17 +201,21 @@ void demonstrate_signature(const char* sig_name) {
     
 cleanup:
     OQS_SIG_free(sig);
-    if (public_key) free(public_key);
-    if (secret_key) free(secret_key);
-    if (signature) free(signature);
+    pqc_arena_reset(arena);  // wipes the secret key
 }
 
 int main(int argc, char* argv[]) {
     printf("🎯 Post-Quantum Signature Demonstration\n");
     printf("======================================\n");
+    pqc_metrics_init("slh_dsa_demo_fixed");
     
-    // List all available signature algorithms
-    list_available_signatures();
+    // The full list creates every algorithm once to read its sizes; only on request
+    if (argc > 1 && strcmp(argv[1], "--list") == 0) {
+        list_available_signatures();
+        return 0;
+    }
+    printf("📋 %zu signature algorithms in this liboqs build (--list shows their sizes)\n",
+           pqc_oqs_sig_count());
     
     // Determine which algorithm to use
     const char* algorithm_to_use = NULL;
@@ -186,14 +241,14 @@ int main(int argc, char* argv[]) {
         algorithm_to_use = "ML-DSA-44";
     }
     
-    if (algorithm_to_use && OQS_SIG_alg_is_enabled(algorithm_to_use)) {
+    if (algorithm_to_use && pqc_oqs_sig_find(algorithm_to_use)) {
         printf("\n🎯 Using algorithm: %s\n", algorithm_to_use);
         demonstrate_signature(algorithm_to_use);
     } else {
         printf("\n❌ Algorithm '%s' not found or not enabled!\n", algorithm_to_use);
         printf("💡 Try one of these available algorithms:\n");
         for (int i = 0; available_algorithms[i] != NULL; i++) {
-            if (OQS_SIG_alg_is_enabled(available_algorithms[i])) {
+            if (pqc_oqs_sig_find(available_algorithms[i])) {
                 printf("   ./slh_dsa_demo_fixed %s\n", available_algorithms[i]);
             }
         }
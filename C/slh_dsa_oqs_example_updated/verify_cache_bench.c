@@ -0,0 +1,250 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "oqs/oqs.h"
+
+#include "pqc_metrics.h"
+#include "pqc_verify_cache.h"
+#include "pqc_timer.h"
+
+#define PUBLISHERS 4
+#define MANIFESTS  8            /* per publisher */
+#define TUPLES     (PUBLISHERS * MANIFESTS)
+
+/*
+ * A package mirror re-verifying the same signed manifests: TUPLES
+ * (public key, manifest, signature) tuples from PUBLISHERS keys, verified in
+ * a pseudo-random order by several threads at once. Each path runs the same
+ * stream:
+ *
+ *   uncached  OQS_SIG_verify() every time
+ *   cached    a pqc_verify_cache holding every tuple
+ *   small     a cache with room for half the tuples (LRU evictions)
+ *   ttl       a cache whose entries expire after TTL_MS
+ */
+
+#define TTL_MS 20
+
+typedef struct {
+    uint8_t *pk;
+    uint8_t msg[64];
+    size_t msg_len;
+    uint8_t *sig;
+    size_t sig_len;
+} tuple;
+
+typedef struct {
+    const OQS_SIG *sig;
+    const tuple *tuples;
+    pqc_verify_cache *cache;    /* NULL: uncached */
+    uint64_t *ns;               /* one latency per verification */
+    size_t n;
+    unsigned nthreads;
+    int failed;
+} run_ctx;
+
+typedef struct {
+    run_ctx *r;
+    unsigned id;
+} worker_arg;
+
+static int verify(const run_ctx *r, const tuple *t) {
+    uint8_t key[PQC_VERIFY_KEY_LEN];
+
+    if (!r->cache)
+        return OQS_SIG_verify(r->sig, t->msg, t->msg_len, t->sig, t->sig_len, t->pk) == OQS_SUCCESS;
+    if (!pqc_verify_cache_key(r->cache, key, r->sig->method_name, t->pk, r->sig->length_public_key,
+                              t->msg, t->msg_len, t->sig, t->sig_len))
+        return 0;
+    return pqc_verify_cache_lookup(r->cache, key)
+        || (OQS_SIG_verify(r->sig, t->msg, t->msg_len, t->sig, t->sig_len, t->pk) == OQS_SUCCESS
+            && pqc_verify_cache_insert(r->cache, key));
+}
+
+static void *worker(void *arg) {
+    worker_arg *w = arg;
+    run_ctx *r = w->r;
+    uint32_t x = 2463534242u + w->id;
+
+    /* Thread i takes verifications i, i + nthreads, ... */
+    for (size_t i = w->id; i < r->n; i += r->nthreads) {
+        uint64_t t0;
+
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        t0 = pqc_now_ns();
+        if (!verify(r, &r->tuples[x % TUPLES])) {
+            __atomic_store_n(&r->failed, 1, __ATOMIC_RELAXED);
+            break;
+        }
+        r->ns[i] = pqc_now_ns() - t0;
+    }
+    return NULL;
+}
+
+/* The caller is one of the threads */
+static int run(run_ctx *r, uint64_t *total) {
+    pthread_t threads[64];
+    worker_arg args[64];
+    unsigned started = 0;
+    uint64_t start = pqc_now_ns();
+
+    r->failed = 0;
+    for (unsigned i = 0; i < r->nthreads; i++) args[i] = (worker_arg){ r, i };
+    for (unsigned i = 1; i < r->nthreads; i++) {
+        if (pthread_create(&threads[started], NULL, worker, &args[i]) != 0) {
+            r->failed = 1;
+            break;
+        }
+        started++;
+    }
+    worker(&args[0]);
+    for (unsigned i = 0; i < started; i++) pthread_join(threads[i], NULL);
+    *total = pqc_now_ns() - start;
+    return !r->failed;
+}
+
+static uint64_t report(const char *name, run_ctx *r, uint64_t total, uint64_t base_p50) {
+    pqc_stats st;
+    pqc_verify_cache_stats cs;
+    pqc_metrics_sizes sizes = { r->sig->length_public_key, 0, 0, 0, r->sig->length_signature };
+
+    pqc_metrics_emit_samples(r->sig->method_name, "verify", name, r->ns, r->n, total, &sizes);
+    pqc_stats_compute(&st, r->ns, NULL, r->n, total);
+    printf("  %-10s %9.1f %9.1f %10.0f %8.2fx", name, st.median_ns / 1e3, st.p99_ns / 1e3,
+           st.ops_per_sec, base_p50 ? base_p50 / (double)st.median_ns : 1.0);
+    if (r->cache) {
+        pqc_verify_cache_get_stats(r->cache, &cs);
+        printf("  %5.1f%% hits, %llu evicted, %llu expired", 100.0 * cs.hits / (cs.hits + cs.misses),
+               (unsigned long long)cs.evictions, (unsigned long long)cs.expirations);
+    }
+    printf("\n");
+    return st.median_ns;
+}
+
+/* A cached tuple must not vouch for a different signature or message */
+static int check(const OQS_SIG *sig, const tuple *t) {
+    pqc_verify_cache *cache = pqc_verify_cache_new(16, 1, 0);
+    run_ctx r = { sig, NULL, cache, NULL, 0, 1, 0 };
+    uint8_t *bad_sig = malloc(t->sig_len);
+    tuple bad = *t;
+    int ok = cache && bad_sig;
+
+    if (ok) {
+        memcpy(bad_sig, t->sig, t->sig_len);
+        bad_sig[t->sig_len / 2] ^= 1;
+        bad.sig = bad_sig;
+        ok = verify(&r, t) && verify(&r, t) && !verify(&r, &bad);
+
+        bad = *t;
+        bad.msg[0] ^= 1;
+        ok = ok && !verify(&r, &bad);
+    }
+    free(bad_sig);
+    pqc_verify_cache_free(cache);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    const char *alg = argc > 1 ? argv[1] : "SPHINCS+-SHA2-128f-simple";
+    size_t n = argc > 2 ? strtoul(argv[2], NULL, 10) : 2000;
+    unsigned nthreads = argc > 3 ? (unsigned)strtoul(argv[3], NULL, 10) : 0;
+    OQS_SIG *sig = NULL;
+    tuple tuples[TUPLES] = { 0 };
+    uint8_t *pks = NULL, *sks = NULL, *sigs = NULL;
+    uint64_t *ns = NULL, total, base;
+    struct { const char *name; size_t capacity; uint64_t ttl_ms; } caches[] = {
+        { "cached", 4 * TUPLES, 0 }, { "small", TUPLES / 2, 0 }, { "ttl", 4 * TUPLES, TTL_MS },
+    };
+    run_ctx r;
+    int ret = 1;
+
+    pqc_metrics_init("verify_cache_bench");
+    printf("🎯 Signature Verification Cache Benchmark\n");
+    printf("=========================================\n");
+
+    if (n == 0) n = 1;
+    if (nthreads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = cpus > 0 ? (unsigned)cpus : 1;
+    }
+    if (nthreads > 64) nthreads = 64;
+    if (!OQS_SIG_alg_is_enabled(alg) || !(sig = OQS_SIG_new(alg))) {
+        printf("❌ %s is not enabled in liboqs\n", alg);
+        return 1;
+    }
+
+    pks = malloc(PUBLISHERS * sig->length_public_key);
+    sks = malloc(PUBLISHERS * sig->length_secret_key);
+    sigs = malloc(TUPLES * sig->length_signature);
+    ns = malloc(n * sizeof(*ns));
+    if (!pks || !sks || !sigs || !ns) {
+        printf("❌ Memory allocation failed\n");
+        goto cleanup;
+    }
+
+    for (size_t p = 0; p < PUBLISHERS; p++) {
+        uint8_t *pk = pks + p * sig->length_public_key, *sk = sks + p * sig->length_secret_key;
+
+        if (OQS_SIG_keypair(sig, pk, sk) != OQS_SUCCESS) {
+            printf("❌ Key generation failed\n");
+            goto cleanup;
+        }
+        for (size_t m = 0; m < MANIFESTS; m++) {
+            tuple *t = &tuples[p * MANIFESTS + m];
+
+            t->pk = pk;
+            t->sig = sigs + (p * MANIFESTS + m) * sig->length_signature;
+            t->msg_len = (size_t)snprintf((char *)t->msg, sizeof(t->msg),
+                                          "manifest publisher=%zu package=%zu sha256=...", p, m);
+            if (OQS_SIG_sign(sig, t->sig, &t->sig_len, t->msg, t->msg_len, sk) != OQS_SUCCESS) {
+                printf("❌ Signing failed\n");
+                goto cleanup;
+            }
+        }
+    }
+    if (!check(sig, &tuples[0])) {
+        printf("❌ The cache accepted a modified signature or message\n");
+        goto cleanup;
+    }
+    printf("✅ Modified signatures and messages rejected after a cache hit\n\n");
+
+    printf("Algorithm: %s, %d tuples, %zu verifications on %u threads\n\n", alg, TUPLES, n, nthreads);
+    printf("  %-10s %9s %9s %10s %9s\n", "path", "p50 us", "p99 us", "verifies/s", "speedup");
+
+    r = (run_ctx){ sig, tuples, NULL, ns, n, nthreads, 0 };
+    if (!run(&r, &total)) goto verify_failed;
+    base = report("uncached", &r, total, 0);
+
+    for (size_t i = 0; i < sizeof(caches) / sizeof(caches[0]); i++) {
+        int ok;
+
+        if (!(r.cache = pqc_verify_cache_new(caches[i].capacity, 0, caches[i].ttl_ms))) {
+            printf("❌ Cache setup failed\n");
+            goto cleanup;
+        }
+        ok = run(&r, &total);
+        if (ok) report(caches[i].name, &r, total, base);
+        pqc_verify_cache_free(r.cache);
+        if (!ok) goto verify_failed;
+    }
+    printf("\n✨ Benchmark completed!\n");
+    ret = 0;
+    goto cleanup;
+
+verify_failed:
+    printf("❌ A valid signature failed to verify\n");
+
+cleanup:
+    if (sks) OQS_MEM_secure_free(sks, PUBLISHERS * sig->length_secret_key);
+    free(pks);
+    free(sigs);
+    free(ns);
+    OQS_SIG_free(sig);
+    return ret;
+}
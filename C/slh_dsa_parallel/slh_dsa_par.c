@@ -0,0 +1,885 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include <openssl/evp.h>
+#include <openssl/err.h>
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#include <openssl/rand.h>
+#include <openssl/crypto.h>
+
+#include "slh_dsa_par.h"
+#include "slh_hashx.h"
+
+#define MAX_N        32
+#define MAX_HEIGHT   14             /* largest FORS or XMSS tree height */
+#define MAX_WOTS_LEN (2 * MAX_N + 3)
+#define MAX_DIGEST   64
+#define W            16             /* Winternitz parameter, lg_w = 4 */
+
+/* Subtree tasks per thread; keeps threads busy while the last tasks finish */
+#define TASKS_PER_THREAD 8
+
+/* ADRS types (FIPS 205, section 4.2) */
+enum {
+    WOTS_HASH = 0, WOTS_PK = 1, TREE = 2, FORS_TREE = 3,
+    FORS_ROOTS = 4, WOTS_PRF = 5, FORS_PRF = 6
+};
+
+static const slh_params param_sets[] = {
+    { "SLH-DSA-SHA2-128s",  16, 63,  7, 9, 12, 14, 30, 1 },
+    { "SLH-DSA-SHA2-128f",  16, 66, 22, 3,  6, 33, 34, 1 },
+    { "SLH-DSA-SHA2-192s",  24, 63,  7, 9, 14, 17, 39, 1 },
+    { "SLH-DSA-SHA2-192f",  24, 66, 22, 3,  8, 33, 42, 1 },
+    { "SLH-DSA-SHA2-256s",  32, 64,  8, 8, 14, 22, 47, 1 },
+    { "SLH-DSA-SHA2-256f",  32, 68, 17, 4,  9, 35, 49, 1 },
+    { "SLH-DSA-SHAKE-128s", 16, 63,  7, 9, 12, 14, 30, 0 },
+    { "SLH-DSA-SHAKE-128f", 16, 66, 22, 3,  6, 33, 34, 0 },
+    { "SLH-DSA-SHAKE-192s", 24, 63,  7, 9, 14, 17, 39, 0 },
+    { "SLH-DSA-SHAKE-192f", 24, 66, 22, 3,  8, 33, 42, 0 },
+    { "SLH-DSA-SHAKE-256s", 32, 64,  8, 8, 14, 22, 47, 0 },
+    { "SLH-DSA-SHAKE-256f", 32, 68, 17, 4,  9, 35, 49, 0 },
+};
+
+const slh_params *slh_par_params(const char *name) {
+    for (size_t i = 0; i < sizeof(param_sets) / sizeof(param_sets[0]); i++) {
+        if (strcasecmp(name, param_sets[i].name) == 0) return &param_sets[i];
+    }
+    return NULL;
+}
+
+/* ---- Addresses ---- */
+
+static void put_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static void adrs_set_layer(uint8_t *a, uint32_t layer) {
+    put_u32(a, layer);
+}
+
+static void adrs_set_tree(uint8_t *a, uint64_t tree) {
+    memset(a + 4, 0, 4);
+    put_u32(a + 8, (uint32_t)(tree >> 32));
+    put_u32(a + 12, (uint32_t)tree);
+}
+
+static void adrs_set_type_and_clear(uint8_t *a, uint32_t type) {
+    put_u32(a + 16, type);
+    memset(a + 20, 0, 12);
+}
+
+static void adrs_set_keypair(uint8_t *a, uint32_t keypair) {
+    put_u32(a + 20, keypair);
+}
+
+/* Chain address and tree height share a field, as do hash address and tree index */
+static void adrs_set_chain(uint8_t *a, uint32_t v) {
+    put_u32(a + 24, v);
+}
+
+static void adrs_set_hash(uint8_t *a, uint32_t v) {
+    put_u32(a + 28, v);
+}
+
+#define adrs_set_tree_height adrs_set_chain
+#define adrs_set_tree_index  adrs_set_hash
+
+/* ---- Tweakable hashes (FIPS 205, sections 11.1 and 11.2) ---- */
+
+typedef struct {
+    const slh_params *p;
+    const uint8_t *sk_seed;
+    EVP_MD_CTX *seeded_f;       /* PK.seed (and padding) absorbed: F and PRF */
+    EVP_MD_CTX *seeded_h;       /* same for H and T_l; SHA-512 for SHA2 n > 16 */
+    EVP_MD_CTX *work;
+    const slh_hashx *x;         /* multi-buffer F and PRF; NULL: one EVP call each */
+    uint8_t pk_seed[MAX_N];
+    uint32_t mid256[8];         /* SHA-256 state after PK.seed || zeros */
+    int ok;
+} hasher;
+
+static void hasher_free(hasher *hs) {
+    EVP_MD_CTX_free(hs->seeded_f);
+    if (hs->seeded_h != hs->seeded_f) EVP_MD_CTX_free(hs->seeded_h);
+    EVP_MD_CTX_free(hs->work);
+    memset(hs, 0, sizeof(*hs));
+}
+
+/* ---- Backend selection ---- */
+
+/*
+ * NULL means automatic: the fastest SIMD backend for SHAKE. For SHA2 it
+ * depends on the CPU: with the SHA extensions OpenSSL's one-at-a-time
+ * SHA-256 beats 8-way AVX2 (SHA2-128f signing 82 vs 68 sig/s on one Xeon
+ * core), without them 8-way AVX2 wins by 1.75x. The scalar backend never
+ * beats OpenSSL.
+ */
+static const slh_hashx evp_marker = { "evp", NULL, NULL };
+static const slh_hashx *selected;
+static const slh_hashx *best;
+static const slh_hashx *best_sha2;
+static pthread_once_t best_once = PTHREAD_ONCE_INIT;
+
+static int cpu_has_sha_ext(void) {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sha");
+#else
+    return 1;                   /* no SIMD backend here: OpenSSL either way */
+#endif
+}
+
+static void pick_best(void) {
+    best = slh_hashx_get(NULL);
+    best_sha2 = cpu_has_sha_ext() || best == slh_hashx_get("scalar") ? &evp_marker : best;
+}
+
+static const slh_hashx *backend_for(const slh_params *p) {
+    const slh_hashx *x = __atomic_load_n(&selected, __ATOMIC_ACQUIRE);
+
+    if (!x) {
+        pthread_once(&best_once, pick_best);
+        x = p->sha2 ? best_sha2 : best;
+    }
+    return x == &evp_marker ? NULL : x;
+}
+
+int slh_par_set_backend(const char *name) {
+    const slh_hashx *x = NULL;
+
+    if (name && strcasecmp(name, "evp") == 0) {
+        x = &evp_marker;
+    } else if (name && !(x = slh_hashx_get(name))) {
+        return 0;
+    }
+    __atomic_store_n(&selected, x, __ATOMIC_RELEASE);
+    return 1;
+}
+
+const char *slh_par_backend(const slh_params *p) {
+    const slh_hashx *x = backend_for(p);
+    return x ? x->name : "evp";
+}
+
+static EVP_MD_CTX *seeded_ctx(const char *md_name, const uint8_t *pk_seed, size_t n,
+                              size_t block) {
+    static const uint8_t zeros[128] = { 0 };
+    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+    EVP_MD *md = EVP_MD_fetch(NULL, md_name, NULL);
+    int ok = ctx && md
+        && EVP_DigestInit_ex(ctx, md, NULL) > 0
+        && EVP_DigestUpdate(ctx, pk_seed, n) > 0
+        && (block == 0 || EVP_DigestUpdate(ctx, zeros, block - n) > 0);
+
+    EVP_MD_free(md);
+    if (!ok) {
+        EVP_MD_CTX_free(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+static int hasher_init(hasher *hs, const slh_params *p, const uint8_t *pk_seed,
+                       const uint8_t *sk_seed) {
+    memset(hs, 0, sizeof(*hs));
+    hs->p = p;
+    hs->sk_seed = sk_seed;
+    hs->work = EVP_MD_CTX_new();
+    hs->x = backend_for(p);
+    memcpy(hs->pk_seed, pk_seed, p->n);
+
+    if (!p->sha2) {
+        hs->seeded_f = hs->seeded_h = seeded_ctx("SHAKE256", pk_seed, p->n, 0);
+    } else {
+        /* PK.seed is padded to a full block so the seeded state can be reused */
+        hs->seeded_f = seeded_ctx("SHA256", pk_seed, p->n, 64);
+        hs->seeded_h = p->n == 16 ? hs->seeded_f : seeded_ctx("SHA512", pk_seed, p->n, 128);
+
+        uint8_t block[64] = { 0 };
+        memcpy(block, pk_seed, p->n);
+        slh_sha256_midstate(hs->mid256, block);
+    }
+
+    hs->ok = hs->work && hs->seeded_f && hs->seeded_h;
+    if (!hs->ok) hasher_free(hs);
+    return hs->ok;
+}
+
+/* Compressed 22-byte ADRS used by the SHA2 instantiations */
+static void compress_adrs(const uint8_t *adrs, uint8_t *adrsc) {
+    adrsc[0] = adrs[3];
+    memcpy(adrsc + 1, adrs + 8, 8);
+    adrsc[9] = adrs[19];
+    memcpy(adrsc + 10, adrs + 20, 12);
+}
+
+/* out = Tweak(PK.seed, ADRS, in1 || in2), n bytes; big selects H/T_l over F/PRF */
+static void thash(hasher *hs, int big, const uint8_t *adrs,
+                  const uint8_t *in1, size_t len1, const uint8_t *in2, size_t len2,
+                  uint8_t *out) {
+    const slh_params *p = hs->p;
+    uint8_t digest[MAX_DIGEST];
+    int ok;
+
+    if (!hs->ok) return;
+
+    ok = EVP_MD_CTX_copy_ex(hs->work, big ? hs->seeded_h : hs->seeded_f) > 0;
+    if (p->sha2) {
+        uint8_t adrsc[22];
+        compress_adrs(adrs, adrsc);
+        ok = ok && EVP_DigestUpdate(hs->work, adrsc, sizeof(adrsc)) > 0;
+    } else {
+        ok = ok && EVP_DigestUpdate(hs->work, adrs, 32) > 0;
+    }
+    ok = ok && EVP_DigestUpdate(hs->work, in1, len1) > 0;
+    if (len2) ok = ok && EVP_DigestUpdate(hs->work, in2, len2) > 0;
+
+    if (p->sha2) {
+        ok = ok && EVP_DigestFinal_ex(hs->work, digest, NULL) > 0;
+        memcpy(out, digest, p->n);
+    } else {
+        ok = ok && EVP_DigestFinalXOF(hs->work, out, p->n) > 0;
+    }
+    hs->ok = ok;
+}
+
+static void hash_f(hasher *hs, const uint8_t *adrs, const uint8_t *in, uint8_t *out) {
+    thash(hs, 0, adrs, in, hs->p->n, NULL, 0, out);
+}
+
+static void hash_h(hasher *hs, const uint8_t *adrs, const uint8_t *left,
+                   const uint8_t *right, uint8_t *out) {
+    thash(hs, 1, adrs, left, hs->p->n, right, hs->p->n, out);
+}
+
+static void hash_t(hasher *hs, const uint8_t *adrs, const uint8_t *in, size_t len,
+                   uint8_t *out) {
+    thash(hs, 1, adrs, in, len, NULL, 0, out);
+}
+
+static void prf(hasher *hs, const uint8_t *adrs, uint8_t *out) {
+    thash(hs, 0, adrs, hs->sk_seed, hs->p->n, NULL, 0, out);
+}
+
+/*
+ * out[i] = F(PK.seed, adrs[i], in[i]) for i < count, evaluated
+ * SLH_HASHX_LANES at a time by the multi-buffer backend. PRF is F over
+ * SK.seed. out[i] may alias in[i].
+ */
+static void hash_f_many(hasher *hs, uint8_t (*adrs)[32], const uint8_t *const *in,
+                        uint8_t *const *out, unsigned count) {
+    const size_t n = hs->p->n;
+
+    if (!hs->ok) return;
+    if (!hs->x) {
+        for (unsigned i = 0; i < count; i++) hash_f(hs, adrs[i], in[i], out[i]);
+        return;
+    }
+
+    for (unsigned base = 0; base < count; base += SLH_HASHX_LANES) {
+        uint8_t buf[SLH_HASHX_LANES][2 * MAX_N + 32], digest[SLH_HASHX_LANES][32];
+        const uint8_t *lanes_in[SLH_HASHX_LANES];
+        uint8_t *lanes_out[SLH_HASHX_LANES];
+        unsigned lanes = count - base < SLH_HASHX_LANES ? count - base : SLH_HASHX_LANES;
+
+        for (unsigned i = 0; i < lanes; i++) {
+            lanes_in[i] = buf[i];
+            if (hs->p->sha2) {
+                /* PK.seed block is in the midstate: ADRSc || in */
+                compress_adrs(adrs[base + i], buf[i]);
+                memcpy(buf[i] + 22, in[base + i], n);
+                lanes_out[i] = digest[i];
+            } else {
+                memcpy(buf[i], hs->pk_seed, n);
+                memcpy(buf[i] + n, adrs[base + i], 32);
+                memcpy(buf[i] + n + 32, in[base + i], n);
+                lanes_out[i] = out[base + i];
+            }
+        }
+        if (hs->p->sha2) {
+            hs->x->sha256(lanes_out, hs->mid256, 64, lanes_in, 22 + n, lanes);
+            for (unsigned i = 0; i < lanes; i++) memcpy(out[base + i], digest[i], n);
+        } else {
+            hs->x->shake256(lanes_out, n, lanes_in, 2 * n + 32, lanes);
+        }
+    }
+}
+
+/* ---- WOTS+ (FIPS 205, section 5) ---- */
+
+/*
+ * adrs: WOTS_HASH address with layer, tree and keypair set. All chains
+ * advance in lockstep so that each step is one multi-buffer call.
+ */
+static void wots_chain_all(hasher *hs, uint8_t *adrs, const uint8_t *lengths,
+                           uint8_t *out) {
+    const size_t n = hs->p->n, len = slh_par_wots_len(hs->p);
+    uint8_t step_adrs[MAX_WOTS_LEN][32];
+    const uint8_t *in[MAX_WOTS_LEN];
+    uint8_t *dst[MAX_WOTS_LEN];
+
+    for (size_t i = 0; i < len; i++) {
+        memcpy(step_adrs[i], adrs, 32);
+        adrs_set_type_and_clear(step_adrs[i], WOTS_PRF);
+        memcpy(step_adrs[i] + 20, adrs + 20, 4);
+        adrs_set_chain(step_adrs[i], (uint32_t)i);
+        in[i] = hs->sk_seed;
+        dst[i] = out + i * n;
+    }
+    hash_f_many(hs, step_adrs, in, dst, (unsigned)len);
+
+    for (unsigned j = 0; j < W - 1; j++) {
+        unsigned count = 0;
+
+        for (size_t i = 0; i < len; i++) {
+            if ((lengths ? lengths[i] : W - 1) <= j) continue;
+            memcpy(step_adrs[count], adrs, 32);
+            adrs_set_chain(step_adrs[count], (uint32_t)i);
+            adrs_set_hash(step_adrs[count], j);
+            in[count] = dst[count] = out + i * n;
+            count++;
+        }
+        if (count == 0) break;
+        hash_f_many(hs, step_adrs, in, dst, count);
+    }
+}
+
+static void wots_pk_gen(hasher *hs, uint8_t *adrs, uint8_t *pk) {
+    uint8_t tmp[MAX_WOTS_LEN * MAX_N], pk_adrs[32];
+
+    wots_chain_all(hs, adrs, NULL, tmp);
+    memcpy(pk_adrs, adrs, 32);
+    adrs_set_type_and_clear(pk_adrs, WOTS_PK);
+    memcpy(pk_adrs + 20, adrs + 20, 4);
+    hash_t(hs, pk_adrs, tmp, slh_par_wots_len(hs->p) * hs->p->n, pk);
+}
+
+static void base_2b(const uint8_t *x, unsigned b, size_t out_len, uint8_t *out) {
+    uint32_t total = 0;
+    unsigned bits = 0;
+
+    for (size_t i = 0; i < out_len; i++) {
+        while (bits < b) {
+            total = (total << 8) | *x++;
+            bits += 8;
+        }
+        bits -= b;
+        out[i] = (uint8_t)((total >> bits) & ((1u << b) - 1));
+    }
+}
+
+static void wots_sign(hasher *hs, uint8_t *adrs, const uint8_t *msg, uint8_t *sig) {
+    const size_t len1 = 2 * hs->p->n, len2 = 3;
+    uint8_t lengths[MAX_WOTS_LEN], csum_bytes[2];
+    uint32_t csum = 0;
+
+    base_2b(msg, 4, len1, lengths);
+    for (size_t i = 0; i < len1; i++) csum += W - 1 - lengths[i];
+    csum <<= 4;     /* (8 - len2 * lg_w % 8) % 8 */
+    csum_bytes[0] = (uint8_t)(csum >> 8);
+    csum_bytes[1] = (uint8_t)csum;
+    base_2b(csum_bytes, 4, len2, lengths + len1);
+
+    wots_chain_all(hs, adrs, lengths, sig);
+}
+
+/* ---- Parallel tree building ---- */
+
+/*
+ * One FORS tree or one XMSS tree on the signing path. It is split into
+ * 2^split subtrees built independently; combine_upper() finishes the top.
+ */
+typedef struct {
+    int fors;
+    unsigned index;             /* FORS tree i, or XMSS layer */
+    unsigned height;
+    unsigned split;
+    uint64_t tree_addr;
+    uint32_t keypair;           /* FORS only: the hypertree leaf signing it */
+    uint32_t leaf;              /* leaf whose authentication path we need */
+    uint8_t *auth;              /* height * n */
+    uint8_t *subroots;          /* 2^split * n */
+    uint8_t root[MAX_N];
+} tree_job;
+
+typedef struct {
+    const slh_params *p;
+    const uint8_t *pk_seed, *sk_seed;
+    tree_job *jobs;
+    size_t njobs;
+    size_t ntasks;
+    size_t next;
+    int failed;
+} tree_work;
+
+static void job_adrs(const tree_job *job, uint8_t *adrs) {
+    memset(adrs, 0, 32);
+    adrs_set_layer(adrs, job->fors ? 0 : job->index);
+    adrs_set_tree(adrs, job->tree_addr);
+}
+
+/* Leaves first .. first + count - 1 (count <= SLH_HASHX_LANES) of the job's tree */
+static void job_leaves(hasher *hs, const tree_job *job, uint32_t first, unsigned count,
+                       uint8_t (*out)[MAX_N]) {
+    uint8_t adrs[SLH_HASHX_LANES][32];
+    const uint8_t *in[SLH_HASHX_LANES];
+    uint8_t *dst[SLH_HASHX_LANES];
+
+    for (unsigned i = 0; i < count; i++) {
+        job_adrs(job, adrs[i]);
+        if (job->fors) {
+            adrs_set_type_and_clear(adrs[i], FORS_PRF);
+            adrs_set_keypair(adrs[i], job->keypair);
+            adrs_set_tree_index(adrs[i], (job->index << job->height) + first + i);
+            in[i] = hs->sk_seed;
+            dst[i] = out[i];
+        } else {
+            adrs_set_type_and_clear(adrs[i], WOTS_HASH);
+            adrs_set_keypair(adrs[i], first + i);
+            wots_pk_gen(hs, adrs[i], out[i]);
+        }
+    }
+    if (!job->fors) return;
+
+    /* sk = PRF(...), leaf = F(sk), both across all lanes */
+    hash_f_many(hs, adrs, in, dst, count);
+    for (unsigned i = 0; i < count; i++) {
+        adrs_set_type_and_clear(adrs[i], FORS_TREE);
+        adrs_set_keypair(adrs[i], job->keypair);
+        adrs_set_tree_height(adrs[i], 0);
+        adrs_set_tree_index(adrs[i], (job->index << job->height) + first + i);
+        in[i] = out[i];
+    }
+    hash_f_many(hs, adrs, in, dst, count);
+}
+
+/* Parent at height z, index idx of the job's tree */
+static void job_node(hasher *hs, const tree_job *job, unsigned z, uint32_t idx,
+                     const uint8_t *left, const uint8_t *right, uint8_t *out) {
+    uint8_t adrs[32];
+
+    job_adrs(job, adrs);
+    if (job->fors) {
+        adrs_set_type_and_clear(adrs, FORS_TREE);
+        adrs_set_keypair(adrs, job->keypair);
+        adrs_set_tree_height(adrs, z);
+        adrs_set_tree_index(adrs, (job->index << (job->height - z)) + idx);
+    } else {
+        adrs_set_type_and_clear(adrs, TREE);
+        adrs_set_tree_height(adrs, z);
+        adrs_set_tree_index(adrs, idx);
+    }
+    hash_h(hs, adrs, left, right, out);
+}
+
+/* Keeps the node if it is on the authentication path of job->leaf */
+static void capture(const tree_job *job, size_t n, unsigned z, uint32_t idx,
+                    const uint8_t *node) {
+    if (z < job->height && idx == ((job->leaf >> z) ^ 1))
+        memcpy(job->auth + z * n, node, n);
+}
+
+static void build_subtree(hasher *hs, const tree_job *job, uint32_t sub) {
+    const size_t n = hs->p->n;
+    const unsigned hs_height = job->height - job->split;
+    const uint32_t leaves = 1u << hs_height, first = sub << hs_height;
+    uint8_t stack[MAX_HEIGHT + 1][MAX_N], node[MAX_N], batch[SLH_HASHX_LANES][MAX_N];
+    unsigned heights[MAX_HEIGHT + 1], sp = 0;
+
+    for (uint32_t l = 0; l < leaves && hs->ok; l++) {
+        uint32_t idx = first + l;
+        unsigned z = 0;
+
+        if (l % SLH_HASHX_LANES == 0) {
+            unsigned count = leaves - l < SLH_HASHX_LANES ? leaves - l : SLH_HASHX_LANES;
+            job_leaves(hs, job, idx, count, batch);
+        }
+        memcpy(node, batch[l % SLH_HASHX_LANES], n);
+        capture(job, n, 0, idx, node);
+        while (sp > 0 && heights[sp - 1] == z) {
+            sp--;
+            z++;
+            idx >>= 1;
+            job_node(hs, job, z, idx, stack[sp], node, node);
+            capture(job, n, z, idx, node);
+        }
+        memcpy(stack[sp], node, n);
+        heights[sp++] = z;
+    }
+    memcpy(job->subroots + (size_t)sub * n, stack[0], n);
+}
+
+static void combine_upper(hasher *hs, tree_job *job) {
+    const size_t n = hs->p->n;
+    uint32_t count = 1u << job->split;
+
+    for (unsigned z = job->height - job->split; count > 1; z++) {
+        for (uint32_t i = 0; i < count / 2; i++) {
+            uint8_t *parent = job->subroots + i * n;
+            job_node(hs, job, z + 1, i, job->subroots + 2 * i * n,
+                     job->subroots + (2 * i + 1) * n, parent);
+            capture(job, n, z + 1, i, parent);
+        }
+        count /= 2;
+    }
+    memcpy(job->root, job->subroots, n);
+}
+
+static int take_task(tree_work *w, tree_job **job, uint32_t *sub) {
+    size_t t = __atomic_fetch_add(&w->next, 1, __ATOMIC_RELAXED);
+
+    if (t >= w->ntasks || __atomic_load_n(&w->failed, __ATOMIC_RELAXED)) return 0;
+    for (size_t j = 0; j < w->njobs; j++) {
+        size_t subtrees = (size_t)1 << w->jobs[j].split;
+        if (t < subtrees) {
+            *job = &w->jobs[j];
+            *sub = (uint32_t)t;
+            return 1;
+        }
+        t -= subtrees;
+    }
+    return 0;
+}
+
+static void *tree_worker(void *arg) {
+    tree_work *w = arg;
+    tree_job *job;
+    uint32_t sub;
+    hasher hs;
+
+    if (!hasher_init(&hs, w->p, w->pk_seed, w->sk_seed)) {
+        __atomic_store_n(&w->failed, 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+    while (take_task(w, &job, &sub)) build_subtree(&hs, job, sub);
+    if (!hs.ok) __atomic_store_n(&w->failed, 1, __ATOMIC_RELAXED);
+    hasher_free(&hs);
+    return NULL;
+}
+
+static unsigned resolve_threads(unsigned nthreads) {
+    if (nthreads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = cpus > 0 ? (unsigned)cpus : 1;
+    }
+    return nthreads;
+}
+
+/*
+ * Splits every tree so that no subtree task costs more than total / target,
+ * measured in hash calls per leaf. One thread keeps every tree whole.
+ */
+static void plan_splits(const slh_params *p, tree_job *jobs, size_t njobs, unsigned nthreads) {
+    double total = 0, grain;
+
+    for (size_t j = 0; j < njobs; j++) {
+        double leaf_cost = jobs[j].fors ? 3.0 : (double)slh_par_wots_len(p) * W;
+        total += leaf_cost * (double)(1u << jobs[j].height);
+    }
+    grain = total / (double)(nthreads * TASKS_PER_THREAD);
+
+    for (size_t j = 0; j < njobs; j++) {
+        double leaf_cost = jobs[j].fors ? 3.0 : (double)slh_par_wots_len(p) * W;
+        unsigned split = 0;
+
+        if (nthreads > 1) {
+            while (split < jobs[j].height
+                   && leaf_cost * (double)(1u << (jobs[j].height - split)) > grain)
+                split++;
+        }
+        jobs[j].split = split;
+    }
+}
+
+/* Builds all jobs' trees with nthreads threads (the caller is one of them). */
+static int build_trees(const slh_params *p, const uint8_t *pk_seed, const uint8_t *sk_seed,
+                       tree_job *jobs, size_t njobs, unsigned nthreads) {
+    tree_work w = { p, pk_seed, sk_seed, jobs, njobs, 0, 0, 0 };
+    pthread_t *threads = NULL;
+    unsigned started = 0;
+    hasher hs;
+    int ok = 0;
+
+    plan_splits(p, jobs, njobs, nthreads);
+    for (size_t j = 0; j < njobs; j++) {
+        jobs[j].subroots = malloc(((size_t)1 << jobs[j].split) * p->n);
+        if (!jobs[j].subroots) goto cleanup;
+        w.ntasks += (size_t)1 << jobs[j].split;
+    }
+
+    if (nthreads > 1 && !(threads = calloc(nthreads - 1, sizeof(pthread_t)))) goto cleanup;
+    for (unsigned i = 0; i + 1 < nthreads; i++) {
+        if (pthread_create(&threads[i], NULL, tree_worker, &w) != 0) break;
+        started++;
+    }
+    tree_worker(&w);
+    for (unsigned i = 0; i < started; i++) pthread_join(threads[i], NULL);
+    if (w.failed || w.next < w.ntasks) goto cleanup;
+
+    if (!hasher_init(&hs, p, pk_seed, sk_seed)) goto cleanup;
+    for (size_t j = 0; j < njobs; j++) combine_upper(&hs, &jobs[j]);
+    ok = hs.ok;
+    hasher_free(&hs);
+
+cleanup:
+    for (size_t j = 0; j < njobs; j++) {
+        free(jobs[j].subroots);
+        jobs[j].subroots = NULL;
+    }
+    free(threads);
+    return ok;
+}
+
+/* ---- Message hashing (FIPS 205, sections 10.2 and 11) ---- */
+
+/*
+ * Feeds M' = 0x00 || |ctx| || ctx || M for pure SLH-DSA.
+ */
+static int update_message(EVP_MD_CTX *md, const uint8_t *ctx, size_t ctx_len,
+                          const uint8_t *msg, size_t msg_len) {
+    uint8_t prefix[2] = { 0x00, (uint8_t)ctx_len };
+
+    return EVP_DigestUpdate(md, prefix, 2) > 0
+        && (ctx_len == 0 || EVP_DigestUpdate(md, ctx, ctx_len) > 0)
+        && EVP_DigestUpdate(md, msg, msg_len) > 0;
+}
+
+/* R = PRF_msg(SK.prf, opt_rand, M') */
+static int prf_msg(const slh_params *p, const uint8_t *sk_prf, const uint8_t *opt_rand,
+                   const uint8_t *ctx, size_t ctx_len, const uint8_t *msg, size_t msg_len,
+                   uint8_t *r) {
+    int ok = 0;
+
+    if (!p->sha2) {
+        EVP_MD_CTX *md = EVP_MD_CTX_new();
+        ok = md && EVP_DigestInit_ex(md, EVP_shake256(), NULL) > 0
+            && EVP_DigestUpdate(md, sk_prf, p->n) > 0
+            && EVP_DigestUpdate(md, opt_rand, p->n) > 0
+            && update_message(md, ctx, ctx_len, msg, msg_len)
+            && EVP_DigestFinalXOF(md, r, p->n) > 0;
+        EVP_MD_CTX_free(md);
+    } else {
+        uint8_t prefix[2] = { 0x00, (uint8_t)ctx_len }, mac[MAX_DIGEST];
+        char digest[] = "SHA512";
+        EVP_MAC *hmac = EVP_MAC_fetch(NULL, "HMAC", NULL);
+        EVP_MAC_CTX *mctx = hmac ? EVP_MAC_CTX_new(hmac) : NULL;
+        OSSL_PARAM params[2];
+        size_t mac_len = 0;
+
+        if (p->n == 16) strcpy(digest, "SHA256");
+        params[0] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest, 0);
+        params[1] = OSSL_PARAM_construct_end();
+        ok = mctx && EVP_MAC_init(mctx, sk_prf, p->n, params) > 0
+            && EVP_MAC_update(mctx, opt_rand, p->n) > 0
+            && EVP_MAC_update(mctx, prefix, 2) > 0
+            && (ctx_len == 0 || EVP_MAC_update(mctx, ctx, ctx_len) > 0)
+            && EVP_MAC_update(mctx, msg, msg_len) > 0
+            && EVP_MAC_final(mctx, mac, &mac_len, sizeof(mac)) > 0;
+        if (ok) memcpy(r, mac, p->n);
+        EVP_MAC_CTX_free(mctx);
+        EVP_MAC_free(hmac);
+    }
+    return ok;
+}
+
+/* digest = H_msg(R, PK.seed, PK.root, M'), m bytes */
+static int h_msg(const slh_params *p, const uint8_t *r, const uint8_t *pk,
+                 const uint8_t *ctx, size_t ctx_len, const uint8_t *msg, size_t msg_len,
+                 uint8_t *digest) {
+    EVP_MD_CTX *md = EVP_MD_CTX_new();
+    int ok;
+
+    if (!p->sha2) {
+        ok = md && EVP_DigestInit_ex(md, EVP_shake256(), NULL) > 0
+            && EVP_DigestUpdate(md, r, p->n) > 0
+            && EVP_DigestUpdate(md, pk, 2 * p->n) > 0
+            && update_message(md, ctx, ctx_len, msg, msg_len)
+            && EVP_DigestFinalXOF(md, digest, p->m) > 0;
+    } else {
+        /* MGF1-SHA-x(R || PK.seed || SHA-x(R || PK.seed || PK.root || M'), m) */
+        const EVP_MD *sha = p->n == 16 ? EVP_sha256() : EVP_sha512();
+        uint8_t seed[2 * MAX_N + MAX_DIGEST], block[MAX_DIGEST];
+        size_t md_len = (size_t)EVP_MD_get_size(sha), done = 0;
+
+        memcpy(seed, r, p->n);
+        memcpy(seed + p->n, pk, p->n);
+        ok = md && EVP_DigestInit_ex(md, sha, NULL) > 0
+            && EVP_DigestUpdate(md, r, p->n) > 0
+            && EVP_DigestUpdate(md, pk, 2 * p->n) > 0
+            && update_message(md, ctx, ctx_len, msg, msg_len)
+            && EVP_DigestFinal_ex(md, seed + 2 * p->n, NULL) > 0;
+
+        for (uint32_t c = 0; ok && done < p->m; c++) {
+            uint8_t counter[4];
+            size_t take = p->m - done < md_len ? p->m - done : md_len;
+
+            put_u32(counter, c);
+            ok = EVP_DigestInit_ex(md, sha, NULL) > 0
+                && EVP_DigestUpdate(md, seed, 2 * p->n + md_len) > 0
+                && EVP_DigestUpdate(md, counter, 4) > 0
+                && EVP_DigestFinal_ex(md, block, NULL) > 0;
+            memcpy(digest + done, block, take);
+            done += take;
+        }
+    }
+    EVP_MD_CTX_free(md);
+    return ok;
+}
+
+static uint64_t to_int(const uint8_t *x, size_t len) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < len; i++) v = (v << 8) | x[i];
+    return v;
+}
+
+/* ---- Public API ---- */
+
+int slh_par_keygen(const slh_params *p, uint8_t *pk, uint8_t *sk, unsigned nthreads) {
+    const size_t n = p->n;
+    tree_job top;
+    int ok;
+
+    /* sk = SK.seed || SK.prf || PK.seed || PK.root */
+    if (RAND_priv_bytes(sk, 3 * n) <= 0) return 0;
+
+    memset(&top, 0, sizeof(top));
+    top.index = p->d - 1;
+    top.height = p->hp;
+    top.auth = malloc(p->hp * n);
+    ok = top.auth && build_trees(p, sk + 2 * n, sk, &top, 1, resolve_threads(nthreads));
+
+    if (ok) {
+        memcpy(sk + 3 * n, top.root, n);
+        memcpy(pk, sk + 2 * n, 2 * n);
+    } else {
+        OPENSSL_cleanse(sk, 4 * n);
+    }
+    free(top.auth);
+    return ok;
+}
+
+int slh_par_sign(const slh_params *p, uint8_t *sig,
+                 const uint8_t *msg, size_t msg_len,
+                 const uint8_t *ctx, size_t ctx_len,
+                 const uint8_t *sk, const uint8_t *addrnd, unsigned nthreads) {
+    const size_t n = p->n, wots_len = slh_par_wots_len(p);
+    const uint8_t *sk_seed = sk, *sk_prf = sk + n, *pk = sk + 2 * n;
+    const size_t md_bytes = (p->k * p->a + 7) / 8;
+    const size_t tree_bytes = (p->h - p->hp + 7) / 8, leaf_bytes = (p->hp + 7) / 8;
+    uint8_t digest[64];
+    uint16_t indices[64];
+    tree_job *jobs = NULL;
+    size_t njobs = p->k + p->d;
+    uint8_t *auth = NULL, *out = sig;
+    hasher hs = { 0 };
+    int ok = 0;
+
+    if (ctx_len > 255) return 0;
+
+    /* R, then the digest that selects the FORS leaves and the hypertree path */
+    if (!prf_msg(p, sk_prf, addrnd ? addrnd : pk, ctx, ctx_len, msg, msg_len, out)
+        || !h_msg(p, out, pk, ctx, ctx_len, msg, msg_len, digest))
+        return 0;
+    out += n;
+
+    uint64_t idx_tree = to_int(digest + md_bytes, tree_bytes);
+    uint32_t idx_leaf = (uint32_t)to_int(digest + md_bytes + tree_bytes, leaf_bytes);
+    if (p->h - p->hp < 64) idx_tree &= ((uint64_t)1 << (p->h - p->hp)) - 1;
+    idx_leaf &= (1u << p->hp) - 1;
+
+    /* FORS leaf indices: k values of a bits each */
+    for (unsigned i = 0; i < p->k; i++) {
+        uint32_t v = 0;
+        for (unsigned b = 0; b < p->a; b++) {
+            size_t bit = (size_t)i * p->a + b;
+            v = (v << 1) | ((digest[bit / 8] >> (7 - bit % 8)) & 1);
+        }
+        indices[i] = (uint16_t)v;
+    }
+
+    /* Every tree on the signing path: XMSS layers first (the big tasks), then FORS */
+    jobs = calloc(njobs, sizeof(*jobs));
+    auth = malloc(((size_t)p->d * p->hp + (size_t)p->k * p->a) * n);
+    if (!jobs || !auth) goto cleanup;
+
+    uint64_t tree = idx_tree;
+    uint32_t leaf = idx_leaf;
+    for (unsigned j = 0; j < p->d; j++) {
+        tree_job *job = &jobs[j];
+        job->index = j;
+        job->height = p->hp;
+        job->tree_addr = tree;
+        job->leaf = leaf;
+        job->auth = auth + (size_t)j * p->hp * n;
+        leaf = (uint32_t)(tree & ((1u << p->hp) - 1));
+        tree >>= p->hp;
+    }
+    for (unsigned i = 0; i < p->k; i++) {
+        tree_job *job = &jobs[p->d + i];
+        job->fors = 1;
+        job->index = i;
+        job->height = p->a;
+        job->tree_addr = idx_tree;
+        job->keypair = idx_leaf;
+        job->leaf = indices[i];
+        job->auth = auth + ((size_t)p->d * p->hp + (size_t)i * p->a) * n;
+    }
+
+    if (!build_trees(p, pk, sk_seed, jobs, njobs, resolve_threads(nthreads))) goto cleanup;
+    if (!hasher_init(&hs, p, pk, sk_seed)) goto cleanup;
+
+    /* FORS signature: revealed secret and authentication path per tree */
+    uint8_t adrs[32], roots[64 * MAX_N], fors_pk[MAX_N];
+    for (unsigned i = 0; i < p->k; i++) {
+        tree_job *job = &jobs[p->d + i];
+
+        memset(adrs, 0, 32);
+        adrs_set_tree(adrs, idx_tree);
+        adrs_set_type_and_clear(adrs, FORS_PRF);
+        adrs_set_keypair(adrs, idx_leaf);
+        adrs_set_tree_index(adrs, (i << p->a) + indices[i]);
+        prf(&hs, adrs, out);
+        memcpy(out + n, job->auth, p->a * n);
+        memcpy(roots + i * n, job->root, n);
+        out += (1 + p->a) * n;
+    }
+
+    memset(adrs, 0, 32);
+    adrs_set_tree(adrs, idx_tree);
+    adrs_set_type_and_clear(adrs, FORS_ROOTS);
+    adrs_set_keypair(adrs, idx_leaf);
+    hash_t(&hs, adrs, roots, p->k * n, fors_pk);
+
+    /* Hypertree: each layer's WOTS+ key signs the root of the layer below */
+    const uint8_t *signed_root = fors_pk;
+    for (unsigned j = 0; j < p->d; j++) {
+        tree_job *job = &jobs[j];
+
+        job_adrs(job, adrs);
+        adrs_set_type_and_clear(adrs, WOTS_HASH);
+        adrs_set_keypair(adrs, job->leaf);
+        wots_sign(&hs, adrs, signed_root, out);
+        memcpy(out + wots_len * n, job->auth, p->hp * n);
+        out += (wots_len + p->hp) * n;
+        signed_root = job->root;
+    }
+    ok = hs.ok;
+
+cleanup:
+    hasher_free(&hs);
+    if (auth) OPENSSL_cleanse(auth, ((size_t)p->d * p->hp + (size_t)p->k * p->a) * n);
+    free(auth);
+    free(jobs);
+    if (!ok) OPENSSL_cleanse(sig, slh_par_sig_len(p));
+    return ok;
+}
@@ -0,0 +1,89 @@
+#ifndef SLH_DSA_PAR_H
+#define SLH_DSA_PAR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Multi-threaded SLH-DSA (FIPS 205) signing.
+ *
+ * Apart from the final WOTS+ signatures, the work in one SLH-DSA signature
+ * is building the k FORS trees and the d XMSS trees along the signing path.
+ * Given the message digest these trees do not depend on each other, so they
+ * are split into subtrees and built concurrently; the subtree roots are then
+ * combined and the WOTS+ chains signed on the calling thread.
+ *
+ * Every hash is computed exactly as in the sequential algorithm, so the
+ * signature is byte-identical for any thread count and matches other FIPS 205
+ * implementations given the same key, context and randomness. The message
+ * hashes, H and T_l go through OpenSSL; F and PRF, which are most of the
+ * work, are batched across WOTS+ chains and FORS leaves and evaluated by a
+ * multi-buffer SIMD backend (see slh_hashx.h).
+ *
+ * Keys use the FIPS 205 encodings: pk = PK.seed || PK.root,
+ * sk = SK.seed || SK.prf || PK.seed || PK.root.
+ */
+
+typedef struct {
+    const char *name;   /* e.g. "SLH-DSA-SHA2-128s" */
+    unsigned n;         /* security parameter, bytes */
+    unsigned h;         /* total hypertree height */
+    unsigned d;         /* hypertree layers */
+    unsigned hp;        /* XMSS tree height, h / d */
+    unsigned a;         /* FORS tree height */
+    unsigned k;         /* FORS trees */
+    unsigned m;         /* message digest bytes */
+    int sha2;           /* SHA2 or SHAKE instantiation */
+} slh_params;
+
+/* NULL if name is not one of the twelve FIPS 205 parameter sets. */
+const slh_params *slh_par_params(const char *name);
+
+static inline size_t slh_par_wots_len(const slh_params *p) {
+    return 2 * p->n + 3;
+}
+
+static inline size_t slh_par_pk_len(const slh_params *p) {
+    return 2 * p->n;
+}
+
+static inline size_t slh_par_sk_len(const slh_params *p) {
+    return 4 * p->n;
+}
+
+static inline size_t slh_par_sig_len(const slh_params *p) {
+    return p->n * (1 + p->k * (1 + p->a) + p->h + p->d * slh_par_wots_len(p));
+}
+
+/*
+ * nthreads == 0 uses one thread per online CPU; 1 runs everything on the
+ * calling thread. Functions return 1 on success, 0 on failure.
+ */
+
+/* Fresh random key pair; the top XMSS tree is built in parallel. */
+int slh_par_keygen(const slh_params *p, uint8_t *pk, uint8_t *sk, unsigned nthreads);
+
+/*
+ * Pure SLH-DSA signature over msg with context ctx (at most 255 bytes).
+ * addrnd is n bytes of fresh randomness, or NULL for the deterministic
+ * variant. sig must hold slh_par_sig_len(p) bytes.
+ */
+int slh_par_sign(const slh_params *p, uint8_t *sig,
+                 const uint8_t *msg, size_t msg_len,
+                 const uint8_t *ctx, size_t ctx_len,
+                 const uint8_t *sk, const uint8_t *addrnd, unsigned nthreads);
+
+/*
+ * Selects how F and PRF are computed: "evp" (one OpenSSL call per hash),
+ * or a slh_hashx backend: "scalar", "avx2", "avx512". NULL restores the
+ * default, which picks per parameter set: the fastest supported SIMD
+ * backend for SHAKE; for SHA2, OpenSSL on CPUs with the SHA extensions and
+ * the SIMD backend on others. Returns 0 if name is unsupported.
+ * Signatures are identical whichever backend is used.
+ */
+int slh_par_set_backend(const char *name);
+
+/* Name of the backend used for parameter set p. */
+const char *slh_par_backend(const slh_params *p);
+
+#endif /* SLH_DSA_PAR_H */
@@ -0,0 +1,196 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <openssl/evp.h>
+#include <openssl/err.h>
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#include <openssl/rand.h>
+
+#include "pqc_metrics.h"
+#include "slh_dsa_par.h"
+#include "pqc_timer.h"
+
+/* Parameter names from OpenSSL 3.5 core_names.h */
+#ifndef OSSL_SIGNATURE_PARAM_CONTEXT_STRING
+#define OSSL_SIGNATURE_PARAM_CONTEXT_STRING "context-string"
+#endif
+#ifndef OSSL_SIGNATURE_PARAM_DETERMINISTIC
+#define OSSL_SIGNATURE_PARAM_DETERMINISTIC "deterministic"
+#endif
+
+/*
+ * Signs one message with 1, 2, 4, ... up to the CPU count threads, checks
+ * that every signature is byte-identical to the single-threaded one, and
+ * reports the speedup. Where OpenSSL provides the parameter set, the
+ * signature is also verified with EVP and compared against OpenSSL's own
+ * deterministic signature over the same key.
+ */
+
+static const unsigned char message[] = "Firmware image v2.4.1 build 20261016";
+static const unsigned char context[] = "firmware-signing";
+
+static void handle_openssl_error(const char *msg) {
+    fprintf(stderr, "ERROR: %s\n", msg);
+    ERR_print_errors_fp(stderr);
+}
+
+static int sign_timed(const slh_params *p, uint8_t *sig, const uint8_t *sk,
+                      const uint8_t *addrnd, unsigned threads, double *ms) {
+    uint64_t t0 = pqc_now_ns();
+    int ok = slh_par_sign(p, sig, message, sizeof(message) - 1,
+                          context, sizeof(context) - 1, sk, addrnd, threads);
+    uint64_t ns = pqc_now_ns() - t0;
+
+    *ms = (double)ns / 1e6;
+    if (ok && pqc_metrics_enabled()) {
+        pqc_metrics_sizes sizes = { slh_par_pk_len(p), slh_par_sk_len(p), 0, 0, slh_par_sig_len(p) };
+        char impl[48];
+
+        snprintf(impl, sizeof(impl), "%s,threads=%u", slh_par_backend(p), threads);
+        pqc_metrics_emit_samples(p->name, "sign", impl, &ns, 1, ns, &sizes);
+    }
+    return ok;
+}
+
+/*
+ * Verifies sig with OpenSSL and compares our deterministic signature with
+ * OpenSSL's. Returns -1 if OpenSSL does not support the parameter set.
+ */
+static int check_with_openssl(const slh_params *p, const uint8_t *sk,
+                              const uint8_t *sig, const uint8_t *det_sig) {
+    size_t sig_len = slh_par_sig_len(p), ref_len = sig_len;
+    EVP_PKEY *pkey = EVP_PKEY_new_raw_private_key_ex(NULL, p->name, NULL, sk, slh_par_sk_len(p));
+    EVP_SIGNATURE *alg = NULL;
+    EVP_PKEY_CTX *pctx = NULL;
+    uint8_t *ref = NULL;
+    int deterministic = 1, ret = 0;
+
+    if (!pkey) {
+        ERR_clear_error();
+        return -1;
+    }
+
+    OSSL_PARAM params[3] = {
+        OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_CONTEXT_STRING,
+                                          (void *)context, sizeof(context) - 1),
+        OSSL_PARAM_construct_end(),
+        OSSL_PARAM_construct_end()
+    };
+
+    alg = EVP_SIGNATURE_fetch(NULL, p->name, NULL);
+    pctx = EVP_PKEY_CTX_new_from_pkey(NULL, pkey, NULL);
+    if (!alg || !pctx || EVP_PKEY_verify_message_init(pctx, alg, params) <= 0) {
+        handle_openssl_error("Failed to initialise verification");
+        goto cleanup;
+    }
+    if (EVP_PKEY_verify(pctx, sig, sig_len, message, sizeof(message) - 1) != 1) {
+        printf("❌ OpenSSL rejected the parallel signature\n");
+        goto cleanup;
+    }
+    printf("✅ OpenSSL verifies the parallel signature\n");
+
+    params[1] = OSSL_PARAM_construct_int(OSSL_SIGNATURE_PARAM_DETERMINISTIC, &deterministic);
+    ref = malloc(sig_len);
+    if (!ref || EVP_PKEY_sign_message_init(pctx, alg, params) <= 0
+        || EVP_PKEY_sign(pctx, ref, &ref_len, message, sizeof(message) - 1) <= 0) {
+        handle_openssl_error("Failed to create reference signature");
+        goto cleanup;
+    }
+    if (ref_len != sig_len || memcmp(ref, det_sig, sig_len) != 0) {
+        printf("❌ Deterministic signature differs from OpenSSL's\n");
+        goto cleanup;
+    }
+    printf("✅ Deterministic signature is byte-identical to OpenSSL's\n");
+    ret = 1;
+
+cleanup:
+    free(ref);
+    EVP_PKEY_CTX_free(pctx);
+    EVP_SIGNATURE_free(alg);
+    EVP_PKEY_free(pkey);
+    return ret;
+}
+
+int main(int argc, char *argv[]) {
+    const char *name = argc > 1 ? argv[1] : "SLH-DSA-SHA2-128s";
+    long cpus = argc > 2 ? strtol(argv[2], NULL, 10) : sysconf(_SC_NPROCESSORS_ONLN);
+    const slh_params *p = slh_par_params(name);
+    uint8_t *pk = NULL, *sk = NULL, *ref = NULL, *sig = NULL;
+    uint8_t addrnd[32];
+    double ms, base_ms;
+    int ret = 1;
+
+    pqc_metrics_init("slh_dsa_par_bench");
+    printf("🎯 Parallel SLH-DSA Signing\n");
+    printf("===========================\n");
+
+    if (!p) {
+        printf("❌ Unknown parameter set %s\n", name);
+        return 1;
+    }
+    if (cpus < 1) cpus = 1;
+
+    pk = malloc(slh_par_pk_len(p));
+    sk = malloc(slh_par_sk_len(p));
+    ref = malloc(slh_par_sig_len(p));
+    sig = malloc(slh_par_sig_len(p));
+    if (!pk || !sk || !ref || !sig || RAND_bytes(addrnd, p->n) <= 0) {
+        printf("❌ Initialisation failed\n");
+        goto cleanup;
+    }
+
+    printf("Algorithm: %s, signature: %zu bytes\n", p->name, slh_par_sig_len(p));
+    printf("Hash backend: %s\n", slh_par_backend(p));
+    printf("1. 🔑 Generating key pair with %ld threads...\n", cpus);
+    if (!slh_par_keygen(p, pk, sk, (unsigned)cpus)) {
+        handle_openssl_error("Key generation failed");
+        goto cleanup;
+    }
+
+    printf("2. ✍️  Signing with 1..%ld threads\n\n", cpus);
+    printf("  %7s %12s %10s %10s\n", "threads", "ms/sig", "speedup", "identical");
+    if (!sign_timed(p, ref, sk, addrnd, 1, &base_ms)) {
+        handle_openssl_error("Signing failed");
+        goto cleanup;
+    }
+    printf("  %7u %12.1f %9.2fx %10s\n", 1u, base_ms, 1.0, "-");
+
+    for (long t = 2; t <= cpus; t = t * 2 > cpus && t < cpus ? cpus : t * 2) {
+        if (!sign_timed(p, sig, sk, addrnd, (unsigned)t, &ms)) {
+            handle_openssl_error("Signing failed");
+            goto cleanup;
+        }
+        int same = memcmp(sig, ref, slh_par_sig_len(p)) == 0;
+        printf("  %7ld %12.1f %9.2fx %10s\n", t, ms, base_ms / ms, same ? "✅" : "❌");
+        if (!same) goto cleanup;
+    }
+
+    printf("\n3. 🔍 Cross-checking with OpenSSL...\n");
+    if (!slh_par_sign(p, sig, message, sizeof(message) - 1, context, sizeof(context) - 1,
+                      sk, NULL, (unsigned)cpus)) {
+        handle_openssl_error("Deterministic signing failed");
+        goto cleanup;
+    }
+    int checked = check_with_openssl(p, sk, ref, sig);
+    if (checked < 0) {
+        printf("💡 %s is not available in this OpenSSL; skipped\n", p->name);
+    } else if (!checked) {
+        goto cleanup;
+    }
+
+    printf("\n✨ Benchmark completed!\n");
+    ret = 0;
+
+cleanup:
+    if (sk) OPENSSL_cleanse(sk, slh_par_sk_len(p));
+    free(pk);
+    free(sk);
+    free(ref);
+    free(sig);
+    return ret;
+}
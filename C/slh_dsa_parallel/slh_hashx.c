@@ -0,0 +1,140 @@
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "slh_hashx_internal.h"
+
+const uint64_t slh_keccak_rc[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL,
+    0x8000000080008000ULL, 0x000000000000808BULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008AULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+    0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800AULL, 0x800000008000000AULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+const uint32_t slh_sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t sha256_iv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+/* ---- Scalar backend ---- */
+
+#define ROL64(x, n) ((n) ? ((x) << (n)) | ((x) >> (64 - (n))) : (x))
+#define ROR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+#define KECCAK_FN   keccak_f1600
+#define KECCAK_ATTR
+#define KECCAK_T    uint64_t
+#define KECCAK_XOR(a, b)  ((a) ^ (b))
+#define KECCAK_ANDN(a, b) (~(a) & (b))
+#define KECCAK_ROL(a, n)  ROL64(a, n)
+#define KECCAK_RC(c)      (c)
+#include "slh_keccak_impl.h"
+
+static void sha256_compress(uint32_t state[8], const uint32_t block[16]) {
+    uint32_t w[64], a, b, c, d, e, f, g, h;
+
+    memcpy(w, block, 64);
+    for (unsigned t = 16; t < 64; t++) {
+        uint32_t s0 = ROR32(w[t - 15], 7) ^ ROR32(w[t - 15], 18) ^ (w[t - 15] >> 3);
+        uint32_t s1 = ROR32(w[t - 2], 17) ^ ROR32(w[t - 2], 19) ^ (w[t - 2] >> 10);
+        w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+    }
+
+    a = state[0]; b = state[1]; c = state[2]; d = state[3];
+    e = state[4]; f = state[5]; g = state[6]; h = state[7];
+    for (unsigned t = 0; t < 64; t++) {
+        uint32_t t1 = h + (ROR32(e, 6) ^ ROR32(e, 11) ^ ROR32(e, 25))
+                    + ((e & f) ^ (~e & g)) + slh_sha256_k[t] + w[t];
+        uint32_t t2 = (ROR32(a, 2) ^ ROR32(a, 13) ^ ROR32(a, 22))
+                    + ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+void slh_sha256_midstate(uint32_t state[8], const uint8_t block[64]) {
+    uint32_t w[16];
+
+    for (unsigned i = 0; i < 16; i++) {
+        w[i] = (uint32_t)block[4 * i] << 24 | (uint32_t)block[4 * i + 1] << 16
+             | (uint32_t)block[4 * i + 2] << 8 | block[4 * i + 3];
+    }
+    memcpy(state, sha256_iv, sizeof(sha256_iv));
+    sha256_compress(state, w);
+}
+
+static void scalar_shake256(uint8_t *const *out, size_t outlen,
+                            const uint8_t *const *in, size_t inlen, unsigned count) {
+    for (unsigned i = 0; i < count; i++) {
+        uint64_t s[25] = { 0 };
+
+        slh_shake_block(s, in[i], inlen);
+        keccak_f1600(s);
+        slh_store_le64(out[i], outlen, s);
+    }
+}
+
+static void scalar_sha256(uint8_t *const *out, const uint32_t midstate[8], uint64_t prefix_len,
+                          const uint8_t *const *in, size_t inlen, unsigned count) {
+    for (unsigned i = 0; i < count; i++) {
+        uint32_t state[8], w[16];
+
+        memcpy(state, midstate, sizeof(state));
+        slh_sha256_block(w, in[i], inlen, prefix_len + inlen);
+        sha256_compress(state, w);
+        slh_store_be32(out[i], state);
+    }
+}
+
+static const slh_hashx slh_hashx_scalar = { "scalar", scalar_shake256, scalar_sha256 };
+
+/* ---- Dispatch ---- */
+
+const char *const slh_hashx_names[] = {
+#ifdef SLH_HASHX_X86
+    "avx512", "avx2",
+#endif
+    "scalar", NULL
+};
+
+static int supported(const slh_hashx *x) {
+#ifdef SLH_HASHX_X86
+    __builtin_cpu_init();
+    if (x == &slh_hashx_avx512) return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2");
+    if (x == &slh_hashx_avx2) return __builtin_cpu_supports("avx2");
+#endif
+    return x == &slh_hashx_scalar;
+}
+
+const slh_hashx *slh_hashx_get(const char *name) {
+    static const slh_hashx *const all[] = {
+#ifdef SLH_HASHX_X86
+        &slh_hashx_avx512, &slh_hashx_avx2,
+#endif
+        &slh_hashx_scalar
+    };
+
+    for (size_t i = 0; i < sizeof(all) / sizeof(all[0]); i++) {
+        if (name && strcasecmp(name, all[i]->name) != 0) continue;
+        if (supported(all[i])) return all[i];
+        if (name) return NULL;
+    }
+    return NULL;
+}
@@ -0,0 +1,51 @@
+#ifndef SLH_HASHX_H
+#define SLH_HASHX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Multi-buffer SHAKE256 and SHA-256 for the short, fixed-size hashes that
+ * dominate SLH-DSA (F, PRF and, for n = 16, H). Up to SLH_HASHX_LANES
+ * independent inputs of the same length are hashed in lockstep, one per SIMD
+ * lane.
+ *
+ * Backends: "scalar" (portable C, always available), "avx2" (4-way Keccak,
+ * 8-way SHA-256) and "avx512" (8-way Keccak). slh_hashx_get(NULL) returns the
+ * fastest one the CPU supports, checked at run time; the SIMD kernels are
+ * compiled with target attributes, so no special compiler flags are needed.
+ */
+
+#define SLH_HASHX_LANES 8
+
+/* Largest SHAKE256 input that fits one block (rate 136, minus padding) */
+#define SLH_HASHX_SHAKE_MAX_IN  135
+/* Largest SHA-256 tail that still fits one block with its padding */
+#define SLH_HASHX_SHA256_MAX_IN 55
+
+typedef struct {
+    const char *name;
+
+    /* out[i] = SHAKE256(in[i], outlen) for i < count; inlen <= 135, outlen <= 136 */
+    void (*shake256)(uint8_t *const *out, size_t outlen,
+                     const uint8_t *const *in, size_t inlen, unsigned count);
+
+    /*
+     * out[i] = SHA-256 digest (32 bytes) of a message whose first prefix_len
+     * bytes (a multiple of 64) are already compressed into midstate and whose
+     * remaining inlen <= 55 bytes are in[i].
+     */
+    void (*sha256)(uint8_t *const *out, const uint32_t midstate[8], uint64_t prefix_len,
+                   const uint8_t *const *in, size_t inlen, unsigned count);
+} slh_hashx;
+
+/* NULL picks the best supported backend; otherwise NULL if name is unsupported. */
+const slh_hashx *slh_hashx_get(const char *name);
+
+/* Names of all backends compiled in, NULL-terminated, supported or not. */
+extern const char *const slh_hashx_names[];
+
+/* SHA-256 state after compressing one 64-byte block from the initial value. */
+void slh_sha256_midstate(uint32_t state[8], const uint8_t block[64]);
+
+#endif /* SLH_HASHX_H */
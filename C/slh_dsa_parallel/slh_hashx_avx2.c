@@ -0,0 +1,104 @@
+#include "slh_hashx_internal.h"
+
+#ifdef SLH_HASHX_X86
+
+#include <immintrin.h>
+
+#define AVX2 __attribute__((target("avx2")))
+
+/* ---- 4-way Keccak-f[1600], one instance per 64-bit lane ---- */
+
+#define KECCAK_FN   keccak_x4
+#define KECCAK_ATTR AVX2
+#define KECCAK_T    __m256i
+#define KECCAK_XOR(a, b)  _mm256_xor_si256(a, b)
+#define KECCAK_ANDN(a, b) _mm256_andnot_si256(a, b)
+#define KECCAK_ROL(a, n)  _mm256_or_si256(_mm256_slli_epi64(a, n), _mm256_srli_epi64(a, 64 - (n)))
+#define KECCAK_RC(c)      _mm256_set1_epi64x((long long)(c))
+#include "slh_keccak_impl.h"
+
+static AVX2 void avx2_shake256(uint8_t *const *out, size_t outlen,
+                               const uint8_t *const *in, size_t inlen, unsigned count) {
+    for (unsigned base = 0; base < count; base += 4) {
+        uint64_t words[4][SHAKE256_RATE_WORDS], lanes[4][25];
+        unsigned active = count - base < 4 ? count - base : 4;
+        __m256i s[25];
+
+        for (unsigned i = 0; i < 4; i++)
+            slh_shake_block(words[i], in[base + (i < active ? i : 0)], inlen);
+        for (unsigned w = 0; w < 25; w++) {
+            s[w] = w < SHAKE256_RATE_WORDS
+                 ? _mm256_setr_epi64x((long long)words[0][w], (long long)words[1][w],
+                                      (long long)words[2][w], (long long)words[3][w])
+                 : _mm256_setzero_si256();
+        }
+
+        keccak_x4(s);
+
+        for (unsigned w = 0; w < (outlen + 7) / 8; w++) {
+            uint64_t v[4];
+            _mm256_storeu_si256((__m256i *)v, s[w]);
+            for (unsigned i = 0; i < 4; i++) lanes[i][w] = v[i];
+        }
+        for (unsigned i = 0; i < active; i++) slh_store_le64(out[base + i], outlen, lanes[i]);
+    }
+}
+
+/* ---- 8-way SHA-256, one instance per 32-bit lane ---- */
+
+#define ROR32X8(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+AVX2 void slh_sha256x8_avx2(uint8_t *const *out, const uint32_t midstate[8], uint64_t prefix_len,
+                            const uint8_t *const *in, size_t inlen, unsigned count) {
+    for (unsigned base = 0; base < count; base += 8) {
+        uint32_t blocks[8][16], result[8][8];
+        unsigned active = count - base < 8 ? count - base : 8;
+        __m256i w[64], st[8], a, b, c, d, e, f, g, h;
+
+        for (unsigned i = 0; i < 8; i++)
+            slh_sha256_block(blocks[i], in[base + (i < active ? i : 0)], inlen, prefix_len + inlen);
+        for (unsigned t = 0; t < 16; t++) {
+            w[t] = _mm256_setr_epi32((int)blocks[0][t], (int)blocks[1][t], (int)blocks[2][t],
+                                     (int)blocks[3][t], (int)blocks[4][t], (int)blocks[5][t],
+                                     (int)blocks[6][t], (int)blocks[7][t]);
+        }
+        for (unsigned t = 16; t < 64; t++) {
+            __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(ROR32X8(w[t - 15], 7), ROR32X8(w[t - 15], 18)),
+                                          _mm256_srli_epi32(w[t - 15], 3));
+            __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(ROR32X8(w[t - 2], 17), ROR32X8(w[t - 2], 19)),
+                                          _mm256_srli_epi32(w[t - 2], 10));
+            w[t] = _mm256_add_epi32(_mm256_add_epi32(w[t - 16], s0), _mm256_add_epi32(w[t - 7], s1));
+        }
+
+        for (unsigned i = 0; i < 8; i++) st[i] = _mm256_set1_epi32((int)midstate[i]);
+        a = st[0]; b = st[1]; c = st[2]; d = st[3];
+        e = st[4]; f = st[5]; g = st[6]; h = st[7];
+        for (unsigned t = 0; t < 64; t++) {
+            __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(ROR32X8(e, 6), ROR32X8(e, 11)), ROR32X8(e, 25));
+            __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+            __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, s1),
+                                          _mm256_add_epi32(_mm256_add_epi32(ch, w[t]),
+                                                           _mm256_set1_epi32((int)slh_sha256_k[t])));
+            __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(ROR32X8(a, 2), ROR32X8(a, 13)), ROR32X8(a, 22));
+            __m256i maj = _mm256_xor_si256(_mm256_xor_si256(_mm256_and_si256(a, b), _mm256_and_si256(a, c)),
+                                           _mm256_and_si256(b, c));
+            h = g; g = f; f = e; e = _mm256_add_epi32(d, t1);
+            d = c; c = b; b = a; a = _mm256_add_epi32(t1, _mm256_add_epi32(s0, maj));
+        }
+        st[0] = _mm256_add_epi32(st[0], a); st[1] = _mm256_add_epi32(st[1], b);
+        st[2] = _mm256_add_epi32(st[2], c); st[3] = _mm256_add_epi32(st[3], d);
+        st[4] = _mm256_add_epi32(st[4], e); st[5] = _mm256_add_epi32(st[5], f);
+        st[6] = _mm256_add_epi32(st[6], g); st[7] = _mm256_add_epi32(st[7], h);
+
+        for (unsigned j = 0; j < 8; j++) {
+            uint32_t v[8];
+            _mm256_storeu_si256((__m256i *)v, st[j]);
+            for (unsigned i = 0; i < 8; i++) result[i][j] = v[i];
+        }
+        for (unsigned i = 0; i < active; i++) slh_store_be32(out[base + i], result[i]);
+    }
+}
+
+const slh_hashx slh_hashx_avx2 = { "avx2", avx2_shake256, slh_sha256x8_avx2 };
+
+#endif /* SLH_HASHX_X86 */
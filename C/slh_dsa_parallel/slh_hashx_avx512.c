@@ -0,0 +1,52 @@
+#include "slh_hashx_internal.h"
+
+#ifdef SLH_HASHX_X86
+
+#include <immintrin.h>
+
+#define AVX512 __attribute__((target("avx512f,avx2")))
+
+/* ---- 8-way Keccak-f[1600], one instance per 64-bit lane ---- */
+
+#define KECCAK_FN   keccak_x8
+#define KECCAK_ATTR AVX512
+#define KECCAK_T    __m512i
+#define KECCAK_XOR(a, b)  _mm512_xor_si512(a, b)
+#define KECCAK_ANDN(a, b) _mm512_andnot_si512(a, b)
+#define KECCAK_ROL(a, n)  _mm512_rol_epi64(a, n)
+#define KECCAK_RC(c)      _mm512_set1_epi64((long long)(c))
+#include "slh_keccak_impl.h"
+
+static AVX512 void avx512_shake256(uint8_t *const *out, size_t outlen,
+                                   const uint8_t *const *in, size_t inlen, unsigned count) {
+    for (unsigned base = 0; base < count; base += 8) {
+        uint64_t words[8][SHAKE256_RATE_WORDS], lanes[8][25];
+        unsigned active = count - base < 8 ? count - base : 8;
+        __m512i s[25];
+
+        for (unsigned i = 0; i < 8; i++)
+            slh_shake_block(words[i], in[base + (i < active ? i : 0)], inlen);
+        for (unsigned w = 0; w < 25; w++) {
+            s[w] = w < SHAKE256_RATE_WORDS
+                 ? _mm512_setr_epi64((long long)words[0][w], (long long)words[1][w],
+                                     (long long)words[2][w], (long long)words[3][w],
+                                     (long long)words[4][w], (long long)words[5][w],
+                                     (long long)words[6][w], (long long)words[7][w])
+                 : _mm512_setzero_si512();
+        }
+
+        keccak_x8(s);
+
+        for (unsigned w = 0; w < (outlen + 7) / 8; w++) {
+            uint64_t v[8];
+            _mm512_storeu_si512(v, s[w]);
+            for (unsigned i = 0; i < 8; i++) lanes[i][w] = v[i];
+        }
+        for (unsigned i = 0; i < active; i++) slh_store_le64(out[base + i], outlen, lanes[i]);
+    }
+}
+
+/* SHA-256 is already 8 lanes wide on AVX2 */
+const slh_hashx slh_hashx_avx512 = { "avx512", avx512_shake256, slh_sha256x8_avx2 };
+
+#endif /* SLH_HASHX_X86 */
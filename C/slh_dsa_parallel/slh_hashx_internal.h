@@ -0,0 +1,76 @@
+#ifndef SLH_HASHX_INTERNAL_H
+#define SLH_HASHX_INTERNAL_H
+
+#include <string.h>
+
+#include "slh_hashx.h"
+
+/* Shared by the scalar and SIMD backends */
+
+#define SHAKE256_RATE_WORDS 17
+
+extern const uint64_t slh_keccak_rc[24];
+extern const uint32_t slh_sha256_k[64];
+
+/* One padded SHAKE256 block as little-endian words; inlen <= 135 */
+static inline void slh_shake_block(uint64_t words[SHAKE256_RATE_WORDS],
+                                   const uint8_t *in, size_t inlen) {
+    uint8_t *block = (uint8_t *)words;
+
+    memset(words, 0, SHAKE256_RATE_WORDS * 8);
+    memcpy(block, in, inlen);
+    block[inlen] ^= 0x1F;
+    block[SHAKE256_RATE_WORDS * 8 - 1] ^= 0x80;
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+    for (unsigned i = 0; i < SHAKE256_RATE_WORDS; i++) {
+        uint64_t w = 0;
+        for (unsigned b = 0; b < 8; b++) w |= (uint64_t)block[8 * i + b] << (8 * b);
+        words[i] = w;
+    }
+#endif
+}
+
+static inline void slh_store_le64(uint8_t *out, size_t outlen, const uint64_t *words) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    memcpy(out, words, outlen);
+#else
+    for (size_t i = 0; i < outlen; i++) out[i] = (uint8_t)(words[i / 8] >> (8 * (i % 8)));
+#endif
+}
+
+/* Final padded SHA-256 block as big-endian words; inlen <= 55 */
+static inline void slh_sha256_block(uint32_t w[16], const uint8_t *in, size_t inlen,
+                                    uint64_t total_len) {
+    uint8_t block[64];
+    uint64_t bits = total_len * 8;
+
+    memset(block, 0, sizeof(block));
+    memcpy(block, in, inlen);
+    block[inlen] = 0x80;
+    for (unsigned i = 0; i < 8; i++) block[63 - i] = (uint8_t)(bits >> (8 * i));
+    for (unsigned i = 0; i < 16; i++) {
+        w[i] = (uint32_t)block[4 * i] << 24 | (uint32_t)block[4 * i + 1] << 16
+             | (uint32_t)block[4 * i + 2] << 8 | block[4 * i + 3];
+    }
+}
+
+static inline void slh_store_be32(uint8_t *out, const uint32_t state[8]) {
+    for (unsigned i = 0; i < 8; i++) {
+        out[4 * i] = (uint8_t)(state[i] >> 24);
+        out[4 * i + 1] = (uint8_t)(state[i] >> 16);
+        out[4 * i + 2] = (uint8_t)(state[i] >> 8);
+        out[4 * i + 3] = (uint8_t)state[i];
+    }
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SLH_HASHX_X86 1
+extern const slh_hashx slh_hashx_avx2;
+extern const slh_hashx slh_hashx_avx512;
+
+/* 8-way AVX2 SHA-256 kernel, shared by both x86 backends */
+void slh_sha256x8_avx2(uint8_t *const *out, const uint32_t midstate[8], uint64_t prefix_len,
+                       const uint8_t *const *in, size_t inlen, unsigned count);
+#endif
+
+#endif /* SLH_HASHX_INTERNAL_H */
@@ -0,0 +1,69 @@
+/*
+ * Keccak-f[1600] written out with constant rotation counts, instantiated once
+ * per backend. Before including, define:
+ *
+ *   KECCAK_FN       function name
+ *   KECCAK_ATTR     function attributes (e.g. a target attribute), may be empty
+ *   KECCAK_T        lane type: uint64_t, or a vector holding one lane per instance
+ *   KECCAK_XOR(a, b), KECCAK_ANDN(a, b) = ~a & b, KECCAK_ROL(a, n),
+ *   KECCAK_RC(c)    round constant broadcast to KECCAK_T
+ *
+ * No include guard: each inclusion defines a new function and undefines the
+ * parameters.
+ */
+
+#define KECCAK_THETA(x) \
+    d[x] = KECCAK_XOR(c[((x) + 4) % 5], KECCAK_ROL(c[((x) + 1) % 5], 1))
+
+/* B[y, 2x + 3y] = rot(A[x, y] ^ D[x], rho[x, y]), one output row at a time */
+#define KECCAK_RHO_PI(row, i0, r0, i1, r1, i2, r2, i3, r3, i4, r4) do { \
+        b[5 * (row) + 0] = KECCAK_ROL(KECCAK_XOR(s[i0], d[(i0) % 5]), r0); \
+        b[5 * (row) + 1] = KECCAK_ROL(KECCAK_XOR(s[i1], d[(i1) % 5]), r1); \
+        b[5 * (row) + 2] = KECCAK_ROL(KECCAK_XOR(s[i2], d[(i2) % 5]), r2); \
+        b[5 * (row) + 3] = KECCAK_ROL(KECCAK_XOR(s[i3], d[(i3) % 5]), r3); \
+        b[5 * (row) + 4] = KECCAK_ROL(KECCAK_XOR(s[i4], d[(i4) % 5]), r4); \
+    } while (0)
+
+#define KECCAK_CHI(row) do { \
+        s[5 * (row) + 0] = KECCAK_XOR(b[5 * (row) + 0], KECCAK_ANDN(b[5 * (row) + 1], b[5 * (row) + 2])); \
+        s[5 * (row) + 1] = KECCAK_XOR(b[5 * (row) + 1], KECCAK_ANDN(b[5 * (row) + 2], b[5 * (row) + 3])); \
+        s[5 * (row) + 2] = KECCAK_XOR(b[5 * (row) + 2], KECCAK_ANDN(b[5 * (row) + 3], b[5 * (row) + 4])); \
+        s[5 * (row) + 3] = KECCAK_XOR(b[5 * (row) + 3], KECCAK_ANDN(b[5 * (row) + 4], b[5 * (row) + 0])); \
+        s[5 * (row) + 4] = KECCAK_XOR(b[5 * (row) + 4], KECCAK_ANDN(b[5 * (row) + 0], b[5 * (row) + 1])); \
+    } while (0)
+
+static KECCAK_ATTR void KECCAK_FN(KECCAK_T s[25]) {
+    KECCAK_T c[5], d[5], b[25];
+
+    for (unsigned round = 0; round < 24; round++) {
+        for (unsigned x = 0; x < 5; x++) {
+            c[x] = KECCAK_XOR(KECCAK_XOR(KECCAK_XOR(s[x], s[x + 5]), KECCAK_XOR(s[x + 10], s[x + 15])),
+                              s[x + 20]);
+        }
+        KECCAK_THETA(0); KECCAK_THETA(1); KECCAK_THETA(2); KECCAK_THETA(3); KECCAK_THETA(4);
+
+        b[0] = KECCAK_XOR(s[0], d[0]);
+        b[1] = KECCAK_ROL(KECCAK_XOR(s[6], d[1]), 44);
+        b[2] = KECCAK_ROL(KECCAK_XOR(s[12], d[2]), 43);
+        b[3] = KECCAK_ROL(KECCAK_XOR(s[18], d[3]), 21);
+        b[4] = KECCAK_ROL(KECCAK_XOR(s[24], d[4]), 14);
+        KECCAK_RHO_PI(1,  3, 28,  9, 20, 10,  3, 16, 45, 22, 61);
+        KECCAK_RHO_PI(2,  1,  1,  7,  6, 13, 25, 19,  8, 20, 18);
+        KECCAK_RHO_PI(3,  4, 27,  5, 36, 11, 10, 17, 15, 23, 56);
+        KECCAK_RHO_PI(4,  2, 62,  8, 55, 14, 39, 15, 41, 21,  2);
+
+        KECCAK_CHI(0); KECCAK_CHI(1); KECCAK_CHI(2); KECCAK_CHI(3); KECCAK_CHI(4);
+        s[0] = KECCAK_XOR(s[0], KECCAK_RC(slh_keccak_rc[round]));
+    }
+}
+
+#undef KECCAK_THETA
+#undef KECCAK_RHO_PI
+#undef KECCAK_CHI
+#undef KECCAK_FN
+#undef KECCAK_ATTR
+#undef KECCAK_T
+#undef KECCAK_XOR
+#undef KECCAK_ANDN
+#undef KECCAK_ROL
+#undef KECCAK_RC
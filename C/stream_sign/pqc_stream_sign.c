@@ -0,0 +1,229 @@
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+#include <openssl/evp.h>
+#include <openssl/err.h>
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+
+#include "pqc_handle_cache.h"
+#include "pqc_stream_sign.h"
+
+#define MU_BYTES         64
+#define SHA512_BYTES     64
+#define MAX_CONTEXT      255
+#define MAX_ENCODED_MSG  (2 + MAX_CONTEXT + 11 + SHA512_BYTES)
+
+/* Parameter names from OpenSSL 3.5 core_names.h */
+#ifndef OSSL_SIGNATURE_PARAM_MU
+#define OSSL_SIGNATURE_PARAM_MU "mu"
+#endif
+#ifndef OSSL_SIGNATURE_PARAM_MESSAGE_ENCODING
+#define OSSL_SIGNATURE_PARAM_MESSAGE_ENCODING "message-encoding"
+#endif
+
+/* DER encoding of the SHA-512 OID, 2.16.840.1.101.3.4.2.3 */
+static const unsigned char sha512_oid[11] = {
+    0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x03
+};
+
+struct pqc_stream {
+    pqc_stream_mode mode;
+    int signing;
+    EVP_PKEY *pkey;
+    EVP_SIGNATURE *sig_alg;     /* borrowed from the handle cache */
+    EVP_MD_CTX *md;
+    unsigned char ctx[MAX_CONTEXT];
+    size_t ctx_len;
+};
+
+static void handle_openssl_error(const char *msg) {
+    fprintf(stderr, "ERROR: %s\n", msg);
+    ERR_print_errors_fp(stderr);
+}
+
+static int start_external_mu(pqc_stream *s) {
+    unsigned char pub[2592], tr[64];
+    unsigned char prefix[2] = { 0x00, (unsigned char)s->ctx_len };
+    size_t pub_len = 0;
+
+    if (EVP_PKEY_get_octet_string_param(s->pkey, OSSL_PKEY_PARAM_PUB_KEY,
+                                        pub, sizeof(pub), &pub_len) <= 0) {
+        handle_openssl_error("Failed to get public key");
+        return 0;
+    }
+
+    /* tr = H(pk, 64) */
+    if (EVP_DigestInit_ex(s->md, EVP_shake256(), NULL) <= 0
+        || EVP_DigestUpdate(s->md, pub, pub_len) <= 0
+        || EVP_DigestFinalXOF(s->md, tr, sizeof(tr)) <= 0) {
+        handle_openssl_error("Failed to hash public key");
+        return 0;
+    }
+
+    /* mu = H(tr || 0 || |ctx| || ctx || M, 64); M follows in updates */
+    return EVP_DigestInit_ex(s->md, EVP_shake256(), NULL) > 0
+        && EVP_DigestUpdate(s->md, tr, sizeof(tr)) > 0
+        && EVP_DigestUpdate(s->md, prefix, sizeof(prefix)) > 0
+        && EVP_DigestUpdate(s->md, s->ctx, s->ctx_len) > 0;
+}
+
+static pqc_stream *stream_init(EVP_PKEY *pkey, const char *alg,
+                               const unsigned char *ctx, size_t ctx_len, int signing) {
+    pqc_stream *s;
+
+    if (!pkey || !alg || ctx_len > MAX_CONTEXT) return NULL;
+
+    s = OPENSSL_zalloc(sizeof(*s));
+    if (!s) return NULL;
+
+    s->signing = signing;
+    if (strncasecmp(alg, "ML-DSA", 6) == 0 || strncasecmp(alg, "MLDSA", 5) == 0) {
+        s->mode = PQC_STREAM_EXTERNAL_MU;
+    } else if (strncasecmp(alg, "SLH-DSA", 7) == 0) {
+        s->mode = PQC_STREAM_PREHASH_SHA512;
+    } else {
+        fprintf(stderr, "ERROR: No streaming mode for %s\n", alg);
+        OPENSSL_free(s);
+        return NULL;
+    }
+
+    s->sig_alg = pqc_handle_cache_signature(NULL, alg);
+    s->md = EVP_MD_CTX_new();
+    if (!s->sig_alg || !s->md || !EVP_PKEY_up_ref(pkey)) {
+        handle_openssl_error("Failed to set up streaming context");
+        EVP_MD_CTX_free(s->md);
+        OPENSSL_free(s);
+        return NULL;
+    }
+    s->pkey = pkey;
+    if (ctx_len) memcpy(s->ctx, ctx, ctx_len);
+    s->ctx_len = ctx_len;
+
+    if (s->mode == PQC_STREAM_EXTERNAL_MU) {
+        if (!start_external_mu(s)) goto err;
+    } else if (EVP_DigestInit_ex(s->md, EVP_sha512(), NULL) <= 0) {
+        handle_openssl_error("Failed to initialise SHA-512");
+        goto err;
+    }
+    return s;
+
+err:
+    pqc_stream_free(s);
+    return NULL;
+}
+
+pqc_stream *pqc_stream_sign_init(EVP_PKEY *pkey, const char *alg,
+                                 const unsigned char *ctx, size_t ctx_len) {
+    return stream_init(pkey, alg, ctx, ctx_len, 1);
+}
+
+pqc_stream *pqc_stream_verify_init(EVP_PKEY *pkey, const char *alg,
+                                   const unsigned char *ctx, size_t ctx_len) {
+    return stream_init(pkey, alg, ctx, ctx_len, 0);
+}
+
+int pqc_stream_update(pqc_stream *s, const unsigned char *data, size_t len) {
+    return EVP_DigestUpdate(s->md, data, len) > 0;
+}
+
+/*
+ * Finishes the hash into tbs (mu for ML-DSA, M' for HashSLH-DSA) and returns
+ * a context initialised for a one-shot sign or verify over it.
+ */
+static EVP_PKEY_CTX *finish(pqc_stream *s, unsigned char *tbs, size_t *tbs_len) {
+    EVP_PKEY_CTX *pctx;
+    OSSL_PARAM params[2];
+    int one = 1, zero = 0;
+
+    if (s->mode == PQC_STREAM_EXTERNAL_MU) {
+        if (EVP_DigestFinalXOF(s->md, tbs, MU_BYTES) <= 0) return NULL;
+        *tbs_len = MU_BYTES;
+        params[0] = OSSL_PARAM_construct_int(OSSL_SIGNATURE_PARAM_MU, &one);
+    } else {
+        unsigned char digest[SHA512_BYTES];
+        size_t off = 0;
+
+        if (EVP_DigestFinal_ex(s->md, digest, NULL) <= 0) return NULL;
+        tbs[off++] = 0x01;
+        tbs[off++] = (unsigned char)s->ctx_len;
+        memcpy(tbs + off, s->ctx, s->ctx_len);
+        off += s->ctx_len;
+        memcpy(tbs + off, sha512_oid, sizeof(sha512_oid));
+        off += sizeof(sha512_oid);
+        memcpy(tbs + off, digest, sizeof(digest));
+        *tbs_len = off + sizeof(digest);
+        /* M' is already encoded, so the provider must take it as-is */
+        params[0] = OSSL_PARAM_construct_int(OSSL_SIGNATURE_PARAM_MESSAGE_ENCODING, &zero);
+    }
+    params[1] = OSSL_PARAM_construct_end();
+
+    /* One context per stream: a per-key template in the handle cache would
+     * keep the key referenced there after pqc_stream_free() */
+    pctx = EVP_PKEY_CTX_new_from_pkey(NULL, s->pkey, NULL);
+    if (!pctx) return NULL;
+
+    if ((s->signing ? EVP_PKEY_sign_message_init(pctx, s->sig_alg, params)
+                    : EVP_PKEY_verify_message_init(pctx, s->sig_alg, params)) <= 0) {
+        EVP_PKEY_CTX_free(pctx);
+        return NULL;
+    }
+    return pctx;
+}
+
+int pqc_stream_sign_final(pqc_stream *s, unsigned char **sig, size_t *sig_len) {
+    unsigned char tbs[MAX_ENCODED_MSG];
+    size_t tbs_len = 0, len = 0;
+    EVP_PKEY_CTX *pctx;
+    int ret = 0;
+
+    *sig = NULL;
+    if (!s->signing || !(pctx = finish(s, tbs, &tbs_len))) {
+        handle_openssl_error("Failed to initialise streaming signature");
+        return 0;
+    }
+
+    if (EVP_PKEY_sign(pctx, NULL, &len, tbs, tbs_len) <= 0
+        || !(*sig = OPENSSL_malloc(len))
+        || EVP_PKEY_sign(pctx, *sig, &len, tbs, tbs_len) <= 0) {
+        handle_openssl_error("Failed to sign message representative");
+        OPENSSL_free(*sig);
+        *sig = NULL;
+        goto cleanup;
+    }
+    *sig_len = len;
+    ret = 1;
+
+cleanup:
+    EVP_PKEY_CTX_free(pctx);
+    return ret;
+}
+
+int pqc_stream_verify_final(pqc_stream *s, const unsigned char *sig, size_t sig_len) {
+    unsigned char tbs[MAX_ENCODED_MSG];
+    size_t tbs_len = 0;
+    EVP_PKEY_CTX *pctx;
+    int ok;
+
+    if (s->signing || !(pctx = finish(s, tbs, &tbs_len))) {
+        handle_openssl_error("Failed to initialise streaming verification");
+        return 0;
+    }
+
+    ok = EVP_PKEY_verify(pctx, sig, sig_len, tbs, tbs_len) == 1;
+    if (!ok) ERR_clear_error();
+    EVP_PKEY_CTX_free(pctx);
+    return ok;
+}
+
+pqc_stream_mode pqc_stream_get_mode(const pqc_stream *s) {
+    return s->mode;
+}
+
+void pqc_stream_free(pqc_stream *s) {
+    if (!s) return;
+    EVP_MD_CTX_free(s->md);
+    EVP_PKEY_free(s->pkey);
+    OPENSSL_free(s);
+}
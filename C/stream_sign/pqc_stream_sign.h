@@ -0,0 +1,49 @@
+#ifndef PQC_STREAM_SIGN_H
+#define PQC_STREAM_SIGN_H
+
+#include <stddef.h>
+
+#include <openssl/evp.h>
+
+/*
+ * Single-pass streaming sign/verify for inputs larger than memory.
+ *
+ * ML-DSA uses external mu (FIPS 204): the message representative
+ *     mu = SHAKE256(SHAKE256(pk, 64) || 0x00 || len(ctx) || ctx || M, 64)
+ * is absorbed incrementally and only mu is handed to OpenSSL. The result is
+ * an ordinary ML-DSA signature over M that any verifier accepts.
+ *
+ * SLH-DSA cannot be streamed (M is hashed twice), so it uses HashSLH-DSA
+ * (FIPS 205) with SHA-512 as the pre-hash:
+ *     M' = 0x01 || len(ctx) || ctx || OID(SHA-512) || SHA-512(M)
+ * Verifiers must use HashSLH-DSA with SHA-512 as well.
+ *
+ * Either way the state is a single hash context, so memory use does not
+ * depend on the input size.
+ */
+
+typedef struct pqc_stream pqc_stream;
+
+typedef enum {
+    PQC_STREAM_EXTERNAL_MU,   /* ML-DSA */
+    PQC_STREAM_PREHASH_SHA512 /* HashSLH-DSA */
+} pqc_stream_mode;
+
+/* alg is the signature name, e.g. "ML-DSA-65" or "SLH-DSA-SHA2-128s". */
+pqc_stream *pqc_stream_sign_init(EVP_PKEY *pkey, const char *alg,
+                                 const unsigned char *ctx, size_t ctx_len);
+pqc_stream *pqc_stream_verify_init(EVP_PKEY *pkey, const char *alg,
+                                   const unsigned char *ctx, size_t ctx_len);
+
+int pqc_stream_update(pqc_stream *s, const unsigned char *data, size_t len);
+
+/* Allocates *sig with OPENSSL_malloc(); the caller frees it. */
+int pqc_stream_sign_final(pqc_stream *s, unsigned char **sig, size_t *sig_len);
+
+/* Returns 1 if the signature is valid, 0 otherwise. */
+int pqc_stream_verify_final(pqc_stream *s, const unsigned char *sig, size_t sig_len);
+
+pqc_stream_mode pqc_stream_get_mode(const pqc_stream *s);
+void pqc_stream_free(pqc_stream *s);
+
+#endif /* PQC_STREAM_SIGN_H */
@@ -1,15 +1,35 @@
-use ml_dsa::{MlDsa87, KeyGen, signature::{Signer, Verifier}};
+use ml_dsa::{KeyGen, KeyPair, MlDsa87, Signature, signature::{Signer, Verifier}};
 use rand::thread_rng;
-use std::env;
 
-fn main() {
+use crate::Sig;
+
+pub const NAME: &str = "ML-DSA-87";
+
+/// ML-DSA-87 for generic callers such as the criterion benches.
+pub struct MlDsa87Set;
+
+impl Sig for MlDsa87Set {
+    const NAME: &'static str = NAME;
+    type Keys = KeyPair<MlDsa87>;
+    type Signature = Signature<MlDsa87>;
+
+    fn keygen() -> Self::Keys {
+        MlDsa87::key_gen(&mut thread_rng())
+    }
+
+    fn sign(keys: &Self::Keys, msg: &[u8]) -> Self::Signature {
+        keys.signing_key().sign(msg)
+    }
+
+    fn verify(keys: &Self::Keys, msg: &[u8], sig: &Self::Signature) -> bool {
+        keys.verifying_key().verify(msg, sig).is_ok()
+    }
+}
+
+pub fn run(msg: &str) {
     let mut rng = thread_rng();
-    let mut msg = String::from("Hello world!");
     let method = String::from("ML-DSA-87");
 
-    let args: Vec<String> = env::args().collect();
-    if args.len() > 1 { msg = args[1].clone(); }
-
     let kp = MlDsa87::key_gen(&mut rng);
     let sig = kp.signing_key().sign(msg.as_bytes());
 
@@ -25,4 +45,4 @@ fn main() {
     let ver = kp.verifying_key().verify(msg.as_bytes(), &sig);
     if ver.is_ok() { println!("\nSignature verified"); }
     else { println!("\nSignature NOT verified"); }
-}
\ No newline at end of file
+}
@@ -0,0 +1,65 @@
+//! Expanded signing keys for signers that sign many messages with one key.
+//! The Rust side of `C/ml_dsa_expanded`.
+//!
+//! Decoding an encoded ML-DSA signing key unpacks s1, s2 and t0, moves them
+//! into the NTT domain and expands the matrix A from rho. The decoded
+//! `ml_dsa::SigningKey` keeps all of it, so a signer that holds the key
+//! encoded and decodes it for every signature (as `OQS_SIG_sign` does) redoes
+//! that work each time. `ExpandedSigningKey` decodes once and keeps the
+//! expanded key resident. `ml-dsa` 0.0.4 does not zeroize keys, so it is
+//! wiped here when dropped.
+
+use std::mem::{self, ManuallyDrop};
+use std::ptr;
+
+use ml_dsa::signature::Signer;
+use ml_dsa::{EncodedSigningKey, KeyPair, MlDsaParams, Signature, SigningKey};
+
+/// A decoded signing key: NTT-domain s1, s2, t0 and A-hat, wiped on drop.
+pub struct ExpandedSigningKey<P: MlDsaParams> {
+    key: ManuallyDrop<SigningKey<P>>,
+}
+
+impl<P: MlDsaParams> ExpandedSigningKey<P> {
+    pub fn from_encoded(encoded: &EncodedSigningKey<P>) -> Self {
+        Self {
+            key: ManuallyDrop::new(SigningKey::decode(encoded)),
+        }
+    }
+
+    pub fn from_keypair(keys: &KeyPair<P>) -> Self {
+        let mut encoded = keys.signing_key().encode();
+        let key = Self::from_encoded(&encoded);
+        wipe(&mut encoded);
+        key
+    }
+
+    /// Deterministic signature with an empty context, like `Signer::sign`.
+    pub fn sign(&self, msg: &[u8]) -> Signature<P> {
+        self.key.sign(msg)
+    }
+
+    /// Bytes held by an expanded key.
+    pub fn size() -> usize {
+        mem::size_of::<SigningKey<P>>()
+    }
+}
+
+impl<P: MlDsaParams> Drop for ExpandedSigningKey<P> {
+    fn drop(&mut self) {
+        wipe(&mut *self.key);
+    }
+}
+
+/// Signs with an encoded key by expanding it first: the per-call cost that
+/// `ExpandedSigningKey` saves.
+pub fn sign_encoded<P: MlDsaParams>(encoded: &EncodedSigningKey<P>, msg: &[u8]) -> Signature<P> {
+    ExpandedSigningKey::from_encoded(encoded).sign(msg)
+}
+
+fn wipe<T>(value: &mut T) {
+    // SAFETY: only used on ml-dsa keys, which are fixed-size arrays of
+    // integers with no heap data or destructor, so all-zero is a valid value.
+    // Volatile so the wipe is not optimised away.
+    unsafe { ptr::write_volatile(value, mem::zeroed()) };
+}
@@ -0,0 +1,32 @@
+//! ML-DSA (FIPS 204) parameter sets on the `ml-dsa` crate.
+//!
+//! Each set lives in its own module under `lib/` with the original walk-through
+//! demo (`run`) and a `Sig` implementation, so one binary and one bench build
+//! cover all three.
+
+#[path = "../lib/ml_dsa44.rs"]
+pub mod ml_dsa44;
+#[path = "../lib/ml_dsa65.rs"]
+pub mod ml_dsa65;
+#[path = "../lib/ml_dsa87.rs"]
+pub mod ml_dsa87;
+
+pub mod expanded;
+
+/// One signature parameter set.
+pub trait Sig {
+    const NAME: &'static str;
+    type Keys;
+    type Signature;
+
+    fn keygen() -> Self::Keys;
+    fn sign(keys: &Self::Keys, msg: &[u8]) -> Self::Signature;
+    fn verify(keys: &Self::Keys, msg: &[u8], sig: &Self::Signature) -> bool;
+}
+
+/// Demo entry points by short name, as used by `make run-<name>`.
+pub const SETS: &[(&str, &str, fn(&str))] = &[
+    ("44", ml_dsa44::NAME, ml_dsa44::run),
+    ("65", ml_dsa65::NAME, ml_dsa65::run),
+    ("87", ml_dsa87::NAME, ml_dsa87::run),
+];
@@ -1,10 +1,89 @@
-// Default main.rs - will be replaced by specific ML-DSA versions
+// ML-DSA: every parameter set behind one binary.
+//
+//   mldsa [set...] [-m message]
+//
+// A set is its short name from `make list` (a leading '_' is ignored) or
+// "all"; with no set every one runs, so one build covers the comparison.
+//
+// With PQC_METRICS=json or csv (see ../pqc-metrics) each demo is followed by
+// one timed keygen, sign and verify, and one record per operation.
+
+use std::env;
+use std::process;
+use std::time::Instant;
+
+use mldsa::ml_dsa44::MlDsa44Set;
+use mldsa::ml_dsa65::MlDsa65Set;
+use mldsa::ml_dsa87::MlDsa87Set;
+use mldsa::{Sig, SETS};
+use pqc_metrics::{Histogram, Reporter, Sizes};
+
+// Public key, private key and signature bytes (FIPS 204), and the metrics
+// pass, by short name
+const METRICS: &[(&str, Sizes, fn(&Reporter, &Sizes, &[u8]))] = &[
+    ("44", Sizes { pk: 1312, sk: 2560, ct: 0, ss: 0, sig: 2420 }, metrics::<MlDsa44Set>),
+    ("65", Sizes { pk: 1952, sk: 4032, ct: 0, ss: 0, sig: 3309 }, metrics::<MlDsa65Set>),
+    ("87", Sizes { pk: 2592, sk: 4896, ct: 0, ss: 0, sig: 4627 }, metrics::<MlDsa87Set>),
+];
+
+fn timed<T>(f: impl FnOnce() -> T) -> (T, Histogram) {
+    let mut h = Histogram::new();
+    let start = Instant::now();
+    let out = f();
+    h.record_duration(start.elapsed());
+    (out, h)
+}
+
+fn metrics<S: Sig>(reporter: &Reporter, sizes: &Sizes, msg: &[u8]) {
+    let (keys, h) = timed(S::keygen);
+    reporter.emit(S::NAME, "keygen", "ml-dsa", &h, None, sizes);
+    let (sig, h) = timed(|| S::sign(&keys, msg));
+    reporter.emit(S::NAME, "sign", "ml-dsa", &h, None, sizes);
+    let (ok, h) = timed(|| S::verify(&keys, msg, &sig));
+    if ok {
+        reporter.emit(S::NAME, "verify", "ml-dsa", &h, None, sizes);
+    }
+}
+
 fn main() {
-    println!("ML-DSA Signature Implementations");
-    println!("Available commands:");
-    println!("  make run-44    - Run ML-DSA-44");
-    println!("  make run-65    - Run ML-DSA-65"); 
-    println!("  make run-87    - Run ML-DSA-87");
-    println!("  make run-all   - Run all versions");
-    println!("  make status    - Show current status");
+    let mut msg = String::from("Hello world!");
+    let mut wanted: Vec<String> = Vec::new();
+    let mut args = env::args().skip(1);
+    while let Some(arg) = args.next() {
+        if arg == "-m" || arg == "--message" {
+            msg = args.next().unwrap_or_default();
+        } else if arg != "all" {
+            wanted.push(arg.trim_start_matches('_').to_string());
+        }
+    }
+
+    let reporter = Reporter::from_env("mldsa");
+    let total = Instant::now();
+    let mut ran = 0;
+    for (key, name, run) in SETS {
+        if !wanted.is_empty() && !wanted.iter().any(|w| key.ends_with(w.as_str())) {
+            continue;
+        }
+        println!("========================================");
+        println!("Running ML-DSA version: {}", name);
+        println!("========================================");
+        let start = Instant::now();
+        run(&msg);
+        println!("⏱️  Time for {}: {:.2?}\n", name, start.elapsed());
+        if let (Some(reporter), Some((_, sizes, metrics))) =
+            (&reporter, METRICS.iter().find(|(k, _, _)| k == key))
+        {
+            metrics(reporter, sizes, msg.as_bytes());
+        }
+        ran += 1;
+    }
+
+    if ran == 0 {
+        let keys: Vec<&str> = SETS.iter().map(|(key, _, _)| *key).collect();
+        eprintln!("Unknown parameter set; available: {}", keys.join(", "));
+        process::exit(1);
+    }
+    if ran > 1 {
+        println!("✅ All {} sets completed in {:.2?}", ran, total.elapsed());
+    }
 }
@@ -1,7 +1,50 @@
 use fips203::ml_kem_768;
 use fips203::traits::{Decaps, Encaps, KeyGen, SerDes};
 
-fn main() {
+use crate::Kem;
+
+pub const NAME: &str = "ML-KEM-768";
+
+/// ML-KEM-768 for generic callers such as the criterion benches.
+pub struct MlKem768;
+
+impl Kem for MlKem768 {
+    const NAME: &'static str = NAME;
+    type EncapsKey = ml_kem_768::EncapsKey;
+    type DecapsKey = ml_kem_768::DecapsKey;
+    type CipherText = ml_kem_768::CipherText;
+    const EK_LEN: usize = ml_kem_768::EK_LEN;
+    const CT_LEN: usize = ml_kem_768::CT_LEN;
+
+    fn keygen() -> (Self::EncapsKey, Self::DecapsKey) {
+        ml_kem_768::KG::try_keygen().expect("ML-KEM-768 keygen")
+    }
+
+    fn keygen_bytes() -> (Vec<u8>, Self::DecapsKey) {
+        let (ek, dk) = Self::keygen();
+        (ek.into_bytes().to_vec(), dk)
+    }
+
+    fn encaps(ek: &Self::EncapsKey) -> ([u8; 32], Self::CipherText) {
+        let (ssk, ct) = ek.try_encaps().expect("ML-KEM-768 encaps");
+        (ssk.into_bytes(), ct)
+    }
+
+    fn decaps(dk: &Self::DecapsKey, ct: &Self::CipherText) -> [u8; 32] {
+        dk.try_decaps(ct).expect("ML-KEM-768 decaps").into_bytes()
+    }
+
+    fn try_encaps_into(ek: &[u8], ct: &mut [u8], ss: &mut [u8]) -> Result<(), &'static str> {
+        let ek_bytes: [u8; ml_kem_768::EK_LEN] =
+            ek.try_into().map_err(|_| "wrong encapsulation key length")?;
+        let (ssk, cipher) = ml_kem_768::EncapsKey::try_from_bytes(ek_bytes)?.try_encaps()?;
+        ct.copy_from_slice(&cipher.into_bytes());
+        ss.copy_from_slice(&ssk.into_bytes());
+        Ok(())
+    }
+}
+
+pub fn run() {
     let method = String::from("ML-KEM-768");
 
     println!("\nMethod: {}\n", method);
@@ -72,4 +115,4 @@ fn main() {
     } else {
         println!("\n❌ Key exchange failed! Shared secrets do not match.");
     }
-}
\ No newline at end of file
+}
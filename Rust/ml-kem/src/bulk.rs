@@ -0,0 +1,200 @@
+//! Bulk encapsulation: one call encapsulates to many recipients, e.g. to wrap
+//! one content key for every recipient of a broadcast message. The Rust side
+//! of `C/ml_kem_oqs_example/mlkem_bulk.c`.
+//!
+//! Input and output are structures of arrays. The public keys are
+//! concatenated in one slice, and entry `i` of the result sits at
+//! `i * CT_LEN` in `ciphertexts` and at `i * SS_LEN` in `shared_secrets`.
+//! As in the C batch, the output arrays start on a 64-byte boundary, so a
+//! vectorised kernel can later take them with aligned loads.
+
+use std::ops::{Deref, DerefMut};
+use std::{ptr, slice};
+use std::thread;
+
+use crate::Kem;
+
+pub const SS_LEN: usize = 32;
+
+const LINE: usize = 64;
+
+/// Entries per run. For every ML-KEM set a run of ciphertexts or shared
+/// secrets is a whole number of 64-byte lines.
+const RUN: usize = 8;
+
+#[derive(Clone, Copy)]
+#[repr(C, align(64))]
+struct Line([u8; LINE]);
+
+/// A zeroed byte array that starts on a 64-byte boundary.
+pub struct AlignedBytes {
+    lines: Vec<Line>,
+    len: usize,
+}
+
+impl AlignedBytes {
+    fn zeroed(len: usize) -> Self {
+        AlignedBytes { lines: vec![Line([0; LINE]); len.div_ceil(LINE)], len }
+    }
+}
+
+impl Deref for AlignedBytes {
+    type Target = [u8];
+
+    fn deref(&self) -> &[u8] {
+        // Line is 64 plain bytes without padding, and lines holds at least len bytes
+        unsafe { slice::from_raw_parts(self.lines.as_ptr().cast(), self.len) }
+    }
+}
+
+impl DerefMut for AlignedBytes {
+    fn deref_mut(&mut self) -> &mut [u8] {
+        unsafe { slice::from_raw_parts_mut(self.lines.as_mut_ptr().cast(), self.len) }
+    }
+}
+
+/// Ciphertexts, shared secrets and per-entry status for one batch.
+pub struct Batch {
+    pub n: usize,
+    pub ct_len: usize,
+    pub ciphertexts: AlignedBytes,
+    pub shared_secrets: AlignedBytes,
+    /// 1 if entry `i` was encapsulated; failed entries are left zeroed.
+    pub status: AlignedBytes,
+}
+
+impl Batch {
+    pub fn ciphertext(&self, i: usize) -> &[u8] {
+        &self.ciphertexts[i * self.ct_len..(i + 1) * self.ct_len]
+    }
+
+    pub fn shared_secret(&self, i: usize) -> &[u8] {
+        &self.shared_secrets[i * SS_LEN..(i + 1) * SS_LEN]
+    }
+
+    pub fn failed(&self) -> usize {
+        self.status.iter().filter(|ok| **ok == 0).count()
+    }
+}
+
+impl Drop for Batch {
+    fn drop(&mut self) {
+        for b in self.shared_secrets.iter_mut() {
+            // volatile so the wipe is not optimised away
+            unsafe { ptr::write_volatile(b, 0) };
+        }
+    }
+}
+
+/// Encapsulates to every `K::EK_LEN`-byte key in `public_keys` on `threads`
+/// threads (0 means one per available CPU). Each thread takes one contiguous
+/// run of entries, a multiple of 8, so its ciphertexts and shared secrets
+/// are whole 64-byte lines that no other thread writes. Status flags at the
+/// ends of a run share a line with the neighbouring runs; each thread writes
+/// its flags in one copy when its run is done.
+///
+/// Fails only if `public_keys` is not a whole number of keys. Entries that do
+/// not encapsulate (a malformed key) are reported in `Batch::status`.
+pub fn try_encaps<K: Kem>(public_keys: &[u8], threads: usize) -> Result<Batch, &'static str> {
+    if public_keys.len() % K::EK_LEN != 0 {
+        return Err("public key array is not a whole number of keys");
+    }
+    let n = public_keys.len() / K::EK_LEN;
+    let mut batch = Batch {
+        n,
+        ct_len: K::CT_LEN,
+        ciphertexts: AlignedBytes::zeroed(n * K::CT_LEN),
+        shared_secrets: AlignedBytes::zeroed(n * SS_LEN),
+        status: AlignedBytes::zeroed(n),
+    };
+    if n == 0 {
+        return Ok(batch);
+    }
+
+    let threads = match threads {
+        0 => thread::available_parallelism().map_or(1, |p| p.get()),
+        t => t,
+    };
+    let per_thread = n.div_ceil(threads.min(n)).next_multiple_of(RUN);
+
+    thread::scope(|s| {
+        let runs = public_keys
+            .chunks(per_thread * K::EK_LEN)
+            .zip(batch.ciphertexts.chunks_mut(per_thread * K::CT_LEN))
+            .zip(batch.shared_secrets.chunks_mut(per_thread * SS_LEN))
+            .zip(batch.status.chunks_mut(per_thread));
+        for (((eks, cts), sss), status) in runs {
+            s.spawn(move || encaps_run::<K>(eks, cts, sss, status));
+        }
+    });
+    Ok(batch)
+}
+
+fn encaps_run<K: Kem>(eks: &[u8], cts: &mut [u8], sss: &mut [u8], status: &mut [u8]) {
+    let mut flags = vec![0u8; status.len()];
+    let entries = eks
+        .chunks(K::EK_LEN)
+        .zip(cts.chunks_mut(K::CT_LEN))
+        .zip(sss.chunks_mut(SS_LEN))
+        .zip(flags.iter_mut());
+    for (((ek, ct), ss), ok) in entries {
+        *ok = K::try_encaps_into(ek, ct, ss).is_ok() as u8;
+        if *ok == 0 {
+            ct.fill(0);
+            ss.fill(0);
+        }
+    }
+    status.copy_from_slice(&flags);
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::ml_kem_1024::MlKem1024;
+    use crate::ml_kem_512::MlKem512;
+    use crate::ml_kem_768::MlKem768;
+    use fips203::traits::SerDes;
+    use fips203::{ml_kem_1024, ml_kem_512, ml_kem_768};
+
+    #[test]
+    fn entries_decapsulate() {
+        let keys: Vec<_> = (0..19).map(|_| MlKem768::keygen_bytes()).collect();
+        let public_keys: Vec<u8> = keys.iter().flat_map(|(ek, _)| ek.iter().copied()).collect();
+        let batch = try_encaps::<MlKem768>(&public_keys, 3).unwrap();
+
+        assert_eq!(batch.failed(), 0);
+        for (i, (_, dk)) in keys.iter().enumerate() {
+            let ct = ml_kem_768::CipherText::try_from_bytes(batch.ciphertext(i).try_into().unwrap()).unwrap();
+            assert_eq!(MlKem768::decaps(dk, &ct), batch.shared_secret(i));
+        }
+    }
+
+    #[test]
+    fn malformed_key_is_reported_and_zeroed() {
+        let keys: Vec<_> = (0..5).map(|_| MlKem1024::keygen_bytes()).collect();
+        let mut public_keys: Vec<u8> = keys.iter().flat_map(|(ek, _)| ek.iter().copied()).collect();
+        // Every coefficient 4095, above q: rejected by the modulus check
+        public_keys[2 * ml_kem_1024::EK_LEN..3 * ml_kem_1024::EK_LEN].fill(0xff);
+        let batch = try_encaps::<MlKem1024>(&public_keys, 2).unwrap();
+
+        assert_eq!(batch.failed(), 1);
+        assert_eq!(&batch.status[..], &[1, 1, 0, 1, 1]);
+        assert!(batch.ciphertext(2).iter().all(|b| *b == 0));
+        assert!(batch.shared_secret(2).iter().all(|b| *b == 0));
+        let ct = ml_kem_1024::CipherText::try_from_bytes(batch.ciphertext(4).try_into().unwrap()).unwrap();
+        assert_eq!(MlKem1024::decaps(&keys[4].1, &ct), batch.shared_secret(4));
+    }
+
+    #[test]
+    fn arrays_and_runs_are_line_aligned() {
+        let public_keys: Vec<u8> = (0..3).flat_map(|_| MlKem512::keygen_bytes().0).collect();
+        let batch = try_encaps::<MlKem512>(&public_keys, 2).unwrap();
+
+        for a in [&batch.ciphertexts, &batch.shared_secrets, &batch.status] {
+            assert_eq!(a.as_ptr() as usize % LINE, 0);
+        }
+        for len in [ml_kem_512::CT_LEN, ml_kem_768::CT_LEN, ml_kem_1024::CT_LEN, SS_LEN] {
+            assert_eq!(RUN * len % LINE, 0);
+        }
+    }
+}
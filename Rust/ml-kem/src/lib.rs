@@ -0,0 +1,41 @@
+//! ML-KEM (FIPS 203) parameter sets on the `fips203` crate.
+//!
+//! Each set lives in its own module under `lib/` with the original walk-through
+//! demo (`run`) and a `Kem` implementation, so one binary and one bench build
+//! cover all three.
+
+#[path = "../lib/ml_kem_512.rs"]
+pub mod ml_kem_512;
+#[path = "../lib/ml_kem_768.rs"]
+pub mod ml_kem_768;
+#[path = "../lib/ml_kem_1024.rs"]
+pub mod ml_kem_1024;
+
+pub mod bulk;
+
+/// One ML-KEM parameter set. Shared secrets are returned as raw bytes.
+pub trait Kem {
+    const NAME: &'static str;
+    type EncapsKey;
+    type DecapsKey;
+    type CipherText;
+    const EK_LEN: usize;
+    const CT_LEN: usize;
+
+    fn keygen() -> (Self::EncapsKey, Self::DecapsKey);
+    /// As `keygen`, with the encapsulation key serialized.
+    fn keygen_bytes() -> (Vec<u8>, Self::DecapsKey);
+    fn encaps(ek: &Self::EncapsKey) -> ([u8; 32], Self::CipherText);
+    fn decaps(dk: &Self::DecapsKey, ct: &Self::CipherText) -> [u8; 32];
+
+    /// Encapsulates to a serialized key, writing the serialized ciphertext
+    /// (CT_LEN bytes) and the shared secret (32 bytes) into the given slices.
+    fn try_encaps_into(ek: &[u8], ct: &mut [u8], ss: &mut [u8]) -> Result<(), &'static str>;
+}
+
+/// Demo entry points by short name, as used by `make run-<name>`.
+pub const SETS: &[(&str, &str, fn())] = &[
+    ("512", ml_kem_512::NAME, ml_kem_512::run),
+    ("768", ml_kem_768::NAME, ml_kem_768::run),
+    ("1024", ml_kem_1024::NAME, ml_kem_1024::run),
+];
@@ -1,5 +1,82 @@
-// ML-KEM Main Entry Point
+// ML-KEM: every parameter set behind one binary.
+//
+//   ml_kem [set...]
+//
+// A set is its short name from `make list` (a leading '_' is ignored) or
+// "all"; with no set every one runs, so one build covers the comparison.
+//
+// With PQC_METRICS=json or csv (see ../pqc-metrics) each demo is followed by
+// one timed keygen, encaps and decaps, and one record per operation.
+
+use std::env;
+use std::process;
+use std::time::Instant;
+
+use ml_kem::ml_kem_1024::MlKem1024;
+use ml_kem::ml_kem_512::MlKem512;
+use ml_kem::ml_kem_768::MlKem768;
+use ml_kem::{Kem, SETS};
+use pqc_metrics::{Histogram, Reporter, Sizes};
+
+// Public key, private key, ciphertext and shared secret bytes (FIPS 203),
+// and the metrics pass, by short name
+const METRICS: &[(&str, Sizes, fn(&Reporter, &Sizes))] = &[
+    ("512", Sizes { pk: 800, sk: 1632, ct: 768, ss: 32, sig: 0 }, metrics::<MlKem512>),
+    ("768", Sizes { pk: 1184, sk: 2400, ct: 1088, ss: 32, sig: 0 }, metrics::<MlKem768>),
+    ("1024", Sizes { pk: 1568, sk: 3168, ct: 1568, ss: 32, sig: 0 }, metrics::<MlKem1024>),
+];
+
+fn timed<T>(f: impl FnOnce() -> T) -> (T, Histogram) {
+    let mut h = Histogram::new();
+    let start = Instant::now();
+    let out = f();
+    h.record_duration(start.elapsed());
+    (out, h)
+}
+
+fn metrics<K: Kem>(reporter: &Reporter, sizes: &Sizes) {
+    let ((ek, dk), h) = timed(K::keygen);
+    reporter.emit(K::NAME, "keygen", "fips203", &h, None, sizes);
+    let ((_, ct), h) = timed(|| K::encaps(&ek));
+    reporter.emit(K::NAME, "encaps", "fips203", &h, None, sizes);
+    let (_, h) = timed(|| K::decaps(&dk, &ct));
+    reporter.emit(K::NAME, "decaps", "fips203", &h, None, sizes);
+}
+
 fn main() {
-    println!("ML-KEM Key Encapsulation Implementations");
-    println!("Use: make run-<version> to test different implementations");
+    let wanted: Vec<String> = env::args()
+        .skip(1)
+        .filter(|arg| arg != "all")
+        .map(|arg| arg.trim_start_matches('_').to_string())
+        .collect();
+
+    let reporter = Reporter::from_env("ml_kem");
+    let total = Instant::now();
+    let mut ran = 0;
+    for (key, name, run) in SETS {
+        if !wanted.is_empty() && !wanted.iter().any(|w| key.ends_with(w.as_str())) {
+            continue;
+        }
+        println!("========================================");
+        println!("Running ML-KEM version: {}", name);
+        println!("========================================");
+        let start = Instant::now();
+        run();
+        println!("⏱️  Time for {}: {:.2?}\n", name, start.elapsed());
+        if let (Some(reporter), Some((_, sizes, metrics))) =
+            (&reporter, METRICS.iter().find(|(k, _, _)| k == key))
+        {
+            metrics(reporter, sizes);
+        }
+        ran += 1;
+    }
+
+    if ran == 0 {
+        let keys: Vec<&str> = SETS.iter().map(|(key, _, _)| *key).collect();
+        eprintln!("Unknown parameter set; available: {}", keys.join(", "));
+        process::exit(1);
+    }
+    if ran > 1 {
+        println!("✅ All {} sets completed in {:.2?}", ran, total.elapsed());
+    }
 }
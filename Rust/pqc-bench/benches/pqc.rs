@@ -0,0 +1,210 @@
+// Criterion comparison of every parameter set in ../ml-kem, ../ml-dsa and
+// ../slh-dsa: one group per operation, one entry per set, so the report
+// lines the sets up side by side. Filter as usual, e.g.
+//
+//   cargo bench -- sign/SLH-DSA
+//   cargo bench -- ML-KEM-768
+
+use std::thread;
+use std::time::Duration;
+
+use criterion::measurement::WallTime;
+use criterion::{
+    black_box, criterion_group, criterion_main, BenchmarkGroup, BenchmarkId, Criterion, Throughput,
+};
+
+use ml_kem::bulk;
+use ml_kem::ml_kem_1024::MlKem1024;
+use ml_kem::ml_kem_512::MlKem512;
+use ml_kem::ml_kem_768::MlKem768;
+use ml_kem::Kem;
+use mldsa::expanded::{self, ExpandedSigningKey};
+use mldsa::ml_dsa44::MlDsa44Set;
+use mldsa::ml_dsa65::MlDsa65Set;
+use mldsa::ml_dsa87::MlDsa87Set;
+use mldsa::Sig;
+use slh_dsa::slh_dsa_shake128f::SlhDsaShake128F;
+use slh_dsa::slh_dsa_shake128s::SlhDsaShake128S;
+use slh_dsa::slh_dsa_shake192f::SlhDsaShake192F;
+use slh_dsa::slh_dsa_shake192s::SlhDsaShake192S;
+use slh_dsa::slh_dsa_shake256f::SlhDsaShake256F;
+use slh_dsa::slh_dsa_shake256s::SlhDsaShake256S;
+
+const MSG: &[u8] = b"Hello world!";
+
+// Recipients per bulk encapsulation, as in broadcast key wrapping
+const RECIPIENTS: usize = 1024;
+
+type Group<'a> = BenchmarkGroup<'a, WallTime>;
+
+fn kem_keygen<K: Kem>(g: &mut Group) {
+    g.bench_function(K::NAME, |b| b.iter(K::keygen));
+}
+
+fn kem_encaps<K: Kem>(g: &mut Group) {
+    let (ek, _) = K::keygen();
+    g.bench_function(K::NAME, |b| b.iter(|| K::encaps(black_box(&ek))));
+}
+
+fn kem_decaps<K: Kem>(g: &mut Group) {
+    let (ek, dk) = K::keygen();
+    let (ss, ct) = K::encaps(&ek);
+    assert_eq!(K::decaps(&dk, &ct), ss, "{} round trip", K::NAME);
+    g.bench_function(K::NAME, |b| {
+        b.iter(|| K::decaps(black_box(&dk), black_box(&ct)))
+    });
+}
+
+// ml-dsa and slh-dsa each define their own Sig trait with the same shape
+macro_rules! sig_benches {
+    ($module:ident, $krate:ident) => {
+        mod $module {
+            use super::*;
+            use $krate::Sig;
+
+            pub fn keygen<S: Sig>(g: &mut Group) {
+                g.bench_function(S::NAME, |b| b.iter(S::keygen));
+            }
+
+            pub fn sign<S: Sig>(g: &mut Group) {
+                let keys = S::keygen();
+                g.bench_function(S::NAME, |b| {
+                    b.iter(|| S::sign(black_box(&keys), black_box(MSG)))
+                });
+            }
+
+            pub fn verify<S: Sig>(g: &mut Group) {
+                let keys = S::keygen();
+                let sig = S::sign(&keys, MSG);
+                assert!(S::verify(&keys, MSG, &sig), "{} round trip", S::NAME);
+                g.bench_function(S::NAME, |b| {
+                    b.iter(|| S::verify(black_box(&keys), black_box(MSG), black_box(&sig)))
+                });
+            }
+        }
+    };
+}
+
+sig_benches!(ml_dsa_sig, mldsa);
+sig_benches!(slh_dsa_sig, slh_dsa);
+
+// The 's' SLH-DSA sets take a fraction of a second per keygen or signature,
+// so those groups keep criterion's minimum sample count.
+fn slow_group<'a>(c: &'a mut Criterion, name: &str) -> Group<'a> {
+    let mut g = c.benchmark_group(name);
+    g.sample_size(10);
+    g.measurement_time(Duration::from_secs(10));
+    g
+}
+
+fn keygen(c: &mut Criterion) {
+    let mut g = slow_group(c, "keygen");
+    kem_keygen::<MlKem512>(&mut g);
+    kem_keygen::<MlKem768>(&mut g);
+    kem_keygen::<MlKem1024>(&mut g);
+    ml_dsa_sig::keygen::<MlDsa44Set>(&mut g);
+    ml_dsa_sig::keygen::<MlDsa65Set>(&mut g);
+    ml_dsa_sig::keygen::<MlDsa87Set>(&mut g);
+    slh_dsa_sig::keygen::<SlhDsaShake128F>(&mut g);
+    slh_dsa_sig::keygen::<SlhDsaShake128S>(&mut g);
+    slh_dsa_sig::keygen::<SlhDsaShake192F>(&mut g);
+    slh_dsa_sig::keygen::<SlhDsaShake192S>(&mut g);
+    slh_dsa_sig::keygen::<SlhDsaShake256F>(&mut g);
+    slh_dsa_sig::keygen::<SlhDsaShake256S>(&mut g);
+    g.finish();
+}
+
+fn encaps(c: &mut Criterion) {
+    let mut g = c.benchmark_group("encaps");
+    kem_encaps::<MlKem512>(&mut g);
+    kem_encaps::<MlKem768>(&mut g);
+    kem_encaps::<MlKem1024>(&mut g);
+    g.finish();
+}
+
+fn decaps(c: &mut Criterion) {
+    let mut g = c.benchmark_group("decaps");
+    kem_decaps::<MlKem512>(&mut g);
+    kem_decaps::<MlKem768>(&mut g);
+    kem_decaps::<MlKem1024>(&mut g);
+    g.finish();
+}
+
+fn sign(c: &mut Criterion) {
+    let mut g = slow_group(c, "sign");
+    ml_dsa_sig::sign::<MlDsa44Set>(&mut g);
+    ml_dsa_sig::sign::<MlDsa65Set>(&mut g);
+    ml_dsa_sig::sign::<MlDsa87Set>(&mut g);
+    slh_dsa_sig::sign::<SlhDsaShake128F>(&mut g);
+    slh_dsa_sig::sign::<SlhDsaShake128S>(&mut g);
+    slh_dsa_sig::sign::<SlhDsaShake192F>(&mut g);
+    slh_dsa_sig::sign::<SlhDsaShake192S>(&mut g);
+    slh_dsa_sig::sign::<SlhDsaShake256F>(&mut g);
+    slh_dsa_sig::sign::<SlhDsaShake256S>(&mut g);
+    g.finish();
+}
+
+fn verify(c: &mut Criterion) {
+    let mut g = c.benchmark_group("verify");
+    ml_dsa_sig::verify::<MlDsa44Set>(&mut g);
+    ml_dsa_sig::verify::<MlDsa65Set>(&mut g);
+    ml_dsa_sig::verify::<MlDsa87Set>(&mut g);
+    slh_dsa_sig::verify::<SlhDsaShake128F>(&mut g);
+    slh_dsa_sig::verify::<SlhDsaShake128S>(&mut g);
+    slh_dsa_sig::verify::<SlhDsaShake192F>(&mut g);
+    slh_dsa_sig::verify::<SlhDsaShake192S>(&mut g);
+    slh_dsa_sig::verify::<SlhDsaShake256F>(&mut g);
+    slh_dsa_sig::verify::<SlhDsaShake256S>(&mut g);
+    g.finish();
+}
+
+// ML-KEM-768 to RECIPIENTS keys per call, on one thread and on every CPU
+fn bulk_encaps(c: &mut Criterion) {
+    let mut g = slow_group(c, "bulk_encaps");
+    let public_keys: Vec<u8> = (0..RECIPIENTS)
+        .flat_map(|_| MlKem768::keygen_bytes().0)
+        .collect();
+    let cpus = thread::available_parallelism().map_or(1, |p| p.get());
+
+    let mut thread_counts = vec![1];
+    if cpus > 1 {
+        thread_counts.push(cpus);
+    }
+
+    g.throughput(Throughput::Elements(RECIPIENTS as u64));
+    for threads in thread_counts {
+        let id = BenchmarkId::new(MlKem768::NAME, format!("{threads} threads"));
+        g.bench_with_input(id, &threads, |b, &threads| {
+            b.iter(|| bulk::try_encaps::<MlKem768>(black_box(&public_keys), threads).unwrap())
+        });
+    }
+    g.finish();
+}
+
+// ML-DSA-65 from the encoded key, expanded for every signature or once
+fn signing_key(c: &mut Criterion) {
+    let mut g = c.benchmark_group("signing_key");
+    let keys = MlDsa65Set::keygen();
+    let encoded = keys.signing_key().encode();
+    let key = ExpandedSigningKey::from_keypair(&keys);
+
+    g.bench_function(BenchmarkId::new(MlDsa65Set::NAME, "expand per call"), |b| {
+        b.iter(|| expanded::sign_encoded(black_box(&encoded), black_box(MSG)))
+    });
+    g.bench_function(BenchmarkId::new(MlDsa65Set::NAME, "expanded"), |b| {
+        b.iter(|| key.sign(black_box(MSG)))
+    });
+    g.finish();
+}
+
+criterion_group!(
+    benches,
+    keygen,
+    encaps,
+    decaps,
+    bulk_encaps,
+    sign,
+    signing_key,
+    verify
+);
+criterion_main!(benches);
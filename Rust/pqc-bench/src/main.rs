@@ -0,0 +1,195 @@
+// Every ML-KEM, ML-DSA and SLH-DSA demo from the sibling crates in one
+// binary, with wall-clock time per set. For statistics use `cargo bench`.
+//
+//   pqc_bench [filter] [-m message] [-n iterations]
+//
+// The filter is a substring of the set name, e.g. ML-KEM or SHAKE-128.
+//
+// With PQC_METRICS=json or csv (see ../pqc-metrics) the demos are replaced
+// by a timed keygen / encaps / decaps or keygen / sign / verify loop per set,
+// up to `-n` iterations or one second per operation, and one record per
+// operation in the same schema as the C benchmarks.
+
+use std::env;
+use std::hint::black_box;
+use std::time::{Duration, Instant};
+
+use ml_kem::ml_kem_1024::MlKem1024;
+use ml_kem::ml_kem_512::MlKem512;
+use ml_kem::ml_kem_768::MlKem768;
+use ml_kem::Kem;
+use mldsa::ml_dsa44::MlDsa44Set;
+use mldsa::ml_dsa65::MlDsa65Set;
+use mldsa::ml_dsa87::MlDsa87Set;
+use pqc_metrics::{Histogram, Reporter, Sizes};
+use slh_dsa::slh_dsa_shake128f::SlhDsaShake128F;
+use slh_dsa::slh_dsa_shake128s::SlhDsaShake128S;
+use slh_dsa::slh_dsa_shake192f::SlhDsaShake192F;
+use slh_dsa::slh_dsa_shake192s::SlhDsaShake192S;
+use slh_dsa::slh_dsa_shake256f::SlhDsaShake256F;
+use slh_dsa::slh_dsa_shake256s::SlhDsaShake256S;
+
+// Time limit per operation in the metrics pass
+const BUDGET: Duration = Duration::from_secs(1);
+
+// Public key, private key, ciphertext, shared secret and signature bytes
+// from FIPS 203, 204 and 205; the Kem and Sig traits do not carry them all.
+const SIZES: &[(&str, Sizes)] = &[
+    ("ML-KEM-512", Sizes { pk: 800, sk: 1632, ct: 768, ss: 32, sig: 0 }),
+    ("ML-KEM-768", Sizes { pk: 1184, sk: 2400, ct: 1088, ss: 32, sig: 0 }),
+    ("ML-KEM-1024", Sizes { pk: 1568, sk: 3168, ct: 1568, ss: 32, sig: 0 }),
+    ("ML-DSA-44", Sizes { pk: 1312, sk: 2560, ct: 0, ss: 0, sig: 2420 }),
+    ("ML-DSA-65", Sizes { pk: 1952, sk: 4032, ct: 0, ss: 0, sig: 3309 }),
+    ("ML-DSA-87", Sizes { pk: 2592, sk: 4896, ct: 0, ss: 0, sig: 4627 }),
+    ("SLH-DSA-SHAKE-128f", Sizes { pk: 32, sk: 64, ct: 0, ss: 0, sig: 17088 }),
+    ("SLH-DSA-SHAKE-128s", Sizes { pk: 32, sk: 64, ct: 0, ss: 0, sig: 7856 }),
+    ("SLH-DSA-SHAKE-192f", Sizes { pk: 48, sk: 96, ct: 0, ss: 0, sig: 35664 }),
+    ("SLH-DSA-SHAKE-192s", Sizes { pk: 48, sk: 96, ct: 0, ss: 0, sig: 16224 }),
+    ("SLH-DSA-SHAKE-256f", Sizes { pk: 64, sk: 128, ct: 0, ss: 0, sig: 49856 }),
+    ("SLH-DSA-SHAKE-256s", Sizes { pk: 64, sk: 128, ct: 0, ss: 0, sig: 29792 }),
+];
+
+// One set's demo or metrics pass
+type Run<'a> = Box<dyn Fn() + 'a>;
+
+fn sizes(name: &str) -> Sizes {
+    SIZES
+        .iter()
+        .find(|(n, _)| *n == name)
+        .map_or_else(Sizes::default, |(_, s)| *s)
+}
+
+struct Metrics {
+    reporter: Reporter,
+    iterations: usize,
+}
+
+impl Metrics {
+    // Runs op up to `iterations` times or for BUDGET, then emits one record
+    fn measure(&self, alg: &str, op: &str, imp: &str, mut f: impl FnMut()) {
+        let mut h = Histogram::new();
+        let start = Instant::now();
+        while (h.samples() as usize) < self.iterations {
+            let t = Instant::now();
+            f();
+            h.record_duration(t.elapsed());
+            if start.elapsed() >= BUDGET {
+                break;
+            }
+        }
+        let total = start.elapsed();
+        println!(
+            "  {:<7} {:<20} {:>9.1} {:>9.1} {:>10.1}",
+            op,
+            alg,
+            h.percentile(50.0) as f64 / 1e3,
+            h.percentile(99.0) as f64 / 1e3,
+            h.samples() as f64 / total.as_secs_f64()
+        );
+        self.reporter.emit(alg, op, imp, &h, Some(total), &sizes(alg));
+    }
+
+    fn kem<K: Kem>(&self) {
+        let (ek, dk) = K::keygen();
+        let (_, ct) = K::encaps(&ek);
+        self.measure(K::NAME, "keygen", "fips203", || {
+            black_box(K::keygen());
+        });
+        self.measure(K::NAME, "encaps", "fips203", || {
+            black_box(K::encaps(black_box(&ek)));
+        });
+        self.measure(K::NAME, "decaps", "fips203", || {
+            black_box(K::decaps(black_box(&dk), black_box(&ct)));
+        });
+    }
+}
+
+// ml-dsa and slh-dsa each define their own Sig trait with the same shape
+macro_rules! sig_metrics {
+    ($name:ident, $krate:ident, $imp:expr) => {
+        fn $name<S: $krate::Sig>(m: &Metrics, msg: &[u8]) {
+            let keys = S::keygen();
+            let sig = S::sign(&keys, msg);
+            m.measure(S::NAME, "keygen", $imp, || {
+                black_box(S::keygen());
+            });
+            m.measure(S::NAME, "sign", $imp, || {
+                black_box(S::sign(black_box(&keys), black_box(msg)));
+            });
+            m.measure(S::NAME, "verify", $imp, || {
+                black_box(S::verify(black_box(&keys), black_box(msg), black_box(&sig)));
+            });
+        }
+    };
+}
+
+sig_metrics!(ml_dsa_metrics, mldsa, "ml-dsa");
+sig_metrics!(slh_dsa_metrics, slh_dsa, "fips205");
+
+fn run_metrics(m: &Metrics, filter: &str, msg: &[u8]) {
+    let sets: Vec<(&str, Run)> = vec![
+        (MlKem512::NAME, Box::new(|| m.kem::<MlKem512>())),
+        (MlKem768::NAME, Box::new(|| m.kem::<MlKem768>())),
+        (MlKem1024::NAME, Box::new(|| m.kem::<MlKem1024>())),
+        (mldsa::ml_dsa44::NAME, Box::new(|| ml_dsa_metrics::<MlDsa44Set>(m, msg))),
+        (mldsa::ml_dsa65::NAME, Box::new(|| ml_dsa_metrics::<MlDsa65Set>(m, msg))),
+        (mldsa::ml_dsa87::NAME, Box::new(|| ml_dsa_metrics::<MlDsa87Set>(m, msg))),
+        (slh_dsa::slh_dsa_shake128f::NAME, Box::new(|| slh_dsa_metrics::<SlhDsaShake128F>(m, msg))),
+        (slh_dsa::slh_dsa_shake128s::NAME, Box::new(|| slh_dsa_metrics::<SlhDsaShake128S>(m, msg))),
+        (slh_dsa::slh_dsa_shake192f::NAME, Box::new(|| slh_dsa_metrics::<SlhDsaShake192F>(m, msg))),
+        (slh_dsa::slh_dsa_shake192s::NAME, Box::new(|| slh_dsa_metrics::<SlhDsaShake192S>(m, msg))),
+        (slh_dsa::slh_dsa_shake256f::NAME, Box::new(|| slh_dsa_metrics::<SlhDsaShake256F>(m, msg))),
+        (slh_dsa::slh_dsa_shake256s::NAME, Box::new(|| slh_dsa_metrics::<SlhDsaShake256S>(m, msg))),
+    ];
+
+    println!("📊 Metrics pass, up to {} iterations or {:?} per operation\n", m.iterations, BUDGET);
+    println!("  {:<7} {:<20} {:>9} {:>9} {:>10}", "op", "set", "p50 us", "p99 us", "ops/s");
+    for (_, run) in sets.iter().filter(|(name, _)| name.contains(filter)) {
+        run();
+    }
+}
+
+fn main() {
+    let mut msg = String::from("Hello world!");
+    let mut filter = String::new();
+    let mut iterations = 1000;
+    let mut args = env::args().skip(1);
+    while let Some(arg) = args.next() {
+        if arg == "-m" || arg == "--message" {
+            msg = args.next().unwrap_or_default();
+        } else if arg == "-n" || arg == "--iterations" {
+            iterations = args.next().and_then(|n| n.parse().ok()).unwrap_or(iterations).max(1);
+        } else {
+            filter = arg;
+        }
+    }
+
+    if let Some(reporter) = Reporter::from_env("pqc_bench") {
+        let total = Instant::now();
+        run_metrics(&Metrics { reporter, iterations }, &filter, msg.as_bytes());
+        println!("\n✅ Metrics pass completed in {:.2?}", total.elapsed());
+        return;
+    }
+
+    let mut sets: Vec<(&str, Run)> = Vec::new();
+    for &(_, name, run) in ml_kem::SETS {
+        sets.push((name, Box::new(run)));
+    }
+    for &(_, name, run) in mldsa::SETS.iter().chain(slh_dsa::SETS) {
+        let msg = msg.clone();
+        sets.push((name, Box::new(move || run(&msg))));
+    }
+
+    let total = Instant::now();
+    let mut ran = 0;
+    for (name, run) in sets
+        .iter()
+        .filter(|(name, _)| name.contains(filter.as_str()))
+    {
+        let start = Instant::now();
+        run();
+        println!("⏱️  Time for {}: {:.2?}\n", name, start.elapsed());
+        ran += 1;
+    }
+    println!("✅ {} sets completed in {:.2?}", ran, total.elapsed());
+}
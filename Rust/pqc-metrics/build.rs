@@ -0,0 +1,17 @@
+// Records the compiler version for the "build" field of every record.
+
+use std::env;
+use std::process::Command;
+
+fn main() {
+    let rustc = env::var("RUSTC").unwrap_or_else(|_| "rustc".into());
+    let version = Command::new(rustc)
+        .arg("--version")
+        .output()
+        .ok()
+        .and_then(|out| String::from_utf8(out.stdout).ok())
+        .map(|v| v.trim().to_string())
+        .unwrap_or_else(|| "rustc".into());
+    println!("cargo:rustc-env=PQC_METRICS_RUSTC={version}");
+    println!("cargo:rerun-if-env-changed=RUSTC");
+}
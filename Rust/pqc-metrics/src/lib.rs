@@ -0,0 +1,409 @@
+//! Machine-readable benchmark records, the Rust side of
+//! `C/common/pqc_metrics.c`.
+//!
+//! With `PQC_METRICS=json` or `PQC_METRICS=csv` in the environment,
+//! [`Reporter::from_env`] returns a reporter that writes one record per
+//! measured operation: program, algorithm, operation, implementation, sample
+//! count, ops/sec, mean / min / p50 / p90 / p99 / p99.9 / max latency, object
+//! sizes, and (JSON only) the non-empty histogram buckets. Records are
+//! appended to `PQC_METRICS_FILE`, or written to stderr, apart from the
+//! program's text on stdout. They carry the host, a build string and
+//! `PQC_METRICS_TAG`. Schema, columns and bucketing match the C side, so C
+//! and Rust runs from any host can share one file.
+
+use std::env;
+use std::fs::{self, OpenOptions};
+use std::io::{self, Write};
+use std::sync::Mutex;
+use std::time::Duration;
+
+pub const SCHEMA: &str = "pqc-metrics/1";
+
+const SUB: usize = 128;
+pub const BUCKETS: usize = 2 * SUB + 56 * SUB;
+
+fn bucket_of(v: u64) -> usize {
+    if v < 2 * SUB as u64 {
+        return v as usize;
+    }
+    let shift = 63 - v.leading_zeros() - 7;
+    2 * SUB + (shift as usize - 1) * SUB + ((v >> shift) as usize - SUB)
+}
+
+/// Largest value that lands in bucket `i`.
+fn bucket_upper(i: usize) -> u64 {
+    if i < 2 * SUB {
+        return i as u64;
+    }
+    let shift = ((i - 2 * SUB) / SUB) as u32 + 1;
+    let sub = ((i - 2 * SUB) % SUB + SUB) as u64;
+    ((sub + 1) << shift).wrapping_sub(1) // the top bucket wraps to u64::MAX
+}
+
+/// HDR-style latency histogram: values below 256 ns are exact, larger ones
+/// fall in one of 128 linear buckets per power of two (within 1%).
+#[derive(Clone)]
+pub struct Histogram {
+    counts: Vec<u64>,
+    samples: u64,
+    min_ns: u64,
+    max_ns: u64,
+    sum_ns: f64,
+}
+
+impl Default for Histogram {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl Histogram {
+    pub fn new() -> Self {
+        Histogram {
+            counts: vec![0; BUCKETS],
+            samples: 0,
+            min_ns: u64::MAX,
+            max_ns: 0,
+            sum_ns: 0.0,
+        }
+    }
+
+    pub fn record(&mut self, ns: u64) {
+        self.counts[bucket_of(ns)] += 1;
+        self.samples += 1;
+        self.sum_ns += ns as f64;
+        self.min_ns = self.min_ns.min(ns);
+        self.max_ns = self.max_ns.max(ns);
+    }
+
+    pub fn record_duration(&mut self, d: Duration) {
+        self.record(u64::try_from(d.as_nanos()).unwrap_or(u64::MAX));
+    }
+
+    pub fn merge(&mut self, other: &Histogram) {
+        for (dst, src) in self.counts.iter_mut().zip(&other.counts) {
+            *dst += src;
+        }
+        self.samples += other.samples;
+        self.sum_ns += other.sum_ns;
+        self.min_ns = self.min_ns.min(other.min_ns);
+        self.max_ns = self.max_ns.max(other.max_ns);
+    }
+
+    pub fn samples(&self) -> u64 {
+        self.samples
+    }
+
+    pub fn min_ns(&self) -> u64 {
+        if self.samples > 0 {
+            self.min_ns
+        } else {
+            0
+        }
+    }
+
+    pub fn max_ns(&self) -> u64 {
+        self.max_ns
+    }
+
+    pub fn mean_ns(&self) -> f64 {
+        if self.samples > 0 {
+            self.sum_ns / self.samples as f64
+        } else {
+            0.0
+        }
+    }
+
+    /// The p-th percentile (0..100): the upper bound of its bucket. 0 if empty.
+    pub fn percentile(&self, p: f64) -> u64 {
+        if self.samples == 0 {
+            return 0;
+        }
+        let rank = ((p / 100.0 * self.samples as f64 + 0.999999) as u64).clamp(1, self.samples);
+        let mut seen = 0;
+        for (i, &count) in self.counts.iter().enumerate() {
+            seen += count;
+            if seen >= rank {
+                return bucket_upper(i).min(self.max_ns);
+            }
+        }
+        self.max_ns
+    }
+
+    /// (upper bound ns, count) for every non-empty bucket.
+    pub fn buckets(&self) -> impl Iterator<Item = (u64, u64)> + '_ {
+        self.counts
+            .iter()
+            .enumerate()
+            .filter(|(_, &count)| count > 0)
+            .map(|(i, &count)| (bucket_upper(i), count))
+    }
+}
+
+/// Byte sizes of the algorithm's objects; 0 where they do not apply.
+#[derive(Clone, Copy, Debug, Default)]
+pub struct Sizes {
+    pub pk: usize,
+    pub sk: usize,
+    pub ct: usize,
+    pub ss: usize,
+    pub sig: usize,
+}
+
+#[derive(Clone, Copy, PartialEq)]
+enum Format {
+    Json,
+    Csv,
+}
+
+struct Output {
+    w: Box<dyn Write + Send>,
+    header_done: bool,
+}
+
+pub struct Reporter {
+    format: Format,
+    out: Mutex<Output>,
+    program: String,
+    host: String,
+    build: String,
+    tag: String,
+}
+
+fn hostname() -> String {
+    ["/proc/sys/kernel/hostname", "/etc/hostname"]
+        .iter()
+        .filter_map(|path| fs::read_to_string(path).ok())
+        .chain(env::var("HOSTNAME").ok())
+        .chain(env::var("COMPUTERNAME").ok())
+        .map(|h| h.trim().to_string())
+        .find(|h| !h.is_empty())
+        .unwrap_or_else(|| "unknown".into())
+}
+
+fn json_str(s: &str) -> String {
+    let mut out = String::with_capacity(s.len() + 2);
+    out.push('"');
+    for c in s.chars() {
+        match c {
+            '"' | '\\' => {
+                out.push('\\');
+                out.push(c);
+            }
+            c if (c as u32) < 0x20 => out.push_str(&format!("\\u{:04x}", c as u32)),
+            c => out.push(c),
+        }
+    }
+    out.push('"');
+    out
+}
+
+fn csv_str(s: &str) -> String {
+    format!("\"{}\"", s.replace('"', "\"\""))
+}
+
+impl Reporter {
+    /// Reads PQC_METRICS, PQC_METRICS_FILE and PQC_METRICS_TAG. None when
+    /// metrics are off (or the file cannot be opened, after a message).
+    pub fn from_env(program: &str) -> Option<Reporter> {
+        let format = match env::var("PQC_METRICS").ok()?.as_str() {
+            "" => return None,
+            "json" => Format::Json,
+            "csv" => Format::Csv,
+            other => {
+                eprintln!("PQC_METRICS: expected json or csv, got '{other}'");
+                return None;
+            }
+        };
+
+        let out = match env::var("PQC_METRICS_FILE") {
+            Ok(path) if !path.is_empty() => {
+                match OpenOptions::new().create(true).append(true).open(&path) {
+                    Ok(f) => {
+                        let header_done = f.metadata().map_or(false, |m| m.len() > 0);
+                        Output { w: Box::new(f), header_done }
+                    }
+                    Err(e) => {
+                        eprintln!("{path}: {e}");
+                        return None;
+                    }
+                }
+            }
+            _ => Output { w: Box::new(io::stderr()), header_done: false },
+        };
+
+        let profile = if cfg!(debug_assertions) { "debug" } else { "release" };
+        Some(Reporter {
+            format,
+            out: Mutex::new(out),
+            program: program.to_string(),
+            host: hostname(),
+            build: format!("{}, {profile}", env!("PQC_METRICS_RUSTC")),
+            tag: env::var("PQC_METRICS_TAG").unwrap_or_default(),
+        })
+    }
+
+    /// One record. `total` is the wall time for ops/sec (None: the summed
+    /// latency). Write errors are ignored, like the benchmark's own output.
+    pub fn emit(&self, alg: &str, op: &str, imp: &str, h: &Histogram, total: Option<Duration>, sizes: &Sizes) {
+        let total_ns = total.map_or(h.sum_ns, |d| d.as_nanos() as f64);
+        let ops = if total_ns > 0.0 { h.samples as f64 * 1e9 / total_ns } else { 0.0 };
+        let line = match self.format {
+            Format::Json => self.json(alg, op, imp, h, ops, sizes),
+            Format::Csv => self.csv(alg, op, imp, h, ops, sizes),
+        };
+
+        let mut out = self.out.lock().unwrap_or_else(|e| e.into_inner());
+        if self.format == Format::Csv && !out.header_done {
+            let _ = writeln!(
+                out.w,
+                "schema,lang,program,host,build,tag,alg,op,impl,samples,ops_per_sec,mean_ns,min_ns,\
+                 p50_ns,p90_ns,p99_ns,p999_ns,max_ns,pk_bytes,sk_bytes,ct_bytes,ss_bytes,sig_bytes"
+            );
+            out.header_done = true;
+        }
+        let _ = out.w.write_all(line.as_bytes());
+        let _ = out.w.flush();
+    }
+
+    fn json(&self, alg: &str, op: &str, imp: &str, h: &Histogram, ops: f64, sz: &Sizes) -> String {
+        let sizes: Vec<String> = [("pk", sz.pk), ("sk", sz.sk), ("ct", sz.ct), ("ss", sz.ss), ("sig", sz.sig)]
+            .iter()
+            .filter(|(_, v)| *v > 0)
+            .map(|(name, v)| format!("\"{name}\":{v}"))
+            .collect();
+        let buckets: Vec<String> = h.buckets().map(|(upper, count)| format!("[{upper},{count}]")).collect();
+
+        format!(
+            "{{\"schema\":\"{SCHEMA}\",\"lang\":\"rust\",\"program\":{},\"host\":{},\"build\":{},\"tag\":{},\
+             \"alg\":{},\"op\":{},\"impl\":{},\"samples\":{},\"ops_per_sec\":{:.3},\"mean_ns\":{:.1},\
+             \"min_ns\":{},\"p50_ns\":{},\"p90_ns\":{},\"p99_ns\":{},\"p999_ns\":{},\"max_ns\":{},\
+             \"sizes\":{{{}}},\"histogram\":[{}]}}\n",
+            json_str(&self.program),
+            json_str(&self.host),
+            json_str(&self.build),
+            json_str(&self.tag),
+            json_str(alg),
+            json_str(op),
+            json_str(imp),
+            h.samples,
+            ops,
+            h.mean_ns(),
+            h.min_ns(),
+            h.percentile(50.0),
+            h.percentile(90.0),
+            h.percentile(99.0),
+            h.percentile(99.9),
+            h.max_ns,
+            sizes.join(","),
+            buckets.join(",")
+        )
+    }
+
+    fn csv(&self, alg: &str, op: &str, imp: &str, h: &Histogram, ops: f64, sz: &Sizes) -> String {
+        format!(
+            "{SCHEMA},rust,{},{},{},{},{},{},{},{},{:.3},{:.1},{},{},{},{},{},{},{},{},{},{},{}\n",
+            csv_str(&self.program),
+            csv_str(&self.host),
+            csv_str(&self.build),
+            csv_str(&self.tag),
+            csv_str(alg),
+            csv_str(op),
+            csv_str(imp),
+            h.samples,
+            ops,
+            h.mean_ns(),
+            h.min_ns(),
+            h.percentile(50.0),
+            h.percentile(90.0),
+            h.percentile(99.0),
+            h.percentile(99.9),
+            h.max_ns,
+            sz.pk,
+            sz.sk,
+            sz.ct,
+            sz.ss,
+            sz.sig
+        )
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    // (value, bucket, bucket upper bound) from bucket_of() / bucket_upper()
+    // in C/common/pqc_metrics.c
+    const C_BUCKETS: &[(u64, usize, u64)] = &[
+        (0, 0, 0),
+        (1, 1, 1),
+        (255, 255, 255),
+        (256, 256, 257),
+        (257, 256, 257),
+        (258, 257, 259),
+        (511, 383, 511),
+        (512, 384, 515),
+        (513, 384, 515),
+        (1000, 506, 1003),
+        (1207, 534, 1207),
+        (1208, 535, 1215),
+        (65535, 1279, 65535),
+        (65536, 1280, 66047),
+        (1_000_000, 1780, 1_003_519),
+        (123_456_789, 2667, 123_731_967),
+        (1 << 40, 4352, 1_108_101_562_367),
+        ((1 << 40) + 12345, 4352, 1_108_101_562_367),
+        (u64::MAX, 7423, u64::MAX),
+    ];
+
+    #[test]
+    fn buckets_match_c() {
+        assert_eq!(BUCKETS, 7424);
+        for &(v, bucket, upper) in C_BUCKETS {
+            assert_eq!(bucket_of(v), bucket, "bucket_of({v})");
+            assert_eq!(bucket_upper(bucket), upper, "bucket_upper({bucket})");
+        }
+    }
+
+    #[test]
+    fn bucket_bounds_are_contiguous() {
+        for i in 0..BUCKETS {
+            let upper = bucket_upper(i);
+            assert_eq!(bucket_of(upper), i);
+            if i + 1 < BUCKETS {
+                assert_eq!(bucket_of(upper + 1), i + 1);
+            }
+        }
+    }
+
+    #[test]
+    fn percentile_round_trip() {
+        // 1..=1000 us; the C histogram gives the same percentiles
+        let mut h = Histogram::new();
+        for v in 1..=1000u64 {
+            h.record(v * 1000);
+        }
+        assert_eq!(h.samples(), 1000);
+        assert_eq!(h.min_ns(), 1000);
+        assert_eq!(h.max_ns(), 1_000_000);
+        for (p, c) in [(0.0, 1003), (50.0, 501_759), (90.0, 901_119), (99.0, 991_231), (99.9, 999_423), (100.0, 1_000_000)] {
+            let got = h.percentile(p);
+            assert_eq!(got, c, "p{p}");
+            // the rank-th smallest value is rank us, and the bucket is within 1%
+            let exact = ((p / 100.0 * 1000.0 + 0.999999) as u64).clamp(1, 1000) * 1000;
+            assert!(got >= exact && got - exact <= exact / 100, "p{p}: {got} vs {exact}");
+        }
+
+        // Values below 256 ns are exact, and a merge adds the counts
+        let mut small = Histogram::new();
+        for v in [5u64, 17, 255] {
+            small.record(v);
+        }
+        assert_eq!(small.percentile(50.0), 17);
+        assert_eq!(small.buckets().collect::<Vec<_>>(), [(5, 1), (17, 1), (255, 1)]);
+        h.merge(&small);
+        assert_eq!(h.samples(), 1003);
+        assert_eq!(h.min_ns(), 5);
+        assert_eq!(Histogram::new().percentile(50.0), 0);
+    }
+}
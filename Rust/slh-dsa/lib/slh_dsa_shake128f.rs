@@ -1,13 +1,33 @@
 use fips205::slh_dsa_shake_128f;
 use fips205::traits::{SerDes, Signer, Verifier};
-use std::env;
 
-fn main() {
-    let mut msg = String::from("Hello world!");
-    let method = String::from("SLH-DSA-SHAKE-128f");
+use crate::Sig;
+
+pub const NAME: &str = "SLH-DSA-SHAKE-128f";
+
+/// SLH-DSA-SHAKE-128f for generic callers such as the criterion benches.
+pub struct SlhDsaShake128F;
+
+impl Sig for SlhDsaShake128F {
+    const NAME: &'static str = NAME;
+    type Keys = (slh_dsa_shake_128f::PublicKey, slh_dsa_shake_128f::PrivateKey);
+    type Signature = <slh_dsa_shake_128f::PrivateKey as Signer>::Signature;
+
+    fn keygen() -> Self::Keys {
+        slh_dsa_shake_128f::try_keygen().expect("SLH-DSA-SHAKE-128f keygen")
+    }
 
-    let args: Vec<String> = env::args().collect();
-    if args.len() > 1 { msg = args[1].clone(); }
+    fn sign((_, sk): &Self::Keys, msg: &[u8]) -> Self::Signature {
+        sk.try_sign(msg, b"", true).expect("SLH-DSA-SHAKE-128f sign")
+    }
+
+    fn verify((pk, _): &Self::Keys, msg: &[u8], sig: &Self::Signature) -> bool {
+        pk.verify(msg, sig, b"")
+    }
+}
+
+pub fn run(msg: &str) {
+    let method = String::from("SLH-DSA-SHAKE-128f");
 
     let msg_bytes = msg.as_bytes();
 
@@ -58,4 +78,4 @@ fn main() {
     } else {
         println!("\nSignature NOT verified");
     }
-}
\ No newline at end of file
+}
@@ -1,13 +1,33 @@
 use fips205::slh_dsa_shake_128s;
 use fips205::traits::{SerDes, Signer, Verifier};
-use std::env;
 
-fn main() {
-    let mut msg = String::from("Hello world!");
-    let method = String::from("SLH-DSA-SHAKE-128s");
+use crate::Sig;
+
+pub const NAME: &str = "SLH-DSA-SHAKE-128s";
+
+/// SLH-DSA-SHAKE-128s for generic callers such as the criterion benches.
+pub struct SlhDsaShake128S;
+
+impl Sig for SlhDsaShake128S {
+    const NAME: &'static str = NAME;
+    type Keys = (slh_dsa_shake_128s::PublicKey, slh_dsa_shake_128s::PrivateKey);
+    type Signature = <slh_dsa_shake_128s::PrivateKey as Signer>::Signature;
+
+    fn keygen() -> Self::Keys {
+        slh_dsa_shake_128s::try_keygen().expect("SLH-DSA-SHAKE-128s keygen")
+    }
 
-    let args: Vec<String> = env::args().collect();
-    if args.len() > 1 { msg = args[1].clone(); }
+    fn sign((_, sk): &Self::Keys, msg: &[u8]) -> Self::Signature {
+        sk.try_sign(msg, b"", true).expect("SLH-DSA-SHAKE-128s sign")
+    }
+
+    fn verify((pk, _): &Self::Keys, msg: &[u8], sig: &Self::Signature) -> bool {
+        pk.verify(msg, sig, b"")
+    }
+}
+
+pub fn run(msg: &str) {
+    let method = String::from("SLH-DSA-SHAKE-128s");
 
     let msg_bytes = msg.as_bytes();
 
@@ -54,4 +74,4 @@ fn main() {
     } else {
         println!("\nSignature NOT verified");
     }
-}
\ No newline at end of file
+}
@@ -1,13 +1,33 @@
 use fips205::slh_dsa_shake_256f;
 use fips205::traits::{SerDes, Signer, Verifier};
-use std::env;
 
-fn main() {
-    let mut msg = String::from("Hello world!");
-    let method = String::from("SLH-DSA-SHAKE-256f");
+use crate::Sig;
+
+pub const NAME: &str = "SLH-DSA-SHAKE-256f";
+
+/// SLH-DSA-SHAKE-256f for generic callers such as the criterion benches.
+pub struct SlhDsaShake256F;
+
+impl Sig for SlhDsaShake256F {
+    const NAME: &'static str = NAME;
+    type Keys = (slh_dsa_shake_256f::PublicKey, slh_dsa_shake_256f::PrivateKey);
+    type Signature = <slh_dsa_shake_256f::PrivateKey as Signer>::Signature;
+
+    fn keygen() -> Self::Keys {
+        slh_dsa_shake_256f::try_keygen().expect("SLH-DSA-SHAKE-256f keygen")
+    }
 
-    let args: Vec<String> = env::args().collect();
-    if args.len() > 1 { msg = args[1].clone(); }
+    fn sign((_, sk): &Self::Keys, msg: &[u8]) -> Self::Signature {
+        sk.try_sign(msg, b"", true).expect("SLH-DSA-SHAKE-256f sign")
+    }
+
+    fn verify((pk, _): &Self::Keys, msg: &[u8], sig: &Self::Signature) -> bool {
+        pk.verify(msg, sig, b"")
+    }
+}
+
+pub fn run(msg: &str) {
+    let method = String::from("SLH-DSA-SHAKE-256f");
 
     let msg_bytes = msg.as_bytes();
 
@@ -55,4 +75,4 @@ fn main() {
     } else {
         println!("\nSignature NOT verified");
     }
-}
\ No newline at end of file
+}
@@ -1,5 +1,95 @@
-// SLH-DSA Main Entry Point
+// SLH-DSA: every parameter set behind one binary.
+//
+//   slh_dsa [set...] [-m message]
+//
+// A set is its short name from `make list` (a leading '_' is ignored) or
+// "all"; with no set every one runs, so one build covers the comparison.
+//
+// With PQC_METRICS=json or csv (see ../pqc-metrics) each demo is followed by
+// one timed keygen, sign and verify, and one record per operation.
+
+use std::env;
+use std::process;
+use std::time::Instant;
+
+use pqc_metrics::{Histogram, Reporter, Sizes};
+use slh_dsa::slh_dsa_shake128f::SlhDsaShake128F;
+use slh_dsa::slh_dsa_shake128s::SlhDsaShake128S;
+use slh_dsa::slh_dsa_shake192f::SlhDsaShake192F;
+use slh_dsa::slh_dsa_shake192s::SlhDsaShake192S;
+use slh_dsa::slh_dsa_shake256f::SlhDsaShake256F;
+use slh_dsa::slh_dsa_shake256s::SlhDsaShake256S;
+use slh_dsa::{Sig, SETS};
+
+// Public key, private key and signature bytes (FIPS 205), and the metrics
+// pass, by short name
+const METRICS: &[(&str, Sizes, fn(&Reporter, &Sizes, &[u8]))] = &[
+    ("shake128f", Sizes { pk: 32, sk: 64, ct: 0, ss: 0, sig: 17088 }, metrics::<SlhDsaShake128F>),
+    ("shake128s", Sizes { pk: 32, sk: 64, ct: 0, ss: 0, sig: 7856 }, metrics::<SlhDsaShake128S>),
+    ("shake192f", Sizes { pk: 48, sk: 96, ct: 0, ss: 0, sig: 35664 }, metrics::<SlhDsaShake192F>),
+    ("shake192s", Sizes { pk: 48, sk: 96, ct: 0, ss: 0, sig: 16224 }, metrics::<SlhDsaShake192S>),
+    ("shake256f", Sizes { pk: 64, sk: 128, ct: 0, ss: 0, sig: 49856 }, metrics::<SlhDsaShake256F>),
+    ("shake256s", Sizes { pk: 64, sk: 128, ct: 0, ss: 0, sig: 29792 }, metrics::<SlhDsaShake256S>),
+];
+
+fn timed<T>(f: impl FnOnce() -> T) -> (T, Histogram) {
+    let mut h = Histogram::new();
+    let start = Instant::now();
+    let out = f();
+    h.record_duration(start.elapsed());
+    (out, h)
+}
+
+fn metrics<S: Sig>(reporter: &Reporter, sizes: &Sizes, msg: &[u8]) {
+    let (keys, h) = timed(S::keygen);
+    reporter.emit(S::NAME, "keygen", "fips205", &h, None, sizes);
+    let (sig, h) = timed(|| S::sign(&keys, msg));
+    reporter.emit(S::NAME, "sign", "fips205", &h, None, sizes);
+    let (ok, h) = timed(|| S::verify(&keys, msg, &sig));
+    if ok {
+        reporter.emit(S::NAME, "verify", "fips205", &h, None, sizes);
+    }
+}
+
 fn main() {
-    println!("SLH-DSA Signature Implementations");
-    println!("Use: make run-<version> to test different implementations");
+    let mut msg = String::from("Hello world!");
+    let mut wanted: Vec<String> = Vec::new();
+    let mut args = env::args().skip(1);
+    while let Some(arg) = args.next() {
+        if arg == "-m" || arg == "--message" {
+            msg = args.next().unwrap_or_default();
+        } else if arg != "all" {
+            wanted.push(arg.trim_start_matches('_').to_string());
+        }
+    }
+
+    let reporter = Reporter::from_env("slh_dsa");
+    let total = Instant::now();
+    let mut ran = 0;
+    for (key, name, run) in SETS {
+        if !wanted.is_empty() && !wanted.iter().any(|w| key.ends_with(w.as_str())) {
+            continue;
+        }
+        println!("========================================");
+        println!("Running SLH-DSA version: {}", name);
+        println!("========================================");
+        let start = Instant::now();
+        run(&msg);
+        println!("⏱️  Time for {}: {:.2?}\n", name, start.elapsed());
+        if let (Some(reporter), Some((_, sizes, metrics))) =
+            (&reporter, METRICS.iter().find(|(k, _, _)| k == key))
+        {
+            metrics(reporter, sizes, msg.as_bytes());
+        }
+        ran += 1;
+    }
+
+    if ran == 0 {
+        let keys: Vec<&str> = SETS.iter().map(|(key, _, _)| *key).collect();
+        eprintln!("Unknown parameter set; available: {}", keys.join(", "));
+        process::exit(1);
+    }
+    if ran > 1 {
+        println!("✅ All {} sets completed in {:.2?}", ran, total.elapsed());
+    }
 }
@@ -0,0 +1,72 @@
+// Criterion comparison of the six SLH-DSA SHAKE sets on the RustCrypto
+// slh-dsa crate. Same group layout as ../pqc-bench, whose SLH-DSA entries
+// use fips205, so the two reports can be read side by side.
+
+use std::time::Duration;
+
+use criterion::measurement::WallTime;
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkGroup, Criterion};
+
+use slh_dsa_02::slh_dsa_shake128f::SlhDsaShake128F;
+use slh_dsa_02::slh_dsa_shake128s::SlhDsaShake128S;
+use slh_dsa_02::slh_dsa_shake192f::SlhDsaShake192F;
+use slh_dsa_02::slh_dsa_shake192s::SlhDsaShake192S;
+use slh_dsa_02::slh_dsa_shake256f::SlhDsaShake256F;
+use slh_dsa_02::slh_dsa_shake256s::SlhDsaShake256S;
+use slh_dsa_02::Sig;
+
+const MSG: &[u8] = b"Hello world!";
+
+type Group<'a> = BenchmarkGroup<'a, WallTime>;
+
+fn bench_keygen<S: Sig>(g: &mut Group) {
+    g.bench_function(S::NAME, |b| b.iter(S::keygen));
+}
+
+fn bench_sign<S: Sig>(g: &mut Group) {
+    let keys = S::keygen();
+    g.bench_function(S::NAME, |b| {
+        b.iter(|| S::sign(black_box(&keys), black_box(MSG)))
+    });
+}
+
+fn bench_verify<S: Sig>(g: &mut Group) {
+    let keys = S::keygen();
+    let sig = S::sign(&keys, MSG);
+    assert!(S::verify(&keys, MSG, &sig), "{} round trip", S::NAME);
+    g.bench_function(S::NAME, |b| {
+        b.iter(|| S::verify(black_box(&keys), black_box(MSG), black_box(&sig)))
+    });
+}
+
+macro_rules! all_sets {
+    ($c:expr, $group:expr, $bench:ident) => {{
+        let mut g = $c.benchmark_group($group);
+        // the 's' sets are slow enough that criterion's minimum sample count
+        // already takes a while
+        g.sample_size(10);
+        g.measurement_time(Duration::from_secs(10));
+        $bench::<SlhDsaShake128F>(&mut g);
+        $bench::<SlhDsaShake128S>(&mut g);
+        $bench::<SlhDsaShake192F>(&mut g);
+        $bench::<SlhDsaShake192S>(&mut g);
+        $bench::<SlhDsaShake256F>(&mut g);
+        $bench::<SlhDsaShake256S>(&mut g);
+        g.finish();
+    }};
+}
+
+fn keygen(c: &mut Criterion) {
+    all_sets!(c, "keygen", bench_keygen);
+}
+
+fn sign(c: &mut Criterion) {
+    all_sets!(c, "sign", bench_sign);
+}
+
+fn verify(c: &mut Criterion) {
+    all_sets!(c, "verify", bench_verify);
+}
+
+criterion_group!(benches, keygen, sign, verify);
+criterion_main!(benches);
@@ -1,14 +1,36 @@
 use slh_dsa::*;
 use signature::{Keypair, RandomizedSigner, Verifier};
 use rand::rngs::ThreadRng;
-use std::env;
 
-fn main() {
-    let mut msg = String::from("Hello world!");
-    let method = String::from("SLH-DSA-SHAKE-128f");
+use crate::Sig;
+
+pub const NAME: &str = "SLH-DSA-SHAKE-128f";
+
+/// SLH-DSA-SHAKE-128f for generic callers such as the criterion benches.
+pub struct SlhDsaShake128F;
+
+impl Sig for SlhDsaShake128F {
+    const NAME: &'static str = NAME;
+    type Keys = (SigningKey<Shake128f>, VerifyingKey<Shake128f>);
+    type Signature = Signature<Shake128f>;
+
+    fn keygen() -> Self::Keys {
+        let sign_key = SigningKey::<Shake128f>::new(&mut rand::thread_rng());
+        let verify_key = sign_key.verifying_key();
+        (sign_key, verify_key)
+    }
 
-    let args: Vec<String> = env::args().collect();
-    if args.len() > 1 { msg = args[1].clone(); }
+    fn sign((sign_key, _): &Self::Keys, msg: &[u8]) -> Self::Signature {
+        sign_key.sign_with_rng(&mut rand::thread_rng(), msg)
+    }
+
+    fn verify((_, verify_key): &Self::Keys, msg: &[u8], sig: &Self::Signature) -> bool {
+        verify_key.verify(msg, sig).is_ok()
+    }
+}
+
+pub fn run(msg: &str) {
+    let method = String::from("SLH-DSA-SHAKE-128f");
 
     let mut rng = rand::thread_rng();
 
@@ -39,4 +61,4 @@ fn main() {
     } else {
         println!("\nSignature NOT verified");
     }
-}
\ No newline at end of file
+}
@@ -1,14 +1,36 @@
 use slh_dsa::*;
 use signature::*;
 use rand::thread_rng;
-use std::env;
 
-fn main() {
-    let mut msg = String::from("Hello world!");
-    let method = String::from("SLH-DSA-SHAKE-256f");
+use crate::Sig;
+
+pub const NAME: &str = "SLH-DSA-SHAKE-256f";
+
+/// SLH-DSA-SHAKE-256f for generic callers such as the criterion benches.
+pub struct SlhDsaShake256F;
+
+impl Sig for SlhDsaShake256F {
+    const NAME: &'static str = NAME;
+    type Keys = (SigningKey<Shake256f>, VerifyingKey<Shake256f>);
+    type Signature = Signature<Shake256f>;
+
+    fn keygen() -> Self::Keys {
+        let sign_key = SigningKey::<Shake256f>::new(&mut rand::thread_rng());
+        let verify_key = sign_key.verifying_key();
+        (sign_key, verify_key)
+    }
 
-    let args: Vec<String> = env::args().collect();
-    if args.len() > 1 { msg = args[1].clone(); }
+    fn sign((sign_key, _): &Self::Keys, msg: &[u8]) -> Self::Signature {
+        sign_key.sign_with_rng(&mut rand::thread_rng(), msg)
+    }
+
+    fn verify((_, verify_key): &Self::Keys, msg: &[u8], sig: &Self::Signature) -> bool {
+        verify_key.verify(msg, sig).is_ok()
+    }
+}
+
+pub fn run(msg: &str) {
+    let method = String::from("SLH-DSA-SHAKE-256f");
 
     let mut rng = rand::thread_rng();
 
@@ -41,4 +63,4 @@ fn main() {
     } else {
         println!("\nSignature NOT verified");
     }
-}
\ No newline at end of file
+}
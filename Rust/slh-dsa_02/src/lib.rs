@@ -0,0 +1,39 @@
+//! SLH-DSA (FIPS 205) SHAKE parameter sets on the RustCrypto `slh-dsa` crate.
+//!
+//! Each set lives in its own module under `lib/` with the original walk-through
+//! demo (`run`) and a `Sig` implementation, so one binary and one bench build
+//! cover all six.
+
+#[path = "../lib/slh_dsa_shake128f.rs"]
+pub mod slh_dsa_shake128f;
+#[path = "../lib/slh_dsa_shake128s.rs"]
+pub mod slh_dsa_shake128s;
+#[path = "../lib/slh_dsa_shake192f.rs"]
+pub mod slh_dsa_shake192f;
+#[path = "../lib/slh_dsa_shake192s.rs"]
+pub mod slh_dsa_shake192s;
+#[path = "../lib/slh_dsa_shake256f.rs"]
+pub mod slh_dsa_shake256f;
+#[path = "../lib/slh_dsa_shake256s.rs"]
+pub mod slh_dsa_shake256s;
+
+/// One signature parameter set.
+pub trait Sig {
+    const NAME: &'static str;
+    type Keys;
+    type Signature;
+
+    fn keygen() -> Self::Keys;
+    fn sign(keys: &Self::Keys, msg: &[u8]) -> Self::Signature;
+    fn verify(keys: &Self::Keys, msg: &[u8], sig: &Self::Signature) -> bool;
+}
+
+/// Demo entry points by short name, as used by `make run-<name>`.
+pub const SETS: &[(&str, &str, fn(&str))] = &[
+    ("shake128f", slh_dsa_shake128f::NAME, slh_dsa_shake128f::run),
+    ("shake128s", slh_dsa_shake128s::NAME, slh_dsa_shake128s::run),
+    ("shake192f", slh_dsa_shake192f::NAME, slh_dsa_shake192f::run),
+    ("shake192s", slh_dsa_shake192s::NAME, slh_dsa_shake192s::run),
+    ("shake256f", slh_dsa_shake256f::NAME, slh_dsa_shake256f::run),
+    ("shake256s", slh_dsa_shake256s::NAME, slh_dsa_shake256s::run),
+];